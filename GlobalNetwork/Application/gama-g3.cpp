@@ -18,20 +18,33 @@
     along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <gnu_gama/xml/dataparser.h>
 #include <gnu_gama/g3/g3_model.h>
 #include <Utilities/Business/version.h>
+#include <Utilities/Service/profile.h>
+#include <Math/Service/memalloc.h>
 
 namespace
 {
   const char* arg_input     = nullptr;
   const char* arg_output    = nullptr;
   const char* arg_algorithm = nullptr;
+  const char* arg_ordering  = nullptr;
   const char* arg_projeq    = nullptr;
+  const char* arg_threads   = nullptr;
+  const char* arg_iter      = nullptr;
+  const char* arg_tol_iter  = nullptr;
+  const char* arg_profile   = nullptr;
 
   GNU_gama::Adj::algorithm algorithm;
+  GNU_gama::SparseOrdering ordering;
+  int threads = 1;
+  int iterations = 1;
+  double tol_iterations = 0;
 
   int error(const char* s) { std::cerr << s << "\n"; return 1; }
 
@@ -44,10 +57,25 @@ namespace
       " input      xml data file name\n"
       " output     optional output data file name\n\n"
 
-      " --algorithm  envelope | gso | svd | cholesky\n"
+      " --algorithm  envelope | gso | svd | cholesky | supernodal\n"
+      " --ordering   rcm | amd | nd\n"
+      "     ordering of unknowns for sparse algorithms, predicted fill\n"
+      "     and operation count are written to standard error output\n"
+      " --threads    N\n"
+      "     number of threads used in envelope decomposition (0 for all\n"
+      "     cores), results do not depend on the number of threads\n"
+      " --iterations N\n"
+      "     maximal number of Gauss-Newton iterations (implicit value 1),\n"
+      "     norms of corrections and timings of each iteration are\n"
+      "     written to standard error output\n"
+      " --tol-iterations mm\n"
+      "     iterations stop when all corrections are less than the limit\n"
 
       " --project-equations file"
       "     optional output of project equations in XML\n"
+      " --profile    text | json\n"
+      "     elapsed time and peak memory of computational phases are\n"
+      "     written to standard error output\n"
 
       "\n"
       " -h         help (this text)\n"
@@ -92,9 +120,85 @@ namespace
             else if (arg == "gso"     ) algorithm = GNU_gama::Adj::gso;
             else if (arg == "svd"     ) algorithm = GNU_gama::Adj::svd;
             else if (arg == "cholesky") algorithm = GNU_gama::Adj::cholesky;
+            else if (arg == "supernodal") algorithm = GNU_gama::Adj::supernodal;
             else
               ok = false;
 
+            continue;
+          }
+        if (a == "-ordering")
+          {
+            if (++i < argc)
+              arg_ordering = argv[i];
+            else
+              ok = false;
+
+            const std::string arg = arg_ordering ? arg_ordering : "";
+            if      (arg == "rcm") ordering = GNU_gama::SparseOrdering::rcm;
+            else if (arg == "amd") ordering = GNU_gama::SparseOrdering::amd;
+            else if (arg == "nd" ) ordering = GNU_gama::SparseOrdering::nd;
+            else
+              ok = false;
+
+            continue;
+          }
+        if (a == "-threads")
+          {
+            if (++i < argc)
+              arg_threads = argv[i];
+            else
+              ok = false;
+
+            const std::string arg = arg_threads ? arg_threads : "";
+            if (arg.empty() ||
+                arg.find_first_not_of("0123456789") != std::string::npos)
+              ok = false;
+            else
+              threads = std::stoi(arg);
+
+            continue;
+          }
+        if (a == "-iterations")
+          {
+            if (++i < argc)
+              arg_iter = argv[i];
+            else
+              ok = false;
+
+            const std::string arg = arg_iter ? arg_iter : "";
+            if (arg.empty() ||
+                arg.find_first_not_of("0123456789") != std::string::npos ||
+                (iterations = std::stoi(arg)) < 1)
+              ok = false;
+
+            continue;
+          }
+        if (a == "-tol-iterations")
+          {
+            if (++i < argc)
+              arg_tol_iter = argv[i];
+            else
+              ok = false;
+
+            char* end = nullptr;
+            if (arg_tol_iter)
+              tol_iterations = std::strtod(arg_tol_iter, &end);
+            if (end == arg_tol_iter || (end && *end) || tol_iterations < 0)
+              ok = false;
+
+            continue;
+          }
+        if (a == "-profile")
+          {
+            if (++i < argc)
+              arg_profile = argv[i];
+            else
+              ok = false;
+
+            const std::string arg = arg_profile ? arg_profile : "";
+            if (arg != "text" && arg != "json")
+              ok = false;
+
             continue;
           }
         if (a == "-project-equations")
@@ -127,21 +231,12 @@ namespace
   {
     using namespace GNU_gama::g3;
 
-    std::ifstream input(file);
-    if (!input) return nullptr;
-
     std::list<GNU_gama::DataObject::Base*> objects;
     GNU_gama::DataParser parser(objects);
 
     try
       {
-        std::string text;
-        while (std::getline(input, text))
-          {
-            parser.xml_parse(text.c_str(), text.length(), 0);
-            parser.xml_parse("\n", 1, 0);
-          }
-        parser.xml_parse("", 0, 1);
+        if (!parser.xml_parse_file(file)) return nullptr;
       }
     catch(const GNU_gama::Exception::parser& p)
       {
@@ -183,12 +278,27 @@ int main_g3()
   using namespace std;
   using namespace GNU_gama::g3;
 
-  Model* model = get_xml_input(arg_input);
+  GNU_gama::Profile profile;
+  GNU_gama::Profile::Active active_profile(arg_profile ? &profile : nullptr);
+  GNU_gama::Profile::set_allocation_counter(GNU_gama::MemAlloc::heap_counter);
+
+  Model* model = nullptr;
+  {
+    GNU_gama::Profile::Scope phase("input");
+    model = get_xml_input(arg_input);
+  }
   if (model == nullptr) return error("error on reading XML input data");
 
   if (arg_algorithm) model->set_algorithm(algorithm);
+  if (arg_ordering)  model->set_ordering(ordering);
+  if (arg_threads)   model->set_threads(threads);
+  if (arg_iter)      model->set_max_iterations(iterations);
+  if (arg_tol_iter)  model->set_tol_iterations(tol_iterations);
 
-  model->update_linearization();
+  {
+    GNU_gama::Profile::Scope phase("linearization");
+    model->update_linearization();
+  }
 
   if (arg_projeq)
     {
@@ -199,19 +309,55 @@ int main_g3()
       out << GNU_gama::DataObject::Base::xml_end();
     }
 
-  model->update_adjustment();
+  {
+    GNU_gama::Profile::Scope phase("adjustment");
+    model->update_adjustment();
+  }
 
-  if (arg_output)
+  if (arg_ordering)
     {
-      ofstream file(arg_output);
-      if (file)
-        model->write_xml_adjustment_results(file);
-      else
-        std::cerr << "\n****** error on opening file " << arg_output << "\n\n";
+      std::cerr << "ordering " << arg_ordering
+                << " : factor elements " << model->adjustment()->factor_nonzeroes()
+                << ", operations " << model->adjustment()->factor_flops() << "\n";
     }
-  else
+
+  if (arg_iter)
     {
-      model->write_xml_adjustment_results(std::cout);
+      int n = 0;
+      for (const Model::Iteration& i : model->iterations)
+        {
+          std::cerr << "iteration " << ++n
+                    << " : linearized " << i.linearized
+                    << ", max correction " << i.max_correction
+                    << ", norm " << i.norm_correction
+                    << ", rtr " << i.rtr
+                    << ", time " << i.time_linearization
+                    << " + " << i.time_adjustment << " s\n";
+        }
+    }
+
+  {
+    GNU_gama::Profile::Scope phase("xml_output");
+    if (arg_output)
+      {
+        ofstream file(arg_output);
+        if (file)
+          model->write_xml_adjustment_results(file);
+        else
+          std::cerr << "\n****** error on opening file " << arg_output << "\n\n";
+      }
+    else
+      {
+        model->write_xml_adjustment_results(std::cout);
+      }
+  }
+
+  if (arg_profile)
+    {
+      if (std::string(arg_profile) == "json")
+        profile.write_json(std::cerr);
+      else
+        profile.write_text(std::cerr);
     }
 
   delete model;
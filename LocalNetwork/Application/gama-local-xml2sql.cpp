@@ -20,29 +20,64 @@
 */
 
 #include <gnu_gama/local/localnetwork2sql.h>
+#include <gnu_gama/local/sqlitewriter.h>
 #include <gnu_gama/exception.h>
 #include <Utilities/Business/version.h>
 #include <iostream>
 #include <fstream>
+#include <string>
 
 
 int help()
 {
   using std::cerr;
   
-  cerr << "Usage: gama-local-xml2sql configuration (xml_input|-) [sql_output|-]\n\n" 
-       << "Convert XML adjustment input of gama-local to SQL\n\n";
+  cerr << "Usage: gama-local-xml2sql configuration (xml_input|-) [sql_output|-]\n"
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+       << "       gama-local-xml2sql --sqlitedb file.db [--stream] "
+          "configuration (xml_input|-)\n"
+#endif
+       << "\nConvert XML adjustment input of gama-local to SQL\n\n"
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+       << "--sqlitedb  write directly into SQLite 3 database in one transaction\n"
+       << "--stream    write clusters of observations as they are read\n\n"
+#endif
+    ;
   
   return 1;
 }
 
 
+struct Options
+{
+  const char* configuration = nullptr;
+  const char* sqlitedb      = nullptr;
+  bool        stream        = false;
+};
+
 
-int parameters(int argc, char* argv[], std::istream*& xml, std::ostream*& sql)
+int parameters(int argc, char* argv[], Options& opt, std::istream*& xml, std::ostream*& sql)
 {
+  int a = 1;
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+  for (; a < argc && argv[a][0] == '-' && argv[a][1] == '-'; a++)
+    {
+      const std::string name = argv[a];
+      if      (name == "--sqlitedb" && a+1 < argc) opt.sqlitedb = argv[++a];
+      else if (name == "--stream")                 opt.stream = true;
+      else return help();
+    }
+  if (opt.stream && !opt.sqlitedb) return help();
+#endif
+
+  argc -= a-1;
+  argv += a-1;
+
   if (argc < 2 || argc > 4) return help();
+  if (opt.sqlitedb && argc > 3) return help();
   
   if (argv[1][0] == '-' ) return help();
+  opt.configuration = argv[1];
 
   const char* inp = "-";
   const char* out = "-";
@@ -50,6 +85,7 @@ int parameters(int argc, char* argv[], std::istream*& xml, std::ostream*& sql)
   switch (argc)
     {
     case 4 : out = argv[3];
+    // fall through
     case 3 : inp = argv[2]; break;
     default: return help();
     }
@@ -59,7 +95,9 @@ int parameters(int argc, char* argv[], std::istream*& xml, std::ostream*& sql)
   else
     xml = new std::ifstream(inp);
 
-  if (std::string(out) == "-")
+  if (opt.sqlitedb)
+    sql = nullptr;
+  else if (std::string(out) == "-")
     sql = &std::cout;
   else
     sql = new std::ofstream(out);
@@ -72,16 +110,34 @@ int main(int argc, char* argv[])
 {
   std::istream* inp;
   std::ostream* out;
+  Options       opt;
 
   GNU_gama::local::LocalNetwork lnet;
 
   try
     {
-      if (const int k = parameters(argc, argv, inp, out)) return k;
+      if (const int k = parameters(argc, argv, opt, inp, out)) return k;
+
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+      if (opt.sqlitedb)
+        {
+          GNU_gama::local::sqlite_db::SqliteWriter writer(opt.sqlitedb);
+          if (opt.stream)
+            {
+              writer.write_input(*inp, opt.configuration);
+            }
+          else
+            {
+              GNU_gama::local::LocalNetwork2sql(lnet).readGkf(*inp);
+              writer.write_input(&lnet, opt.configuration);
+            }
+          return 0;
+        }
+#endif
 
       GNU_gama::local::LocalNetwork2sql ln2sql(lnet);
       ln2sql.readGkf(*inp);
-      ln2sql.write  (*out, argv[1]);
+      ln2sql.write  (*out, opt.configuration);
       out->flush(); 
    }
   catch (GNU_gama::Exception::parser perr)
@@ -92,10 +148,15 @@ int main(int argc, char* argv[])
                 << std::endl;
       return 1;
     }
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+  catch (const GNU_gama::Exception::sqlitexc& e)
+    {
+      std::cerr << "sqlite error : " << e.what() << std::endl;
+      return 1;
+    }
+#endif
   catch (...)
     {
       std::cerr << "unknown exception\n";
     }
 }
-
-
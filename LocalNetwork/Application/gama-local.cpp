@@ -22,16 +22,29 @@
 
 #ifdef GNU_GAMA_LOCAL_SQLITE_READER
 #include <gnu_gama/local/sqlitereader.h>
+#include <gnu_gama/local/sqlitewriter.h>
 #endif
 
 #include <Parsing/Business/outstream.h>
 
 #include <Math/Business/Core/intfloat.h>
+#include <Math/Service/memalloc.h>
 #include <Utilities/Business/version.h>
+#include <Utilities/Service/profile.h>
 #include <gnu_gama/xml/gkfparser.h>
 #include <gnu_gama/xml/localnetworkoctave.h>
 #include <gnu_gama/xml/localnetworkxml.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include <gnu_gama/ellipsoids.h>
 #include <gnu_gama/local/acord/acord2.h>
@@ -68,6 +81,8 @@ std::istream& operator>>(std::istream& in, GNU_gama::local::gama_language& langu
 }  // namespace local
 
 std::istream& operator>>(std::istream& in, GNU_gama::OutStream::Encoding& encoding);
+std::istream& operator>>(std::istream& in, GNU_gama::SparseOrdering& ordering);
+std::istream& operator>>(std::istream& in, GNU_gama::SVDMethod& method);
 }  // namespace GNU_gama
 
 enum class Angle
@@ -76,20 +91,29 @@ enum class Angle
     Degree
 };
 std::istream& operator>>(std::istream& in, Angle& angles);
-GNU_gama::local::XMLerror xmlerr;
+namespace boost_options = boost::program_options;
 
-
-int main(int argc, char* argv[]) try
+namespace
 {
+/* Settings of a single adjustment, option values are bound to its
+ * members. In batch mode each job has its own settings.
+ */
+struct Settings
+{
+    GNU_gama::local::LocalNetwork::Algorithm algo {GNU_gama::local::LocalNetwork::Algorithm::envelope};
+    GNU_gama::SparseOrdering ordering {GNU_gama::SparseOrdering::rcm};
+    GNU_gama::SVDMethod svd_method {GNU_gama::SVDMethod::golub_reinsch};
+    GNU_gama::local::gama_language lang {GNU_gama::local::en};
+    GNU_gama::OutStream::Encoding enc {GNU_gama::OutStream::utf_8};
+    Angle angles {Angle::Gon};
+    int iterations {5};
+    int threads {1};
+
+    boost_options::variables_map option_variables;
+};
 
-    auto argv_algo = GNU_gama::local::LocalNetwork::Algorithm::envelope;
-    auto argv_lang = GNU_gama::local::en;
-    auto argv_enc = GNU_gama::OutStream::utf_8;
-    auto argv_angles = Angle::Gon;
-    auto argv_iterations = int{5};
-
-    namespace boost_options = boost::program_options;
-
+boost_options::options_description options(Settings& s)
+{
     auto option_description = boost_options::options_description( "\n"
       "Adjustment of local geodetic network version: " + GNU_gama::GNU_gama_version() +
       " / " + GNU_gama::GNU_gama_compiler() + "\n"
@@ -104,16 +128,25 @@ int main(int argc, char* argv[]) try
        "gama-local  --sqlitedb sqlite.db"
        "  --readonly-configuration name  [options]\n"
 #endif
+      "gama-local  --batch manifest.txt | directory  [options]\n"
       "\nOptions");
 
       option_description.add_options()
         ("help,h", "Display this help message")
         ("version,v", "Display the version number")
         ("input-file", boost_options::value<std::string>(), "The input xml that will be parsed")
-        ("algorithm", boost_options::value<GNU_gama::local::LocalNetwork::Algorithm>(&argv_algo), "gso | svd | cholesky | envelope")
-        ("language", boost_options::value<GNU_gama::local::gama_language>(&argv_lang), "en | ca | cz | du | es | fi | fr | hu | ru | ua | zh")
-        ("encoding", boost_options::value<GNU_gama::OutStream::Encoding>(&argv_enc), "utf-8 | iso-8859-2 | iso-8859-2-flat | cp-1250 | cp-1251" )
-        ("angles", boost_options::value<Angle>(&argv_angles),"400 | 360")
+        ("algorithm", boost_options::value<GNU_gama::local::LocalNetwork::Algorithm>(&s.algo), "gso | svd | cholesky | envelope | supernodal")
+        ("ordering", boost_options::value<GNU_gama::SparseOrdering>(&s.ordering),
+            "rcm | amd | nd\n"
+            "ordering of unknowns for sparse algorithms, predicted fill and operation count are written to standard error output")
+        ("svd-method", boost_options::value<GNU_gama::SVDMethod>(&s.svd_method),
+            "golub-reinsch | jacobi\n"
+            "singular value decomposition used by the svd algorithm, one-sided Jacobi is computed in parallel with --threads")
+        ("threads", boost_options::value<int>(&s.threads),
+            "number of threads used in linearization, envelope decomposition and dense normal equations (0 for all cores), results do not depend on the number of threads")
+        ("language", boost_options::value<GNU_gama::local::gama_language>(&s.lang), "en | ca | cz | du | es | fi | fr | hu | ru | ua | zh")
+        ("encoding", boost_options::value<GNU_gama::OutStream::Encoding>(&s.enc), "utf-8 | iso-8859-2 | iso-8859-2-flat | cp-1250 | cp-1251" )
+        ("angles", boost_options::value<Angle>(&s.angles),"400 | 360")
         ("ellipsoid", boost_options::value<std::string>(), "<ellipsoid name>")
         ("latitude", boost_options::value<std::string>(), "<latitude>")
         ("text", boost_options::value<std::string>(), "adjustment_results.txt")
@@ -128,7 +161,7 @@ int main(int argc, char* argv[]) try
             "covariance matrix of adjusted parameters in XML output\n"
             "n  = -1 \tfor full covariance matrix (implicit value)\n"
             "n >=  0 \tcovariances are computed only for bandwidth n\n")
-        ("iterations", boost_options::value<int>(&argv_iterations),
+        ("iterations", boost_options::value<int>(&s.iterations),
             "maximum number of iterations allowed in the linearized least squares algorithm (implicit value is 5)")
         ("updated-xml", boost_options::value<std::string>(), 
             // TODO
@@ -137,22 +170,57 @@ int main(int argc, char* argv[]) try
         ("sqlitedb", boost_options::value<std::string>(), "sqlitedb sqlite.db")
         ("configuration", boost_options::value<std::string>(), "name")
         ("readonly-configuration", boost_options::value<std::string>(), "name")
+        ("sqlite-statistics",
+            "number of rows and load time for each table read from sqlitedb are written to standard error output")
   #endif
+        ("profile", boost_options::value<std::string>(),
+            "text | json\n"
+            "elapsed time and peak memory of computational phases are written to standard error output and to the xml output")
+        ("allocator", boost_options::value<std::string>(),
+            "default | aligned | pool\n"
+            "storage of matrices and vectors is allocated from the heap, aligned to 64 bytes or reused from a memory pool of the adjustment (implicit value is default)")
+        ("batch", boost_options::value<std::string>(),
+            "manifest.txt | directory\n"
+            "adjust all networks given by lines of the manifest (command line arguments of gama-local without --profile and --allocator) or all .gkf files in the directory")
+        ("batch-threads", boost_options::value<int>(),
+            "number of networks adjusted concurrently in batch mode (0 for all cores, implicit value)")
+        ("batch-output", boost_options::value<std::string>(),
+            "directory for text and xml results of networks read from a batch directory (implicit value is the working directory)")
       ;
 
+    return option_description;
+}
+
+boost_options::parsed_options parse(Settings& s,
+                                    const boost_options::options_description& option_description,
+                                    const std::vector<std::string>& args)
+{
     auto positional_options = boost_options::positional_options_description{};
     positional_options.add("input-file", 1);
 
-    auto option_variables = boost_options::variables_map{};
+    auto parsed = boost_options::command_line_parser(args)
+                      .options(option_description)
+                      .positional(positional_options)
+                      .run();
+    boost_options::store(parsed, s.option_variables);
+    boost_options::notify(s.option_variables);
+
+    return parsed;
+}
 
-    boost_options::store(
-        boost_options::command_line_parser(argc, argv)
-            .options(option_description)
-            .positional(positional_options)
-            .run(),
-        option_variables);
+int adjust(const Settings& s, std::ostream& out, std::ostream& err);
+int batch(const Settings& s, const std::vector<std::string>& common);
+}  // namespace
 
 
+int main(int argc, char* argv[]) try
+{
+    Settings settings;
+    auto option_description = options(settings);
+    auto parsed = parse(settings, option_description,
+                        std::vector<std::string>(argv + 1, argv + argc));
+    const auto& option_variables = settings.option_variables;
+
     if(option_variables.count("help"))
     {
         std::cout << option_description << std::endl;
@@ -165,7 +233,86 @@ int main(int argc, char* argv[]) try
         return GNU_gama::version("gama-local", "Ales Cepek et al.");
     }
 
-    set_gama_language(argv_lang);
+    // language of messages outside of networks, each network (and job
+    // in batch mode) writes its texts in the language of its settings
+    set_gama_language(settings.lang);
+
+    // allocation policy of matrices and vectors is process-wide too,
+    // profiles report allocations of matrix and vector storage
+    GNU_gama::Profile::set_allocation_counter(GNU_gama::MemAlloc::heap_counter);
+    if(option_variables.count("allocator"))
+    {
+        using GNU_gama::MemAlloc::Policy;
+        const auto allocator = option_variables["allocator"].as<std::string>();
+        if(allocator == "default")
+            GNU_gama::MemAlloc::set_policy(Policy::standard);
+        else if(allocator == "aligned")
+            GNU_gama::MemAlloc::set_policy(Policy::aligned);
+        else if(allocator == "pool")
+            GNU_gama::MemAlloc::set_policy(Policy::pool);
+        else
+        {
+            boost_options::invalid_option_value error(allocator);
+            error.set_option_name("--allocator");
+            throw error;
+        }
+    }
+
+    if(option_variables.count("batch"))
+    {
+        if(option_variables.count("profile"))
+            throw GNU_gama::local::Exception("option --profile is not available in batch mode");
+
+        // options other than batch options, input and the allocator (set
+        // above for the whole process) are common to all jobs
+        std::vector<std::string> common;
+        for(const auto& option : parsed.options)
+        {
+            if(option.string_key == "batch" || option.string_key == "batch-threads"
+               || option.string_key == "batch-output" || option.string_key == "input-file"
+               || option.string_key == "allocator")
+                continue;
+            common.insert(common.end(), option.original_tokens.begin(),
+                          option.original_tokens.end());
+        }
+
+        return batch(settings, common);
+    }
+
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+    if((option_variables.count("configuration") && option_variables.count("readonly-configuration"))
+       || (!option_variables.count("input-file") && !option_variables.count("sqlitedb")))
+    {
+        std::cout << option_description << std::endl;
+        return EXIT_SUCCESS;
+    }
+#endif
+
+    return adjust(settings, std::cout, std::cerr);
+}
+catch(std::exception& stde)
+{
+    std::cout << "\n" << stde.what() << "\n\n";
+    return 1;
+}
+
+
+namespace
+{
+/* Adjustment of a single network, messages are written to out and err
+ * streams, exceptions are handled in adjust().
+ */
+int run(const Settings& s, std::ostream& out, std::ostream& err,
+        GNU_gama::local::XMLerror& xmlerr)
+{
+    const auto& argv_algo = s.algo;
+    const auto& argv_ordering = s.ordering;
+    const auto& argv_svd_method = s.svd_method;
+    const auto& argv_enc = s.enc;
+    const auto& argv_angles = s.angles;
+    const auto& argv_iterations = s.iterations;
+    const auto& argv_threads = s.threads;
+    const auto& option_variables = s.option_variables;
 
     // implicit output
     std::ostream* output = nullptr;
@@ -173,7 +320,7 @@ int main(int argc, char* argv[]) try
     if(!option_variables.count("text") && !option_variables.count("html")
        && !option_variables.count("xml"))
     {
-        output = &std::cout;
+        output = &out;
     }
     std::ofstream fcout;
     if(option_variables.count("text"))
@@ -183,29 +330,33 @@ int main(int argc, char* argv[]) try
         output = &fcout;
     }
 
-#ifdef GNU_GAMA_LOCAL_SQLITE_READER
-    if(option_variables.count("configuration") && option_variables.count("readonly-configuration"))
-    {
-        std::cout << option_description << std::endl;
-        return EXIT_SUCCESS;
-    }
-
-    if(!option_variables.count("input-file") && !option_variables.count("sqlitedb"))
-    {
-        std::cout << option_description << std::endl;
-        return EXIT_SUCCESS;
-    }
-#endif
-
     GNU_gama::OutStream cout(output);
     cout.set_encoding(argv_enc);
 
-    GNU_gama::local::LocalNetwork* IS = new GNU_gama::local::LocalNetwork;
+    auto network = std::make_unique<GNU_gama::local::LocalNetwork>();
+    GNU_gama::local::LocalNetwork* IS = network.get();
+    IS->set_language(s.lang);
+    const GNU_gama::local::Texts& texts = IS->texts();
+
+    const bool profiling = option_variables.count("profile");
+    if(profiling)
+    {
+        auto format = option_variables["profile"].as<std::string>();
+        if(format != "text" && format != "json")
+        {
+            boost_options::invalid_option_value error(format);
+            error.set_option_name("--profile");
+            throw error;
+        }
+    }
+    GNU_gama::Profile profile;
+    GNU_gama::Profile::Active active_profile(profiling ? &profile : nullptr);
 
 #ifdef GNU_GAMA_LOCAL_SQLITE_READER
     if(option_variables.count("sqlitedb"))
     {
         auto argv_sqlitedb = option_variables["sqlitedb"].as<std::string>();
+        GNU_gama::Profile::Scope phase("input");
         GNU_gama::local::sqlite_db::SqliteReader reader(argv_sqlitedb);
 
         auto conf = std::string{};
@@ -215,10 +366,19 @@ int main(int argc, char* argv[]) try
             conf = option_variables["readonly-configuration"].as<std::string>();
 
         reader.retrieve(IS, conf);
+
+        if(option_variables.count("sqlite-statistics"))
+        {
+            for(const auto& table : reader.load_statistics())
+                err << "sqlite " << table.table
+                    << " : rows " << table.rows
+                    << ", time " << table.seconds << " s\n";
+        }
     }
     else
 #endif
     {
+        GNU_gama::Profile::Scope phase("input");
         auto argv_1 = option_variables["input-file"].as<std::string>();
         std::ifstream soubor(argv_1);
         try
@@ -230,7 +390,7 @@ int main(int argc, char* argv[]) try
         {
             if(xmlerr.isValid())
             {
-                xmlerr.setDescription(GNU_gama::local::T_GaMa_exception_2a);
+                xmlerr.setDescription(texts.T_GaMa_exception_2a);
                 std::string t;
                 
                 auto message = std::string_view{exception.what()};
@@ -248,34 +408,46 @@ int main(int argc, char* argv[]) try
                 return xmlerr.write_xml("gamaLocalParserError");
             }
 
-            std::cerr << "\n"
-                      << GNU_gama::local::T_GaMa_exception_2a << "\n\n"
-                      << GNU_gama::local::T_GaMa_exception_2b << exception.line << " : " << exception.what()
-                      << std::endl;
+            err << "\n"
+                << texts.T_GaMa_exception_2a << "\n\n"
+                << texts.T_GaMa_exception_2b << exception.line << " : " << exception.what()
+                << std::endl;
             return 3;
         }
         catch(const GNU_gama::local::Exception& v)
         {
             if(xmlerr.isValid())
             {
-                xmlerr.setDescription(GNU_gama::local::T_GaMa_exception_2a);
+                xmlerr.setDescription(texts.T_GaMa_exception_2a);
                 xmlerr.setDescription(v.what());
                 return xmlerr.write_xml("gamaLocalException");
             }
 
-            std::cerr << "\n"
-                      << GNU_gama::local::T_GaMa_exception_2a << "\n"
-                      << "\n***** " << v.what() << "\n\n";
+            err << "\n"
+                << texts.T_GaMa_exception_2a << "\n"
+                << "\n***** " << v.what() << "\n\n";
             return 2;
         }
         catch(...)
         {
-            std::cerr << "\n" << GNU_gama::local::T_GaMa_exception_2a << "\n\n";
+            err << "\n" << texts.T_GaMa_exception_2a << "\n\n";
             throw;
         }
     }
 
-    IS->set_algorithm(argv_algo);
+    if(option_variables.count("algorithm") || !IS->has_algorithm())
+        IS->set_algorithm(argv_algo);
+    if(option_variables.count("ordering"))
+        IS->set_ordering(argv_ordering);
+    if(option_variables.count("svd-method"))
+        IS->set_svd_method(argv_svd_method);
+    if(argv_threads < 0)
+    {
+        boost_options::invalid_option_value error(std::to_string(argv_threads));
+        error.set_option_name("--threads");
+        throw error;
+    }
+    IS->set_threads(argv_threads);
 
     switch(argv_angles)
     {
@@ -289,7 +461,7 @@ int main(int argc, char* argv[]) try
 
         if(band < -1)
         {
-            std::cout << "band variable is invalid";
+            out << "band variable is invalid";
             return EXIT_SUCCESS;
         }
 
@@ -298,7 +470,7 @@ int main(int argc, char* argv[]) try
 
     if(argv_iterations < 0)
     {
-        std::cout << "The number of iterations must be a positive number";
+        out << "The number of iterations must be a positive number";
         return EXIT_SUCCESS;
     }
 
@@ -312,7 +484,7 @@ int main(int argc, char* argv[]) try
         {
             if(!GNU_gama::IsFloat(argv_latitude))
             {
-                std::cout << "The latitude was not valid";
+                out << "The latitude was not valid";
                 return EXIT_SUCCESS;
             }
 
@@ -329,7 +501,7 @@ int main(int argc, char* argv[]) try
         GNU_gama::gama_ellipsoid gama_el = GNU_gama::ellipsoid(argv_ellipsoid.c_str());
         if(gama_el == GNU_gama::ellipsoid_unknown)
         {
-            std::cout << "The defined ellipsoid is unknown.";
+            out << "The defined ellipsoid is unknown.";
             return EXIT_SUCCESS;
         }
         IS->set_ellipsoid(argv_ellipsoid);
@@ -337,20 +509,20 @@ int main(int argc, char* argv[]) try
 
 
     {
-        cout << GNU_gama::local::T_GaMa_Adjustment_of_geodetic_network << "        "
-             << GNU_gama::local::T_GaMa_version << GNU_gama::GNU_gama_version() << "-"
+        cout << texts.T_GaMa_Adjustment_of_geodetic_network << "        "
+             << texts.T_GaMa_version << GNU_gama::GNU_gama_version() << "-"
              << IS->algorithm() << " / " << GNU_gama::GNU_gama_compiler() << "\n"
              << GNU_gama::local::underline(
-                    GNU_gama::local::T_GaMa_Adjustment_of_geodetic_network, '*')
+                    texts.T_GaMa_Adjustment_of_geodetic_network, '*')
              << "\n"
              << "http://www.gnu.org/software/gama/\n\n\n";
     }
 
     if(IS->PD.empty())
-        throw GNU_gama::local::Exception(GNU_gama::local::T_GaMa_No_points_available);
+        throw GNU_gama::local::Exception(texts.T_GaMa_No_points_available);
 
     if(IS->OD.clusters.empty())
-        throw GNU_gama::local::Exception(GNU_gama::local::T_GaMa_No_observations_available);
+        throw GNU_gama::local::Exception(texts.T_GaMa_No_observations_available);
 
     try
     {
@@ -375,10 +547,14 @@ int main(int argc, char* argv[]) try
          */
 
         GNU_gama::local::Acord2 acord2(IS->PD, IS->OD);
-        acord2.execute();
+        {
+            GNU_gama::Profile::Scope phase("acord2");
+            acord2.execute();
+        }
 
         if(IS->correction_to_ellipsoid())
         {
+            GNU_gama::Profile::Scope phase("reduce_to_ellipsoid");
             GNU_gama::gama_ellipsoid elnum = GNU_gama::ellipsoid(IS->ellipsoid().c_str());
             GNU_gama::Ellipsoid el{};
             GNU_gama::set(&el, elnum);
@@ -388,7 +564,7 @@ int main(int argc, char* argv[]) try
         }
 
         stats.execute();
-        GNU_gama::local::ApproximateCoordinates(&stats, cout);
+        GNU_gama::local::ApproximateCoordinates(&stats, cout, texts);
     }
     catch(GNU_gama::local::Exception& e)
     {
@@ -398,7 +574,7 @@ int main(int argc, char* argv[]) try
             return xmlerr.write_xml("gamaLocalException");
         }
 
-        std::cerr << e.what() << std::endl;
+        err << e.what() << std::endl;
         return 1;
     }
     catch(...)
@@ -411,14 +587,14 @@ int main(int argc, char* argv[]) try
             return xmlerr.write_xml("gamaLocalApproximateCoordinates");
         }
 
-        std::cerr << "Gama / Acord: approximate coordinates failed\n\n";
+        err << "Gama / Acord: approximate coordinates failed\n\n";
         return 1;
     }
 
 
     if(IS->sum_points() == 0 || IS->sum_unknowns() == 0)
     {
-        throw GNU_gama::local::Exception(GNU_gama::local::T_GaMa_No_network_points_defined);
+        throw GNU_gama::local::Exception(texts.T_GaMa_No_network_points_defined);
     }
 
     // else ... do not use else after throw
@@ -427,19 +603,19 @@ int main(int argc, char* argv[]) try
         {
             OutlyingAbsoluteTerms(IS, cout);
             IS->remove_huge_abs_terms();
-            cout << GNU_gama::local::T_GaMa_Observatios_with_outlying_absolute_terms_removed
+            cout << texts.T_GaMa_Observatios_with_outlying_absolute_terms_removed
                  << "\n\n\n";
         }
 
         if(!IS->connected_network())
-            cout << GNU_gama::local::T_GaMa_network_not_connected << "\n\n\n";
+            cout << texts.T_GaMa_network_not_connected << "\n\n\n";
 
         bool network_can_be_adjusted;
         {
             std::ostringstream tmp_out;
             if(!(network_can_be_adjusted = GeneralParameters(IS, tmp_out)))
             {
-                GNU_gama::local::NetworkDescription(IS->description, cout);
+                GNU_gama::local::NetworkDescription(IS->description, cout, texts);
                 cout << tmp_out.str();
             }
         }
@@ -455,27 +631,41 @@ int main(int argc, char* argv[]) try
 
             if(IS->linearization_iterations() > 0)
             {
-                cout << GNU_gama::local::T_GaMa_Approximate_coordinates_replaced << "\n"
+                cout << texts.T_GaMa_Approximate_coordinates_replaced << "\n"
                      << GNU_gama::local::underline(
-                            GNU_gama::local::T_GaMa_Approximate_coordinates_replaced, '*')
+                            texts.T_GaMa_Approximate_coordinates_replaced, '*')
                      << "\n\n"
-                     << GNU_gama::local::T_GaMa_Number_of_linearization_iterations
+                     << texts.T_GaMa_Number_of_linearization_iterations
                      << IS->linearization_iterations() << "\n\n";
             }
 
             if(!TestLinearization(IS, cout)) cout << "\n";
 
-            GNU_gama::local::NetworkDescription(IS->description, cout);
-            GNU_gama::local::GeneralParameters(IS, cout);
-            GNU_gama::local::FixedPoints(IS, cout);
-            GNU_gama::local::AdjustedUnknowns(IS, cout);
-            GNU_gama::local::ErrorEllipses(IS, cout);
-            GNU_gama::local::AdjustedObservations(IS, cout);
-            GNU_gama::local::ResidualsObservations(IS, cout);
+            {
+                GNU_gama::Profile::Scope phase("text_output");
+                GNU_gama::local::NetworkDescription(IS->description, cout, texts);
+                GNU_gama::local::GeneralParameters(IS, cout);
+                GNU_gama::local::FixedPoints(IS, cout);
+                GNU_gama::local::AdjustedUnknowns(IS, cout);
+                GNU_gama::local::ErrorEllipses(IS, cout);
+                GNU_gama::local::AdjustedObservations(IS, cout);
+                GNU_gama::local::ResidualsObservations(IS, cout);
+            }
+
+            if(option_variables.count("ordering"))
+            {
+                using GNU_gama::SparseOrdering;
+                err << "ordering "
+                    << (argv_ordering == SparseOrdering::amd ? "amd" :
+                        argv_ordering == SparseOrdering::nd  ? "nd"  : "rcm")
+                    << " : factor elements " << IS->factor_nonzeroes()
+                    << ", operations " << IS->factor_flops() << "\n";
+            }
         }
 
         if(option_variables.count("svg"))
         {
+            GNU_gama::Profile::Scope phase("svg_output");
             GNU_gama::local::GamaLocalSVG svg(IS);
             auto argv_svgout = option_variables["svg"].as<std::string>();
             std::ofstream file(argv_svgout);
@@ -484,6 +674,7 @@ int main(int argc, char* argv[]) try
 
         if(option_variables.count("obs"))
         {
+            GNU_gama::Profile::Scope phase("obs_output");
             auto argv_obsout = option_variables["obs"].as<std::string>();
             std::ofstream opr(argv_obsout);
             IS->project_equations(opr);
@@ -491,6 +682,7 @@ int main(int argc, char* argv[]) try
 
         if(option_variables.count("html"))
         {
+            GNU_gama::Profile::Scope phase("html_output");
             GNU_gama::local::GamaLocalHTML html(IS);
             html.exec();
 
@@ -501,6 +693,7 @@ int main(int argc, char* argv[]) try
 
         if(option_variables.count("xml"))
         {
+            GNU_gama::Profile::Scope phase("xml_output");
             auto argv_xmlout = option_variables["xml"].as<std::string>();
             xmlerr.setXmlOutput(argv_xmlout);
 
@@ -508,6 +701,7 @@ int main(int argc, char* argv[]) try
             IS->set_gons();
 
             GNU_gama::LocalNetworkXML xml(IS);
+            if(profiling) xml.set_profile(&profile);
 
             std::ofstream file(argv_xmlout);
             xml.write(file);
@@ -515,6 +709,7 @@ int main(int argc, char* argv[]) try
 
         if(option_variables.count("octave"))
         {
+            GNU_gama::Profile::Scope phase("octave_output");
 
             auto argv_octaveout = option_variables["octave"].as<std::string>();
             // TODO: why do we override the choice from the user?
@@ -528,79 +723,276 @@ int main(int argc, char* argv[]) try
 
         if(network_can_be_adjusted && option_variables.count("updated-xml"))
         {
+            GNU_gama::Profile::Scope phase("updated_xml_output");
             auto argv_updated_xml = option_variables["updated-xml"].as<std::string>();
             std::string xml = IS->updated_xml();
             std::ofstream file(argv_updated_xml);
             file << xml;
         }
+
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+        if(network_can_be_adjusted && option_variables.count("sqlitedb")
+           && option_variables.count("configuration"))
+        {
+            GNU_gama::Profile::Scope phase("sqlite_output");
+            auto argv_sqlitedb = option_variables["sqlitedb"].as<std::string>();
+            GNU_gama::local::sqlite_db::SqliteWriter writer(argv_sqlitedb);
+            writer.write(IS, option_variables["configuration"].as<std::string>());
+        }
+#endif
+    }
+
+    if(profiling)
+    {
+        if(option_variables["profile"].as<std::string>() == "json")
+            profile.write_json(err);
+        else
+            profile.write_text(err);
     }
 
-    delete IS;
     return 0;
 }
-#ifdef GNU_GAMA_LOCAL_SQLITE_READER
-catch(const GNU_gama::Exception::sqlitexc& gamalite)
+
+int adjust(const Settings& s, std::ostream& out, std::ostream& err)
 {
-    if(xmlerr.isValid())
+    GNU_gama::local::XMLerror xmlerr;
+    const GNU_gama::local::Texts& texts = GNU_gama::local::gama_texts(s.lang);
+
+    try
     {
-        xmlerr.setDescription(gamalite.what());
-        return xmlerr.write_xml("gamaLocalSqlite");
+        return run(s, out, err, xmlerr);
     }
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+    catch(const GNU_gama::Exception::sqlitexc& gamalite)
+    {
+        if(xmlerr.isValid())
+        {
+            xmlerr.setDescription(gamalite.what());
+            return xmlerr.write_xml("gamaLocalSqlite");
+        }
 
-    std::cout << "\n"
-              << "****** " << gamalite.what() << "\n\n";
-    return 1;
-}
+        out << "\n"
+            << "****** " << gamalite.what() << "\n\n";
+        return 1;
+    }
 #endif
-catch(const GNU_gama::Exception::adjustment& choldec)
-{
-    if(xmlerr.isValid())
+    catch(const GNU_gama::Exception::adjustment& choldec)
     {
-        xmlerr.setDescription(GNU_gama::local::T_GaMa_solution_ended_with_error);
-        xmlerr.setDescription(choldec.str);
-        return xmlerr.write_xml("gamaLocalAdjustment");
+        if(xmlerr.isValid())
+        {
+            xmlerr.setDescription(texts.T_GaMa_solution_ended_with_error);
+            xmlerr.setDescription(choldec.str);
+            return xmlerr.write_xml("gamaLocalAdjustment");
+        }
+
+        out << "\n"
+            << texts.T_GaMa_solution_ended_with_error << "\n\n"
+            << "****** " << choldec.str << "\n\n";
+        return 1;
     }
+    catch(const GNU_gama::local::Exception& V)
+    {
+        if(xmlerr.isValid())
+        {
+            xmlerr.setDescription(texts.T_GaMa_solution_ended_with_error);
+            xmlerr.setDescription(V.what());
+            return xmlerr.write_xml("gamaLocalException");
+        }
 
-    std::cout << "\n"
-              << GNU_gama::local::T_GaMa_solution_ended_with_error << "\n\n"
-              << "****** " << choldec.str << "\n\n";
-    return 1;
-}
-catch(const GNU_gama::local::Exception& V)
-{
-    if(xmlerr.isValid())
+        out << "\n"
+            << texts.T_GaMa_solution_ended_with_error << "\n\n"
+            << "****** " << V.what() << "\n\n";
+        return 1;
+    }
+    catch(std::exception& stde)
     {
-        xmlerr.setDescription(GNU_gama::local::T_GaMa_solution_ended_with_error);
-        xmlerr.setDescription(V.what());
-        return xmlerr.write_xml("gamaLocalException");
+        if(xmlerr.isValid())
+        {
+            xmlerr.setDescription(stde.what());
+            return xmlerr.write_xml("gamaLocalStdException");
+        }
+
+        out << "\n" << stde.what() << "\n\n";
+        return 1;
     }
+    catch(...)
+    {
 
-    std::cout << "\n"
-              << GNU_gama::local::T_GaMa_solution_ended_with_error << "\n\n"
-              << "****** " << V.what() << "\n\n";
-    return 1;
+        if(xmlerr.isValid())
+        {
+            return xmlerr.write_xml("gamaLocalUnknownException");
+        }
+
+        out << "\n" << texts.T_GaMa_internal_program_error << "\n\n";
+        return 1;
+    }
 }
-catch(std::exception& stde)
+
+/* Batch mode, jobs are command lines of gama-local given by lines of
+ * a manifest file or generated for .gkf files of a directory. Jobs are
+ * adjusted concurrently on a pool of threads, each job with its own
+ * settings and output streams. Messages of failed jobs are written to
+ * standard error output, timings of jobs and summary to standard output.
+ */
+int batch(const Settings& s, const std::vector<std::string>& common)
 {
-    if(xmlerr.isValid())
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    const auto& option_variables = s.option_variables;
+    const auto source = option_variables["batch"].as<std::string>();
+
+    int threads = 0;
+    if(option_variables.count("batch-threads"))
+        threads = option_variables["batch-threads"].as<int>();
+    if(threads <= 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads <= 0)
+        threads = 1;
+
+    // --threads of a job is limited by cores available to each job
+    int hardware = std::thread::hardware_concurrency();
+    const int job_threads = std::max(1, hardware / threads);
+
+    std::vector<std::vector<std::string>> jobs;
+    if(fs::is_directory(source))
     {
-        xmlerr.setDescription(stde.what());
-        return xmlerr.write_xml("gamaLocalStdException");
+        fs::path output = ".";
+        if(option_variables.count("batch-output"))
+            output = option_variables["batch-output"].as<std::string>();
+
+        std::vector<fs::path> files;
+        for(const auto& entry : fs::directory_iterator(source))
+            if(entry.is_regular_file() && entry.path().extension() == ".gkf")
+                files.push_back(entry.path());
+        std::sort(files.begin(), files.end());
+
+        for(const auto& file : files)
+        {
+            const auto result = (output / file.stem()).string();
+            jobs.push_back({file.string(), "--text", result + ".txt", "--xml", result + ".xml"});
+        }
     }
+    else
+    {
+        std::ifstream manifest(source);
+        if(!manifest)
+            throw GNU_gama::local::Exception("cannot open batch manifest " + source);
 
-    std::cout << "\n" << stde.what() << "\n\n";
-}
-catch(...)
-{
+        std::string line;
+        for(int number = 1; std::getline(manifest, line); number++)
+        {
+            auto args = boost_options::split_unix(line);
+            if(args.empty() || (!args.front().empty() && args.front().front() == '#'))
+                continue;
+
+            // process-wide options cannot be given for a single job
+            Settings job;
+            parse(job, options(job), args);
+            for(const char* option : {"profile", "allocator", "batch", "batch-threads",
+                                      "batch-output"})
+                if(job.option_variables.count(option))
+                    throw GNU_gama::local::Exception(
+                        source + ":" + std::to_string(number) + " : option --"
+                        + option + " is not allowed in batch jobs");
+
+            jobs.push_back(args);
+        }
+    }
+
+    struct Result
+    {
+        int status {0};
+        double seconds {0};
+        std::string label;
+        std::string messages;
+    };
+    std::vector<Result> results(jobs.size());
+
+    const auto start = Clock::now();
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for(std::size_t j; (j = next++) < jobs.size();)
+        {
+            const auto job_start = Clock::now();
+            Result& result = results[j];
+            for(const auto& arg : jobs[j])
+                result.label += (result.label.empty() ? "" : " ") + arg;
+
+            std::ostringstream messages;
+            try
+            {
+                auto args = jobs[j];
+                args.insert(args.end(), common.begin(), common.end());
+
+                Settings job;
+                parse(job, options(job), args);
+                if(job.threads == 0 || job.threads > job_threads)
+                    job.threads = job_threads;
+
+                const auto& variables = job.option_variables;
+                if(!variables.count("input-file") && !variables.count("sqlitedb"))
+                    throw GNU_gama::local::Exception("missing input file");
+                if(variables.count("configuration") && variables.count("readonly-configuration"))
+                    throw GNU_gama::local::Exception(
+                        "options --configuration and --readonly-configuration are exclusive");
+
+                result.status = adjust(job, messages, messages);
+            }
+            catch(const std::exception& e)
+            {
+                messages << e.what() << "\n";
+                result.status = 1;
+            }
+            result.messages = messages.str();
+            result.seconds =
+                std::chrono::duration<double>(Clock::now() - job_start).count();
+        }
+    };
 
-    if(xmlerr.isValid())
+    // jobs are taken from the shared counter, if a thread cannot be
+    // created the jobs are adjusted by the threads already started
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    try
     {
-        return xmlerr.write_xml("gamaLocalUnknownException");
+        for(int t = 1; t < threads; t++)
+            pool.emplace_back(worker);
     }
+    catch(const std::system_error&)
+    {
+    }
+    worker();
+    for(auto& thread : pool)
+        thread.join();
 
-    std::cout << "\n" << GNU_gama::local::T_GaMa_internal_program_error << "\n\n";
-    return 1;
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int failed = 0;
+    double sum = 0;
+    std::cout.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    for(std::size_t j = 0; j < results.size(); j++)
+    {
+        const Result& result = results[j];
+        if(result.status)
+        {
+            failed++;
+            std::cerr << "job " << j + 1 << " : " << result.label << "\n"
+                      << result.messages << "\n";
+        }
+        sum += result.seconds;
+        std::cout << std::setw(6) << j + 1 << (result.status ? "  failed " : "  ok     ")
+                  << std::setprecision(3) << std::setw(10) << result.seconds << " s  "
+                  << result.label << "\n";
+    }
+
+    std::cout << "\njobs " << results.size() << ", failed " << failed << ", threads "
+              << threads << ", time " << std::setprecision(3) << seconds
+              << " s (sum of jobs " << sum << " s)\n";
+
+    return failed ? 1 : 0;
 }
+}  // namespace
 
 std::istream& GNU_gama::local::
     operator>>(std::istream& in, GNU_gama::local::LocalNetwork::Algorithm& algorithm)
@@ -616,6 +1008,8 @@ std::istream& GNU_gama::local::
         algorithm = GNU_gama::local::LocalNetwork::Algorithm::cholesky;
     else if(token == "envelope")
         algorithm = GNU_gama::local::LocalNetwork::Algorithm::envelope;
+    else if(token == "supernodal")
+        algorithm = GNU_gama::local::LocalNetwork::Algorithm::supernodal;
     else
         in.setstate(std::ios_base::failbit);
 
@@ -679,6 +1073,38 @@ std::istream& GNU_gama::operator>>(std::istream& in, GNU_gama::OutStream::Encodi
     return in;
 }
 
+std::istream& GNU_gama::operator>>(std::istream& in, GNU_gama::SparseOrdering& ordering)
+{
+    std::string token;
+    in >> token;
+
+    if(token == "rcm")
+        ordering = GNU_gama::SparseOrdering::rcm;
+    else if(token == "amd")
+        ordering = GNU_gama::SparseOrdering::amd;
+    else if(token == "nd")
+        ordering = GNU_gama::SparseOrdering::nd;
+    else
+        in.setstate(std::ios_base::failbit);
+
+    return in;
+}
+
+std::istream& GNU_gama::operator>>(std::istream& in, GNU_gama::SVDMethod& method)
+{
+    std::string token;
+    in >> token;
+
+    if(token == "golub-reinsch")
+        method = GNU_gama::SVDMethod::golub_reinsch;
+    else if(token == "jacobi")
+        method = GNU_gama::SVDMethod::jacobi;
+    else
+        in.setstate(std::ios_base::failbit);
+
+    return in;
+}
+
 std::istream& operator>>(std::istream& in, Angle& angles)
 {
     std::string token;
@@ -8,10 +8,12 @@ set(header_files
     "include/Math/Business/Adjustment/adj_envelope.h"
     "include/Math/Business/Adjustment/adj_gso.h"
     "include/Math/Business/Adjustment/adj_input_data.h"
+    "include/Math/Business/Adjustment/adj_supernodal.h"
     "include/Math/Business/Adjustment/adj_svd.h"
     "include/Math/Business/Adjustment/AdjustmentException.h"
     "include/Math/Business/Adjustment/envelope.h"
     "include/Math/Business/Adjustment/homogenization.h"
+    "include/Math/Business/Adjustment/supernodal.h"
    )
 
 # Source Files files
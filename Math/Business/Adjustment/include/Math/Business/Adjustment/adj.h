@@ -19,6 +19,7 @@
 */
 
 #include <Math/Service/covmat.h>
+#include <Math/Service/smatrix_ordering.h>
 #include "adj_input_data.h"
 
 #include <iostream>
@@ -48,7 +49,11 @@ namespace GNU_gama {
         envelope,
         gso,       /*!< Gram-Schmidt ortogonalization of design matrix */
         svd,       /*!< Singular Value decomposition of project matrix */
-        cholesky   /*!< Cholesky decomposition of normal equations     */
+        cholesky,  /*!< Cholesky decomposition of normal equations     */
+        /** Supernodal sparse LDL' decomposition of normal equations with
+            fill-in limited by elimination tree.
+         */
+        supernodal
       };
 
     Adj ()
@@ -73,6 +78,15 @@ namespace GNU_gama {
     /** returns current numerical algorithm */
     Adj::algorithm get_algorithm() const { return algorithm_; }
 
+    /** ordering of unknowns for sparse algorithms */
+    void set_ordering(SparseOrdering);
+    /** predicted number of elements of sparse factor (0 for dense) */
+    double factor_nonzeroes() const;
+    /** predicted number of operations of sparse decomposition */
+    double factor_flops() const;
+    /** number of threads used in sparse decomposition (0 for all cores) */
+    void set_threads(int n) { threads_ = n; }
+
     int    defect() const { return least_squares->defect(); }
     double rtr   () const { return rtr_; }     /*!< weighted sum of squares */
     const Vec<>& x();                          /*!< adjusted parameters     */
@@ -100,9 +114,13 @@ namespace GNU_gama {
 
     const AdjInputData* data {nullptr};
     AdjBase* least_squares {nullptr};
+    algorithm least_squares_algorithm_ {envelope};
 
     bool      solved {false};
     algorithm algorithm_ {envelope};
+    SparseOrdering ordering_ {SparseOrdering::rcm};
+    bool      has_ordering_ {false};
+    int       threads_ {1};
     int       n_obs_{0}, n_par_{0};
     double    rtr_ {0};
     int       minx_dim {0};
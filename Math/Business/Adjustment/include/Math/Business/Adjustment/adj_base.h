@@ -62,6 +62,26 @@ namespace GNU_gama {
 
     virtual Float q0_xx(Index i, Index j)  { return q_xx(i,j); }
 
+    // diagonal of weight coefficients of adjusted observations, i.e.
+    // q_bb(i,i) for all observations computed in a single call
+
+    virtual void q_bb_diagonal(Vec<Float,Index,Exception::matvec>& qbb)
+    {
+      const Index M = residuals().dim();
+      qbb.reset(M);
+      for (Index i=1; i<=M; i++) qbb(i) = q_bb(i,i);
+    }
+
+    // weight coefficients q[k] = q_xx(i[k],j[k]), k = 0,...,n-1, for a
+    // set of index pairs (covariance blocks of points, bands) computed
+    // in a single call
+
+    virtual void q_xx_selected(Index n, const Index i[], const Index j[],
+                               Float q[])
+    {
+      for (Index k=0; k<n; k++) q[k] = q_xx(i[k], j[k]);
+    }
+
   };
 
 }
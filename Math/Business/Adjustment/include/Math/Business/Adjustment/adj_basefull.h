@@ -75,6 +75,10 @@ namespace GNU_gama {
     // solve() must compute vectors x, r  and set is_solved=true
     virtual void solve() = 0;
 
+    /** number of threads used in dense matrix kernels (0 for all cores) */
+    void  set_threads(Index n) { threads_ = n; }
+    Index threads() const { return threads_; }
+
 
   protected:
 
@@ -84,6 +88,7 @@ namespace GNU_gama {
     Vec<Float, Index, Exc> x;
     Vec<Float, Index, Exc> r;
     bool is_solved {false};
+    Index threads_ {1};
 
   };
 
@@ -23,6 +23,10 @@
 #define GNU_Gama_gnu_gama_gnugama_GaMa_AdjBaseSparse_h
 
 #include "adj_base.h"
+#include <Math/Service/smatrix.h>
+#include <Math/Service/smatrix_ordering.h>
+#include <vector>
+#include <algorithm>
 
 namespace GNU_gama {
 
@@ -52,11 +56,75 @@ namespace GNU_gama {
       stage = 0;
     }
 
+    /** ordering of unknowns used in the next solution */
+    void set_ordering(SparseOrdering ord) { ordering_type = ord; stage = 0; }
+    SparseOrdering ordering() const { return ordering_type; }
+
+    /** predicted number of elements of the factor for current ordering */
+    double factor_nonzeroes() const { return factor_nonzeroes_; }
+    /** predicted number of operations of the decomposition */
+    double factor_flops()     const { return factor_flops_; }
+
+    /** number of threads used in homogenization and decomposition
+     *  (0 for all cores) */
+    void  set_threads(Index n) { threads_ = n; }
+    Index threads() const { return threads_; }
+
   protected:
 
     const AdjInputData* input {nullptr};
     int                 stage {0};
 
+    SparseOrdering ordering_type {SparseOrdering::rcm};
+    double         factor_nonzeroes_ {0};
+    double         factor_flops_     {0};
+    Index          threads_          {1};
+
+    /** Returns true if the sparsity pattern of the matrix and the
+     *  ordering type are the same as in the previous call, i.e. the
+     *  symbolic factorization (graph, ordering, structure of the
+     *  factor) can be reused and only the numerical phase is needed.
+     *  The pattern is stored otherwise. */
+    bool same_pattern(const SparseMatrix<Float, Index>* mat)
+    {
+      const Index rows = mat->rows();
+      bool same = has_pattern_ && pattern_ordering_ == ordering_type
+        && pattern_columns_ == mat->columns()
+        && Index(pattern_rptr_.size()) == rows + 1
+        && Index(pattern_cind_.size()) == mat->nonzeroes();
+
+      for (Index r=1; same && r<=rows; r++)
+        {
+          const Index* b = mat->ibegin(r);
+          const Index* e = mat->iend(r);
+          const Index  p = pattern_rptr_[r-1];
+          same = pattern_rptr_[r] - p == Index(e - b)
+            && std::equal(b, e, pattern_cind_.begin() + p);
+        }
+      if (same) return true;
+
+      pattern_rptr_.assign(1, 0);
+      pattern_cind_.clear();
+      for (Index r=1; r<=rows; r++)
+        {
+          pattern_cind_.insert(pattern_cind_.end(),
+                               mat->ibegin(r), mat->iend(r));
+          pattern_rptr_.push_back(Index(pattern_cind_.size()));
+        }
+      pattern_columns_  = mat->columns();
+      pattern_ordering_ = ordering_type;
+      has_pattern_      = true;
+
+      return false;
+    }
+
+  private:
+
+    bool               has_pattern_ {false};
+    SparseOrdering     pattern_ordering_ {SparseOrdering::rcm};
+    Index              pattern_columns_ {0};
+    std::vector<Index> pattern_rptr_;
+    std::vector<Index> pattern_cind_;
   };
 
 
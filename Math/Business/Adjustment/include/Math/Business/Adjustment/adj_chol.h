@@ -304,26 +304,9 @@ namespace GNU_gama {
 
     mat.reset(N);
     rhs.reset(N);
-    for (Index i=1; i<=N; i++)
-      {
-        Float s = 0;
-        for (Index k=1; k<=M; k++)
-          {
-            s += A(k,i)*b(k);
-          }
-        rhs(i) = s;
-
-        for (Index j=i; j<=N; j++)
-          {
-            Float s = 0;
-            for (Index k=1; k<=M; k++)
-              {
-                s += A(k,i)*A(k,j);
-              }
-            mat(i,j) = s;
-
-          }
-      }
+    Kernels::syrk_tn(N, M, A.begin(), N, mat.begin(), int(this->threads_));
+    Kernels::gemm_tn(N, Index(1), M, A.begin(), N, b.begin(), Index(1),
+                     rhs.begin(), Index(1), int(this->threads_));
 
 
     if (s_tol <= Float())
@@ -27,7 +27,11 @@
 #include <Math/Service/smatrix_ordering.h>
 #include "homogenization.h"
 #include <Utilities/Service/movetofront.h>
+#include <Utilities/Service/profile.h>
 #include <vector>
+#include <memory>
+#include <map>
+#include <algorithm>
 
 namespace GNU_gama {
 
@@ -58,6 +62,10 @@ namespace GNU_gama {
 
     Float q0_xx(Index i, Index j) override;
 
+    void q_bb_diagonal(GNU_gama::Vec<Float, Index, Exc>& qbb) override;
+    void q_xx_selected(Index n, const Index i[], const Index j[],
+                       Float q[]) override;
+
     bool lindep(Index i) override;
     void min_x() override;
     void min_x(Index n, Index m[]) override;
@@ -68,7 +76,7 @@ namespace GNU_gama {
 
   private:
 
-    ReverseCuthillMcKee<Index>   ordering;
+    std::unique_ptr<SparseMatrixOrdering<Index>> ordering;
     Homogenization<Float, Index>      hom;
     Envelope<Float, Index>       envelope;
 
@@ -83,6 +91,7 @@ namespace GNU_gama {
 
     GNU_gama::Vec<Float, Index, Exc> tmpvec;
     GNU_gama::Vec<Float, Index, Exc> tmpres;         // used in q_bb
+    GNU_gama::Vec<Float, Index, Exc> qbbdiag;        // diagonal of q_bb
 
     std::vector<GNU_gama::Vec<Float, Index, Exc>> qxxbuf;
     GNU_gama::MoveToFront<3,Index,Index>          indbuf;
@@ -95,20 +104,25 @@ namespace GNU_gama {
     };
 
     bool init_q_bb{};         // weight coefficieants of adjusted observations
+    bool init_qbbdiag{};      // diagonal of q_bb
     bool init_residuals{};    // residuals r = Ax - b
     bool init_q0{};           // weight coefficients of particular solution x0
     bool init_x{};            // unique or regularized solution
+    bool init_qxx{};          // regularization terms of q_xx
 
     void set_stage(Stage s);
     void solve_ordering();
     void solve_x0();
     void solve_x();
     void solve_q0();
-    void T_row(GNU_gama::Vec<Float, Index, Exc>& row, Index i);
+    void solve_qxx();
 
     Index nullity;
     Mat<Float, Index, Exc> G;
+    Mat<Float, Index, Exc> W;     // Q0*H
+    Mat<Float, Index, Exc> P;     // G*H'*Q0*H - Q0*H
     Float dot(Index i, Index j) const;
+    Float q_reg(Index i, Index j) const;
 
     Index* min_x_list;
     Index  min_x_size;
@@ -144,8 +158,10 @@ namespace GNU_gama {
         init_residuals = true;
         init_q0        = true;
         init_x         = true;
+        init_qxx       = true;
       case stage_q0:
         init_q_bb      = true;
+        init_qbbdiag   = true;
         ;
       }
 
@@ -159,13 +175,33 @@ namespace GNU_gama {
     if (this->stage >= stage_ordering) return;
 
     hom.reset(this->input);
+    hom.set_threads(this->threads_);
     design_matrix = hom.mat();
 
-    SparseMatrixGraph <Float, Index> graph(design_matrix);
-    ordering.reset(&graph);
-    // std::cerr << "renumbering is suppressed!\n";
-    // for (int i=1; i<=design_matrix->columns(); i++)
-    //   ordering.perm(i) = ordering.invp(i) = i;
+    // symbolic phase is reused if the sparsity pattern has not changed
+    // (typically in linearization iterations)
+
+    if (this->same_pattern(design_matrix))
+      {
+        envelope.assemble(design_matrix, ordering.get());
+      }
+    else
+      {
+        Profile::Scope profile("ordering");
+
+        SparseMatrixGraph <Float, Index> graph(design_matrix);
+        ordering = make_ordering<Index>(this->ordering_type);
+        ordering->reset(&graph);
+        // std::cerr << "renumbering is suppressed!\n";
+        // for (int i=1; i<=design_matrix->columns(); i++)
+        //   ordering->perm(i) = ordering->invp(i) = i;
+
+        FactorStatistics<Index> fill(&graph, ordering.get());
+        this->factor_nonzeroes_ = fill.envelope_nonzeroes();
+        this->factor_flops_     = fill.envelope_flops();
+
+        envelope.set(design_matrix, &graph, ordering.get());
+      }
 
     const Vec<Float>& rhs = hom.rhs();
     const Index N = design_matrix->columns();
@@ -180,7 +216,7 @@ namespace GNU_gama {
 
         while (b != e)
           {
-            const Index c = ordering.invp(*n++);
+            const Index c = ordering->invp(*n++);
             const Float a = *b++;
 
             // absolute terms in normal equations
@@ -188,8 +224,6 @@ namespace GNU_gama {
           }
       }
 
-    envelope.set(design_matrix, &graph, &ordering);
-
     set_stage(stage_ordering);
   }
 
@@ -202,6 +236,7 @@ namespace GNU_gama {
 
     // Cholesky decomposition L*D*L'
 
+    envelope.set_threads(this->threads_);
     envelope.cholDec();
 
     // particular solution x0
@@ -211,7 +246,7 @@ namespace GNU_gama {
     x0.reset(tmpvec.dim());
     for (Index i=1; i<=tmpvec.dim(); i++)
       {
-        x0(ordering.perm(i)) = tmpvec(i);
+        x0(ordering->perm(i)) = tmpvec(i);
       }
     tmpvec.reset();
 
@@ -237,13 +272,6 @@ namespace GNU_gama {
 
     nullity = envelope.defect();
 
-    if (nullity)
-      {
-        qxxbuf.resize(indbuf.size());
-        for (Index i=0; i<size_to<Index>(qxxbuf.size()); i++)
-          qxxbuf[i].reset(parameters);
-      }
-
     set_stage(stage_x0);
   }
 
@@ -310,29 +338,29 @@ namespace GNU_gama {
   }
 
 
-  // T = I - alpha*inv(alpha'*alpha)*alpha'
+  /*
+    Singular system: the regularized weight coefficients are
+
+      Q = T*Q0*T',  T = I - G*H',
+
+    where Q0 = inv(L') pinv(D) inv(L) are the weight coefficients of
+    the particular solution x0 and H are the columns of G restricted
+    to the rows of the regularized parameters. Then
+
+      Q = Q0 + (G*K - W)*G' - G*W',  W = Q0*H,  K = H'*W
+
+    and the regularization terms need only the nullity columns of W
+    and P = G*K - W, computed once (indexes are permuted).
+  */
 
   template <typename Float, typename Index, typename Exc>
-  void AdjEnvelope<Float, Index, Exc>
-    ::T_row(GNU_gama::Vec<Float, Index, Exc>& row, Index ii)
+  Float AdjEnvelope<Float, Index, Exc>::q_reg(Index i, Index j) const
   {
-    Float t;
-    const Index i = ordering.invp(ii);
-    for (Index jj=1; jj<=parameters; jj++)
-      {
-        const Index j = ordering.invp(jj);
-        t = Float();
-        if (i == j) t = Float(1);
-
-        for (Index k=0; k<min_x_size; k++)
-          if (min_x_list[k] == jj)
-            {
-              for (Index c=1; c<=nullity; c++) t -= G(i,c)*G(j,c);
-              break;
-            }
+    Float s = Float();
+    for (Index c=1; c<=nullity; c++)
+      s += P(i,c)*G(j,c) - G(i,c)*W(j,c);
 
-        row(j) = t;
-      }
+    return s;
   }
 
 
@@ -346,29 +374,9 @@ namespace GNU_gama {
     // singular system
 
     if (init_x) solve_x();
+    if (init_qxx) solve_qxx();
 
-    std::pair<Index,bool> pa = indbuf.get(i);
-    std::pair<Index,bool> pb = indbuf.get(j);
-
-    Vec<Float, Index, Exc>& a = qxxbuf[pa.first];
-    Vec<Float, Index, Exc>& b = qxxbuf[pb.first];
-    if (!pa.second)
-      {
-        T_row(a, i);
-        envelope.lowerSolve(1, parameters, a.begin());
-      }
-    if (!pb.second)
-      {
-        T_row(b, j);
-        envelope.lowerSolve(1, parameters, b.begin());
-      }
-
-    Float s = Float();
-    for (Index i=1; i<=parameters; i++)
-      if (const Float d = envelope.diagonal(i))
-        s += a(i)/d*b(i);
-
-    return s;
+    return q0_xx(i, j) + q_reg(ordering->invp(i), ordering->invp(j));
   }
 
 
@@ -377,7 +385,7 @@ namespace GNU_gama {
   {
     if (this->stage < stage_q0) solve_q0();
 
-    Float* q = q0.element(ordering.invp(i), ordering.invp(j));
+    Float* q = q0.element(ordering->invp(i), ordering->invp(j));
     if (q) return *q;
 
     // elements outside the envelope (full solution)
@@ -389,8 +397,8 @@ namespace GNU_gama {
           qxxbuf[i].reset(parameters);
       }
 
-    Index ii = ordering.invp(i);
-    Index jj = ordering.invp(j);
+    Index ii = ordering->invp(i);
+    Index jj = ordering->invp(j);
     if (ii < jj) std::swap(ii, jj);
 
     std::pair<Index,bool> pa = indbuf.get(ii);
@@ -407,6 +415,90 @@ namespace GNU_gama {
   }
 
 
+  template <typename Float, typename Index, typename Exc>
+  void AdjEnvelope<Float, Index, Exc>
+    ::q_xx_selected(Index n, const Index i[], const Index j[], Float q[])
+  {
+    if (this->stage < stage_q0) solve_q0();
+
+    if (nullity)
+      {
+        if (init_x) solve_x();
+        if (init_qxx) solve_qxx();
+      }
+
+    /*
+      Elements within the envelope are taken from the selected inverse
+      q0. For the remaining pairs a single column of inv(N) is computed
+      for each distinct permuted index, the forward substitution starts
+      from the unit element. Pairs are grouped by their more frequent
+      index, a row of a covariance band thus needs only one solution.
+    */
+
+    std::vector<Index> outside;
+    for (Index k=0; k<n; k++)
+      {
+        const Index ii = ordering->invp(i[k]);
+        const Index jj = ordering->invp(j[k]);
+        if (const Float* p = q0.element(ii, jj))
+          q[k] = *p;
+        else
+          outside.push_back(k);
+      }
+
+    if (!outside.empty())
+      {
+        std::map<Index, Index> count;
+        for (Index k : outside)
+          {
+            count[ordering->invp(i[k])]++;
+            count[ordering->invp(j[k])]++;
+          }
+
+        auto column = [this, i, j, &count](Index k)
+          {
+            const Index ii = ordering->invp(i[k]);
+            const Index jj = ordering->invp(j[k]);
+            const Index ci = count[ii];
+            const Index cj = count[jj];
+            if (ci != cj) return ci > cj ? ii : jj;
+            return std::max(ii, jj);
+          };
+
+        std::vector<Index> col(n);
+        for (Index k : outside) col[k] = column(k);
+
+        std::stable_sort(outside.begin(), outside.end(),
+                         [&col](Index a, Index b)
+                         {
+                           return col[a] < col[b];
+                         });
+
+        Vec<Float, Index, Exc> a(parameters);
+        Index c = 0;
+        for (Index k : outside)
+          {
+            if (col[k] != c)
+              {
+                c = col[k];
+                a.set_zero();
+                a(c) = Float(1);
+                envelope.lowerSolve   (c, parameters, a.begin() + (c-1));
+                envelope.diagonalSolve(c, parameters, a.begin() + (c-1));
+                envelope.upperSolve   (1, parameters, a.begin());
+              }
+
+            const Index ii = ordering->invp(i[k]);
+            q[k] = a(ii == c ? ordering->invp(j[k]) : ii);
+          }
+      }
+
+    if (nullity)
+      for (Index k=0; k<n; k++)
+        q[k] += q_reg(ordering->invp(i[k]), ordering->invp(j[k]));
+  }
+
+
   template <typename Float, typename Index, typename Exc>
   Float AdjEnvelope<Float, Index, Exc>::q_bb(Index i, Index j)
   {
@@ -424,14 +516,14 @@ namespace GNU_gama {
     Float qbb = Float();
     while (b != e)
       {
-        const Index k = ordering.invp(*n++);
+        const Index k = ordering->invp(*n++);
         b2 = design_matrix->begin (j);
         e2 = design_matrix->end   (j);
         n2 = design_matrix->ibegin(j);
         Float s = Float();
         while (b2 != e2)
           {
-            qk = q0.element(k, ordering.invp(*n2++));
+            qk = q0.element(k, ordering->invp(*n2++));
             if (qk == nullptr) goto FULL_VECTOR;
             s += *qk * *b2++;
           }
@@ -454,7 +546,7 @@ namespace GNU_gama {
     n = design_matrix->ibegin(j);
     while (b != e)
       {
-        tmpres(ordering.invp(*n++)) = *b++;
+        tmpres(ordering->invp(*n++)) = *b++;
       }
 
     envelope.solve(tmpres.begin(), parameters);
@@ -465,13 +557,94 @@ namespace GNU_gama {
     Float s = Float();
     while (b != e)
       {
-        s += *b++ * tmpres(ordering.invp(*n++));
+        s += *b++ * tmpres(ordering->invp(*n++));
       }
 
     return s;
   }
 
 
+  template <typename Float, typename Index, typename Exc>
+  void AdjEnvelope<Float, Index, Exc>
+    ::q_bb_diagonal(GNU_gama::Vec<Float, Index, Exc>& qbb)
+  {
+    if (this->stage < stage_q0) solve_q0();
+
+    if (init_qbbdiag)
+      {
+        /*
+          q_bb(i,i) = a' inv(N) a = y' inv(D) y,  where L y = a
+
+          If all products of the i-th row elements are within the
+          envelope of q0 the diagonal element is computed directly,
+          otherwise only the forward substitution is needed. It starts
+          from the first nonzero of the permuted row.
+        */
+
+        const Index M = design_matrix->rows();
+        qbbdiag.reset(M);
+        tmpres.reset(parameters);
+        tmpres.set_zero();
+        init_q_bb = false;
+
+        for (Index i=1; i<=M; i++)
+          {
+            const Float* b = design_matrix->begin (i);
+            const Float* e = design_matrix->end   (i);
+            const Index* n = design_matrix->ibegin(i);
+
+            bool  inside = true;
+            Index start  = parameters;
+            Float qii    = Float();
+            for (const Float* p=b; p!=e; p++)
+              {
+                const Index k = ordering->invp(n[p-b]);
+                if (k < start) start = k;
+                if (!inside) continue;
+
+                Float s = Float();
+                for (const Float* q=b; q!=e; q++)
+                  {
+                    const Float* qk = q0.element(k, ordering->invp(n[q-b]));
+                    if (qk == nullptr)
+                      {
+                        inside = false;
+                        break;
+                      }
+                    s += *qk * *q;
+                  }
+                qii += *p * s;
+              }
+
+            if (!inside)
+              {
+                Float* y = tmpres.begin() + (start - 1);
+                for (const Float* p=b; p!=e; p++)
+                  {
+                    tmpres(ordering->invp(n[p-b])) = *p;
+                  }
+
+                envelope.lowerSolve(start, parameters, y);
+
+                qii = Float();
+                for (Index k=start; k<=parameters; k++)
+                  {
+                    if (const Float d = envelope.diagonal(k))
+                      qii += tmpres(k)*tmpres(k)/d;
+                    tmpres(k) = Float();
+                  }
+              }
+
+            qbbdiag(i) = qii;
+          }
+
+        init_qbbdiag = false;
+      }
+
+    qbb = qbbdiag;
+  }
+
+
   template <typename Float, typename Index, typename Exc>
   Float AdjEnvelope<Float, Index, Exc>::q_bx(Index, Index)
   {
@@ -496,7 +669,8 @@ namespace GNU_gama {
     delete[] min_x_list;
     min_x_list = nullptr;
 
-    init_x = true;
+    init_x   = true;
+    init_qxx = true;
   }
 
 
@@ -509,7 +683,8 @@ namespace GNU_gama {
     for (Index i=0; i<min_x_size; i++)
       min_x_list[i] = m[i];
 
-    init_x = true;
+    init_x   = true;
+    init_qxx = true;
   }
 
 
@@ -523,6 +698,8 @@ namespace GNU_gama {
   template <typename Float, typename Index, typename Exc>
   void AdjEnvelope<Float, Index, Exc>::solve_q0()
   {
+    Profile::Scope profile("solve_q0");
+
     if (init_q0)
       {
         if (this->stage < stage_x0) solve_x0();
@@ -541,7 +718,7 @@ namespace GNU_gama {
     Float s = Float();
     for (Index n=0; n<min_x_size; n++)
       {
-        const Index k = ordering.invp(min_x_list[n]);
+        const Index k = ordering->invp(min_x_list[n]);
         s += G(k,i)*G(k,j);
       }
     return s;
@@ -593,16 +770,13 @@ namespace GNU_gama {
             }
 
         for (Index i=1; i<=parameters; i++)
-          G(ordering.invp(i), N1) = x0(i);
+          G(ordering->invp(i), N1) = x0(i);
 
 
         // Gramm-Schmidt orthogonalization
 
-        static Float s_tol = Float();
-        if (s_tol <= Float())
-          {
-            s_tol = std::sqrt( std::numeric_limits<Float>::epsilon() );
-          }
+        static const Float s_tol =
+          std::sqrt( std::numeric_limits<Float>::epsilon() );
 
         for (Index column=1; column<=nullity; column++)
           {
@@ -626,8 +800,59 @@ namespace GNU_gama {
 
         x.reset(parameters);
         for (Index i=1; i<=parameters; i++)
-          x(ordering.perm(i)) = G(i, N1);
+          x(ordering->perm(i)) = G(i, N1);
+
+        init_qxx = true;
+      }
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjEnvelope<Float, Index, Exc>::solve_qxx()
+  {
+    // W = Q0*H, P = G*K - W, K = H'*W  (see q_reg)
+
+    std::vector<bool> reg(parameters+1, false);
+    for (Index n=0; n<min_x_size; n++)
+      reg[ordering->invp(min_x_list[n])] = true;
+
+    W.reset(parameters, nullity);
+    Vec<Float, Index, Exc> a(parameters);
+    for (Index c=1; c<=nullity; c++)
+      {
+        for (Index i=1; i<=parameters; i++)
+          a(i) = reg[i] ? G(i,c) : Float();
+
+        envelope.solve(a.begin(), parameters);
+
+        for (Index i=1; i<=parameters; i++)
+          W(i,c) = a(i);
       }
+
+    Mat<Float, Index, Exc> K(nullity, nullity);
+    for (Index c=1; c<=nullity; c++)
+      for (Index e=1; e<=nullity; e++)
+        {
+          Float s = Float();
+          for (Index n=0; n<min_x_size; n++)
+            {
+              const Index k = ordering->invp(min_x_list[n]);
+              s += G(k,c)*W(k,e);
+            }
+          K(c,e) = s;
+        }
+
+    P.reset(parameters, nullity);
+    for (Index i=1; i<=parameters; i++)
+      for (Index e=1; e<=nullity; e++)
+        {
+          Float s = -W(i,e);
+          for (Index c=1; c<=nullity; c++)
+            s += G(i,c)*K(c,e);
+          P(i,e) = s;
+        }
+
+    init_qxx = false;
   }
 
 }  // namespace GNU_gama
@@ -0,0 +1,708 @@
+/*
+  GNU Gama -- adjustment of geodetic networks
+  Copyright (C) 2026  GNU Gama developers
+
+  This file is part of the GNU Gama C++ library
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_Gama_gnu_gama_adj_supernodal_gnugamaadjsupernodal_adj_supernodal_h
+#define GNU_Gama_gnu_gama_adj_supernodal_gnugamaadjsupernodal_adj_supernodal_h
+
+
+#include "adj_basesparse.h"
+#include "supernodal.h"
+#include <Math/Service/smatrix_ordering.h>
+#include "homogenization.h"
+#include <Utilities/Service/movetofront.h>
+#include <Utilities/Service/profile.h>
+#include <vector>
+#include <memory>
+
+namespace GNU_gama {
+
+
+  /** \brief Sparse adjustment based on supernodal LDL' decomposition.
+   *
+   * The class has the same stages and regularization as AdjEnvelope,
+   * only the envelope of normal equations is replaced by supernodal
+   * factor L whose fill-in is limited to the structure given by the
+   * elimination tree. Weight coefficients within the structure of L
+   * are taken from the selected inverse (Supernodal::inverse()), other
+   * elements from solutions with unit vectors (q0_xx) or from forward
+   * substitution with rows of the design matrix (q_bb). Approximate
+   * minimum degree ordering is used implicitly.
+   */
+
+  template <typename Float=double,  typename Index=int,
+            typename Exc=Exception::matvec>
+  class AdjSupernodal
+    : public AdjBaseSparse<Float, Index, Exc, AdjInputData>
+  {
+  public:
+
+    AdjSupernodal() : min_x_list(nullptr)
+    {
+      this->ordering_type = SparseOrdering::amd;
+    }
+    ~AdjSupernodal() override { delete[] min_x_list; }
+
+    AdjSupernodal(const AdjSupernodal&) = delete;
+    AdjSupernodal& operator= (const AdjSupernodal&) = delete;
+    AdjSupernodal(const AdjSupernodal&&) = delete;
+    AdjSupernodal& operator= (const AdjSupernodal&&) = delete;
+
+    const GNU_gama::Vec<Float, Index, Exc>& unknowns() override;
+    const GNU_gama::Vec<Float, Index, Exc>& residuals() override;
+    Float sum_of_squares() override;
+    Index defect() override;
+
+    Float q_xx(Index i, Index j) override;
+    Float q_bb(Index i, Index j) override;
+    Float q_bx(Index i, Index j) override;
+
+    Float q0_xx(Index i, Index j) override;
+
+    void q_bb_diagonal(GNU_gama::Vec<Float, Index, Exc>& qbb) override;
+
+    bool lindep(Index i) override;
+    void min_x() override;
+    void min_x(Index n, Index m[]) override;
+
+    void solve();
+
+    void reset(const AdjInputData *data) override;
+
+  private:
+
+    std::unique_ptr<SparseMatrixOrdering<Index>> ordering;
+    Homogenization<Float, Index>      hom;
+    Supernodal<Float, Index>       factor;
+
+    Index                    observations;
+    Index                      parameters;
+    const SparseMatrix<>*   design_matrix {nullptr};
+    GNU_gama::Vec<Float, Index, Exc>   x0;    // particular solution
+    GNU_gama::Vec<Float, Index, Exc>    x;    // unique or regularized solution
+    GNU_gama::Vec<Float, Index, Exc>resid;        // residuals
+    Float                         squares;        // sum of squares
+
+    GNU_gama::Vec<Float, Index, Exc> tmpvec;
+    GNU_gama::Vec<Float, Index, Exc> tmpres;         // used in q_bb
+    GNU_gama::Vec<Float, Index, Exc> tmpres2;
+    GNU_gama::Vec<Float, Index, Exc> qbbdiag;        // diagonal of q_bb
+
+    std::vector<GNU_gama::Vec<Float, Index, Exc>> qxxbuf;
+    GNU_gama::MoveToFront<3,Index,Index>          indbuf;
+    std::vector<GNU_gama::Vec<Float, Index, Exc>> q0buf;  // unit solutions
+    GNU_gama::MoveToFront<3,Index,Index>          q0ind;
+
+    enum Stage {
+      stage_init,       // implicitly set by Adj_BaseSparse constuctor
+      stage_ordering,   // permutation vector and symbolic factorization
+      stage_x0,         // particular solution (dependent unknown set to 0)
+      stage_q0
+    };
+
+    bool init_qbbdiag{};      // diagonal of q_bb
+    bool init_residuals{};    // residuals r = Ax - b
+    bool init_q0{};           // weight coefficients of particular solution x0
+    bool init_x{};            // unique or regularized solution
+
+    void set_stage(Stage s);
+    void solve_ordering();
+    void solve_x0();
+    void solve_x();
+    void solve_q0();
+    void T_row(GNU_gama::Vec<Float, Index, Exc>& row, Index i);
+    Index forward(Index row, GNU_gama::Vec<Float, Index, Exc>& y);
+    Float q_bb_ii(Index row) const;
+    void reset_qxxbuf();
+
+    Index nullity;
+    Mat<Float, Index, Exc> G;
+    Float dot(Index i, Index j) const;
+
+    Index* min_x_list;
+    Index  min_x_size;
+  };
+
+  // ---  Implementation  ------------------------------------------------
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::reset(const AdjInputData *data)
+  {
+    observations = data->mat()->rows();
+    parameters   = data->mat()->columns();
+    this->input  = data;
+
+    set_stage(stage_init);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::reset_qxxbuf()
+  {
+    indbuf.erase();
+    qxxbuf.resize(indbuf.size());
+    for (Index i=0; i<size_to<Index>(qxxbuf.size()); i++)
+      qxxbuf[i].reset(parameters);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::set_stage(Stage s)
+  {
+    switch (s)
+      {
+      default:
+      case stage_init:
+      case stage_ordering:
+      case stage_x0:
+        init_residuals = true;
+        init_q0        = true;
+        init_x         = true;
+        // fall through
+      case stage_q0:
+        init_qbbdiag   = true;
+        ;
+      }
+
+    this->stage = s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::solve_ordering()
+  {
+    if (this->stage >= stage_ordering) return;
+
+    hom.reset(this->input);
+    hom.set_threads(this->threads_);
+    design_matrix = hom.mat();
+
+    // symbolic factorization composes the ordering with the postorder
+    // of the elimination tree; only factor.perm()/invp() are used below.
+    // It is reused if the sparsity pattern has not changed.
+
+    if (this->same_pattern(design_matrix))
+      {
+        factor.assemble(design_matrix);
+      }
+    else
+      {
+        Profile::Scope profile("ordering");
+
+        SparseMatrixGraph <Float, Index> graph(design_matrix);
+        ordering = make_ordering<Index>(this->ordering_type);
+        ordering->reset(&graph);
+
+        FactorStatistics<Index> fill(&graph, ordering.get());
+        this->factor_nonzeroes_ = fill.nonzeroes();
+        this->factor_flops_     = fill.flops();
+
+        factor.set(design_matrix, &graph, ordering.get());
+      }
+
+    const Vec<Float>& rhs = hom.rhs();
+    const Index N = design_matrix->columns();
+    tmpvec.reset(N);
+    tmpvec.set_zero();
+
+    for (Index r=1; r<=design_matrix->rows(); r++)
+      {
+        const Float* b=design_matrix->begin (r);
+        const Float* e=design_matrix->end   (r);
+        const Index* n=design_matrix->ibegin(r);
+
+        while (b != e)
+          {
+            const Index c = factor.invp(*n++);
+            const Float a = *b++;
+
+            // absolute terms in normal equations
+            tmpvec(c) +=  a * rhs(r);
+          }
+      }
+
+    set_stage(stage_ordering);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::solve_x0()
+  {
+    if (this->stage >= stage_x0) return;
+    solve_ordering();
+
+    // supernodal decomposition L*D*L'
+
+    factor.cholDec();
+
+    // particular solution x0
+
+    factor.solve(tmpvec.begin(), tmpvec.dim());
+
+    x0.reset(tmpvec.dim());
+    for (Index i=1; i<=tmpvec.dim(); i++)
+      {
+        x0(factor.perm(i)) = tmpvec(i);
+      }
+    tmpvec.reset();
+
+    // sum of squares of weighted residuals
+
+    const SparseMatrix<Float, Index>*  mat = hom.mat();
+    const Vec         <Float>&         rhs = hom.rhs();
+    squares = 0;
+    for (Index i=1; i<=mat->rows(); i++)
+      {
+        Float *b = mat->begin(i);
+        Float *e = mat->end(i);
+        Index *n = mat->ibegin(i);
+        Float  s = Float();
+        while(b != e)
+          {
+            s += *b++ * x0(*n++);
+          }
+
+        const Float t = s - rhs(i);
+        squares += t*t;
+      }
+
+    nullity = factor.defect();
+
+    set_stage(stage_x0);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  const GNU_gama::Vec<Float, Index, Exc>&
+  AdjSupernodal<Float, Index, Exc>::unknowns()
+  {
+    if (init_x) solve_x();
+
+    return x;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  const GNU_gama::Vec<Float, Index, Exc>&
+  AdjSupernodal<Float, Index, Exc>::residuals()
+  {
+    if (init_residuals)
+      {
+        if (this->stage < stage_x0) solve_x0();
+
+        const SparseMatrix<Float, Index>* mat = this->input->mat();
+        const Vec<>&                      rhs = this->input->rhs();
+        const Index N = rhs.dim();
+        resid.reset(N);
+
+        for (Index i=1; i<=N; i++)        // residuals = Ax - rhs
+          {
+            Float *b = mat->begin(i);
+            Float *e = mat->end(i);
+            Index *n = mat->ibegin(i);
+            Float  s = Float();
+            while(b != e)
+              {
+                s += *b++ * x0(*n++);
+              }
+
+            resid(i) = s - rhs(i);
+          }
+
+        init_residuals = false;
+      }
+
+    return resid;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::sum_of_squares()
+  {
+    if (this->stage < stage_x0) solve_x0();
+
+    return squares;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Index AdjSupernodal<Float, Index, Exc>::defect()
+  {
+    if (this->stage < stage_x0) solve_x0();
+
+    return nullity;
+  }
+
+
+  // T = I - alpha*inv(alpha'*alpha)*alpha'
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>
+    ::T_row(GNU_gama::Vec<Float, Index, Exc>& row, Index ii)
+  {
+    Float t;
+    const Index i = factor.invp(ii);
+    for (Index jj=1; jj<=parameters; jj++)
+      {
+        const Index j = factor.invp(jj);
+        t = Float();
+        if (i == j) t = Float(1);
+
+        for (Index k=0; k<min_x_size; k++)
+          if (min_x_list[k] == jj)
+            {
+              for (Index c=1; c<=nullity; c++) t -= G(i,c)*G(j,c);
+              break;
+            }
+
+        row(j) = t;
+      }
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::q_xx(Index i, Index j)
+  {
+    if (this->stage < stage_q0) solve_q0();
+
+    if (nullity == 0) return q0_xx(i, j);
+
+    // singular system
+
+    if (init_x) solve_x();
+
+    std::pair<Index,bool> pa = indbuf.get(i);
+    std::pair<Index,bool> pb = indbuf.get(j);
+
+    Vec<Float, Index, Exc>& a = qxxbuf[pa.first];
+    Vec<Float, Index, Exc>& b = qxxbuf[pb.first];
+    if (!pa.second)
+      {
+        T_row(a, i);
+        factor.lowerSolve(1, parameters, a.begin());
+      }
+    if (!pb.second)
+      {
+        T_row(b, j);
+        factor.lowerSolve(1, parameters, b.begin());
+      }
+
+    Float s = Float();
+    for (Index i=1; i<=parameters; i++)
+      if (const Float d = factor.diagonal(i))
+        s += a(i)/d*b(i);
+
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::q0_xx(Index i, Index j)
+  {
+    if (this->stage < stage_q0) solve_q0();
+
+    Index ii = factor.invp(i);
+    Index jj = factor.invp(j);
+    if (ii < jj) std::swap(ii, jj);
+
+    if (const Float* z = factor.inverse(ii, jj)) return *z;
+
+    std::pair<Index,bool> pa = q0ind.get(ii);
+
+    Vec<Float, Index, Exc>& a = q0buf[pa.first];
+    if (!pa.second)
+      {
+        a.set_zero();
+        a(ii) = 1;
+        factor.solve(a.begin(), a.dim());
+      }
+
+    return a(jj);
+  }
+
+
+  // forward substitution L y = a for the permuted i-th row of the design
+  // matrix, returns index of the first nonzero element of y; y is a
+  // scratch vector of dimension parameters, only its elements from the
+  // returned index are defined
+
+  template <typename Float, typename Index, typename Exc>
+  Index AdjSupernodal<Float, Index, Exc>
+    ::forward(Index i, GNU_gama::Vec<Float, Index, Exc>& y)
+  {
+    const Float* b = design_matrix->begin (i);
+    const Float* e = design_matrix->end   (i);
+    const Index* n = design_matrix->ibegin(i);
+
+    Index start = parameters;
+    for (const Index* k=n; k!=design_matrix->iend(i); k++)
+      start = std::min(start, factor.invp(*k));
+
+    std::fill(y.begin() + (start - 1), y.end(), Float());
+    while (b != e)
+      {
+        y(factor.invp(*n++)) = *b++;
+      }
+
+    factor.lowerSolve(start, parameters, y.begin() + (start - 1));
+
+    return start;
+  }
+
+
+  // q_bb(i,i) = a_i' Z a_i, columns of a row of the design matrix are
+  // a clique of normal equations, all pairs are within the selected
+  // inverse Z
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::q_bb_ii(Index i) const
+  {
+    const Float* b = design_matrix->begin (i);
+    const Float* e = design_matrix->end   (i);
+    const Index* n = design_matrix->ibegin(i);
+
+    Float s = Float();
+    for (; b != e; b++, n++)
+      {
+        const Index k = factor.invp(*n);
+        const Float* b2 = design_matrix->begin (i);
+        const Index* n2 = design_matrix->ibegin(i);
+        for (; b2 != b; b2++, n2++)
+          s += 2 * *b * *b2 * *factor.inverse(k, factor.invp(*n2));
+        s += *b * *b * *factor.inverse(k, k);
+      }
+
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::q_bb(Index i, Index j)
+  {
+    if (this->stage < stage_q0) solve_q0();
+
+    if (i == j) return q_bb_ii(i);
+
+    // q_bb(i,j) = a_i' inv(N) a_j = y_i' inv(D) y_j
+
+    const Index si = forward(i, tmpres);
+    const Index sj = forward(j, tmpres2);
+
+    Float s = Float();
+    for (Index k=std::max(si, sj); k<=parameters; k++)
+      if (const Float d = factor.diagonal(k))
+        s += tmpres(k)/d*tmpres2(k);
+
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>
+    ::q_bb_diagonal(GNU_gama::Vec<Float, Index, Exc>& qbb)
+  {
+    if (this->stage < stage_q0) solve_q0();
+
+    if (init_qbbdiag)
+      {
+        const Index M = design_matrix->rows();
+        qbbdiag.reset(M);
+
+        for (Index i=1; i<=M; i++)
+          {
+            qbbdiag(i) = q_bb_ii(i);
+          }
+
+        init_qbbdiag = false;
+      }
+
+    qbb = qbbdiag;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::q_bx(Index, Index)
+  {
+    throw Exc(Exception::BadRegularization,
+              "q_bx not implemented");
+    return 0;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjSupernodal<Float, Index, Exc>::lindep(Index i)
+  {
+    if (this->stage < stage_x0) solve_x0();
+
+    return (factor.diagonal(i) == Float());
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::min_x()
+  {
+    delete[] min_x_list;
+    min_x_list = nullptr;
+
+    init_x = true;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::min_x(Index n, Index m[])
+  {
+    delete[] min_x_list;
+    min_x_size = n;
+    min_x_list = new Index[min_x_size];
+    for (Index i=0; i<min_x_size; i++)
+      min_x_list[i] = m[i];
+
+    init_x = true;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::solve()
+  {
+    solve_x();
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::solve_q0()
+  {
+    Profile::Scope profile("solve_q0");
+
+    if (init_q0)
+      {
+        if (this->stage < stage_x0) solve_x0();
+
+        // weight coefficients within the structure of L are taken from
+        // the selected inverse, others are computed on demand from
+        // solutions with unit vectors
+
+        factor.inverse();
+
+        tmpres .reset(parameters);
+        tmpres2.reset(parameters);
+
+        q0ind.erase();
+        q0buf.resize(q0ind.size());
+        for (Index i=0; i<size_to<Index>(q0buf.size()); i++)
+          q0buf[i].reset(parameters);
+
+        init_q0 = false;
+        set_stage(stage_q0);
+      }
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSupernodal<Float, Index, Exc>::dot(Index i, Index j) const
+  {
+    Float s = Float();
+    for (Index n=0; n<min_x_size; n++)
+      {
+        const Index k = factor.invp(min_x_list[n]);
+        s += G(k,i)*G(k,j);
+      }
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSupernodal<Float, Index, Exc>::solve_x()
+  {
+    if (init_x)
+      {
+        if (min_x_list == nullptr)   // regularization for all parameters
+          {
+            min_x_size = parameters;
+            min_x_list = new Index[min_x_size];
+            for (Index i=0; i<min_x_size; i++)
+              min_x_list[i] = i+1;
+          }
+
+        if (this->stage < stage_x0) solve_x0();
+        init_x = false;
+        reset_qxxbuf();
+        if (defect() == 0)
+          {
+            x = x0;
+            return;
+          }
+
+        nullity = defect();
+        const Index N1 = nullity+1;
+        G.reset(parameters, N1);
+        Vec<Float, Index, Exc> tmp(parameters);
+
+        // null space vectors  g = -inv(L') e_c  for zero pivots
+
+        for (Index k=1, column=1; column<=parameters; column++)
+          if (factor.diagonal(column) == 0)
+            {
+              tmp.set_zero();
+              tmp(column) = Float(1);
+              factor.upperSolve(1, column, tmp.begin());
+
+              for (Index i=1; i<=parameters; i++)
+                  G(i,k) = -tmp(i);
+
+              k++;
+            }
+
+        for (Index i=1; i<=parameters; i++)
+          G(factor.invp(i), N1) = x0(i);
+
+
+        // Gramm-Schmidt orthogonalization
+
+        static const Float s_tol =
+          std::sqrt( std::numeric_limits<Float>::epsilon() );
+
+        for (Index column=1; column<=nullity; column++)
+          {
+            const Float pivot = std::sqrt( dot(column, column) );
+            if (pivot < s_tol)
+              {
+                init_x = true;
+                throw Exc(Exception::BadRegularization,
+                        "AdjSupernodal::solve_x() --- bad regularization");
+              }
+            for (Index i=1; i<=parameters; i++)
+              G(i,column) /= pivot;
+
+            for (Index col=column+1; col<=N1; col++)
+              {
+                const Float dp = dot(column, col);
+                for (Index i=1; i<=parameters; i++)
+                  G(i,col) -= dp*G(i, column);
+              }
+          }
+
+        x.reset(parameters);
+        for (Index i=1; i<=parameters; i++)
+          x(factor.perm(i)) = G(i, N1);
+      }
+  }
+
+}  // namespace GNU_gama
+
+#endif
@@ -45,6 +45,11 @@ namespace GNU_gama {
       svd.reset(A);
     }
 
+    /** Golub-Reinsch (implicit) or one-sided Jacobi SVD, the Jacobi
+     *  method runs on threads() threads */
+    void      set_method(SVDMethod m) { svd.set_method(m); }
+    SVDMethod method() const { return svd.method(); }
+
     Index defect() override{ return svd.nullity(); }
     bool  lindep(Index i) override { return svd.lindep(i); }
 
@@ -82,6 +87,7 @@ namespace GNU_gama {
 
     if (this->is_solved) return;
 
+    svd.set_threads(this->threads_);
     svd.reset(*this->pA);
     svd.solve(*this->pb, this->x);
 
@@ -24,10 +24,16 @@
 
 
 #include <limits>
+#include <atomic>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include <Math/Service/smatrix_graph.h>
 #include <Math/Service/smatrix_ordering.h>
 #include <Math/Service/sbdiagonal.h>
 #include <Math/Service/symmat.h>
+#include <Utilities/Service/profile.h>
 
 
 namespace GNU_gama {
@@ -77,6 +83,14 @@ namespace GNU_gama {
     Index dim()    const { return dim_;    }
     Index defect() const { return defect_; }
 
+    /** Number of threads used in cholDec(); 0 stands for all hardware
+     *  threads. The result does not depend on the number of threads. */
+    void  set_threads(Index n) { threads_ = n; }
+    Index threads() const { return threads_; }
+
+    /** LDL' decomposition; unknowns with pivot below tol (default
+     *  sqrt(epsilon)) relative to their diagonal element are taken
+     *  as linearly dependent, see defect() */
     void cholDec(Float tol=Float());
     void solve (Float* rhs, Index dimension) const;
     void lowerSolve   (Index start, Index stop, Float* rhs) const;
@@ -86,6 +100,11 @@ namespace GNU_gama {
              const SparseMatrixGraph    <Float, Index>* graph,
              const SparseMatrixOrdering <Index>*        ordering);
     void set(const BlockDiagonal<Float, Index>& cov);
+    /** Numerical phase of set(): normal equations of the matrix sm are
+     *  assembled into the existing envelope. The sparsity pattern of
+     *  sm and the ordering must be those used in the last call of set(). */
+    void assemble(const SparseMatrix         <Float, Index>* sm,
+                  const SparseMatrixOrdering <Index>*        ordering);
     void set(const Float* b_diag, const Float* e_diag,
              const Float* b_env,  const Float* e_env,
              const Index* b_bend, const Index* e_bend);
@@ -157,6 +176,9 @@ namespace GNU_gama {
     Float*  diag_{nullptr};   // diagonal elements
     Float*  env_{nullptr};    // of-diagonal elements
     Float** xenv_{nullptr};
+    Index   threads_{1};
+
+    void cholDecParallel(Float tol, Index threads);
 
     void clear()
     {
@@ -175,12 +197,22 @@ namespace GNU_gama {
   template <typename Float, typename Index>
   void Envelope<Float, Index>::cholDec(Float tol)
   {
+    Profile::Scope profile("cholDec");
+
     if (tol <= Float())
       {
         tol = std::sqrt( std::numeric_limits<Float>::epsilon() );
       }
     defect_ = 0;
 
+    Index threads = threads_;
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads > 1 && dim_ >= 8*threads)
+      {
+        cholDecParallel(tol, threads);
+        return;
+      }
+
     for (Index row=2; row<=dim_; row++)
       {
         /*
@@ -208,9 +240,10 @@ namespace GNU_gama {
             s += *b * *b * *d++;
             b++;
           }
+        const Float a = *d;
         *d -= s;                                  // d = diag_ - uDu'
 
-        if (std::abs(*d) < tol)
+        if (std::abs(*d) <= tol*std::abs(a))      // relative to diag_
           {
             *d = Float();                         // linearly dependend unknown
             defect_++;
@@ -219,6 +252,98 @@ namespace GNU_gama {
   }
 
 
+  template <typename Float, typename Index>
+  void Envelope<Float, Index>::cholDecParallel(Float tol, Index threads)
+  {
+    /*
+      Rows are factorized in a pipeline. Worker threads take the next
+      free row from a shared counter and run the same operations as
+      the sequential cholDec(), waiting only for those rows of L that
+      are actually needed, i.e. the rows within the envelope of the
+      row being processed. Each element is thus computed with the same
+      sequence of floating point operations as in the sequential
+      algorithm and the factorization is identical for any number of
+      threads.
+     */
+
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[dim_+1]);
+    for (Index i=0; i<=dim_; i++) done[i].store(false, std::memory_order_relaxed);
+    done[1].store(true, std::memory_order_release);
+
+    std::atomic<Index> next_row(2);
+    std::vector<Index> defects(threads, 0);
+
+    auto wait = [&done](Index row)
+      {
+        while (!done[row].load(std::memory_order_acquire))
+          std::this_thread::yield();
+      };
+
+    auto worker = [&](Index thread)
+      {
+        for (Index row; (row = next_row.fetch_add(1)) <= dim_; )
+          {
+            Float* b = begin(row);
+            Float* e = end(row);
+
+            const Index start = row - (e-b);
+            const Index stop  = row - 1;
+
+            // lowerSolve(start, stop, begin(row))
+            Float* rhs = b;
+            if (start < row) wait(start);
+            rhs++;
+            for (Index r=start+1; r<=stop; r++)
+              {
+                wait(r);
+                const Float* rb = xenv_[r];
+                const Float* re = xenv_[r+1];
+                const Float* x  = rhs;
+                Float s = Float();
+                while (rb != re && x != b)  s += *--x * *--re;
+                *rhs++ -= s;
+              }
+
+            diagonalSolve(start, stop, b);
+
+            Float* d = diag_ + (start - 1);
+            Float  s = Float();
+            while (b != e)
+              {
+                s += *b * *b * *d++;
+                b++;
+              }
+            const Float a = *d;
+            *d -= s;
+
+            if (std::abs(*d) <= tol*std::abs(a))
+              {
+                *d = Float();
+                defects[thread]++;
+              }
+
+            done[row].store(true, std::memory_order_release);
+          }
+      };
+
+    // rows are taken from the shared counter, if a thread cannot be
+    // created the decomposition runs on the threads already started
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    try
+      {
+        for (Index t=1; t<threads; t++) pool.emplace_back(worker, t);
+      }
+    catch (const std::system_error&)
+      {
+      }
+    worker(0);
+    for (auto& t : pool) t.join();
+
+    for (auto n : defects) defect_ += n;
+  }
+
+
   template <typename Float, typename Index>
   void Envelope<Float, Index>::solve(Float* rhs, Index dimension) const
   {
@@ -462,7 +587,17 @@ namespace GNU_gama {
       }
     delete[] min_neighbour;
 
+    assemble(sm, ordering);
+  }
+
 
+  template <typename Float, typename Index>
+  void Envelope<Float, Index>::assemble(const SparseMatrix<Float, Index>* sm,
+                                        const SparseMatrixOrdering<Index>* ordering)
+  {
+    if (dim_ == 0) return;
+
+    const Index env_size = xenv_[dim_+1] - xenv_[1];
     for (Index i=0; i<dim_; i++) diag_[i] = 0;
     for (Index i=0; i<env_size; i++) env_[i] = 0;
 
@@ -566,49 +701,82 @@ namespace GNU_gama {
       }
     xenv_[dim_+1] = t;
 
-    // Z = inv(D)*inv(L) + (I - L')*Z
+    /*
+      Selected inversion (Takahashi equations)
+
+         Z = inv(D)*inv(L) + (I - L')*Z
+
+      Only elements of Z within the envelope are computed, column by
+      column starting from the last one. Element Z(i,j), i > j, depends
+      on Z(k,i) for all k > j with L(k,j) within the envelope, and all
+      these elements are within the envelope again. The number of
+      operations is of the same order as of the decomposition.
+    */
 
-    Float        d, s;
-    const Float*    u;   // element of upper triangular matrix L'
-    Float      *    z;   //            inverse matrix
-    for (Index step=dim_; step>=1; step--)
+    // column structure of L: for each column j rows k > j within the
+    // envelope, pointers to elements L(k,j) and Z(k,j)
+
+    std::vector<Index> xcol(dim_+2, 0);
+    for (Index k=1; k<=dim_; k++)
+      for (Index c = k - (chol.end(k) - chol.begin(k)); c < k; c++)
+        xcol[c+1]++;
+    for (Index j=1; j<=dim_+1; j++) xcol[j] += xcol[j-1];
+
+    std::vector<Index>        rows(env_size);
+    std::vector<const Float*> lval(env_size);
+    std::vector<Float*>       zval(env_size);
+    {
+      std::vector<Index> next(xcol.begin(), xcol.end()-1);
+      for (Index k=1; k<=dim_; k++)
+        {
+          const Float* l = chol.begin(k);
+          Float*       z = begin(k);
+          for (Index c = k - (chol.end(k) - l); c < k; c++)
+            {
+              const Index p = next[c]++;
+              rows[p] = k;
+              lval[p] = l++;
+              zval[p] = z++;
+            }
+        }
+    }
+
+    auto Z = [this](Index k, Index i) -> Float
       {
-        d = chol.diagonal(step);
+        if (k > i) return *(xenv_[k+1] - (k - i));
+        if (k < i) return *(xenv_[i+1] - (i - k));
+        return diag_[k-1];
+      };
+
+    for (Index j=dim_; j>=1; j--)
+      {
+        const Index b = xcol[j];
+        const Index e = xcol[j+1];
+
+        const Float d = chol.diagonal(j);
         if (d == 0)
           {
-            diagonal(step) = Float();
-            Float* b = begin(step);
-            Float* e = end(step);
-            while (b != e) *b++ = Float();
+            diagonal(j) = Float();
+            for (Index p=b; p<e; p++) *zval[p] = Float();
             continue;
           }
 
-        d = Float(1)/d;
-        for (Index n=1, k=step+1; k<=dim_; k++, n++)
+        for (Index p=b; p<e; p++)
           {
-            // d -= U(k, step)*Z(step, k);
-            u = chol.element(k, step);
-            if (u == nullptr) continue;
-            z = element(step, k);
-            d -= *u * *z;
-          }
-        diagonal(step) = d;
-
-        Float* b = begin(step);
-        Float* e = end(step);
-        for (Index i=step-1; i>=1 && b != e ; i--)
-          {
-            s = Float();
-            for (Index k=i+1; k<=dim_; k++)
+            // Z(i,j) = - sum L(k,j)*Z(k,i)
+            const Index i = rows[p];
+            Float s = Float();
+            for (Index q=b; q<e; q++)
               {
-                // s -= U(i, k)*Z(k, step);
-                u = chol.element(i,k);
-                if (u == nullptr) continue;
-                z = element(k, step);
-                s -= *u * *z;
+                s -= *lval[q] * Z(rows[q], i);
               }
-            *--e = s;
+            *zval[p] = s;
           }
+
+        // Z(j,j) = 1/d - sum L(k,j)*Z(k,j)
+        Float s = Float(1)/d;
+        for (Index p=b; p<e; p++) s -= *lval[p] * *zval[p];
+        diagonal(j) = s;
       }
   }
 
@@ -26,8 +26,14 @@
 #include "adj.h"
 #include "envelope.h"
 #include <Math/Service/covmat.h>
+#include <Utilities/Service/profile.h>
 #include <Utilities/Service/size_to.h>
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 
 namespace GNU_gama {
@@ -59,6 +65,11 @@ namespace GNU_gama {
       ready = false;
     }
 
+    /** Number of threads transforming correlated blocks; 0 stands
+     *  for all hardware threads. */
+    void  set_threads(Index n) { threads_ = n; }
+    Index threads() const { return threads_; }
+
     const SparseMatrix<Float, Index>* mat() { run(); return sm; }
     const Vec<Float>&                 rhs() { run(); return pr; }
 
@@ -72,11 +83,17 @@ namespace GNU_gama {
     const AdjInputData* data {nullptr};
 
     using Sparse  = SparseMatrix<Float, Index>;
-    using Indices = std::set<Index>;
+
+    struct Rows {              // scaled rows of a correlated block
+      std::vector<Index> ptr;
+      std::vector<Float> val;
+      std::vector<Index> ind;
+    };
 
     Sparse*        sm;
     Vec<Float>     pr;   // right hand side
     bool        ready {false};
+    Index     threads_ {1};
 
 
     void run()
@@ -84,6 +101,8 @@ namespace GNU_gama {
       if (ready) return;
       if (!data) throw Exception::matvec(Exception::BadRank, "Homogenization : No input data");
 
+      Profile::Scope profile("homogenization");
+
       const BlockDiagonal<Float, Index>& cov = *data->cov();
 
       BlockDiagonal<Float, Index>* blockdiagonal = cov.replicate();
@@ -112,38 +131,42 @@ namespace GNU_gama {
         }
 
 
-      /* counting total number of nonzeros in scaled sparse matrix */
+      /* correlated blocks are transformed independently, possibly
+       * in parallel; uncorrelated rows are only scaled */
+
+      const Index blocks = bd->blocks();
+      std::vector<Index> first_row(blocks+2);          // 1 based indexing
+      std::vector<Index> correlated;
+      first_row[1] = 1;
+      for (Index b=1; b<=blocks; b++)
+        {
+          first_row[b+1] = first_row[b] + bd->dim(b);
+          if (bd->width(b) > 0) correlated.push_back(b);
+        }
+
+      std::vector<Rows> scaled(blocks+1);
+      scale_blocks(correlated, first_row, bd, upper, mata, scaled);
 
-      std::vector<Index> block_cols(bd->blocks()+1);   // 1 based indexing
 
-      for (Index row=1, block_index=1; block_index<=bd->blocks(); block_index++)
+      /* counting total number of nonzeros in scaled sparse matrix */
+
+      for (Index row=1, block_index=1; block_index<=blocks; block_index++)
         {
           const Index  block_dim   = bd->dim  (block_index);
           const Index  block_width = bd->width(block_index);
 
           if (block_width == 0)    // uncorrelated observations
             {
-              Index nonz = 0;
               for (Index i=1; i<=block_dim; i++, row++)
                 {
-                  nonz += size_to<Index>(mata->end(row) - mata->begin(row));
+                  total_scaled_nonzeroes +=
+                    size_to<Index>(mata->end(row) - mata->begin(row));
                 }
-              total_scaled_nonzeroes += nonz;
             }
           else                     // correlated observations
             {
-              Indices indices;
-              for (Index i=1; i<=block_dim; i++, row++)
-                {
-                  const Index* n = mata->ibegin(row);
-                  const Index* e = mata->iend  (row);
-                  while (n != e)
-                    {
-                      indices.insert(*n++);
-                    }
-                }
-              block_cols[block_index] = size_to<Index>(indices.size());
-              total_scaled_nonzeroes += block_dim*indices.size();
+              total_scaled_nonzeroes += size_to<Index>(scaled[block_index].val.size());
+              row += block_dim;
             }
         }
 
@@ -153,9 +176,7 @@ namespace GNU_gama {
 
       /* assembling scaled sparse matrix */
 
-      std::vector<Index> perm(mata->columns()+1);  // block index permutation
-
-      for (Index row=1, block_index=1; block_index<=bd->blocks(); block_index++)
+      for (Index row=1, block_index=1; block_index<=blocks; block_index++)
         {
           const Float* block_b     = bd->begin(block_index);
           const Index  block_dim   = bd->dim  (block_index);
@@ -176,70 +197,168 @@ namespace GNU_gama {
               }
           else                     // correlated observations
             {
-              const Index bcols = block_cols[block_index];
-              std::vector<Index> invp(bcols+1);     // block inverse permutaion
-              Index invp_count = 0;
-
-              Mat<Float> T(block_dim, bcols);       // matrix of block columns
-              T.set_zero();
-
-              /* copy block sparse columns to T */
-
-              for (Index i=1; i<=block_dim; i++, row++)
+              Rows& r = scaled[block_index];
+              for (Index i=0; i<block_dim; i++)
                 {
-                  const Float* b = mata->begin (row);
-                  const Float* e = mata->end   (row);
-                  const Index* n = mata->ibegin(row);
-                  while (b != e)
+                  sm->new_row();
+                  for (Index k=r.ptr[i]; k<r.ptr[i+1]; k++)
                     {
-                      const Index c = *n++;
-                      if (perm[c] == 0)
-                        {
-                          perm[c] = ++invp_count;
-                          invp[invp_count] = c;
-                        }
-
-                      T(i, perm[c]) = *b++;
+                      sm->add_element(r.val[k], r.ind[k]);
                     }
                 }
+              r = Rows();
+              row += block_dim;
+            }
+        }
 
-              /* forward substitution for T */
+      delete blockdiagonal;
+      ready = true;
+    }
 
-              for (Index c=1; c<=bcols; c++)
-                for (Index n, r=row-block_dim, i=1; i<=block_dim; i++, r++)
-                  {
-                    const Float* b = upper.begin(r);
-                    const Float* e = upper.end  (r);
-                    const Float  x = T(i,c) / *b++;
-                    T(i,c) = x;
-                    n = i + 1;
-                    while (b != e)
-                      {
-                        T(n++,c) -= *b++ * x;
-                      }
-                  }
 
-              /* move transformed T to ouput sparse matrix  */
+    /* Scaled rows of a correlated block are computed by forward
+     * substitution with the banded upper triangular factor U of the
+     * block. Row i of the result depends only on rows i-width ... i,
+     * rows are therefore kept as sparse accumulators in a window of
+     * width+1 slots and the nonzero structure of a scaled row is the
+     * union of structures of the rows it is updated from. Slots hold
+     * only their nonzero elements, a single map of column positions
+     * is shared by all slots. Elements are computed with the same
+     * operations as in dense forward substitution of block columns. */
+
+    void scale_block(Index row0, Index dim, Index width,
+                     const UpperBlockDiagonal<Float, Index>& upper,
+                     const Sparse* mata, std::vector<Index>& perm,
+                     Rows& out) const
+    {
+      std::vector<Index> invp(1);                // block inverse permutation
+      for (Index r=row0; r<row0+dim; r++)
+        for (const Index* n=mata->ibegin(r); n!=mata->iend(r); n++)
+          if (perm[*n] == 0)
+            {
+              perm[*n] = size_to<Index>(invp.size());
+              invp.push_back(*n);
+            }
+      const Index bcols = size_to<Index>(invp.size()) - 1;
+
+      struct Element { Index col; Float val; };
+      using Slot = std::vector<Element>;
+      const Index nslots = std::min(width + 1, dim);
+      std::vector<Slot> slots(nslots);
+      std::vector<Index> pos(bcols+1, 0);        // 1 + position in a slot
+
+      auto element = [&](Slot& slot, Index c) -> Float& {
+        if (pos[c] == 0)
+          {
+            slot.push_back({c, Float()});
+            pos[c] = size_to<Index>(slot.size());
+          }
+        return slot[pos[c]-1].val;
+      };
+      auto release = [&](const Slot& slot) {
+        for (const Element& x : slot) pos[x.col] = 0;
+      };
+
+      auto load = [&](Index i) {                 // 0 based row of block
+        Slot& slot = slots[i % nslots];
+        const Index* n = mata->ibegin(row0 + i);
+        const Float* b = mata->begin (row0 + i);
+        const Float* e = mata->end   (row0 + i);
+        while (b != e) element(slot, perm[*n++]) = *b++;
+        release(slot);
+      };
+
+      for (Index i=0; i<nslots; i++) load(i);
+
+      out.ptr.assign(1, 0);
+      for (Index i=0; i<dim; i++)
+        {
+          Slot& x = slots[i % nslots];
+          std::sort(x.begin(), x.end(),
+                    [](const Element& a, const Element& b) { return a.col < b.col; });
+
+          const Float* b = upper.begin(row0 + i);
+          const Float* e = upper.end  (row0 + i);
+          const Float  d = *b++;
+          for (Element& t : x) t.val /= d;
+
+          for (Index n=i+1; b!=e; n++)           // update following rows
+            {
+              const Float u = *b++;
+              if (u == Float()) continue;
+              Slot& y = slots[n % nslots];
+              for (Index k=0; k<size_to<Index>(y.size()); k++) pos[y[k].col] = k+1;
+              for (const Element& t : x) element(y, t.col) -= u * t.val;
+              release(y);
+            }
 
-              for (Index i=1; i<=block_dim; i++)
+          for (const Element& t : x)
+            {
+              if (t.val != Float())
                 {
-                  sm->new_row();
-                  for (Index j=1; j<=bcols; j++)
-                    if (const Float element = T(i,j))
-                      {
-                        sm->add_element(element, invp[j]);
-                      }
+                  out.val.push_back(t.val);
+                  out.ind.push_back(invp[t.col]);
                 }
+            }
+          x.clear();
+          out.ptr.push_back(size_to<Index>(out.val.size()));
+
+          if (i + nslots < dim) load(i + nslots);
+        }
+
+      for (Index c=1; c<=bcols; c++) perm[invp[c]] = 0;
+    }
 
-              for (Index i=1; i<=bcols; i++)      // clear permutation vector
+    /* the first exception in the order of blocks is rethrown after all
+     * threads are joined, as if the blocks were transformed sequentially */
+
+    void scale_blocks(const std::vector<Index>& correlated,
+                      const std::vector<Index>& first_row,
+                      const BlockDiagonal<Float, Index>* bd,
+                      const UpperBlockDiagonal<Float, Index>& upper,
+                      const Sparse* mata, std::vector<Rows>& scaled) const
+    {
+      const Index count = size_to<Index>(correlated.size());
+      std::atomic<Index> next(0);
+      std::vector<std::exception_ptr> error(count);
+
+      auto worker = [&]()
+        {
+          std::vector<Index> perm;
+          for (Index k; (k = next.fetch_add(1)) < count; )
+            {
+              try
+                {
+                  perm.resize(mata->columns()+1, 0);
+                  const Index b = correlated[k];
+                  scale_block(first_row[b], bd->dim(b), bd->width(b),
+                              upper, mata, perm, scaled[b]);
+                }
+              catch (...)
                 {
-                  perm[invp[i]] = 0;
+                  error[k] = std::current_exception();
+                  std::fill(perm.begin(), perm.end(), 0);
                 }
             }
+        };
+
+      Index threads = threads_;
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+      if (threads > count) threads = count;
+
+      std::vector<std::thread> pool;
+      try
+        {
+          for (Index t=1; t<threads; t++) pool.emplace_back(worker);
         }
+      catch (const std::system_error&)
+        {
+          // blocks are shared by the threads already running
+        }
+      worker();
+      for (auto& t : pool) t.join();
 
-      delete blockdiagonal;
-      ready = true;
+      for (auto& e : error) if (e) std::rethrow_exception(e);
     }
 
   };
@@ -0,0 +1,671 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  GNU Gama developers
+
+    This file is part of the GNU Gama C++ library
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef GNU_Gama_Supernodal_gnu_gama_supernodal_gnugamasupernodal_supernodal_h
+#define GNU_Gama_Supernodal_gnu_gama_supernodal_gnugamasupernodal_supernodal_h
+
+
+#include <limits>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <Math/Service/smatrix_graph.h>
+#include <Math/Service/smatrix_ordering.h>
+#include <Utilities/Service/profile.h>
+
+
+namespace GNU_gama {
+
+
+  /** \brief Supernodal sparse LDL' decomposition of normal equations.
+   *
+   * Normal matrix N = A'A of a sparse design matrix A is decomposed as
+   * LDL', where the nonzero structure of L is given by the elimination
+   * tree of N rather than by its envelope. Columns of L with identical
+   * structure are grouped into supernodes stored as dense column major
+   * blocks, and all numerical work is done on these dense blocks.
+   *
+   * The external ordering is composed with a postorder of the
+   * elimination tree; perm() and invp() give the resulting permutation
+   * and all other member functions work with the permuted indexes.
+   * Interface of the class follows Envelope, linearly dependent
+   * unknowns have zero diagonal elements and zero columns in L.
+   */
+
+  template <typename Float=double, typename Index=int>
+  class Supernodal
+  {
+  public:
+
+    Supernodal() = default;
+
+    Supernodal(const Supernodal&) = delete;
+    Supernodal& operator=(const Supernodal&) = delete;
+
+    Index dim()    const { return dim_;    }
+    Index defect() const { return defect_; }
+
+    Index perm(Index i) const { return perm_[i]; }
+    Index invp(Index i) const { return invp_[i]; }
+
+    /** number of supernodes */
+    Index supernodes() const { return nsuper_; }
+    /** number of elements in L including its diagonal */
+    std::size_t nonzeroes() const;
+
+    void set(const SparseMatrix         <Float, Index>* sm,
+             const SparseMatrixGraph    <Float, Index>* graph,
+             const SparseMatrixOrdering <Index>*        ordering);
+    /** numerical phase of set() for a matrix with the same sparsity
+     *  pattern, the symbolic factorization is reused */
+    void assemble(const SparseMatrix<Float, Index>* sm)
+    {
+      sm_ = sm;
+      assemble();
+    }
+    /** LDL' decomposition; unknowns with pivot below tol (default
+     *  sqrt(epsilon)) relative to their diagonal element are taken
+     *  as linearly dependent, see defect() */
+    void cholDec(Float tol=Float());
+    void solve (Float* rhs, Index dimension) const;
+    void lowerSolve   (Index start, Index stop, Float* rhs) const;
+    void diagonalSolve(Index start, Index stop, Float* rhs) const;
+    void upperSolve   (Index start, Index stop, Float* rhs) const;
+
+    Float  diagonal(Index i) const { return diag_[i-1]; }
+
+    /** selected inverse Z = inv(LDL') on the structure of L computed
+     *  from Takahashi equations, called after cholDec() */
+    void inverse();
+    /** element Z(i,j) of the selected inverse or nullptr if (i,j) is
+     *  outside the structure of L */
+    const Float* inverse(Index i, Index j) const;
+
+  private:
+
+    Index dim_    {0};
+    Index defect_ {0};
+    Index nsuper_ {0};
+
+    const SparseMatrix<Float, Index>* sm_ {nullptr};
+
+    std::vector<Index> perm_, invp_;   // 1 based indexes
+    std::vector<Index> parent_;        // elimination tree
+    std::vector<Index> super_;         // first column of supernodes
+    std::vector<Index> col2super_;     // supernode of a column
+    std::vector<Index> xrow_, row_;    // row indexes of supernodes
+    std::vector<std::size_t> xval_;    // beginnings of dense blocks
+    std::vector<Float> val_;           // dense blocks (column major)
+    std::vector<Float> diag_;          // diagonal D
+    std::vector<Float> inv_;           // selected inverse (layout of val_)
+
+    Index ncols(Index s) const { return super_[s+1] - super_[s]; }
+    Index nrows(Index s) const { return xrow_[s+1] - xrow_[s]; }
+
+    void etree(const SparseMatrixGraph<Float, Index>* graph,
+               const std::vector<Index>& p, const std::vector<Index>& ip);
+    void assemble();
+  };
+
+
+  template <typename Float, typename Index>
+  std::size_t Supernodal<Float, Index>::nonzeroes() const
+  {
+    std::size_t n = 0;
+    for (Index s=0; s<nsuper_; s++)
+      {
+        const std::size_t r = nrows(s), c = ncols(s);
+        n += r*c - c*(c-1)/2;
+      }
+    return n;
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::etree(const SparseMatrixGraph<Float, Index>* graph,
+                                       const std::vector<Index>& p,
+                                       const std::vector<Index>& ip)
+  {
+    std::vector<Index> ancestor(dim_+1, 0);
+    parent_.assign(dim_+1, 0);
+
+    for (Index k=1; k<=dim_; k++)
+      {
+        using const_iterator = typename SparseMatrixGraph<Float, Index>::const_iterator;
+        const_iterator b = graph->begin(p[k]);
+        const_iterator e = graph->end  (p[k]);
+        while (b != e)
+          {
+            Index r = ip[*b++];
+            if (r >= k) continue;
+
+            while (ancestor[r] != 0 && ancestor[r] != k)
+              {
+                const Index t = ancestor[r];
+                ancestor[r] = k;
+                r = t;
+              }
+            if (ancestor[r] == 0)
+              {
+                ancestor[r] = k;
+                parent_[r]  = k;
+              }
+          }
+      }
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::set(const SparseMatrix<Float, Index>* sm,
+                                     const SparseMatrixGraph<Float, Index>* graph,
+                                     const SparseMatrixOrdering<Index>* ordering)
+  {
+    using const_iterator = typename SparseMatrixGraph<Float, Index>::const_iterator;
+
+    sm_     = sm;
+    dim_    = sm->columns();
+    defect_ = 0;
+    nsuper_ = 0;
+
+    perm_.assign(dim_+1, 0);
+    invp_.assign(dim_+1, 0);
+    for (Index i=1; i<=dim_; i++)
+      {
+        perm_[i] = ordering->perm(i);
+        invp_[i] = ordering->invp(i);
+      }
+
+    // ---  postorder of the elimination tree  ---------------------------
+
+    etree(graph, perm_, invp_);
+    {
+      std::vector<Index> head(dim_+1, 0), next(dim_+1, 0), stack, post;
+      for (Index j=dim_; j>=1; j--)
+        if (const Index p = parent_[j])
+          {
+            next[j] = head[p];
+            head[p] = j;
+          }
+
+      post.reserve(dim_+1);
+      post.push_back(0);
+      for (Index j=1; j<=dim_; j++)
+        {
+          if (parent_[j]) continue;        // roots only
+          stack.push_back(j);
+          while (!stack.empty())
+            {
+              const Index t = stack.back();
+              if (const Index c = head[t])
+                {
+                  head[t] = next[c];
+                  stack.push_back(c);
+                }
+              else
+                {
+                  stack.pop_back();
+                  post.push_back(t);
+                }
+            }
+        }
+
+      std::vector<Index> p(dim_+1);
+      for (Index k=1; k<=dim_; k++) p[k] = perm_[post[k]];
+      perm_.swap(p);
+      for (Index k=1; k<=dim_; k++) invp_[perm_[k]] = k;
+    }
+    etree(graph, perm_, invp_);
+
+    // ---  column counts of L  -----------------------------------------
+
+    std::vector<Index> mark(dim_+1, 0), count(dim_+1, 1), children(dim_+1, 0);
+    for (Index k=1; k<=dim_; k++)
+      {
+        if (parent_[k]) children[parent_[k]]++;
+
+        mark[k] = k;
+        const_iterator b = graph->begin(perm_[k]);
+        const_iterator e = graph->end  (perm_[k]);
+        while (b != e)
+          {
+            for (Index j = invp_[*b++]; j < k && mark[j] != k; j = parent_[j])
+              {
+                mark[j] = k;
+                count[j]++;
+              }
+          }
+      }
+
+    // ---  fundamental supernodes  -------------------------------------
+
+    super_.clear();
+    col2super_.assign(dim_+1, 0);
+    for (Index j=1; j<=dim_; j++)
+      {
+        const bool merge = j > 1 && parent_[j-1] == j && children[j] == 1
+                                 && count[j-1] == count[j] + 1;
+        if (!merge) super_.push_back(j);
+        col2super_[j] = Index(super_.size()) - 1;
+      }
+    nsuper_ = Index(super_.size());
+    super_.push_back(dim_+1);
+
+    // ---  row structure of supernodes  --------------------------------
+
+    xrow_.assign(nsuper_+1, 0);
+    for (Index s=0; s<nsuper_; s++)
+      {
+        xrow_[s+1] = xrow_[s] + count[super_[s]];
+      }
+    row_.assign(xrow_[nsuper_], 0);
+
+    std::vector<Index> fill(nsuper_);
+    for (Index s=0; s<nsuper_; s++)
+      {
+        fill[s] = xrow_[s];
+        for (Index j=super_[s]; j<super_[s+1]; j++) row_[fill[s]++] = j;
+      }
+
+    std::fill(mark.begin(), mark.end(), 0);
+    std::vector<Index> smark(nsuper_, 0);
+    for (Index k=1; k<=dim_; k++)
+      {
+        mark[k] = k;
+        const_iterator b = graph->begin(perm_[k]);
+        const_iterator e = graph->end  (perm_[k]);
+        while (b != e)
+          {
+            for (Index j = invp_[*b++]; j < k && mark[j] != k; j = parent_[j])
+              {
+                mark[j] = k;
+                const Index s = col2super_[j];
+                if (k >= super_[s+1] && smark[s] != k)
+                  {
+                    smark[s] = k;
+                    row_[fill[s]++] = k;
+                  }
+              }
+          }
+      }
+
+    xval_.assign(nsuper_+1, 0);
+    for (Index s=0; s<nsuper_; s++)
+      {
+        xval_[s+1] = xval_[s] + std::size_t(nrows(s))*std::size_t(ncols(s));
+      }
+    val_.assign(xval_[nsuper_], Float());
+    diag_.assign(dim_, Float());
+
+    assemble();
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::assemble()
+  {
+    // normal equations N = A'A are assembled into the lower triangle of
+    // the dense supernode blocks; the diagonal is stored in the blocks
+    // until cholDec() moves it to diag_
+
+    std::fill(val_.begin(), val_.end(), Float());
+    inv_.clear();
+
+    std::vector<Float> a;
+    std::vector<Index> c;
+    for (Index r=1; r<=sm_->rows(); r++)
+      {
+        a.clear();
+        c.clear();
+        const Float* b = sm_->begin (r);
+        const Float* e = sm_->end   (r);
+        const Index* n = sm_->ibegin(r);
+        while (b != e)
+          {
+            a.push_back(*b++);
+            c.push_back(invp_[*n++]);
+          }
+
+        for (std::size_t i=0; i<c.size(); i++)
+          for (std::size_t j=0; j<c.size(); j++)
+            {
+              const Index row = c[i];
+              const Index col = c[j];
+              if (row < col) continue;
+
+              const Index  s  = col2super_[col];
+              const Index* rb = row_.data() + xrow_[s];
+              const Index* re = row_.data() + xrow_[s+1];
+              const Index  p  = Index(std::lower_bound(rb, re, row) - rb);
+
+              val_[xval_[s] + std::size_t(col - super_[s])*nrows(s) + p]
+                += a[i]*a[j];
+            }
+      }
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::cholDec(Float tol)
+  {
+    Profile::Scope profile("cholDec");
+
+    if (tol <= Float())
+      {
+        tol = std::sqrt( std::numeric_limits<Float>::epsilon() );
+      }
+    defect_ = 0;
+
+    std::vector<Index> link(nsuper_, -1);   // linked lists of updates
+    std::vector<Index> head(nsuper_, -1);
+    std::vector<Index> next(nsuper_,  0);   // first row for next update
+    std::vector<Index> map (dim_+1,   0);   // relative row indexes
+    std::vector<Float> W, C;
+    std::vector<Float> A;                   // diagonal before updates
+
+    for (Index J=0; J<nsuper_; J++)
+      {
+        const Index  fJ = super_[J];
+        const Index  lJ = super_[J+1] - 1;
+        const Index  nr = nrows(J);
+        const Index  nc = ncols(J);
+        const Index* rJ = row_.data() + xrow_[J];
+        Float*       LJ = val_.data() + xval_[J];
+
+        for (Index p=0; p<nr; p++) map[rJ[p]] = p;
+
+        A.resize(nc);
+        for (Index k=0; k<nc; k++) A[k] = LJ[std::size_t(k)*nr + k];
+
+        /* updates from all descendant supernodes K
+         *
+         *    L(J) -= L(K,rows) * D(K) * L(K,cols)'
+         */
+
+        for (Index K = head[J]; K != -1; )
+          {
+            const Index  nextK = link[K];
+            const Index  pK = next[K];
+            const Index  rK = nrows(K);
+            const Index  cK = ncols(K);
+            const Index* iK = row_.data() + xrow_[K];
+            const Float* LK = val_.data() + xval_[K];
+            const Float* dK = diag_.data() + (super_[K] - 1);
+
+            Index m1 = 0;                          // rows within columns of J
+            while (pK + m1 < rK && iK[pK + m1] <= lJ) m1++;
+            const Index m = rK - pK;               // all updating rows
+
+            W.assign(std::size_t(m)*cK, Float());  // W = L(K,rows) * D(K)
+            for (Index k=0; k<cK; k++)
+              {
+                const Float  d = dK[k];
+                const Float* l = LK + std::size_t(k)*rK + pK;
+                Float*       w = W.data() + std::size_t(k)*m;
+                for (Index i=0; i<m; i++) w[i] = l[i]*d;
+              }
+
+            C.assign(std::size_t(m)*m1, Float());  // C = W * L(K,cols)'
+            for (Index k=0; k<cK; k++)
+              {
+                const Float* l = LK + std::size_t(k)*rK + pK;
+                const Float* w = W.data() + std::size_t(k)*m;
+                for (Index j=0; j<m1; j++)
+                  {
+                    const Float t = l[j];
+                    if (t == Float()) continue;
+                    Float* c = C.data() + std::size_t(j)*m;
+                    for (Index i=j; i<m; i++) c[i] += w[i]*t;
+                  }
+              }
+
+            for (Index j=0; j<m1; j++)             // scatter C to L(J)
+              {
+                Float* col = LJ + std::size_t(iK[pK+j] - fJ)*nr;
+                const Float* c = C.data() + std::size_t(j)*m;
+                for (Index i=j; i<m; i++) col[map[iK[pK+i]]] -= c[i];
+              }
+
+            next[K] = pK + m1;
+            if (next[K] < rK)
+              {
+                const Index S = col2super_[iK[next[K]]];
+                link[K] = head[S];
+                head[S] = K;
+              }
+
+            K = nextK;
+          }
+
+        /* dense LDL' decomposition of the supernode panel */
+
+        for (Index k=0; k<nc; k++)
+          {
+            Float* colk = LJ + std::size_t(k)*nr;
+            Float  d    = colk[k];
+
+            if (std::abs(d) <= tol*std::abs(A[k]))
+              {
+                d = Float();                   // linearly dependend unknown
+                defect_++;
+                for (Index i=k+1; i<nr; i++) colk[i] = Float();
+              }
+            else
+              {
+                for (Index i=k+1; i<nr; i++) colk[i] /= d;
+
+                for (Index j=k+1; j<nc; j++)
+                  {
+                    const Float t = colk[j]*d;
+                    if (t == Float()) continue;
+                    Float* colj = LJ + std::size_t(j)*nr;
+                    for (Index i=j; i<nr; i++) colj[i] -= colk[i]*t;
+                  }
+              }
+
+            diag_[fJ + k - 1] = d;
+            colk[k] = Float(1);
+          }
+
+        if (nc < nr)
+          {
+            next[J] = nc;
+            const Index S = col2super_[rJ[nc]];
+            link[J] = head[S];
+            head[S] = J;
+          }
+      }
+  }
+
+
+  template <typename Float, typename Index>
+  const Float* Supernodal<Float, Index>::inverse(Index i, Index j) const
+  {
+    if (inv_.empty()) return nullptr;
+    if (i < j) std::swap(i, j);
+
+    // row i in column j of supernode s, rows of the diagonal block are
+    // the columns of the supernode, the remaining rows are sorted
+
+    const Index  s  = col2super_[j];
+    const Index  nr = nrows(s);
+    const Index* rs = row_.data() + xrow_[s];
+
+    Index r = i - super_[s];
+    if (i >= super_[s+1])
+      {
+        const Index* b = rs + ncols(s);
+        const Index* e = rs + nr;
+        const Index* p = std::lower_bound(b, e, i);
+        if (p == e || *p != i) return nullptr;
+        r = Index(p - rs);
+      }
+
+    return inv_.data() + xval_[s] + std::size_t(j - super_[s])*nr + r;
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::inverse()
+  {
+    Profile::Scope profile("inverse");
+
+    inv_.assign(val_.size(), Float());
+
+    /*
+      Selected inversion (Takahashi equations)
+
+         Z = inv(D)*inv(L) + (I - L')*Z
+
+      Elements of Z are computed on the structure of L, column by column
+      starting from the last one. Element Z(i,j), i > j, depends on
+      Z(k,i) for all rows k > j of column j; the structure of L is closed
+      under the elimination tree, so all these elements are within the
+      structure of column min(k,i). Linearly dependent unknowns have zero
+      rows and columns in Z, as in solve().
+    */
+
+    for (Index s=nsuper_-1; s>=0; s--)
+      {
+        const Index  nr = nrows(s);
+        const Index* rs = row_.data() + xrow_[s];
+        const Float* Ls = val_.data() + xval_[s];
+        Float*       Zs = inv_.data() + xval_[s];
+
+        for (Index k=ncols(s)-1; k>=0; k--)
+          {
+            const Index  j = super_[s] + k;
+            const Float* l = Ls + std::size_t(k)*nr;
+            Float*       z = Zs + std::size_t(k)*nr;
+
+            const Float d = diag_[j-1];
+            if (d == Float()) continue;
+
+            for (Index p=k+1; p<nr; p++)
+              {
+                // Z(i,j) = - sum L(q,j)*Z(q,i)
+                const Index i = rs[p];
+                Float t = Float();
+                for (Index q=k+1; q<nr; q++)
+                  if (l[q] != Float())
+                    t -= l[q] * *inverse(rs[q], i);
+                z[p] = t;
+              }
+
+            Float t = Float(1)/d;
+            for (Index p=k+1; p<nr; p++) t -= l[p]*z[p];
+            z[k] = t;
+          }
+      }
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::solve(Float* rhs, Index dimension) const
+  {
+    lowerSolve   (1, dimension, rhs);
+    diagonalSolve(1, dimension, rhs);
+    upperSolve   (1, dimension, rhs);
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::lowerSolve(Index start, Index stop,
+                                            Float* rhs) const
+  {
+    // rhs points to the element with index start
+
+    if (start > stop) return;
+
+    for (Index s=col2super_[start]; s<nsuper_ && super_[s]<=stop; s++)
+      {
+        const Index  nr = nrows(s);
+        const Index* rs = row_.data() + xrow_[s];
+        const Float* Ls = val_.data() + xval_[s];
+
+        for (Index k=std::max(start, super_[s])-super_[s]; k<ncols(s); k++)
+          {
+            const Index col = super_[s] + k;
+            if (col > stop) break;
+
+            const Float x = rhs[col - start];
+            if (x == Float()) continue;
+
+            const Float* l = Ls + std::size_t(k)*nr;
+            for (Index i=k+1; i<nr && rs[i]<=stop; i++)
+              {
+                rhs[rs[i] - start] -= l[i]*x;
+              }
+          }
+      }
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::diagonalSolve(Index start, Index stop,
+                                               Float* rhs) const
+  {
+    const Float* d = diag_.data() + start - 1;     // 1 based indexes
+    while (start++ <= stop)
+      if (*d)
+        {
+          *rhs++ /= *d++;
+        }
+      else
+        {
+          *rhs++ = Float();
+          d++;
+        }
+  }
+
+
+  template <typename Float, typename Index>
+  void Supernodal<Float, Index>::upperSolve(Index start, Index stop,
+                                            Float* rhs) const
+  {
+    // rhs points to the element with index start
+
+    if (start > stop) return;
+
+    for (Index s=col2super_[stop]; s>=0 && super_[s+1]>start; s--)
+      {
+        const Index  nr = nrows(s);
+        const Index* rs = row_.data() + xrow_[s];
+        const Float* Ls = val_.data() + xval_[s];
+
+        for (Index k=std::min(stop+1, super_[s+1])-super_[s]-1; k>=0; k--)
+          {
+            const Index col = super_[s] + k;
+            if (col < start) break;
+
+            const Float* l = Ls + std::size_t(k)*nr;
+            Float t = Float();
+            for (Index i=k+1; i<nr && rs[i]<=stop; i++)
+              {
+                t += l[i]*rhs[rs[i] - start];
+              }
+            rhs[col - start] -= t;
+          }
+      }
+  }
+
+}  // namespace GNU_gama
+
+#endif
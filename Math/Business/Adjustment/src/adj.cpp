@@ -20,6 +20,7 @@
 
 #include "Math/Business/Adjustment/adj.h"
 #include "Math/Business/Adjustment/adj_input_data.h"
+#include "Math/Business/Adjustment/adj_supernodal.h"
 #include <Utilities/Service/size_to.h>
 #include <vector>
 #include <cstddef>
@@ -33,7 +34,7 @@ using namespace std;
 Adj::~Adj()
 {
   delete least_squares;
-  delete minx;
+  delete[] minx;
 }
 
 
@@ -42,7 +43,6 @@ void Adj::init(const AdjInputData* inp)
 {
   delete data;
   data = inp;
-  least_squares = nullptr;
   solved = false;
   n_obs_ = n_par_ = 0;
 
@@ -57,29 +57,44 @@ void Adj::init(const AdjInputData* inp)
 
 void Adj::init_least_squares()
 {
-  delete least_squares;
+  // the solver object is kept for the same algorithm, sparse algorithms
+  // can then reuse symbolic factorization if only numerical values of
+  // the design matrix have changed (linearization iterations)
 
-  switch (algorithm_)
+  if (least_squares && least_squares_algorithm_ != algorithm_)
     {
-    case envelope:
-      least_squares = new AdjEnvelope<double, int, Exception::matvec>;
-      break;
-    case svd:
-      least_squares = new AdjSVD<double, int, Exception::matvec>;
-      break;
-    case gso:
-      least_squares = new AdjGSO<double, int, Exception::matvec>;
-      break;
-    case cholesky:
-      least_squares = new AdjCholDec<double, int, Exception::matvec>;
-      break;
-    default:
-      throw Exception::adjustment("### unknown algorithm");
+      delete least_squares;
+      least_squares = nullptr;
+    }
+
+  if (least_squares == nullptr)
+    {
+      switch (algorithm_)
+        {
+        case envelope:
+          least_squares = new AdjEnvelope<double, int, Exception::matvec>;
+          break;
+        case svd:
+          least_squares = new AdjSVD<double, int, Exception::matvec>;
+          break;
+        case gso:
+          least_squares = new AdjGSO<double, int, Exception::matvec>;
+          break;
+        case cholesky:
+          least_squares = new AdjCholDec<double, int, Exception::matvec>;
+          break;
+        case supernodal:
+          least_squares = new AdjSupernodal<double, int, Exception::matvec>;
+          break;
+        default:
+          throw Exception::adjustment("### unknown algorithm");
+        }
+      least_squares_algorithm_ = algorithm_;
     }
 
   if (const IntegerList<>* p = data->minx())
     {
-      delete minx;
+      delete[] minx;
       minx_dim = 0;
 
       if (int   N = p->dim())
@@ -98,6 +113,8 @@ void Adj::init_least_squares()
 
   if (AdjBaseSparse* sprs = dynamic_cast<AdjBaseSparse*>(least_squares))
     {
+      if (has_ordering_) sprs->set_ordering(ordering_);
+      sprs->set_threads(threads_);
       sprs->reset(data);
 
       x_   = least_squares->unknowns();
@@ -181,6 +198,7 @@ void Adj::set_algorithm(Adj::algorithm alg)
     case svd:
     case gso:
     case cholesky:
+    case supernodal:
       solved = false;
       algorithm_ = alg;
       break;
@@ -192,6 +210,35 @@ void Adj::set_algorithm(Adj::algorithm alg)
 
 
 
+void Adj::set_ordering(SparseOrdering ord)
+{
+  solved = false;
+  ordering_ = ord;
+  has_ordering_ = true;
+}
+
+
+
+double Adj::factor_nonzeroes() const
+{
+  if (const AdjBaseSparse* sprs = dynamic_cast<const AdjBaseSparse*>(least_squares))
+    return sprs->factor_nonzeroes();
+
+  return 0;
+}
+
+
+
+double Adj::factor_flops() const
+{
+  if (const AdjBaseSparse* sprs = dynamic_cast<const AdjBaseSparse*>(least_squares))
+    return sprs->factor_flops();
+
+  return 0;
+}
+
+
+
 const Vec<>& Adj::x()
 {
   if (!solved) init_least_squares();
@@ -45,10 +45,14 @@ namespace GNU_gama { namespace local
 
       std::string str() const { return sid; }
 
+      /** Hash value of the identifier, computed once on construction. */
+      std::size_t hash() const { return hsh; }
+
     private:
 
       using PointInt = long;
       PointInt     iid;   // positive integer representation if available or 0
+      std::size_t  hsh;   // cached std::hash of sid
       std::string  sid;
 
       void init(const std::string& s);
@@ -33,7 +33,7 @@ namespace std
 {
   size_t hash<PointID>::operator()(const PointID & obj) const
   {
-    return hash<std::string>()(obj.str());
+    return obj.hash();
   }
 }
 
@@ -53,6 +53,8 @@ void PointID::init(const std::string& s)
     }
   if (!sid.empty() && std::isspace(sid.back())) sid.pop_back();
 
+  hsh = std::hash<std::string>()(sid);
+
   std::string::const_iterator b=sid.begin();
   std::string::const_iterator e=sid.end();
   iid = 0;
@@ -73,12 +75,12 @@ void PointID::init(const std::string& s)
 
 bool PointID::operator==(const PointID& p) const
 {
-  return iid == p.iid && sid == p.sid;
+  return hsh == p.hsh && sid == p.sid;
 }
 
 bool PointID::operator!=(const PointID& p) const
 {
-  return iid != p.iid || sid != p.sid;
+  return hsh != p.hsh || sid != p.sid;
 }
 
 bool PointID::operator< (const PointID& p) const
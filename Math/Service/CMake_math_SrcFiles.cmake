@@ -8,10 +8,12 @@ set(header_files
    "include/Math/Service/hilbert.h"
    "include/Math/Service/inderr.h"
    "include/Math/Service/jacobian.h"
+   "include/Math/Service/kernels.h"
    "include/Math/Service/matbase.h"
    "include/Math/Service/mat.h"
    "include/Math/Service/matvecbase.h"
    "include/Math/Service/matvec.h"
+   "include/Math/Service/memalloc.h"
    "include/Math/Service/memrep.h"
    "include/Math/Service/pinv.h"
    "include/Math/Service/sortvec.h"
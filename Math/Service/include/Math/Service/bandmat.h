@@ -56,8 +56,8 @@ namespace GNU_gama {   /** \brief Symmetric Band Matrix */
     void    reset(Index d, Index b);
     Index   dim() const { return this->row_; }
     Index   bandWidth() const { return band_; }
-    Float   operator()(Index, Index) const;
-    Float&  operator()(Index, Index);
+    Float   operator()(Index, Index) const override final;
+    Float&  operator()(Index, Index) override final;
     Float*  operator[](Index row) { return this->begin() + --row*(band_+1); }
     void    cholDec();
     void    solve(Vec<Float, Index, Exc>&) const;
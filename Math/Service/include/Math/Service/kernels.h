@@ -0,0 +1,237 @@
+/*
+  C++ Matrix/Vector templates (GNU Gama / matvec)
+  Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ Matrix/Vector template library.
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_gama_gMatVec_Kernels_h
+#define GNU_gama_gMatVec_Kernels_h
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/* Loops over contiguous rows are free of dependencies, the compiler
+ * is told so to vectorise them without runtime alias checks. */
+
+#if defined(__clang__)
+#  define GNU_gama_kernels_simd _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#  define GNU_gama_kernels_simd _Pragma("GCC ivdep")
+#else
+#  define GNU_gama_kernels_simd
+#endif
+
+
+namespace GNU_gama { namespace Kernels {
+
+  /** \brief Dense matrix kernels on row-major storage
+   *
+   * Cache blocked matrix products used by Mat, TransMat and the full
+   * matrix adjustment algorithms. Rows of the result are split into
+   * panels computed by worker threads; every element of the result is
+   * accumulated over k in ascending order, exactly as in a simple dot
+   * product loop, so results do not depend on blocking or on the
+   * number of threads.
+   *
+   * Matrices are given by a pointer to the first element and a row
+   * stride (leading dimension), indexes are zero based.
+   */
+
+  /** Implicit number of threads of kernels called from matrix
+   *  operators; 0 stands for all hardware threads, implicitly 1. */
+  inline std::atomic<int>& threads_()
+  {
+    static std::atomic<int> threads {1};
+    return threads;
+  }
+
+  inline void set_threads(int n) { threads_().store(n); }
+  inline int  threads()          { return threads_().load(); }
+
+
+  const int block_rows = 32;    // rows of the result in one panel
+  const int block_cols = 256;   // columns of the result in one block
+  const int block_k    = 128;   // rows of the right factor in one block
+
+
+  /* Runs f(first_row, last_row) on panels of the result, in parallel
+   * if the product is large enough to pay for starting threads. */
+
+  template <typename Index, typename Function>
+  void panels(Index m, double flops, int threads, Function f)
+  {
+    if (threads == 0) threads = int(std::thread::hardware_concurrency());
+
+    const Index count = (m + block_rows - 1) / block_rows;
+    if (threads > count) threads = int(count);
+    if (flops < 1e6) threads = 1;
+
+    std::atomic<Index> next(0);
+    auto worker = [&]()
+      {
+        for (Index p; (p = next.fetch_add(1)) < count; )
+          {
+            const Index first = p*block_rows;
+            f(first, std::min(m, first + block_rows));
+          }
+      };
+
+    // panels are taken from the shared counter, if a thread cannot be
+    // created the product is computed by the threads already started
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    try
+      {
+        for (int t=1; t<threads; t++) pool.emplace_back(worker);
+      }
+    catch (const std::system_error&)
+      {
+      }
+    worker();
+    for (auto& t : pool) t.join();
+  }
+
+
+  /** C = A*B;  A is m x k, B is k x n, C is m x n */
+
+  template <typename Float, typename Index>
+  void gemm(Index m, Index n, Index k,
+            const Float* A, Index lda,
+            const Float* B, Index ldb,
+            Float* C, Index ldc, int threads = Kernels::threads())
+  {
+    panels(m, 2.0*m*n*k, threads, [=](Index first, Index last)
+      {
+        for (Index i=first; i<last; i++)
+          std::fill(C + i*ldc, C + i*ldc + n, Float());
+
+        for (Index jb=0; jb<n; jb+=block_cols)
+          {
+            const Index je = std::min(n, jb + block_cols);
+            for (Index kb=0; kb<k; kb+=block_k)
+              {
+                const Index ke = std::min(k, kb + block_k);
+                for (Index i=first; i<last; i++)
+                  {
+                    Float*       c = C + i*ldc;
+                    const Float* a = A + i*lda;
+                    for (Index p=kb; p<ke; p++)
+                      {
+                        const Float  t = a[p];
+                        const Float* b = B + p*ldb;
+                        GNU_gama_kernels_simd
+                        for (Index j=jb; j<je; j++) c[j] += t*b[j];
+                      }
+                  }
+              }
+          }
+      });
+  }
+
+
+  /** C = trans(A)*B;  A is k x m, B is k x n, C is m x n */
+
+  template <typename Float, typename Index>
+  void gemm_tn(Index m, Index n, Index k,
+               const Float* A, Index lda,
+               const Float* B, Index ldb,
+               Float* C, Index ldc, int threads = Kernels::threads())
+  {
+    panels(m, 2.0*m*n*k, threads, [=](Index first, Index last)
+      {
+        for (Index i=first; i<last; i++)
+          std::fill(C + i*ldc, C + i*ldc + n, Float());
+
+        for (Index jb=0; jb<n; jb+=block_cols)
+          {
+            const Index je = std::min(n, jb + block_cols);
+            for (Index kb=0; kb<k; kb+=block_k)
+              {
+                const Index ke = std::min(k, kb + block_k);
+                for (Index i=first; i<last; i++)
+                  {
+                    Float* c = C + i*ldc;
+                    for (Index p=kb; p<ke; p++)
+                      {
+                        const Float  t = A[p*lda + i];
+                        const Float* b = B + p*ldb;
+                        GNU_gama_kernels_simd
+                        for (Index j=jb; j<je; j++) c[j] += t*b[j];
+                      }
+                  }
+              }
+          }
+      });
+  }
+
+
+  /** C = trans(A)*A;  A is m x n, C is n x n symmetric matrix in
+   *  packed storage of SymMat (lower triangle by rows) */
+
+  template <typename Float, typename Index>
+  void syrk_tn(Index n, Index m, const Float* A, Index lda, Float* C,
+               int threads = Kernels::threads())
+  {
+    panels(n, double(n)*n*m, threads, [=](Index first, Index last)
+      {
+        for (Index i=first; i<last; i++)
+          std::fill(C + i*(i+1)/2, C + i*(i+1)/2 + i + 1, Float());
+
+        for (Index jb=0; jb<last; jb+=block_cols)
+          {
+            const Index je = std::min(last, jb + block_cols);
+            for (Index kb=0; kb<m; kb+=block_k)
+              {
+                const Index ke = std::min(m, kb + block_k);
+                for (Index i=std::max(first, jb); i<last; i++)
+                  {
+                    Float*      c  = C + i*(i+1)/2;
+                    const Index je_i = std::min(je, i+1);
+                    for (Index p=kb; p<ke; p++)
+                      {
+                        const Float* a = A + p*lda;
+                        const Float  t = a[i];
+                        GNU_gama_kernels_simd
+                        for (Index j=jb; j<je_i; j++) c[j] += a[j]*t;
+                      }
+                  }
+              }
+          }
+      });
+  }
+
+
+  /** B = trans(A);  A is m x n, B is n x m */
+
+  template <typename Float, typename Index>
+  void transpose(Index m, Index n, const Float* A, Index lda,
+                 Float* B, Index ldb)
+  {
+    const Index s = 32;
+    for (Index ib=0; ib<m; ib+=s)
+      for (Index jb=0; jb<n; jb+=s)
+        for (Index i=ib; i<std::min(m, ib+s); i++)
+          for (Index j=jb; j<std::min(n, jb+s); j++)
+            B[j*ldb + i] = A[i*lda + j];
+  }
+
+}}   // namespace GNU_gama::Kernels
+
+#endif
@@ -23,10 +23,12 @@
 
 #include "matbase.h"
 #include "array.h"
+#include "kernels.h"
 
 #include <iostream>
 #include <initializer_list>
 #include <limits>
+#include <utility>
 
 namespace GNU_gama {
 
@@ -62,34 +64,64 @@ namespace GNU_gama {
       }
     }
 
-    Float& operator()(Index r, Index c) override {
+    Float& operator()(Index r, Index c) override final {
       Float *m = this->begin();
       return m[--r*this->cols() + --c];
     }
-    Float  operator()(Index r, Index c) const override {
+    Float  operator()(Index r, Index c) const override final {
       const Float *m = this->begin();
       return m[--r*this->cols() + --c];
     }
 
-    Mat operator*(Float f) const {
+    /* Operands which are temporaries are reused for the result, a
+     * chain of operations allocates a single temporary. */
+
+    Mat operator*(Float f) const & {
       Mat t(this->rows(), this->cols()); this->mul(f, t); return t;
     }
-    Mat operator+(const Mat& M) const {
-      if (this->rows() != M.rows() || this->cols() != M.cols())
-        throw Exc(Exception::BadRank, "Mat::operator+(const Mat& M) const");
+    Mat operator*(Float f) && {
+      this->mul(f, *this); return std::move(*this);
+    }
+    Mat operator+(const Mat& M) const & {
+      check_dim(M, "Mat::operator+(const Mat& M) const");
 
       Mat T(this->rows(), this->cols());
       this->add(M, T);
       return T;
     }
-    Mat operator-(const Mat& M) const {
-      if (this->rows() != M.rows() || this->cols() != M.cols())
-        throw Exc(Exception::BadRank, "Mat::operator-(const Mat& M) const");
+    Mat operator+(Mat&& M) const & {
+      check_dim(M, "Mat::operator+(const Mat& M) const");
+
+      this->add(M, M);
+      return std::move(M);
+    }
+    Mat operator+(const Mat& M) && {
+      check_dim(M, "Mat::operator+(const Mat& M) const");
+
+      this->add(M, *this);
+      return std::move(*this);
+    }
+    Mat operator+(Mat&& M) && { return std::move(*this) + M; }
+    Mat operator-(const Mat& M) const & {
+      check_dim(M, "Mat::operator-(const Mat& M) const");
 
       Mat T(this->rows(), this->cols());
       this->sub(M, T);
       return T;
     }
+    Mat operator-(Mat&& M) const & {
+      check_dim(M, "Mat::operator-(const Mat& M) const");
+
+      this->sub(M, M);
+      return std::move(M);
+    }
+    Mat operator-(const Mat& M) && {
+      check_dim(M, "Mat::operator-(const Mat& M) const");
+
+      this->sub(M, *this);
+      return std::move(*this);
+    }
+    Mat operator-(Mat&& M) && { return std::move(*this) - M; }
 
     void transpose() override { *this = trans(*this); }
     void invert(Float tol=std::numeric_limits<Float>::epsilon()*1000);
@@ -99,6 +131,12 @@ namespace GNU_gama {
     Float* pentry {nullptr};  // not initialized in constructor !!!
     Float& entry(Index i, Index j) { return *(pentry + i*this->col_ + j); }
 
+    void check_dim(const Mat& M, const char* fun) const
+    {
+      if (this->rows() != M.rows() || this->cols() != M.cols())
+        throw Exc(Exception::BadRank, fun);
+    }
+
     };
 
 
@@ -111,34 +149,60 @@ namespace GNU_gama {
 
 
   template <typename Float, typename Index, typename Exc>
+    inline Mat<Float, Index, Exc>
+    operator*(Float f, Mat<Float, Index, Exc> &&M)
+    {
+      return std::move(M)*f;
+    }
+
+
+  template <template <typename, typename, typename> class MA,
+            template <typename, typename, typename> class MB,
+            typename Float, typename Index, typename Exc,
+            typename = MatBaseIf<MA<Float, Index, Exc>, Float, Index, Exc>,
+            typename = MatBaseIf<MB<Float, Index, Exc>, Float, Index, Exc>>
     Mat<Float, Index, Exc>
-    operator* (const MatBase<Float, Index, Exc> &A,
-               const MatBase<Float, Index, Exc> &B)
+    operator* (const MA<Float, Index, Exc> &A,
+               const MB<Float, Index, Exc> &B)
     {
       if (A.cols() != B.rows())
         throw Exc(Exception::BadRank,
                   "Mat operator* (const MatBase&, const MatBase&)");
 
-      Mat<Float, Index, Exc> C(A.rows(), B.cols());
-      typename Mat<Float, Index, Exc>::iterator c = C.begin();
-      Float s;
-      for (Index i=1; i<=C.rows(); i++)
-        for (Index j=1; j<=C.cols(); j++)
-          {
-            s = 0;
-            for (Index k=1; k<=B.rows(); k++)
-              s += A(i,k) * B(k,j);
-            *c++ = s;
-          }
+      // operands are copied to row-major storage unless they are Mat
 
-      return C;
+      const Mat<Float, Index, Exc>* pa = dynamic_cast<const Mat<Float, Index, Exc>*>(&A);
+      const Mat<Float, Index, Exc>* pb = dynamic_cast<const Mat<Float, Index, Exc>*>(&B);
+      Mat<Float, Index, Exc> a, b;
+      if (pa == nullptr)
+        {
+          a.reset(A.rows(), A.cols());
+          for (Index i=1; i<=A.rows(); i++)
+            for (Index j=1; j<=A.cols(); j++)
+              a(i,j) = A(i,j);
+          pa = &a;
+        }
+      if (pb == nullptr)
+        {
+          b.reset(B.rows(), B.cols());
+          for (Index i=1; i<=B.rows(); i++)
+            for (Index j=1; j<=B.cols(); j++)
+              b(i,j) = B(i,j);
+          pb = &b;
+        }
+
+      return (*pa) * (*pb);
     }
 
 
-  template <typename Float, typename Index, typename Exc>
+  template <template <typename, typename, typename> class MA,
+            template <typename, typename, typename> class MB,
+            typename Float, typename Index, typename Exc,
+            typename = MatBaseIf<MA<Float, Index, Exc>, Float, Index, Exc>,
+            typename = MatBaseIf<MB<Float, Index, Exc>, Float, Index, Exc>>
     Mat<Float, Index, Exc>
-    operator+(const MatBase<Float, Index, Exc> &A,
-              const MatBase<Float, Index, Exc> &B)
+    operator+(const MA<Float, Index, Exc> &A,
+              const MB<Float, Index, Exc> &B)
     {
       if (A.rows() != B.rows() || A.cols() != B.cols())
         throw Exc(Exception::BadRank,
@@ -153,10 +217,14 @@ namespace GNU_gama {
     }
 
 
-  template <typename Float, typename Index, typename Exc>
+  template <template <typename, typename, typename> class MA,
+            template <typename, typename, typename> class MB,
+            typename Float, typename Index, typename Exc,
+            typename = MatBaseIf<MA<Float, Index, Exc>, Float, Index, Exc>,
+            typename = MatBaseIf<MB<Float, Index, Exc>, Float, Index, Exc>>
     Mat<Float, Index, Exc>
-    operator-(const MatBase<Float, Index, Exc> &A,
-              const MatBase<Float, Index, Exc> &B)
+    operator-(const MA<Float, Index, Exc> &A,
+              const MB<Float, Index, Exc> &B)
     {
       if (A.rows() != B.rows() || A.cols() != B.cols())
         throw Exc(Exception::BadRank,
@@ -180,24 +248,9 @@ namespace GNU_gama {
         throw Exc(Exception::BadRank, "Mat operator*(const Mat&, const Mat&)");
 
       Mat<Float, Index, Exc> C(A.rows(), B.cols());
-      typename Mat<Float, Index, Exc>::iterator c = C.begin();
-      typename Mat<Float, Index, Exc>::const_iterator ab = A.begin();
-      typename Mat<Float, Index, Exc>::const_iterator a;
-      typename Mat<Float, Index, Exc>::const_iterator bb = B.begin();
-      typename Mat<Float, Index, Exc>::const_iterator b;
-      Float s;
-
-      for (Index i=1; i<=C.rows(); i++, ab += A.cols())
-        for (Index j=0; j<C.cols(); j++)
-          {
-            s = 0;
-            a = ab;
-            b = bb + j;
-            for (Index k=1; k<=A.cols(); k++, b += B.cols())
-              s += *a++ * *b;
-            *c++ = s;
-          }
-
+      Kernels::gemm(A.rows(), B.cols(), A.cols(),
+                    A.begin(), A.cols(), B.begin(), B.cols(),
+                    C.begin(), C.cols());
       return C;
     }
 
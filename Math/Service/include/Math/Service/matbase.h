@@ -23,6 +23,8 @@
 
 #include "matvecbase.h"
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 
 namespace GNU_gama {   /** \brief Base matrix class */
@@ -43,6 +45,23 @@ namespace GNU_gama {   /** \brief Base matrix class */
       : MatVecBase<Float, Index, Exc>(nsz), row_(r), col_(c) {}
     MatBase(Index r, Index c, const MatBase& m)
       : MatVecBase<Float, Index, Exc>(m), row_(r), col_(c) {}
+    MatBase(const MatBase&) = default;
+    MatBase(MatBase&& m) noexcept
+      : MatVecBase<Float, Index, Exc>(std::move(m)), row_(m.row_), col_(m.col_)
+    {
+      m.row_ = m.col_ = 0;    // storage was moved
+    }
+    MatBase& operator=(const MatBase&) = default;
+    MatBase& operator=(MatBase&& m) noexcept
+    {
+      if (&m != this)
+        {
+          MatVecBase<Float, Index, Exc>::operator=(std::move(m));
+          row_ = m.row_;  col_ = m.col_;
+          if (m.size() == 0) m.row_ = m.col_ = 0;   // storage was moved
+        }
+      return *this;
+    }
     virtual ~MatBase() = default;
 
   public:
@@ -118,6 +137,17 @@ namespace GNU_gama {   /** \brief Base matrix class */
   };
 
 
+  /* Element access operator() is virtual in MatBase and final in all
+   * matrix classes. Generic operators are templates over the class of
+   * their operands (MatBaseIf), element access of a known class is a
+   * direct indexed load; virtual calls remain only for operands of
+   * type MatBase. */
+
+  template <typename M, typename Float, typename Index, typename Exc>
+  using MatBaseIf = typename std::enable_if<
+    std::is_base_of<MatBase<Float, Index, Exc>, M>::value>::type;
+
+
   template <typename Float, typename Index, typename Exc>
   std::istream& operator>>(std::istream& inp, MatBase<Float, Index, Exc>& M)
   {
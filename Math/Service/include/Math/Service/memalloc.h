@@ -0,0 +1,526 @@
+/*
+  C++ Matrix/Vector templates (GNU Gama / matvec)
+  Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ Matrix/Vector template library.
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_gama_gMatVec_MemAlloc_h
+#define GNU_gama_gMatVec_MemAlloc_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace GNU_gama {
+
+  class MemPool;
+
+  namespace MemAlloc {
+
+  /** \brief Allocation of storage of matrices and vectors (MemRep)
+   *
+   * Policy of the process:
+   *
+   *  - standard : blocks are taken from the heap (operator new)
+   *  - aligned  : blocks are aligned to 64 bytes (cache line)
+   *  - pool     : blocks are aligned to 64 bytes and allocated in the
+   *               MemPool activated in the calling thread by MemArena;
+   *               blocks released to the pool are reused by later
+   *               allocations of the same size class, allocations
+   *               without an active arena are aligned
+   *
+   * Each block is preceded by a small header describing how it was
+   * allocated, a block can be released in any thread, after the
+   * policy was changed or after its pool was destroyed.
+   */
+
+  enum class Policy { standard, aligned, pool };
+
+  inline std::atomic<int>& policy_()
+  {
+    static std::atomic<int> policy {int(Policy::standard)};
+    return policy;
+  }
+
+  inline void   set_policy(Policy p) { policy_().store(int(p)); }
+  inline Policy policy()             { return Policy(policy_().load()); }
+
+
+  /** Allocation statistics of the process */
+
+  struct Stats {
+    long long allocations      {0};   ///< blocks requested
+    long long bytes            {0};   ///< bytes requested
+    long long heap_allocations {0};   ///< blocks taken from the heap
+    long long heap_bytes       {0};   ///< bytes taken from the heap
+    long long pool_reuses      {0};   ///< blocks reused from a pool
+    long long in_use           {0};   ///< bytes of blocks in use
+  };
+
+  /* Counters are kept by each thread and written only by the thread,
+   * stats() sums counters of all threads. Counters of finished threads
+   * are added to the retired counters of the process. */
+
+  struct Counters {
+    std::atomic<long long> allocations      {0};
+    std::atomic<long long> bytes            {0};
+    std::atomic<long long> heap_allocations {0};
+    std::atomic<long long> heap_bytes       {0};
+    std::atomic<long long> pool_reuses      {0};
+    std::atomic<long long> in_use           {0};
+
+    static void add(std::atomic<long long>& c, long long n)
+    {
+      c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void add_to(Stats& s) const
+    {
+      s.allocations      += allocations.load(std::memory_order_relaxed);
+      s.bytes            += bytes.load(std::memory_order_relaxed);
+      s.heap_allocations += heap_allocations.load(std::memory_order_relaxed);
+      s.heap_bytes       += heap_bytes.load(std::memory_order_relaxed);
+      s.pool_reuses      += pool_reuses.load(std::memory_order_relaxed);
+      s.in_use           += in_use.load(std::memory_order_relaxed);
+    }
+  };
+
+  struct Registry {
+    std::mutex             mutex;
+    std::vector<Counters*> threads;
+    Stats                  retired;
+    Stats                  base;      // subtracted by reset_stats()
+  };
+
+  inline Registry& registry()
+  {
+    static Registry* r = new Registry;   // blocks may be released in
+    return *r;                           // static destructors
+  }
+
+  inline Counters*& thread_counters_()
+  {
+    static thread_local Counters* c = nullptr;
+    return c;
+  }
+
+  struct Retire {
+    ~Retire()
+    {
+      Counters*& c = thread_counters_();
+      Registry& r = registry();
+      {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        c->add_to(r.retired);
+        r.threads.erase(std::find(r.threads.begin(), r.threads.end(), c));
+      }
+      delete c;
+      c = nullptr;
+    }
+  };
+
+  /** Counters of the calling thread */
+  inline Counters& counters()
+  {
+    Counters*& c = thread_counters_();
+    if (c == nullptr)
+      {
+        c = new Counters;
+        Registry& r = registry();
+        {
+          std::lock_guard<std::mutex> lock(r.mutex);
+          r.threads.push_back(c);
+        }
+        static thread_local Retire retire;   // not again after the thread
+      }                                      // local destructors
+    return *c;
+  }
+
+  inline Stats stats()
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Stats s = r.retired;
+    for (const Counters* c : r.threads) c->add_to(s);
+    s.allocations      -= r.base.allocations;
+    s.bytes            -= r.base.bytes;
+    s.heap_allocations -= r.base.heap_allocations;
+    s.heap_bytes       -= r.base.heap_bytes;
+    s.pool_reuses      -= r.base.pool_reuses;
+    return s;
+  }
+
+  /** Resets all counters except of bytes in use */
+  inline void reset_stats()
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Stats s = r.retired;
+    for (const Counters* c : r.threads) c->add_to(s);
+    r.base = s;
+  }
+
+  /** Blocks and bytes taken from the heap, counter of allocations
+   *  for GNU_gama::Profile (set_allocation_counter()) */
+  inline void heap_counter(long long& blocks, long long& bytes)
+  {
+    const Stats s = stats();
+    blocks = s.heap_allocations;
+    bytes  = s.heap_bytes;
+  }
+
+
+  const std::size_t alignment = 64;   // aligned and pool blocks
+  const std::size_t header    = 32;   // header before standard blocks
+  const int         classes   = 19;   // pool size classes 64 B ... 16 MB
+
+  struct PoolCore;
+
+  struct Header {
+    PoolCore*     pool;    // owning pool or nullptr
+    Header*       next;    // free list of a pool
+    std::size_t   bytes;   // requested size
+    std::uint32_t kind;    // Policy of the allocation
+    std::uint32_t cls;     // size class of pool blocks
+  };
+
+  static_assert(sizeof(Header) <= header, "MemAlloc::Header");
+
+  inline Header* header_of(void* p)
+  {
+    return reinterpret_cast<Header*>(static_cast<char*>(p) - sizeof(Header));
+  }
+
+  inline void* block_of(Header* h)
+  {
+    return reinterpret_cast<char*>(h) + sizeof(Header);
+  }
+
+
+  /* blocks from the heap */
+
+  inline void* heap_allocate(std::size_t bytes, Policy kind)
+  {
+    Counters& c = counters();
+    char* raw;
+    char* p;
+    if (kind == Policy::standard)
+      {
+        raw = static_cast<char*>(::operator new(bytes + header));
+        p   = raw + header;
+      }
+    else
+      {
+        raw = static_cast<char*>(::operator new(bytes + alignment,
+                                                std::align_val_t(alignment)));
+        p   = raw + alignment;
+      }
+    Counters::add(c.heap_allocations, 1);
+    Counters::add(c.heap_bytes, bytes);
+
+    Header* h = header_of(p);
+    h->pool  = nullptr;
+    h->next  = nullptr;
+    h->bytes = bytes;
+    h->kind  = std::uint32_t(kind);
+    h->cls   = 0;
+    return p;
+  }
+
+  inline void heap_release(void* p)
+  {
+    Header* h = header_of(p);
+    if (Policy(h->kind) == Policy::standard)
+      ::operator delete(static_cast<char*>(p) - header);
+    else
+      ::operator delete(static_cast<char*>(p) - alignment,
+                        std::align_val_t(alignment));
+  }
+
+
+  /* Blocks of a pool are held in free lists of size classes. A pool
+   * is owned by the thread of its active arenas, only the owner
+   * allocates from the pool and its free lists are not locked; blocks
+   * released in other threads are pushed to lock-free lists, which the
+   * owner takes over when its own list of the class is empty. The core
+   * of a pool lives until the pool and all its blocks in use are
+   * released; blocks released after the pool was destroyed return to
+   * the heap. */
+
+  struct PoolCore {
+    std::atomic<std::thread::id> owner {std::thread::id()};
+    int                    arenas {0};         // active arenas of the owner
+    Header*                local  [classes] {}; // free blocks of the owner
+    std::atomic<Header*>   remote [classes] {}; // released in other threads
+    std::atomic<long long> cached {0};         // bytes in free lists
+    std::atomic<long long> refs   {1};         // the pool and blocks in use
+    std::atomic<bool>      closed {false};
+
+    ~PoolCore() { clear(true); }
+
+    static int size_class(std::size_t bytes)
+    {
+      int c = 0;
+      while (c < classes && (alignment << c) < bytes) c++;
+      return c;
+    }
+
+    /* the calling thread becomes the owner unless the pool is owned
+     * by another thread */
+    bool enter()
+    {
+      const std::thread::id self = std::this_thread::get_id();
+      std::thread::id none;
+      if (owner.load(std::memory_order_relaxed) != self &&
+          !owner.compare_exchange_strong(none, self, std::memory_order_acquire))
+        return false;
+
+      arenas++;
+      return true;
+    }
+
+    void leave()
+    {
+      if (--arenas == 0) owner.store(std::thread::id(), std::memory_order_release);
+    }
+
+    /* called by the owner only */
+    void* allocate(std::size_t bytes)
+    {
+      const int c = size_class(bytes);
+      if (c == classes) return heap_allocate(bytes, Policy::aligned);
+
+      refs.fetch_add(1, std::memory_order_relaxed);
+      Header* h = local[c];
+      if (h == nullptr) h = remote[c].exchange(nullptr, std::memory_order_acquire);
+
+      void* p;
+      if (h)
+        {
+          local[c] = h->next;
+          cached.fetch_sub((long long)(alignment << c), std::memory_order_relaxed);
+          Counters::add(counters().pool_reuses, 1);
+          p = block_of(h);
+        }
+      else
+        p = heap_allocate(alignment << c, Policy::pool);
+
+      h = header_of(p);
+      h->pool  = this;
+      h->next  = nullptr;
+      h->bytes = bytes;
+      h->kind  = std::uint32_t(Policy::pool);
+      h->cls   = std::uint32_t(c);
+      return p;
+    }
+
+    void release(void* p)
+    {
+      Header* h = header_of(p);
+      const int c = int(h->cls);
+      if (closed.load(std::memory_order_acquire))
+        heap_release(p);
+      else
+        {
+          cached.fetch_add((long long)(alignment << c), std::memory_order_relaxed);
+          if (owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+            {
+              h->next  = local[c];
+              local[c] = h;
+            }
+          else
+            {
+              h->next = remote[c].load(std::memory_order_relaxed);
+              while (!remote[c].compare_exchange_weak(h->next, h,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed)) {}
+            }
+        }
+      if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+
+    /* free lists of the owner are cleared only if the caller can
+     * enter the pool, an arena of another thread cannot take over the
+     * pool until the lists are cleared */
+    void clear(bool all = false)
+    {
+      const bool owned = all || enter();
+      for (int c=0; c<classes; c++)
+        {
+          Header* h = remote[c].exchange(nullptr, std::memory_order_acquire);
+          if (owned)
+            {
+              Header* t = local[c];
+              local[c] = nullptr;
+              if (h == nullptr) h = t;
+              else
+                {
+                  Header* e = h;
+                  while (e->next) e = e->next;
+                  e->next = t;
+                }
+            }
+          while (h)
+            {
+              Header* n = h->next;
+              cached.fetch_sub((long long)(alignment << c), std::memory_order_relaxed);
+              heap_release(block_of(h));
+              h = n;
+            }
+        }
+      if (owned && !all) leave();
+    }
+
+    void close()
+    {
+      closed.store(true, std::memory_order_release);
+      clear();
+      if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+  };
+
+
+  /** Pool of the calling thread activated by MemArena */
+  inline PoolCore*& active_pool()
+  {
+    static thread_local PoolCore* pool = nullptr;
+    return pool;
+  }
+
+
+  /** Storage of n objects of type T; objects are default initialised
+   *  as by new T[n]. */
+  template <typename T>
+  T* allocate(std::size_t n)
+  {
+    if (n == 0) return nullptr;
+
+    const std::size_t bytes = n*sizeof(T);
+    Counters& c = counters();
+    Counters::add(c.allocations, 1);
+    Counters::add(c.bytes, bytes);
+    Counters::add(c.in_use, bytes);
+
+    const Policy policy = MemAlloc::policy();
+    void* p;
+    if (policy == Policy::pool && active_pool())
+      p = active_pool()->allocate(bytes);
+    else
+      p = heap_allocate(bytes, policy == Policy::standard ? Policy::standard
+                                                          : Policy::aligned);
+
+    T* t = static_cast<T*>(p);
+    std::uninitialized_default_construct_n(t, n);
+    return t;
+  }
+
+  /** Releases storage returned by allocate<T>(n) */
+  template <typename T>
+  void deallocate(T* t, std::size_t n)
+  {
+    if (t == nullptr) return;
+
+    std::destroy_n(t, n);
+    Header* h = header_of(t);
+    Counters::add(counters().in_use, -(long long)h->bytes);
+    if (h->pool)
+      h->pool->release(t);
+    else
+      heap_release(t);
+  }
+
+  }  // namespace MemAlloc
+
+
+  /** \brief Pool of matrix and vector storage
+   *
+   * Blocks released by matrices and vectors allocated while the pool
+   * is active (MemArena) are kept in the pool and reused, typically
+   * by repeated temporaries of one adjustment. Cached blocks are
+   * returned to the heap by release() or when the pool is destroyed;
+   * blocks still in use may outlive the pool.
+   */
+
+  class MemPool {
+  public:
+
+    MemPool() : core_(new MemAlloc::PoolCore) {}
+    ~MemPool() { core_->close(); }
+
+    MemPool(const MemPool&) = delete;
+    MemPool& operator=(const MemPool&) = delete;
+
+    /** Returns cached blocks to the heap; blocks cached by an arena
+     *  active in another thread are kept, an arena constructed in
+     *  another thread while the blocks are released does nothing */
+    void release() { core_->clear(); }
+
+    /** Bytes of cached blocks */
+    long long cached_bytes() const { return core_->cached.load(); }
+
+  private:
+
+    friend class MemArena;
+    MemAlloc::PoolCore* core_;
+  };
+
+
+  /** \brief Activates a pool in the calling thread
+   *
+   * The pool is active from construction to destruction of the arena
+   * if the policy of the process is MemAlloc::Policy::pool, otherwise
+   * the arena does nothing. Arenas can be nested. A pool is active in
+   * one thread at a time, an arena of a pool active in another thread
+   * does nothing.
+   */
+
+  class MemArena {
+  public:
+
+    explicit MemArena(MemPool& pool)
+      : previous_(MemAlloc::active_pool()), pool_(nullptr)
+    {
+      if (MemAlloc::policy() == MemAlloc::Policy::pool && pool.core_->enter())
+        {
+          pool_ = pool.core_;
+          MemAlloc::active_pool() = pool_;
+        }
+    }
+    ~MemArena()
+    {
+      if (pool_) pool_->leave();
+      MemAlloc::active_pool() = previous_;
+    }
+
+    MemArena(const MemArena&) = delete;
+    MemArena& operator=(const MemArena&) = delete;
+
+  private:
+
+    MemAlloc::PoolCore* previous_;
+    MemAlloc::PoolCore* pool_;
+  };
+
+}   // namespace GNU_gama
+
+#endif
@@ -23,10 +23,14 @@
 #define GNU_gama_gMatVec_MemRep_h
 
 #include "inderr.h"
+#include "memalloc.h"
 #include <cstring>
 
 namespace GNU_gama {   /** \brief Memory repository for matvec objects */
 
+  /* storage is allocated by MemAlloc according to the allocation
+   * policy of the process (memalloc.h) */
+
   template <typename Float=double,
             typename Index=int,
             typename Exc=Exception::matvec>
@@ -53,7 +57,7 @@ namespace GNU_gama {   /** \brief Memory repository for matvec objects */
       if (nsz > 0)
         {
           sz  = nsz;
-          rep = new Float[sz];
+          rep = MemAlloc::allocate<Float>(sz);
         }
       else if (nsz == 0)
         {
@@ -68,8 +72,8 @@ namespace GNU_gama {   /** \brief Memory repository for matvec objects */
 
     MemRep(const MemRep& x)
     {
-      sz = x.sz; rep = new Float[sz];
-      std::memcpy(rep, x.rep, sz*sizeof(Float));
+      sz = x.sz; rep = MemAlloc::allocate<Float>(sz);
+      if (sz > 0) std::memcpy(rep, x.rep, sz*sizeof(Float));
     }
 
     MemRep(MemRep&& x) noexcept
@@ -87,10 +91,11 @@ namespace GNU_gama {   /** \brief Memory repository for matvec objects */
         return *this;
       }
 
+      MemAlloc::deallocate(rep, sz);
       sz = x.sz;
       if (sz > 0)
         {
-          rep = new Float[sz];
+          rep = MemAlloc::allocate<Float>(sz);
           std::memcpy(rep, x.rep, sz*sizeof(Float));
         }
       else
@@ -101,30 +106,37 @@ namespace GNU_gama {   /** \brief Memory repository for matvec objects */
       return *this;
     }
 
+    /* storage of the destination is reused if it has the same size,
+     * its elements remain at the same addresses as with the copy
+     * assignment; x keeps its storage */
+
     MemRep& operator = (MemRep&& x) noexcept
     {
-      if (&x != this)
-        {
-          if (rep != nullptr) delete[] rep;
+      if (&x == this) return *this;
 
-          sz = x.sz;  rep = x.rep;
-          x.sz = 0;   x.rep = nullptr;
-        }
+      if (sz == x.sz) {
+        if (sz > 0) std::memcpy(rep, x.rep, sz*sizeof(Float));
+        return *this;
+      }
+
+      MemAlloc::deallocate(rep, sz);
+      sz = x.sz;  rep = x.rep;
+      x.sz = 0;   x.rep = nullptr;
 
       return *this;
     }
 
-    ~MemRep() { delete[] rep; }
+    ~MemRep() { MemAlloc::deallocate(rep, sz); }
 
     void resize(Index nsz)
     {
       if (nsz == sz) return;
 
+      MemAlloc::deallocate(rep, sz);
       sz = nsz;
-      delete[] rep;
 
       if (sz > 0)
-        rep = new Float[sz];
+        rep = MemAlloc::allocate<Float>(sz);
       else
         rep = nullptr;
     }
@@ -27,6 +27,8 @@
 #include "smatrix_graph.h"
 
 #include <vector>
+#include <memory>
+#include <algorithm>
 
 namespace GNU_gama {
 
@@ -296,6 +298,465 @@ namespace GNU_gama {
     }
   };
 
+
+  /** \brief Approximate minimum degree ordering
+   *
+   * Minimum degree ordering computed on the quotient graph, where each
+   * eliminated node becomes an element representing the clique of its
+   * neighbours. Instead of exact external degrees only their upper
+   * bounds are updated after each elimination, elements whose variables
+   * are all adjacent to the new element are absorbed by it.
+   */
+
+  template <typename Index=int>
+  class ApproximateMinimumDegree : public SparseMatrixOrdering<Index>
+  {
+  public:
+
+    ApproximateMinimumDegree()
+    {
+    }
+    ApproximateMinimumDegree(const Adjacency<Index>* graph)
+    {
+      this->reset(graph);
+    }
+
+  private:
+
+    enum Status { variable, element, absorbed };
+
+    void algorithm(const Adjacency<Index>* graph)
+    {
+      const Index N = graph->nodes();
+
+      std::vector<std::vector<Index>> A(N+1);   // adjacent variables
+      std::vector<std::vector<Index>> E(N+1);   // adjacent elements
+      std::vector<std::vector<Index>> L(N+1);   // variables of elements
+      std::vector<Status> status(N+1, variable);
+      std::vector<Index>  degree(N+1, 0), w(N+1, 0), wmark(N+1, 0);
+      std::vector<Index>  mark(N+1, 0), head(N+1, 0), next(N+1, 0),
+                          prev(N+1, 0);
+
+      auto insert = [&](Index i)
+        {
+          const Index d = degree[i];
+          prev[i] = 0;
+          next[i] = head[d];
+          if (head[d]) prev[head[d]] = i;
+          head[d] = i;
+        };
+      auto remove = [&](Index i)
+        {
+          if (prev[i]) next[prev[i]] = next[i];
+          else         head[degree[i]] = next[i];
+          if (next[i]) prev[next[i]] = prev[i];
+        };
+
+      for (Index i=1; i<=N; i++)
+        {
+          typename Adjacency<Index>::const_iterator b=graph->begin(i);
+          typename Adjacency<Index>::const_iterator e=graph->end  (i);
+          while (b != e)
+            {
+              const Index j = *b++;
+              if (j != i) A[i].push_back(j);
+            }
+          degree[i] = Index(A[i].size());
+        }
+      for (Index i=N; i>=1; i--) insert(i);
+
+      Index mindeg = 0, tag = 0;
+      std::vector<Index> Lp, tmp;
+      for (Index k=1; k<=N; k++)
+        {
+          while (head[mindeg] == 0) mindeg++;
+          const Index p = head[mindeg];
+          remove(p);
+          this->perm(k) = p;
+          status[p] = element;
+
+          // variables of the new element p
+
+          const Index inLp = ++tag;
+          mark[p] = inLp;
+          Lp.clear();
+          for (Index e : E[p])
+            if (status[e] == element)
+              {
+                for (Index i : L[e])
+                  if (status[i] == variable && mark[i] != inLp)
+                    {
+                      mark[i] = inLp;
+                      Lp.push_back(i);
+                    }
+                status[e] = absorbed;
+                std::vector<Index>().swap(L[e]);
+              }
+          for (Index i : A[p])
+            if (status[i] == variable && mark[i] != inLp)
+              {
+                mark[i] = inLp;
+                Lp.push_back(i);
+              }
+          std::vector<Index>().swap(A[p]);
+          std::vector<Index>().swap(E[p]);
+
+          // w(e) = |Le \ Lp| for all elements adjacent to Lp
+
+          const Index wtag = ++tag;
+          for (Index i : Lp)
+            for (Index e : E[i])
+              if (status[e] == element)
+                {
+                  if (wmark[e] != wtag)
+                    {
+                      wmark[e] = wtag;
+                      w[e] = Index(L[e].size());
+                    }
+                  w[e]--;
+                }
+
+          // update of adjacency lists and approximate degrees
+
+          const Index lp = Index(Lp.size()) - 1;
+          for (Index i : Lp)
+            {
+              remove(i);
+
+              Index ext = 0;
+              tmp.clear();
+              for (Index e : E[i])
+                if (status[e] == element)
+                  {
+                    if (w[e] == 0)
+                      {
+                        status[e] = absorbed;     // aggressive absorption
+                        std::vector<Index>().swap(L[e]);
+                      }
+                    else
+                      {
+                        tmp.push_back(e);
+                        ext += w[e];
+                      }
+                  }
+              tmp.push_back(p);
+              E[i].swap(tmp);
+
+              tmp.clear();
+              for (Index j : A[i])
+                if (status[j] == variable && mark[j] != inLp)
+                  tmp.push_back(j);
+              A[i].swap(tmp);
+
+              Index d = std::min(N - k - 1, degree[i] + lp);
+              d = std::min(d, Index(A[i].size()) + lp + ext);
+              degree[i] = d;
+              insert(i);
+              if (d < mindeg) mindeg = d;
+            }
+
+          L[p].swap(Lp);
+        }
+    }
+  };
+
+
+  /** \brief Nested dissection ordering
+   *
+   * The graph is recursively split by vertex separators taken from the
+   * middle level of a rooted level structure of a pseudo-peripheral
+   * node. Separators are numbered after both parts, subgraphs smaller
+   * than the given leaf size are numbered in the order of their level
+   * structure.
+   */
+
+  template <typename Index=int>
+  class NestedDissection : public SparseMatrixOrdering<Index>
+  {
+  public:
+
+    NestedDissection(Index leaf_size = 8) : leaf(leaf_size)
+    {
+    }
+    NestedDissection(const Adjacency<Index>* graph, Index leaf_size = 8)
+      : leaf(leaf_size)
+    {
+      this->reset(graph);
+    }
+
+  private:
+
+    Index leaf;
+
+    std::vector<Index> part, level, visited, order, xlevel;
+    Index              stamp {0};
+
+    // breadth first search within the subgraph with the given label,
+    // returns the number of levels
+
+    Index bfs(const Adjacency<Index>* graph, Index root, Index label)
+    {
+      ++stamp;
+      order.clear();
+      xlevel.clear();
+      order.push_back(root);
+      visited[root] = stamp;
+      level[root] = 0;
+      xlevel.push_back(0);
+
+      for (std::size_t i=0; i<order.size(); i++)
+        {
+          const Index x = order[i];
+          if (level[x] == Index(xlevel.size()))
+            xlevel.push_back(Index(i));
+
+          typename Adjacency<Index>::const_iterator b=graph->begin(x);
+          typename Adjacency<Index>::const_iterator e=graph->end  (x);
+          while (b != e)
+            {
+              const Index n = *b++;
+              if (part[n] == label && visited[n] != stamp)
+                {
+                  visited[n] = stamp;
+                  level[n] = level[x] + 1;
+                  order.push_back(n);
+                }
+            }
+        }
+      xlevel.push_back(Index(order.size()));
+
+      return Index(xlevel.size()) - 1;
+    }
+
+    void algorithm(const Adjacency<Index>* graph)
+    {
+      const Index N = graph->nodes();
+      if (N == 0) return;
+
+      part.assign(N+1, 1);
+      level.assign(N+1, 0);
+      visited.assign(N+1, 0);
+      stamp = 0;
+
+      typedef std::pair<Index, std::vector<Index>> Subgraph;  // first index
+      std::vector<Subgraph> stack;
+      Index labels = 1;
+
+      stack.push_back(Subgraph(1, std::vector<Index>()));
+      for (Index i=1; i<=N; i++) stack.back().second.push_back(i);
+
+      while (!stack.empty())
+        {
+          const Index lo = stack.back().first;
+          std::vector<Index> nodes;
+          nodes.swap(stack.back().second);
+          stack.pop_back();
+
+          const Index n = Index(nodes.size());
+          const Index label = part[nodes[0]];
+          Index levels = bfs(graph, nodes[0], label);
+
+          if (Index(order.size()) < n)       // disconnected subgraph
+            {
+              Index first = lo;
+              for (Index x : nodes)
+                if (part[x] == label)
+                  {
+                    bfs(graph, x, label);
+                    const Index cl = ++labels;
+                    for (Index y : order) part[y] = cl;
+
+                    stack.push_back(Subgraph(first, order));
+                    first += Index(order.size());
+                  }
+              continue;
+            }
+
+          // pseudo-peripheral node of the subgraph
+
+          for (;;)
+            {
+              Index r = order[xlevel[levels-1]];
+              for (Index i=xlevel[levels-1]; i<xlevel[levels]; i++)
+                if (graph->degree(order[i]) < graph->degree(r))
+                  r = order[i];
+
+              const Index prev = levels;
+              std::vector<Index> po(order), px(xlevel);
+              levels = bfs(graph, r, label);
+              if (levels <= prev)
+                {
+                  order.swap(po);
+                  xlevel.swap(px);
+                  levels = prev;
+                  for (Index l=0; l<levels; l++)
+                    for (Index i=xlevel[l]; i<xlevel[l+1]; i++)
+                      level[order[i]] = l;
+                  break;
+                }
+            }
+
+          if (n <= leaf || levels < 3)
+            {
+              for (Index i=0; i<n; i++)
+                {
+                  this->perm(lo + i) = order[i];
+                  part[order[i]] = 0;
+                }
+              continue;
+            }
+
+          // separator from the middle level, only nodes adjacent to the
+          // upper part are needed
+
+          Index m = 1;
+          while (m < levels-2 && xlevel[m+1] < n/2) m++;
+
+          std::vector<Index> lower, upper, sep;
+          for (Index i=0; i<xlevel[m]; i++) lower.push_back(order[i]);
+          for (Index i=xlevel[m+1]; i<n; i++) upper.push_back(order[i]);
+          for (Index i=xlevel[m]; i<xlevel[m+1]; i++)
+            {
+              const Index x = order[i];
+              bool separates = false;
+              typename Adjacency<Index>::const_iterator b=graph->begin(x);
+              typename Adjacency<Index>::const_iterator e=graph->end  (x);
+              while (b != e && !separates)
+                {
+                  const Index t = *b++;
+                  separates = part[t] == label && level[t] == m+1;
+                }
+              if (separates) sep.push_back(x);
+              else           lower.push_back(x);
+            }
+
+          const Index hi = lo + n - 1;
+          for (Index i=0; i<Index(sep.size()); i++)
+            {
+              this->perm(hi - Index(sep.size()) + 1 + i) = sep[i];
+              part[sep[i]] = 0;
+            }
+
+          const Index cl = ++labels;
+          const Index cu = ++labels;
+          for (Index x : lower) part[x] = cl;
+          for (Index x : upper) part[x] = cu;
+
+          const Index nl = Index(lower.size());
+          if (nl) stack.push_back(Subgraph(lo, lower));
+          if (!upper.empty()) stack.push_back(Subgraph(lo + nl, upper));
+        }
+    }
+  };
+
+
+  /** \brief Sparse matrix orderings available in adjustment classes */
+
+  enum class SparseOrdering { rcm, amd, nd };
+
+
+  template <typename Index=int>
+  std::unique_ptr<SparseMatrixOrdering<Index>> make_ordering(SparseOrdering ord)
+  {
+    switch (ord)
+      {
+      case SparseOrdering::amd:
+        return std::unique_ptr<SparseMatrixOrdering<Index>>
+          (new ApproximateMinimumDegree<Index>);
+      case SparseOrdering::nd:
+        return std::unique_ptr<SparseMatrixOrdering<Index>>
+          (new NestedDissection<Index>);
+      case SparseOrdering::rcm:
+      default:
+        return std::unique_ptr<SparseMatrixOrdering<Index>>
+          (new ReverseCuthillMcKee<Index>);
+      }
+  }
+
+
+  /** \brief Predicted fill and operation count of LDL' decomposition
+   *
+   * Column counts of the factor L are computed from the elimination
+   * tree of the permuted graph without numerical factorization. The
+   * number of operations is the number of multiplications and
+   * divisions. For comparison with the envelope decomposition the same
+   * statistics are computed for the envelope of L.
+   */
+
+  template <typename Index=int>
+  class FactorStatistics
+  {
+  public:
+
+    FactorStatistics()
+    {
+    }
+    FactorStatistics(const Adjacency<Index>* graph,
+                     const SparseMatrixOrdering<Index>* ordering)
+    {
+      reset(graph, ordering);
+    }
+
+    void reset(const Adjacency<Index>* graph,
+               const SparseMatrixOrdering<Index>* ordering)
+    {
+      const Index N = ordering->nodes();
+      std::vector<Index> parent(N+1, 0), mark(N+1, 0);
+      std::vector<Index> count(N+1, 1), first(N+2, 0);
+
+      for (Index k=1; k<=N; k++)
+        {
+          Index f = k;
+          typename Adjacency<Index>::const_iterator b=graph->begin(ordering->perm(k));
+          typename Adjacency<Index>::const_iterator e=graph->end  (ordering->perm(k));
+          for (; b != e; ++b)
+            {
+              Index r = ordering->invp(*b);
+              if (r >= k) continue;
+              if (r < f) f = r;
+
+              // row subtree of k in the elimination tree
+
+              for (Index j=r; j<k && mark[j] != k; j=parent[j])
+                {
+                  mark[j] = k;
+                  count[j]++;
+                  if (parent[j] == 0) parent[j] = k;
+                }
+            }
+          first[f]++;    // envelope of row k starts in column f
+          first[k]--;
+        }
+
+      nonzeroes_ = flops_ = env_nonzeroes_ = env_flops_ = 0;
+      Index env = 0;
+      for (Index j=1; j<=N; j++)
+        {
+          const double c = count[j];
+          nonzeroes_ += c;
+          flops_     += (c - 1)*(c + 2)/2;
+
+          env += first[j];            // rows below j within envelope
+          const double ce = 1 + env;
+          env_nonzeroes_ += ce;
+          env_flops_     += (ce - 1)*(ce + 2)/2;
+        }
+    }
+
+    /** elements of the sparse factor L including diagonal */
+    double nonzeroes() const { return nonzeroes_; }
+    /** operations of the sparse LDL' decomposition */
+    double flops()     const { return flops_; }
+    /** elements of the envelope of L including diagonal */
+    double envelope_nonzeroes() const { return env_nonzeroes_; }
+    /** operations of the envelope LDL' decomposition */
+    double envelope_flops()     const { return env_flops_; }
+
+  private:
+
+    double nonzeroes_ {0}, flops_ {0}, env_nonzeroes_ {0}, env_flops_ {0};
+  };
+
 }
 
 #endif
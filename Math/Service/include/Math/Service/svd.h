@@ -22,7 +22,13 @@
 #define GNU_gama_gMatVec_MatSVD_h
 
 #include "matvec.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 
 namespace GNU_gama {
@@ -84,8 +90,44 @@ namespace GNU_gama {
       >    s2 = s1 + ABS(f);
       >    if (s1 == s2) goto test_for_convergence;
 
+      -----------------------------------------------------------------------
+
+      SVDMethod::jacobi
+      -----------------
+
+      One-sided Jacobi method (Hestenes 1958): columns of A are
+      orthogonalized by plane rotations applied from the right,
+      A*V = U*W, V is the product of the rotations. Matrices with
+      m >= n are preconditioned by two QR decompositions, A*P = Q1*R
+      with column pivoting and trans(R) = Q2*R2, and the rotations are
+      applied to the n x n matrix trans(R2) (Drmac and Veselic, New
+      fast and accurate Jacobi SVD algorithm I, SIAM J. Matrix Anal.
+      Appl. 29, 2008). In each sweep all pairs of blocks of columns are
+      visited in the round-robin order, pairs of blocks of a round are
+      rotated by worker threads. Each rotation is computed by the same
+      operations for any number of threads, results do not depend on
+      the number of threads. Sweeps are repeated until no pair of
+      columns with |g_p'g_q| > rows*eps*|g_p||g_q| is left (Demmel and
+      Veselic, Jacobi's method is more accurate than QR, SIAM J. Matrix
+      Anal. Appl. 13, 1992).
+
       ----------------------------------------------------------------------- */
 
+  /** SVD algorithm */
+  enum class SVDMethod { golub_reinsch, jacobi };
+
+  /** Minimal m*n*n of the Jacobi method running on more than one
+   *  thread, implicitly 1e6; 0 runs matrices of any size on all
+   *  threads() threads (tests of small networks). */
+  inline std::atomic<double>& svd_parallel_work_()
+  {
+    static std::atomic<double> work {1e6};
+    return work;
+  }
+
+  inline void   set_svd_parallel_work(double w) { svd_parallel_work_().store(w); }
+  inline double svd_parallel_work() { return svd_parallel_work_().load(); }
+
   template <typename Float=double,
             typename Index=int,
             typename Exc=Exception::matvec>
@@ -112,6 +154,15 @@ namespace GNU_gama {
     Float tol(Float t) { W_tol = t; set_inv_W(); return W_tol; }
 
     SVD& decompose() { svd(); return *this; }
+
+    /** Golub-Reinsch (implicit) or one-sided Jacobi decomposition */
+    void      set_method(SVDMethod m) { method_ = m; decomposed = 0; }
+    SVDMethod method() const { return method_; }
+
+    /** Number of threads of the Jacobi method; 0 stands for all
+     *  hardware threads. */
+    void  set_threads(Index t) { threads_ = t; }
+    Index threads() const { return threads_; }
     SVD& reset(const Mat<Float, Index, Exc>& A);
     SVD& reset(const Mat<Float, Index, Exc>& A,
                const Vec<Float, Index, Exc>& w);
@@ -146,6 +197,11 @@ namespace GNU_gama {
 
     Index decomposed;
     void svd();
+    void golub_reinsch();
+    void jacobi();
+
+    SVDMethod method_ {SVDMethod::golub_reinsch};
+    Index     threads_ {1};
 
     volatile Float W_tol;
     Vec<Float, Index, Exc> inv_W_;
@@ -231,6 +287,26 @@ namespace GNU_gama {
     if (decomposed)
       return;
 
+    reset_UWV();
+    if (method_ == SVDMethod::jacobi)
+      jacobi();
+    else
+      golub_reinsch();
+
+    decomposed = 1;
+    set_inv_W();
+    if (defect > 0)
+      {
+        minV = V_;
+        if (minx == subset) min_subset_x();
+      }
+
+  }      /* void SVD<Float, Index, Exc>::svd() */
+
+
+  template <typename Float, typename Index, typename Exc>
+  void SVD<Float, Index, Exc>::golub_reinsch()
+  {
     const Float ZERO = 0;
     const Float ONE  = 1;
     const Float TWO  = 2;
@@ -241,7 +317,6 @@ namespace GNU_gama {
     volatile Float  tmp1;
     Index  mn;
 
-    reset_UWV();
     Vec<Float, Index, Exc> rv1_(n);
     Float* rv1 = rv1_.begin() - 1;
 
@@ -471,15 +546,353 @@ namespace GNU_gama {
 
       }   // for k
 
-    decomposed = 1;
-    set_inv_W();
-    if (defect > 0)
+  }      /* void SVD<Float, Index, Exc>::golub_reinsch() */
+
+
+  template <typename Float, typename Index, typename Exc>
+  void SVD<Float, Index, Exc>::jacobi()
+  {
+    // columns of A and V are stored as contiguous rows of A_ and H
+
+    std::vector<Float> A_(std::size_t(n)*m), H(std::size_t(n)*n, Float());
+    std::vector<Float> norm(n);          // squared norms of columns of G
+
+    for (Index i=0; i<m; i++)
+      for (Index j=0; j<n; j++)
+        A_[std::size_t(j)*m + i] = U[i+1][j+1];
+    for (Index j=0; j<n; j++)
+      H[std::size_t(j)*n + j] = 1;
+
+    // four partial sums, independent additions can be pipelined
+    auto dot = [](const Float* a, const Float* b, Index k)
       {
-        minV = V_;
-        if (minx == subset) min_subset_x();
+        Float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        Index i = 0;
+        for (; i+3<k; i+=4)
+          {
+            s0 += a[i  ]*b[i  ];
+            s1 += a[i+1]*b[i+1];
+            s2 += a[i+2]*b[i+2];
+            s3 += a[i+3]*b[i+3];
+          }
+        for (; i<k; i++) s0 += a[i]*b[i];
+        return (s0 + s1) + (s2 + s3);
+      };
+
+    /* Householder QR decomposition of the rows x cols matrix a (rows
+     * >= cols) with optional column pivoting. Reflectors I - beta*v*v'
+     * remain in the columns of a, the upper triangular matrix is
+     * stored by columns to r (cols x cols). */
+    auto qr = [&dot](std::vector<Float>& a, Index rows, Index cols,
+                     std::vector<Float>& beta, std::vector<Float>& r,
+                     std::vector<Index>* perm)
+      {
+        const Float limit = std::sqrt(std::numeric_limits<Float>::epsilon());
+        std::vector<Float> pn(cols), ref(cols);   // partial norms
+        for (Index j=0; perm && j<cols; j++)
+          {
+            const Float* x = &a[std::size_t(j)*rows];
+            pn[j] = ref[j] = std::sqrt(dot(x, x, rows));
+          }
+
+        beta.assign(cols, Float());
+        r.assign(std::size_t(cols)*cols, Float());
+        for (Index k=0; k<cols; k++)
+          {
+            const Index p = perm ? Index(std::max_element(pn.begin()+k,
+                                                          pn.end())
+                                         - pn.begin()) : k;
+            if (p != k)
+              {
+                std::swap_ranges(a.begin() + std::size_t(k)*rows,
+                                 a.begin() + std::size_t(k+1)*rows,
+                                 a.begin() + std::size_t(p)*rows);
+                std::swap_ranges(r.begin() + std::size_t(k)*cols,
+                                 r.begin() + std::size_t(k)*cols + k,
+                                 r.begin() + std::size_t(p)*cols);
+                std::swap(pn[k],  pn[p]);
+                std::swap(ref[k], ref[p]);
+                std::swap((*perm)[k], (*perm)[p]);
+              }
+
+            Float* v = &a[std::size_t(k)*rows + k];
+            const Index L = rows - k;
+            const Float normx = std::sqrt(dot(v, v, L));
+            Float alpha = 0;
+            if (normx > 0)
+              {
+                alpha = v[0] >= 0 ? -normx : normx;
+                beta[k] = 1/(normx*(normx + std::abs(v[0])));
+                v[0] -= alpha;
+              }
+            r[std::size_t(k)*cols + k] = alpha;
+
+            for (Index j=k+1; j<cols; j++)
+              {
+                Float* y = &a[std::size_t(j)*rows + k];
+                if (beta[k] != 0)
+                  {
+                    const Float t = beta[k]*dot(v, y, L);
+                    for (Index i=0; i<L; i++) y[i] -= t*v[i];
+                  }
+                r[std::size_t(j)*cols + k] = y[0];
+
+                // downdated norms, recomputed after cancellation
+                if (perm && pn[j] > 0)
+                  {
+                    Float t = std::abs(y[0])/pn[j];
+                    t = std::max(Float(), (1 + t)*(1 - t));
+                    const Float q = pn[j]/ref[j];
+                    if (t*q*q <= limit)
+                      pn[j] = ref[j] = std::sqrt(dot(y+1, y+1, L-1));
+                    else
+                      pn[j] *= std::sqrt(t);
+                  }
+              }
+          }
+      };
+
+    // u = Q*u for Q given by reflectors of qr()
+    auto apply_q = [&dot](const std::vector<Float>& a, Index rows,
+                          Index cols, const std::vector<Float>& beta,
+                          Float* u)
+      {
+        for (Index k=cols; k-- > 0; )
+          if (beta[k] != 0)
+            {
+              const Float* v = &a[std::size_t(k)*rows + k];
+              const Float  t = beta[k]*dot(v, u+k, rows-k);
+              for (Index i=k; i<rows; i++) u[i] -= t*v[i-k];
+            }
+      };
+
+    auto transpose = [this](const std::vector<Float>& a, std::vector<Float>& t)
+      {
+        t.resize(std::size_t(n)*n);
+        for (Index i=0; i<n; i++)
+          for (Index j=0; j<n; j++)
+            t[std::size_t(j)*n + i] = a[std::size_t(i)*n + j];
+      };
+
+    /* Preconditioning (Drmac and Veselic, New fast and accurate Jacobi
+     * SVD algorithm I, SIAM J. Matrix Anal. Appl. 29, 2008). Matrices
+     * with m >= n are factorized as A*P = Q1*R by the QR decomposition
+     * with column pivoting and trans(R) = Q2*R2 without pivoting.
+     * Rotations orthogonalize columns of the n x n lower triangular
+     * matrix trans(R2) = G, A = (Q1*G*inv(W))*W*trans(P*Q2*H), which
+     * runs on n instead of m rows and needs only a few sweeps, as
+     * columns of trans(R2) are nearly orthogonal with graded norms. */
+
+    const bool precondition = m >= n;
+    std::vector<Index> perm(n);
+    std::vector<Float> beta1, beta2, R, T;
+    for (Index j=0; j<n; j++) perm[j] = j;
+
+    if (precondition)
+      {
+        qr(A_, m, n, beta1, R, &perm);
+        transpose(R, T);
+        qr(T, n, n, beta2, R, nullptr);
+        std::vector<Float> R2;
+        transpose(R, R2);
+        R.swap(R2);
       }
 
-  }      /* void SVD<Float, Index, Exc>::svd() */
+    // columns orthogonalized by rotations: R (n x n) or A (m x n)
+
+    const Index rows = precondition ? n : m;
+    std::vector<Float>& G = precondition ? R : A_;
+
+    Float frobenius = 0;
+    for (Index j=0; j<n; j++)
+      frobenius += dot(&G[std::size_t(j)*rows], &G[std::size_t(j)*rows], rows);
+
+    const Float eps   = std::numeric_limits<Float>::epsilon();
+    const Float tol   = eps*std::max(rows, Index(1));
+    const Float small = eps*eps*frobenius;   // numerically zero columns
+
+    /* Rotation of the pair of columns p < q, returns true if the pair
+     * was not orthogonal. */
+    auto rotate = [&](Index p, Index q)
+      {
+        Float* gp = &G[std::size_t(p)*rows];
+        Float* gq = &G[std::size_t(q)*rows];
+        const Float alpha = norm[p];
+        const Float beta  = norm[q];
+        if (alpha <= small || beta <= small) return false;
+
+        const Float gamma = dot(gp, gq, rows);
+        if (std::abs(gamma) <= tol*std::sqrt(alpha)*std::sqrt(beta))
+          return false;
+
+        const Float zeta = (beta - alpha)/(2*gamma);
+        const Float t = (zeta >= 0 ? 1 : -1) /
+                        (std::abs(zeta) + std::sqrt(1 + zeta*zeta));
+        const Float c = 1/std::sqrt(1 + t*t);
+        const Float s = c*t;
+
+        for (Index i=0; i<rows; i++)
+          {
+            const Float x = gp[i], y = gq[i];
+            gp[i] = c*x - s*y;
+            gq[i] = s*x + c*y;
+          }
+        Float* hp = &H[std::size_t(p)*n];
+        Float* hq = &H[std::size_t(q)*n];
+        for (Index i=0; i<n; i++)
+          {
+            const Float x = hp[i], y = hq[i];
+            hp[i] = c*x - s*y;
+            hq[i] = s*x + c*y;
+          }
+
+        // updated norms, recomputed after cancellation
+        norm[p] = alpha - t*gamma;
+        norm[q] = beta  + t*gamma;
+        if (norm[p] < alpha/8) norm[p] = dot(gp, gp, rows);
+        if (norm[q] < beta/8)  norm[q] = dot(gq, gq, rows);
+        return true;
+      };
+
+    /* Blocking: round-robin ordering pairs blocks of columns and all
+     * pairs of columns of two blocks are rotated while the blocks of G
+     * and H stay in cache (256 kB). The block size depends only on the
+     * dimensions, results do not depend on the number of threads. */
+    const Index cache  = Index(262144/(2*sizeof(Float)*(rows + n)));
+    const Index bs     = std::max(Index(1), std::min(cache, n/16));
+    const Index blocks = (n + bs - 1)/bs;
+    const Index N      = blocks + blocks%2;    // even number of blocks
+
+    // rotations of columns of blocks P < Q, within blocks if intra
+    auto rotate_blocks = [&](Index P, Index Q, bool intra)
+      {
+        const Index p0 = P*bs, p1 = std::min(n, p0 + bs);
+        const Index q0 = Q*bs, q1 = std::min(n, q0 + bs);
+        Index count = 0;
+        for (Index p=p0; intra && p<p1; p++)
+          for (Index q=p+1; q<p1; q++) count += rotate(p, q);
+        for (Index p=q0; intra && p<q1; p++)
+          for (Index q=p+1; q<q1; q++) count += rotate(p, q);
+        for (Index p=p0; p<p1; p++)
+          for (Index q=q0; q<q1; q++) count += rotate(p, q);
+        return count;
+      };
+
+    Index threads = threads_;
+    if (threads == 0) threads = Index(std::thread::hardware_concurrency());
+    const double work = svd_parallel_work();
+    if (work > 0 && threads > n/8) threads = n/8;
+    if (double(rows)*n*n < work) threads = 1;
+    if (threads > N/2) threads = N/2;
+    if (threads < 1) threads = 1;
+
+    // workers meet at the end of each round (and norms computation)
+    std::atomic<Index> arrived(0), generation(0);
+    auto barrier = [&]()
+      {
+        const Index g = generation.load();
+        if (arrived.fetch_add(1) + 1 == threads)
+          {
+            arrived.store(0);
+            generation.fetch_add(1);
+          }
+        else
+          while (generation.load() == g) std::this_thread::yield();
+      };
+
+    const Index max_sweeps = 60;
+    std::vector<Index> rotations(threads);
+    bool converged = false;
+
+    std::atomic<bool> start(false);
+
+    auto worker = [&](Index thread)
+      {
+        while (!start.load()) std::this_thread::yield();
+
+        for (Index sweep=0; sweep<max_sweeps; sweep++)
+          {
+            for (Index j=thread; j<n; j+=threads)
+              norm[j] = dot(&G[std::size_t(j)*rows], &G[std::size_t(j)*rows],
+                            rows);
+            rotations[thread] = 0;
+            barrier();
+
+            // round-robin pairs of blocks of round r: (N-1, r) and
+            // (r+k, r-k) mod N-1, each block is in one pair of a round
+            const Index pairs = N/2;
+            const Index first = thread*pairs/threads;
+            const Index last  = (thread+1)*pairs/threads;
+            for (Index r=0; r<N-1; r++)
+              {
+                for (Index k=first; k<last; k++)
+                  {
+                    Index p, q;
+                    if (k == 0) { p = r; q = N-1; }
+                    else
+                      {
+                        p = (r + k) % (N-1);
+                        q = (r - k + N-1) % (N-1);
+                      }
+                    if (p > q) std::swap(p, q);
+                    rotations[thread] += rotate_blocks(p, q, r == 0);
+                  }
+                barrier();
+              }
+
+            Index total = 0;
+            for (Index t : rotations) total += t;
+            barrier();      // all workers have read rotations
+
+            if (total == 0)
+              {
+                if (thread == 0) converged = true;
+                return;
+              }
+          }
+      };
+
+    // workers wait for the start, if a thread cannot be created the
+    // decomposition runs on the threads already started
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    try
+      {
+        for (Index t=1; t<threads; t++) pool.emplace_back(worker, t);
+      }
+    catch (const std::system_error&)
+      {
+        threads = Index(pool.size()) + 1;
+        rotations.resize(threads);
+      }
+    start.store(true);
+    worker(0);
+    for (auto& t : pool) t.join();
+
+    if (!converged)
+      throw Exc(Exception::NoConvergence, "No convergence in SVD (jacobi)");
+
+    // A*V = U*W, with preconditioning U = Q1*G*inv(W) and V = P*Q2*H
+
+    std::vector<Float> u(m);
+    for (Index j=0; j<n; j++)
+      {
+        const Float* g = &G[std::size_t(j)*rows];
+        const Float  w = std::sqrt(dot(g, g, rows));
+        W[j+1] = w;
+        std::fill(u.begin(), u.end(), Float());
+        for (Index i=0; w > 0 && i<rows; i++) u[i] = g[i]/w;
+        if (precondition && w > 0) apply_q(A_, m, n, beta1, u.data());
+        for (Index i=0; i<m; i++)
+          U[i+1][j+1] = u[i];
+
+        Float* h = &H[std::size_t(j)*n];
+        if (precondition) apply_q(T, n, n, beta2, h);
+        for (Index i=0; i<n; i++)
+          V[perm[i]+1][j+1] = h[i];
+      }
+
+  }      /* void SVD<Float, Index, Exc>::jacobi() */
 
 
   template <typename Float, typename Index, typename Exc>
@@ -626,13 +1039,13 @@ namespace GNU_gama {
 
 
   template <typename Float, typename Index, typename Exc>
-  void SVD<Float, Index, Exc>::min_x(Index n, Index list[])
+  void SVD<Float, Index, Exc>::min_x(Index nmin, Index list[])
   {
     minx = subset;
     if (list_min != 0) delete[] list_min;
-    n_min = n;
+    n_min = nmin;
     list_min = new Index[n_min];
-    for (Index i = 0; i < n; i++)
+    for (Index i = 0; i < n_min; i++)
       list_min[i] = list[i];
 
     if (decomposed && defect != 0) {
@@ -644,7 +1057,7 @@ namespace GNU_gama {
         V[i] = V[i-1] + n;
       min_subset_x();
     }
-  }      /* void SVD<Float, Index, Exc>::min_x(Index n, Index list[]) */
+  }      /* void SVD<Float, Index, Exc>::min_x(Index nmin, Index list[]) */
 
 
   template <typename Float, typename Index, typename Exc>
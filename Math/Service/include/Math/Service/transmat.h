@@ -25,6 +25,7 @@
 #include "vec.h"
 #include "transvec.h"
 #include <iostream>
+#include <utility>
 
 namespace GNU_gama {   /** \brief Transpose matrix */
 
@@ -44,12 +45,12 @@ namespace GNU_gama {   /** \brief Transpose matrix */
     {
     }
 
-    Float& operator()(Index r, Index c) override
+    Float& operator()(Index r, Index c) override final
     {
       Float *m = this->begin();
       return m[--c*this->rows() + --r];
     }
-    Float  operator()(Index r, Index c) const override
+    Float  operator()(Index r, Index c) const override final
     {
       const Float *m = this->begin();
       return m[--c*this->rows() + --r];
@@ -62,30 +63,70 @@ namespace GNU_gama {   /** \brief Transpose matrix */
       }
     }
 
-    TransMat operator*(Float f) const
+    /* Operands which are temporaries are reused for the result */
+
+    TransMat operator*(Float f) const &
     {
-      TransMat t(this->rows(), this->cols()); mul(f, t); return t;
+      TransMat t(this->cols(), this->rows()); this->mul(f, t); return t;
     }
-    TransMat operator+(const TransMat& M) const
+    TransMat operator*(Float f) &&
     {
-      if (this->rows() != M.rows() || this->cols() != M.cols())
-        throw Exc(Exception::BadRank,
-                  "TransMat operator+(const TransMat& M) const");
+      this->mul(f, *this); return std::move(*this);
+    }
+    TransMat operator+(const TransMat& M) const &
+    {
+      check_dim(M, "TransMat operator+(const TransMat& M) const");
 
-      TransMat T(this->rows(), this->cols());
+      TransMat T(this->cols(), this->rows());
       this->add(M, T);
       return T;
     }
-    TransMat operator-(const TransMat& M) const
+    TransMat operator+(TransMat&& M) const &
     {
-      if (this->rows() != M.rows() || this->cols() != M.cols())
-        throw Exc(Exception::BadRank,
-                  "TransMat operator-(const TransMat& M) const");
+      check_dim(M, "TransMat operator+(const TransMat& M) const");
+
+      this->add(M, M);
+      return std::move(M);
+    }
+    TransMat operator+(const TransMat& M) &&
+    {
+      check_dim(M, "TransMat operator+(const TransMat& M) const");
+
+      this->add(M, *this);
+      return std::move(*this);
+    }
+    TransMat operator+(TransMat&& M) && { return std::move(*this) + M; }
+    TransMat operator-(const TransMat& M) const &
+    {
+      check_dim(M, "TransMat operator-(const TransMat& M) const");
 
-      TransMat T(this->rows(), this->cols());
+      TransMat T(this->cols(), this->rows());
       this->sub(M, T);
       return T;
     }
+    TransMat operator-(TransMat&& M) const &
+    {
+      check_dim(M, "TransMat operator-(const TransMat& M) const");
+
+      this->sub(M, M);
+      return std::move(M);
+    }
+    TransMat operator-(const TransMat& M) &&
+    {
+      check_dim(M, "TransMat operator-(const TransMat& M) const");
+
+      this->sub(M, *this);
+      return std::move(*this);
+    }
+    TransMat operator-(TransMat&& M) && { return std::move(*this) - M; }
+
+  private:
+
+    void check_dim(const TransMat& M, const char* fun) const
+    {
+      if (this->rows() != M.rows() || this->cols() != M.cols())
+        throw Exc(Exception::BadRank, fun);
+    }
 
   };
 
@@ -98,17 +139,21 @@ namespace GNU_gama {   /** \brief Transpose matrix */
   }
 
 
+  template <typename Float, typename Index, typename Exc>
+  inline TransMat<Float, Index, Exc>
+  operator*(Float f, TransMat<Float, Index, Exc> &&M)
+  {
+    return std::move(M)*f;
+  }
+
+
   template <typename Float, typename Index, typename Exc>
   Mat<Float, Index, Exc>::Mat(const TransMat<Float, Index, Exc>& M)
     : MatBase<Float, Index, Exc>(M.rows(), M.cols(), M.rows()*M.cols())
   {
-    iterator p=this->begin();
-    const Index R = M.rows();
-    const Index C = M.cols();
-    Index i, j;
-    for (i=1; i<=R; i++)
-      for (j=1; j<=C; j++, ++p)
-        *p = M(i,j);
+    // M is stored as its transposition
+    Kernels::transpose(M.cols(), M.rows(), M.begin(), M.rows(),
+                       this->begin(), this->cols());
   }
 
 
@@ -287,24 +332,9 @@ namespace GNU_gama {   /** \brief Transpose matrix */
                 "Mat operator*(const TransMat&, const Mat&)");
 
     Mat<Float, Index, Exc> C(A.rows(), B.cols());
-    typename Mat<Float, Index, Exc>::iterator c = C.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator ab = A.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator a;
-    typename Mat<Float, Index, Exc>::const_iterator bb = B.begin();
-    typename Mat<Float, Index, Exc>::const_iterator b;
-    Float s;
-
-    for (Index i=1; i<=C.rows(); i++, ab++)
-      for (Index j=0; j<C.cols(); j++)
-        {
-          s = 0;
-          a = ab;
-          b = bb + j;
-          for (Index k=1; k<=A.cols(); k++, b += B.cols(), a += A.rows())
-            s += *a * *b;
-          *c++ = s;
-        }
-
+    Kernels::gemm_tn(A.rows(), B.cols(), A.cols(),
+                     A.begin(), A.rows(), B.begin(), B.cols(),
+                     C.begin(), C.cols());
     return C;
   }
 
@@ -318,25 +348,15 @@ namespace GNU_gama {   /** \brief Transpose matrix */
       throw Exc(Exception::BadRank,
                 "Mat operator*(const Mat&, const TransMat&)");
 
-    Mat<Float, Index, Exc> C(A.rows(), B.cols());
-    typename Mat<Float, Index, Exc>::iterator c = C.begin();
-    typename Mat<Float, Index, Exc>::const_iterator ab = A.begin();
-    typename Mat<Float, Index, Exc>::const_iterator a;
-    typename TransMat<Float, Index, Exc>::const_iterator bb = B.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator b;
-    Float s;
-
-    for (Index i=1; i<=C.rows(); i++, ab += A.cols())
-      for (Index j=0; j<C.cols(); j++)
-        {
-          s = 0;
-          a = ab;
-          b = bb + j*B.rows();
-          for (Index k=1; k<=A.cols(); k++, b++)
-            s += *a++ * *b;
-          *c++ = s;
-        }
+    // B is stored as its transposition
+    Mat<Float, Index, Exc> b(B.rows(), B.cols());
+    Kernels::transpose(B.cols(), B.rows(), B.begin(), B.rows(),
+                       b.begin(), b.cols());
 
+    Mat<Float, Index, Exc> C(A.rows(), B.cols());
+    Kernels::gemm(A.rows(), B.cols(), A.cols(),
+                  A.begin(), A.cols(), b.begin(), b.cols(),
+                  C.begin(), C.cols());
     return C;
   }
 
@@ -350,25 +370,14 @@ namespace GNU_gama {   /** \brief Transpose matrix */
       throw Exc(Exception::BadRank,
                 "Mat operator*(const TransMat&, const TransMat&)");
 
-    Mat<Float, Index, Exc> C(A.rows(), B.cols());
-    typename Mat<Float, Index, Exc>::iterator c = C.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator ab = A.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator a;
-    typename TransMat<Float, Index, Exc>::const_iterator bb = B.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator b;
-    Float s;
-
-    for (Index i=1; i<=C.rows(); i++, ab++)
-      for (Index j=0; j<C.cols(); j++)
-        {
-          s = 0;
-          a = ab;
-          b = bb + j*B.cols();
-          for (Index k=1; k<=A.cols(); k++, a += A.rows(), b++)
-            s += *a * *b;
-          *c++ = s;
-        }
+    Mat<Float, Index, Exc> b(B.rows(), B.cols());
+    Kernels::transpose(B.cols(), B.rows(), B.begin(), B.rows(),
+                       b.begin(), b.cols());
 
+    Mat<Float, Index, Exc> C(A.rows(), B.cols());
+    Kernels::gemm_tn(A.rows(), B.cols(), A.cols(),
+                     A.begin(), A.rows(), b.begin(), b.cols(),
+                     C.begin(), C.cols());
     return C;
   }
 
@@ -45,18 +45,40 @@ public:
   {
   }
 
-  TransVec operator*(Float f) const
+  TransVec operator*(Float f) const &
   {
       TransVec t(this->dim()); this->mul(f, t); return t;
   }
-  TransVec operator+(const TransVec &x) const
+  TransVec operator*(Float f) &&
+  {
+      this->mul(f, *this); return std::move(*this);
+  }
+  TransVec operator+(const TransVec &x) const &
   {
     TransVec t(this->dim()); this->add(x, t); return t;
   }
-  TransVec operator-(const TransVec &x) const
+  TransVec operator+(TransVec &&x) const &
+  {
+    this->add(x, x); return std::move(x);
+  }
+  TransVec operator+(const TransVec &x) &&
+  {
+    this->add(x, *this); return std::move(*this);
+  }
+  TransVec operator+(TransVec &&x) && { return std::move(*this) + x; }
+  TransVec operator-(const TransVec &x) const &
   {
     TransVec t(this->dim()); this->sub(x, t); return t;
   }
+  TransVec operator-(TransVec &&x) const &
+  {
+    this->sub(x, x); return std::move(x);
+  }
+  TransVec operator-(const TransVec &x) &&
+  {
+    this->sub(x, *this); return std::move(*this);
+  }
+  TransVec operator-(TransVec &&x) && { return std::move(*this) - x; }
 
 };
 
@@ -69,9 +91,17 @@ operator*(Float f, const TransVec<Float, Index, Exc>& V)
   }
 
 
+template <typename Float, typename Index, typename Exc>
+inline TransVec<Float, Index, Exc>
+operator*(Float f, TransVec<Float, Index, Exc>&& V)
+  {
+    return std::move(V)*f;
+  }
+
+
 template <typename Float, typename Index, typename Exc>
 inline Float
-operator*(TransVec<Float, Index, Exc> a, Vec<Float, Index, Exc> b)
+operator*(const TransVec<Float, Index, Exc>& a, const Vec<Float, Index, Exc>& b)
   {
     return a.dot(b);
   }
@@ -141,10 +171,11 @@ trans(const TransVec<Float, Index, Exc>& v)
 }
 
 
-template <typename Float, typename Index, typename Exc>
+template <template <typename, typename, typename> class MA,
+          typename Float, typename Index, typename Exc,
+          typename = MatBaseIf<MA<Float, Index, Exc>, Float, Index, Exc>>
 TransVec<Float, Index, Exc>
-operator*(const TransVec<Float, Index, Exc> &b, const MatBase<Float,
-          Index, Exc> &A)
+operator*(const TransVec<Float, Index, Exc> &b, const MA<Float, Index, Exc> &A)
   {
     if (b.dim() != A.rows())
       throw Exc(Exception::BadRank,
@@ -155,7 +186,7 @@ operator*(const TransVec<Float, Index, Exc> &b, const MatBase<Float,
     for (Index j=1; j<=A.cols(); j++)
       {
         s = 0;
-        for (Index i=1; i<=A.cols(); i++)
+        for (Index i=1; i<=A.rows(); i++)
           s += b(i)*A(i,j);
         t(j) = s;
       }
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <cmath>
 #include <initializer_list>
+#include <utility>
 
 namespace GNU_gama {   /** \brief Vector */
 
@@ -55,15 +56,35 @@ namespace GNU_gama {   /** \brief Vector */
         *f++ = p;
     }
 
-    Vec operator*(Float f) const {
+    /* Operands which are temporaries are reused for the result, a
+     * chain of operations allocates a single temporary. */
+
+    Vec operator*(Float f) const & {
       Vec t(this->dim()); this->mul(f, t); return t;
     }
-    Vec operator+(const Vec &x) const {
+    Vec operator*(Float f) && {
+      this->mul(f, *this); return std::move(*this);
+    }
+    Vec operator+(const Vec &x) const & {
       Vec t(this->dim()); this->add(x, t); return t;
     }
-    Vec operator-(const Vec &x) const {
+    Vec operator+(Vec &&x) const & {
+      this->add(x, x); return std::move(x);
+    }
+    Vec operator+(const Vec &x) && {
+      this->add(x, *this); return std::move(*this);
+    }
+    Vec operator+(Vec &&x) && { return std::move(*this) + x; }
+    Vec operator-(const Vec &x) const & {
       Vec t(this->dim()); this->sub(x, t); return t;
     }
+    Vec operator-(Vec &&x) const & {
+      this->sub(x, x); return std::move(x);
+    }
+    Vec operator-(const Vec &x) && {
+      this->sub(x, *this); return std::move(*this);
+    }
+    Vec operator-(Vec &&x) && { return std::move(*this) - x; }
 
     Vec& operator*=(Float f)      { this->mul(f, *this); return *this; }
     Vec& operator+=(const Vec &x) { this->add(x, *this); return *this; }
@@ -80,8 +101,18 @@ namespace GNU_gama {   /** \brief Vector */
 
 
   template <typename Float, typename Index, typename Exc>
+  inline Vec<Float, Index, Exc>
+  operator*(Float f, Vec<Float, Index, Exc>&& V)
+  {
+    return std::move(V)*f;
+  }
+
+
+  template <template <typename, typename, typename> class MA,
+            typename Float, typename Index, typename Exc,
+            typename = MatBaseIf<MA<Float, Index, Exc>, Float, Index, Exc>>
   Vec<Float, Index, Exc>
-  operator*(const MatBase<Float, Index, Exc> &A,
+  operator*(const MA<Float, Index, Exc> &A,
             const Vec<Float, Index, Exc> &b)
   {
     if (A.cols() != b.dim())
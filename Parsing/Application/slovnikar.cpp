@@ -30,9 +30,15 @@
 
          const int N = sizeof(language)/sizeof(const char*);
 
-         const char* version = "1.15";
+         const char* version = "1.16";
 
 /* ---------------------------------------------------------------------------
+ *
+ * 1.16  2026-10-18
+ *
+ *       - struct Texts with texts of one language, gama_texts() returns
+ *         texts of a given language (language of each LocalNetwork),
+ *         get_gama_language() the language set by set_gama_language()
  *
  * 1.15  2019-01-19
  *
@@ -379,8 +385,21 @@ int main(int argc, char *argv[])
         out << " " << language[i];
         if (i != N) out << ",";
       }
-    out << " };\n";
-    out << "void set_gama_language(gama_language);\n\n";
+    out << " };\n\n";
+
+    out << "/* Texts of one language. Each LocalNetwork writes its results\n"
+           " * in its own language (LocalNetwork::set_language()), global\n"
+           " * texts T_... of the process are set by set_gama_language(). */\n";
+    out << "struct Texts {\n";
+    for (Dictionary::const_iterator i=dict.begin(); i!=dict.end(); ++i)
+      {
+        out << "  const char* " << (*i).first << ";\n";
+      }
+    out << "};\n\n";
+
+    out << "void set_gama_language(gama_language);\n";
+    out << "gama_language get_gama_language();\n";
+    out << "const Texts& gama_texts(gama_language);\n\n";
 
     for (Dictionary::const_iterator i=dict.begin(); i!=dict.end(); ++i)
       {
@@ -444,13 +463,34 @@ int main(int argc, char *argv[])
   {
     ofstream out("language.cpp");
     out << "/* slovnikar " << version << " */\n\n"
-        << "#include <gnu_gama/local/language.h>\n\n"
+        << "#include <gnu_gama/local/language.h>\n"
+        << "#include <atomic>\n\n"
         << "namespace GNU_gama { namespace local {\n\n"
+        << "namespace {\n\n"
         << "const char* T_language_cpp_internal_error = "
         << "\" internal error : "
         << "program must call function set_gama_language() \";\n\n";
 
     Dictionary::const_iterator i;
+    out << "const Texts texts[] = {\n";
+    for (int l=0; l<N; l++)
+      {
+      out << "  { /* " << language[l] << " */\n";
+      for (i=dict.begin(); i!=dict.end(); ++i)
+        {
+          string text = (*i).second.lang[l];
+          if (text == "")
+            text = (*i).second.lang[0];   // English is used implicitly
+
+          out << "\t\"" << text << "\",\n";
+        }
+        out << "  },\n";
+      }
+    out << "};\n\n";
+
+    out << "std::atomic<int> process_language {en};\n\n"
+        << "}  // unnamed namespace\n\n";
+
     for (i=dict.begin(); i!=dict.end(); ++i)
       {
         out << "const char* "
@@ -459,27 +499,28 @@ int main(int argc, char *argv[])
       }
     out << endl;
 
-    out << "void set_gama_language(gama_language lang)\n"
+    out << "const Texts& gama_texts(gama_language lang)\n"
         << "{\n"
-        << "   switch(lang)\n"
-        << "   {\n";
+        << "   if (lang < 0 || lang >= " << N << ") lang = en;\n"
+        << "   return texts[lang];\n"
+        << "}\n\n";
 
-    out << "   default:\n";
-    for (int l=0; l<N; l++)
-      {
-      out << "   case " << language[l] << ":\n";
-      for (i=dict.begin(); i!=dict.end(); ++i)
-        {
-          string text = (*i).second.lang[l];
-          if (text == "")
-            text = (*i).second.lang[0];   // English is used implicitly
-
-          out << "\t" << (*i).first << "=\"" << text << "\";\n";
-        }
-        out << "\treturn;\n\n";
+    out << "gama_language get_gama_language()\n"
+        << "{\n"
+        << "   return gama_language(process_language.load());\n"
+        << "}\n\n";
 
+    out << "void set_gama_language(gama_language lang)\n"
+        << "{\n"
+        << "   if (lang < 0 || lang >= " << N << ") lang = en;\n"
+        << "   process_language.store(lang);\n"
+        << "   const Texts& t = texts[lang];\n\n";
+    for (i=dict.begin(); i!=dict.end(); ++i)
+      {
+        out << "   " << (*i).first << " = t." << (*i).first << ";\n";
       }
-    out << "   }\n\n}\n\n}}   // namespace GNU_gama::local\n";
+    out << "}\n\n"
+        << "}}   // namespace GNU_gama::local\n";
   }
 
   return result;
@@ -45,7 +45,7 @@ create table if not exists gnu_gama_local_configurations (
    angles    varchar(12) default 'left-handed' not null check (angles in ('left-handed', 'right-handed')),
    ang_units int default 400 not null check (ang_units in (400, 360)),
    cov_band  int default -1 not null check (cov_band >= -1),
-   algorithm varchar(12) check (algorithm in ('svd', 'gso', 'cholesky', 'envelope')),
+   algorithm varchar(12) check (algorithm in ('svd', 'gso', 'cholesky', 'envelope', 'supernodal')),
    epoch     double precision,
    latitude  double precision,
    ellipsoid varchar(20)
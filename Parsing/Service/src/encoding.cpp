@@ -298,13 +298,8 @@ int Utf8Decode(int& u, unsigned char *buf){
 
 char* utf8_cp1250(char *buf){
   static int tab[256];
-  // static int itab=cp1250_unicode((int*)tab);  ... rewritten to avoid warning
-  static bool init_tab = true;
-  if (init_tab)
-    {
-      cp1250_unicode((int*)tab);
-      init_tab = false;
-    }
+  static const int itab = cp1250_unicode((int*)tab);  // thread-safe initialization
+  (void)itab;
   unsigned int u;
   char *p,*q;
   p=q=buf;
@@ -324,13 +319,8 @@ char* utf8_cp1250(char *buf){
 
 char* utf8_iso_8859_2(char *buf){
   static int tab[256];
-  // static int itab=iso_8859_2_unicode((int*)tab);  ... avoid warning
-  static bool init_tab = true;
-  if (init_tab)
-    {
-      iso_8859_2_unicode((int*)tab);
-      init_tab = false;
-    }
+  static const int itab = iso_8859_2_unicode((int*)tab);  // thread-safe initialization
+  (void)itab;
   unsigned int u;
   char *p,*q;
   p=q=buf;
@@ -76,12 +76,8 @@ int cp1251_unicode(int* tab)
 char* utf8_cp1251(char *buf)
 {
   static int tab[256];
-  static bool init_tab = true;
-  if (init_tab)
-    {
-      cp1251_unicode((int*)tab);
-      init_tab = false;
-    }
+  static const int itab = cp1251_unicode((int*)tab);  // thread-safe initialization
+  (void)itab;
   unsigned int u;
   char *p,*q;
   p=q=buf;
@@ -1,6 +1,7 @@
 # Header files
 set(header_files
     "include/Utilities/Service/movetofront.h"
+    "include/Utilities/Service/profile.h"
     "include/Utilities/Service/simplified.h"
     "include/Utilities/Service/size_to.h"
     "include/Utilities/Service/visitor.h"
@@ -8,5 +9,6 @@ set(header_files
 
 # Source Files files
 set(source_files
+    "src/profile.cpp"
     "src/simplified.cpp"
     "src/size_to.cpp")
@@ -0,0 +1,122 @@
+/*
+  GNU Gama C++ library
+  Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library
+
+  GNU Gama is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GNU Gama is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_gama_profile_h
+#define GNU_gama_profile_h
+
+#include "UtilitiesDLL.h"
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace GNU_gama
+{
+  /** \brief Elapsed time and peak memory of computational phases.
+   *
+   * Phases are recorded by Profile::Scope objects into the profile
+   * activated for the calling thread by Profile::Active. Without an
+   * active profile a Scope does nothing, instrumented library code
+   * only tests a thread local pointer. Phases are listed in the order
+   * of their first start, repeated phases of the same name and nesting
+   * level are summed. Phases still in progress are not written.
+   *
+   * Memory is given by the peak resident set size of the process
+   * (the high-water mark) after the phase and by its growth during the
+   * phase; it is not available on all platforms (zero values).
+   * Allocations are blocks and bytes taken from the heap during the
+   * phase as given by the allocation counter, which is set by the
+   * owner of the allocator (MemAlloc::heap_counter() of matvec
+   * storage); without a counter allocations are zero.
+   */
+  class UtilitiesAPI Profile
+  {
+  public:
+
+    struct Phase
+    {
+      std::string name;
+      int    level     {0};   ///< nesting level, 0 for top level phases
+      int    calls     {0};
+      double seconds   {0};
+      long   peak_kb   {0};   ///< peak memory after the last call [kB]
+      long   growth_kb {0};   ///< growth of peak memory in all calls [kB]
+      long long allocations  {0};   ///< heap allocations in all calls
+      long long allocated_kb {0};   ///< heap allocated in all calls [kB]
+    };
+
+    const std::vector<Phase>& phases() const { return phases_; }
+    void clear() { phases_.clear(); }
+
+    void write_text(std::ostream&) const;
+    void write_json(std::ostream&) const;
+    void write_xml (std::ostream&) const;
+
+    /** Peak resident set size of the process in kB, 0 if unknown. */
+    static long peak_memory_kb();
+
+    /** Number of blocks and bytes allocated in the process so far */
+    using AllocationCounter = void (*)(long long& blocks, long long& bytes);
+
+    /** Counter sampled by phases of all profiles, nullptr for none. */
+    static void set_allocation_counter(AllocationCounter);
+
+    /** Profile \a p is active in the calling thread while the object
+     *  exists, nullptr disables profiling. */
+    class UtilitiesAPI Active
+    {
+    public:
+      explicit Active(Profile* p);
+      ~Active();
+
+      Active(const Active&) = delete;
+      void operator=(const Active&) = delete;
+
+    private:
+      Profile* previous_;
+    };
+
+    /** Records a phase from construction to destruction. */
+    class UtilitiesAPI Scope
+    {
+    public:
+      explicit Scope(const char* name);
+      ~Scope();
+
+      Scope(const Scope&) = delete;
+      void operator=(const Scope&) = delete;
+
+    private:
+      Profile* profile_;
+      std::size_t index_ {0};
+      long peak_ {0};
+      long long allocations_ {0};
+      long long bytes_ {0};
+      std::chrono::steady_clock::time_point start_;
+    };
+
+  private:
+
+    std::vector<Phase> phases_;
+    int level_ {0};
+  };
+}
+
+#endif
@@ -0,0 +1,202 @@
+/*
+  GNU Gama C++ library
+  Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library
+
+  GNU Gama is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GNU Gama is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Utilities/Service/profile.h>
+#include <atomic>
+#include <iomanip>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+  thread_local GNU_gama::Profile* active_profile = nullptr;
+
+  std::atomic<GNU_gama::Profile::AllocationCounter> allocation_counter {nullptr};
+
+  void allocated(long long& blocks, long long& bytes)
+  {
+    blocks = bytes = 0;
+    if (auto counter = allocation_counter.load(std::memory_order_acquire))
+      counter(blocks, bytes);
+  }
+}
+
+namespace GNU_gama
+{
+  long Profile::peak_memory_kb()
+  {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return long(usage.ru_maxrss / 1024);   // bytes on macOS
+#else
+    return long(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+  }
+
+
+  void Profile::set_allocation_counter(AllocationCounter counter)
+  {
+    allocation_counter.store(counter, std::memory_order_release);
+  }
+
+
+  Profile::Active::Active(Profile* p) : previous_(active_profile)
+  {
+    active_profile = p;
+  }
+
+  Profile::Active::~Active()
+  {
+    active_profile = previous_;
+  }
+
+
+  Profile::Scope::Scope(const char* name) : profile_(active_profile)
+  {
+    if (profile_ == nullptr) return;
+
+    const int level = profile_->level_++;
+    std::vector<Phase>& phases = profile_->phases_;
+    for (index_ = 0; index_ < phases.size(); index_++)
+      if (phases[index_].level == level && phases[index_].name == name) break;
+    if (index_ == phases.size())
+      {
+        Phase phase;
+        phase.name  = name;
+        phase.level = level;
+        phases.push_back(phase);
+      }
+
+    allocated(allocations_, bytes_);
+
+    peak_  = peak_memory_kb();
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  Profile::Scope::~Scope()
+  {
+    if (profile_ == nullptr) return;
+
+    const auto stop = std::chrono::steady_clock::now();
+    const long peak = peak_memory_kb();
+    long long allocations, bytes;
+    allocated(allocations, bytes);
+
+    Phase& phase = profile_->phases_[index_];
+    phase.calls++;
+    phase.seconds  += std::chrono::duration<double>(stop - start_).count();
+    phase.peak_kb   = peak;
+    phase.growth_kb += peak - peak_;
+    phase.allocations  += allocations - allocations_;
+    phase.allocated_kb += (bytes - bytes_ + 512)/1024;
+
+    profile_->level_--;
+  }
+
+
+  void Profile::write_text(std::ostream& out) const
+  {
+    const auto flags = out.flags();
+    const auto prec  = out.precision();
+
+    out << "profile" << std::string(23, ' ')
+        << "  calls    time [s]   peak [MB]  growth [MB]"
+        << "   allocs  alloc [MB]\n";
+    out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    for (const Phase& p : phases_)
+      {
+        if (p.calls == 0) continue;   // phase in progress
+
+        std::string name = std::string(2*p.level + 2, ' ') + p.name;
+        if (name.size() < 30) name += std::string(30 - name.size(), ' ');
+        out << name
+            << std::setw(7)  << p.calls
+            << std::setprecision(4) << std::setw(12) << p.seconds
+            << std::setprecision(1) << std::setw(12) << p.peak_kb/1024.0
+            << std::setprecision(1) << std::setw(13) << p.growth_kb/1024.0
+            << std::setw(9)  << p.allocations
+            << std::setprecision(1) << std::setw(12) << p.allocated_kb/1024.0
+            << "\n";
+      }
+
+    out.flags(flags);
+    out.precision(prec);
+  }
+
+  void Profile::write_json(std::ostream& out) const
+  {
+    const auto flags = out.flags();
+    const auto prec  = out.precision();
+
+    out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    out.precision(6);
+    out << "{\"profile\": [";
+    const char* sep = "\n  ";
+    for (const Phase& p : phases_)
+      {
+        if (p.calls == 0) continue;
+
+        out << sep
+            << "{\"phase\": \"" << p.name << "\", \"level\": " << p.level
+            << ", \"calls\": " << p.calls << ", \"seconds\": " << p.seconds
+            << ", \"peak_kb\": " << p.peak_kb
+            << ", \"growth_kb\": " << p.growth_kb
+            << ", \"allocations\": " << p.allocations
+            << ", \"allocated_kb\": " << p.allocated_kb << "}";
+        sep = ",\n  ";
+      }
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(prec);
+  }
+
+  void Profile::write_xml(std::ostream& out) const
+  {
+    const auto flags = out.flags();
+    const auto prec  = out.precision();
+
+    out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    out.precision(6);
+    out << "\n<profile>\n";
+    for (const Phase& p : phases_)
+      {
+        if (p.calls == 0) continue;
+
+        out << "<phase name=\"" << p.name << "\" level=\"" << p.level
+            << "\" calls=\"" << p.calls << "\" seconds=\"" << p.seconds
+            << "\" peak-kb=\"" << p.peak_kb
+            << "\" growth-kb=\"" << p.growth_kb
+            << "\" allocations=\"" << p.allocations
+            << "\" allocated-kb=\"" << p.allocated_kb << "\"/>\n";
+      }
+    out << "</profile>\n";
+
+    out.flags(flags);
+    out.precision(prec);
+  }
+}
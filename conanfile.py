@@ -139,6 +139,8 @@ class GaMa(ConanFile):
       self.cpp_info.components["Business_MathAdjustment"].includedirs = ["include/GaMa"]
       self.cpp_info.components["Business_MathAdjustment"].libs = ["Business_MathAdjustment"]
       self.cpp_info.components["Business_MathAdjustment"].requires = ["Service_Math"]
+      if self.settings.os in ["Linux", "FreeBSD"]:
+         self.cpp_info.components["Business_MathAdjustment"].system_libs = ["pthread"]
 
       self.cpp_info.components["libgama"].names["cmake_find_package"] = "libgama"
       self.cpp_info.components["libgama"].includedirs = ["include/GaMa"]
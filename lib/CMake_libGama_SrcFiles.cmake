@@ -60,9 +60,12 @@ set(header_files
     "gnu_gama/local/matvec.h"
     "gnu_gama/local/medianf.h"
     "gnu_gama/local/observation.h"
+    "gnu_gama/local/observation_store.h"
     "gnu_gama/local/readsabw.h"
     "gnu_gama/local/skipcomm.h"
     "gnu_gama/local/sqlitereader.h"
+    "gnu_gama/local/sqlitestatement.h"
+    "gnu_gama/local/sqlitewriter.h"
     "gnu_gama/local/writevisitor.h"
     "gnu_gama/local/xmlerror.h"
 
@@ -105,7 +108,6 @@ set(source_files
     "gnu_gama/local/acord/acordzderived.cpp"
     "gnu_gama/local/acord/reduce_observations.cpp"
     "gnu_gama/local/acord/reduce_to_ellipsoid.cpp"
-    "gnu_gama/local/format.cpp"
     "gnu_gama/local/gamadata.cpp"
     "gnu_gama/local/local_linearization.cpp"
     "gnu_gama/local/localnetwork2sql.cpp"
@@ -121,6 +123,7 @@ set(source_files
     "gnu_gama/local/observation.cpp"
     "gnu_gama/local/skipcomm.cpp"
     "gnu_gama/local/sqlitereader.cpp"
+    "gnu_gama/local/sqlitewriter.cpp"
     "gnu_gama/local/xmlerror.cpp"
 
     "gnu_gama/g3/g3_adjres.cpp"
@@ -24,6 +24,9 @@
 #include <Parsing/Business/outstream.h>
 #include <Math/Business/Adjustment/adj.h>
 #include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
 
 
 using namespace std;
@@ -48,6 +51,10 @@ Model::Model()
   apriori_sd       = 1.00;
   confidence_level = 0.95;
   tol_abs          = 1e3;
+  max_iterations   = 1;
+  tol_iterations   = 1e-3;
+  dm_linearized    = 0;
+  dm_time          = 0;
 
   actual_sd = aposteriori;
 
@@ -227,32 +234,66 @@ void Model::update_adjustment()
 {
   if (!check_linearization()) update_linearization();
 
-  // parameters 'height' are linked to corresponding parameters 'U'
+  iterations.clear();
 
-  for (Model::PointBase::iterator
-         i=points->begin(), e=points->end(); i!=e; ++i)
+  for (;;)
     {
-      Parameter& U      = (*i)->U;
-      Parameter& height = (*i)->height;
+      Iteration iteration;
+      iteration.linearized = dm_linearized;
+      iteration.time_linearization = dm_time;
 
-      if      (U.fixed() ) height.set_fixed();
-      else if (U.constr()) height.set_constr();
-      else if (U.free()  ) height.set_free();
-      else                 height.set_unused();
+      const auto start = std::chrono::steady_clock::now();
+      const Vec<>& x = adj->x();
+      iteration.time_adjustment = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
 
-      if (height.free())
+      // parameters 'height' are linked to corresponding parameters 'U'
+
+      for (Model::PointBase::iterator
+             i=points->begin(), e=points->end(); i!=e; ++i)
         {
-          int k = U.index();
-          height.set_index(k);
-          height.add_correction(adj->x()(k));
+          Parameter& U      = (*i)->U;
+          Parameter& height = (*i)->height;
+
+          if      (U.fixed() ) height.set_fixed();
+          else if (U.constr()) height.set_constr();
+          else if (U.free()  ) height.set_free();
+          else                 height.set_unused();
+
+          if (height.free())
+            {
+              int k = U.index();
+              height.set_index(k);
+              height.add_correction(x(k));
+            }
         }
-    }
 
-  for (ParameterList::iterator
-         i=par_list->begin(), e=par_list->end(); i!=e; ++i)
-    {
-      Parameter* p = *i;
-      if (int k = p->index()) p->add_correction(adj->x()(k));
+      for (ParameterList::iterator
+             i=par_list->begin(), e=par_list->end(); i!=e; ++i)
+        {
+          Parameter* p = *i;
+          if (int k = p->index()) p->add_correction(x(k));
+        }
+
+      double max = 0, norm = 0;
+      for (int k=1; k<=x.dim(); k++)
+        {
+          max   = std::max(max, std::abs(x(k)));
+          norm += x(k)*x(k);
+        }
+      iteration.max_correction  = max;
+      iteration.norm_correction = std::sqrt(norm);
+      iteration.rtr = adj->rtr();
+      iterations.push_back(iteration);
+
+      if (int(iterations.size()) >= max_iterations) break;
+      if (max < tol_iterations) break;
+
+      // Gauss-Newton iteration: approximate coordinates are moved to
+      // the adjusted position and observations are linearized again
+
+      move_points();
+      update_linearization();
     }
 
   // ..........................................................
@@ -311,6 +352,43 @@ GNU_gama::E_3 Model::normal(const Point* p) const
 }
 
 
+void Model::move_points()
+{
+  moved_points.clear();
+
+  for (Model::PointBase::iterator
+         i=points->begin(), end=points->end(); i!=end; ++i)
+    {
+      Point* p = *i;
+      if (!p->has_position()) continue;
+
+      const double n = p->N();
+      const double e = p->E();
+      const double u = p->U();
+
+      const double dx = p->x_transform(n, e, u);
+      const double dy = p->y_transform(n, e, u);
+      const double dz = p->z_transform(n, e, u);
+
+      if (dx == p->X.correction() &&
+          dy == p->Y.correction() &&
+          dz == p->Z.correction()) continue;
+
+      p->X_.set_correction(dx);
+      p->Y_.set_correction(dy);
+      p->Z_.set_correction(dz);
+
+      double b, l, h;
+      ellipsoid.xyz2blh(p->X(), p->Y(), p->Z(), b, l, h);
+      p->B_.set_correction(b - p->B.init_value());
+      p->L_.set_correction(l - p->L.init_value());
+      p->H_.set_correction(h - p->H.init_value());
+
+      moved_points.insert(p);
+    }
+}
+
+
 GNU_gama::E_3 Model::vertical(const Point* p) const
 {
   const double B = p->B() + p->dB();
@@ -32,6 +32,8 @@
 #include <Math/Business/Adjustment/adj.h>
 #include <Math/Business/Core/e3.h>
 #include <list>
+#include <set>
+#include <vector>
 
 namespace GNU_gama {
 
@@ -104,6 +106,9 @@ namespace GNU_gama {
     void write_xml_adjusted(std::ostream&, const ZenithAngle*,int);
 
     void set_algorithm(Adj::algorithm a) { adj->set_algorithm(a); }
+    void set_ordering(SparseOrdering o)  { adj->set_ordering(o);  }
+    void set_threads (int n)             { adj->set_threads(n);   }
+    const Adj* adjustment() const        { return adj; }
 
     void   set_apriori_sd(double s) { apriori_sd = s;          }
     double get_apriori_sd() const   { return apriori_sd;       }
@@ -112,6 +117,15 @@ namespace GNU_gama {
     void   set_tol_abs   (double c) { tol_abs = c;             }
     double get_tol_abs   () const   { return tol_abs;          }
 
+    /** maximal number of Gauss-Newton iterations, implicit value 1
+     *  means a single linearization without iterations */
+    void   set_max_iterations(int n)    { max_iterations = n;    }
+    int    get_max_iterations() const   { return max_iterations; }
+    /** iterations stop when all corrections of parameters are smaller
+     *  than the given limit (in mm for linear parameters) */
+    void   set_tol_iterations(double c) { tol_iterations = c;    }
+    double get_tol_iterations() const   { return tol_iterations; }
+
     double standard_deviation() const { return std_deviation; }
     double standard_variance () const { return std_variance; }
     double cov_xx(int i, int j) { return std_variance*adj->q_xx(i,j); }
@@ -146,6 +160,20 @@ namespace GNU_gama {
     RejectedObs     rejected_obs;
 
 
+    struct Iteration
+    {
+      int    linearized;       // number of (re)linearized observations
+      double max_correction;   // maximal absolute value of corrections
+      double norm_correction;  // Euclidean norm of corrections
+      double rtr;              // weighted sum of squares
+      double time_linearization;   // in seconds
+      double time_adjustment;      // in seconds
+    };
+
+    typedef std::vector<Iteration>  IterationList;
+    IterationList   iterations;
+
+
   private:   /*-----------------------------------------------------------*/
 
     Model(const Model&);
@@ -174,6 +202,15 @@ namespace GNU_gama {
     BlockDiagonal<>*  B;
     GNU_gama::AdjInputData*  adj_input_data = nullptr;
 
+    // linearization of observations in Gauss-Newton iterations, rows of
+    // observations whose points have not moved are copied from the
+    // previous design matrix
+    std::vector<int>         dm_obs_rows;  // last row of each observation
+    std::set<const Point*>   moved_points;
+    int                      dm_linearized;
+    double                   dm_time;
+    void move_points();
+
 
     // adjustment
     Adj*              adj;
@@ -191,6 +228,8 @@ namespace GNU_gama {
     double apriori_sd;
     double confidence_level;
     double tol_abs;
+    int    max_iterations;
+    double tol_iterations;
 
     bool   gons_;
 
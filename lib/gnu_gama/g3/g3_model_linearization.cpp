@@ -24,6 +24,7 @@
 #include <Math/Business/Adjustment/adj.h>
 #include <Math/Service/smatrix_graph.h>
 #include <iomanip>
+#include <chrono>
 
 
 using namespace std;
@@ -85,12 +86,99 @@ namespace
     GNU_gama::g3::Model* model;
 
   };
+
+
+  // test if any point of the observation has moved in the last iteration
+
+  class MovedPoints :
+    public GNU_gama::BaseVisitor,
+    public GNU_gama::Visitor<Angle>,
+    public GNU_gama::Visitor<Azimuth>,
+    public GNU_gama::Visitor<Distance>,
+    public GNU_gama::Visitor<Height>,
+    public GNU_gama::Visitor<HeightDiff>,
+    public GNU_gama::Visitor<Vector>,
+    public GNU_gama::Visitor<XYZ>,
+    public GNU_gama::Visitor<ZenithAngle>
+  {
+  public:
+
+    MovedPoints(GNU_gama::g3::Model* m, const std::set<const Point*>& s)
+      : model(m), moved_points(s), result(false)
+    {
+    }
+
+    bool moved() const { return result; }
+
+    void visit(Angle* p)
+    {
+      result = test(p->from) || test(p->left) || test(p->right);
+    }
+    void visit(Azimuth* p)
+    {
+      result = test(p->from) || test(p->to);
+    }
+    void visit(Distance* p)
+    {
+      result = test(p->from) || test(p->to);
+    }
+    void visit(Height* p)
+    {
+      result = test(p->id);
+    }
+    void visit(HeightDiff* p)
+    {
+      result = test(p->from) || test(p->to);
+    }
+    void visit(Vector* p)
+    {
+      result = test(p->from) || test(p->to);
+    }
+    void visit(XYZ* p)
+    {
+      result = test(p->id);
+    }
+    void visit(ZenithAngle* p)
+    {
+      result = test(p->from) || test(p->to);
+    }
+
+  private:
+
+    GNU_gama::g3::Model* model;
+    const std::set<const Point*>& moved_points;
+    bool result;
+
+    bool test(const Point::Name& name) const
+    {
+      return moved_points.count(model->points->find(name)) != 0;
+    }
+  };
 }
 
 
 
 void GNU_gama::g3::Model::update_linearization()
 {
+  const auto start = std::chrono::steady_clock::now();
+
+  // data of the previous linearization are owned by the adjustment
+  // object and are released by the next call of Adj::set(); rows of
+  // observations with unmoved points are copied from them
+
+  const SparseMatrix<>* A0 = nullptr;
+  Vec<> rhs0;
+  if (adj_input_data)
+    {
+      if (check_linearization() || check_adjustment())
+        {
+          A0   = A;
+          rhs0 = rhs;
+        }
+      adj_input_data = nullptr;
+      A              = nullptr;
+    }
+
   do
     {
       if (!check_observations()) update_observations();
@@ -104,15 +192,59 @@ void GNU_gama::g3::Model::update_linearization()
       rhs.reset(dm_rows);
       rhs_ind = 0;
 
+      if (A0 == nullptr || A0->rows() != dm_rows ||
+          A0->columns() != dm_cols ||
+          dm_obs_rows.size() != active_obs->size())
+        {
+          A0 = nullptr;
+          moved_points.clear();
+        }
+
+      const bool selected = A0 != nullptr;
+      std::vector<int> obs_rows;
+      obs_rows.reserve(active_obs->size());
+      dm_linearized = 0;
+
       Linearization linearization(this);
+      int k = 0;
       for (ObservationList::iterator
-             i=active_obs->begin(), e=active_obs->end(); i!=e; ++i)
+             i=active_obs->begin(), e=active_obs->end(); i!=e; ++i, ++k)
         {
-          (*i)->accept(&linearization);
+          MovedPoints moved(this, moved_points);
+          if (selected) (*i)->accept(&moved);
+
+          if (selected && !moved.moved())
+            {
+              for (int r = k ? dm_obs_rows[k-1]+1 : 1; r<=dm_obs_rows[k]; r++)
+                {
+                  A->new_row();
+                  const double* b = A0->begin(r);
+                  const double* e = A0->end(r);
+                  const int*    n = A0->ibegin(r);
+                  while (b != e) A->add_element(*b++, *n++);
+                  rhs(++rhs_ind) = rhs0(r);
+                }
+            }
+          else
+            {
+              (*i)->accept(&linearization);
+              dm_linearized++;
+            }
+
+          obs_rows.push_back(rhs_ind);
         }
 
+      dm_obs_rows.swap(obs_rows);
+
+      // an observation rejected in linearization changes the set of
+      // active observations, all observations are linearized again
+
+      if (!check_observations()) A0 = nullptr;
+
     } while (!check_observations());
 
+  moved_points.clear();
+
   if (dm_floats * dm_rows * dm_cols == 0)
     throw GNU_gama::Exception::string("No parameters and/or observations");
 
@@ -183,6 +315,9 @@ void GNU_gama::g3::Model::update_linearization()
 
   adj->set(adj_input_data);
 
+  dm_time = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+
   return next_state_(linear_);
 }
 
@@ -157,6 +157,7 @@ void Model::write_xml_adjustment_results_statistics(std::ostream& out)
   else if (alg == Adj::gso)      out << "gso";
   else if (alg == Adj::svd)      out << "svd";
   else if (alg == Adj::cholesky) out << "cholesky";
+  else if (alg == Adj::supernodal) out << "supernodal";
   else                           out << "unknown";
   out << " </algorithm>\n\n";
 
@@ -24,27 +24,37 @@
 
 namespace GNU_gama { namespace local {
 
+/** \brief Output precisions of observations written by WriteVisitor.
+ *
+ * Precisions are held by each LocalNetwork (see LocalNetwork::format()),
+ * independent networks can be written concurrently.
+ */
 class Format {
 
-  static int coordinates_p;
-  static int centesimal_degrees_p;
-  static int standard_deviations_p;
+  int coordinates_p         {3};
+  int centesimal_degrees_p  {4};
+  int standard_deviations_p {1};
 
 public:
 
-  static int coord_p(int n = coordinates_p)
+  int coord_p() const { return coordinates_p; }
+  int gon_p  () const { return centesimal_degrees_p; }
+  int stdev_p() const { return standard_deviations_p; }
+
+  /** Sets new precision and returns the previous one. */
+  int coord_p(int n)
              {
                 int p = coordinates_p;
                 coordinates_p = n;
                 return p;
              }
-  static int gon_p(int n = centesimal_degrees_p)
+  int gon_p(int n)
              {
                 int p = centesimal_degrees_p;
                 centesimal_degrees_p = n;
                 return p;
              }
-  static int stdev_p(int n = standard_deviations_p)
+  int stdev_p(int n)
              {
                 int p = standard_deviations_p;
                 standard_deviations_p = n;
@@ -31,18 +31,155 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include <algorithm>
 
 namespace GNU_gama { namespace local {
 
   typedef std::list<PointID>    PointIDList;
 
-  class PointData : public std::map <PointID, LocalPoint>,
-                    public LocalCoordinateSystem,
+  /** Points ordered by their identifiers.
+   *
+   *  Points are held in a private std::map and iterated in its order.
+   *  Lookups by operator[], find() and count() go through a flat open
+   *  addressing table of map iterators indexed by the hash value cached
+   *  in PointID, so that identifiers are not stored twice. The map is
+   *  modified only by member functions of PointData, which keep the
+   *  table in sync; lookups do not modify the table.
+   */
+  class PointData : public LocalCoordinateSystem,
                     public AngularObservations
     {
+      using Map = std::map<PointID, LocalPoint>;
+
     public:
+      using key_type       = Map::key_type;
+      using mapped_type    = Map::mapped_type;
+      using value_type     = Map::value_type;
+      using size_type      = Map::size_type;
+      using iterator       = Map::iterator;
+      using const_iterator = Map::const_iterator;
+
+      PointData() = default;
+      PointData(const PointData& pd)
+        : LocalCoordinateSystem(pd), AngularObservations(pd),
+          points_(pd.points_)
+        {
+          reindex();
+        }
+      PointData& operator=(const PointData& pd)
+        {
+          LocalCoordinateSystem::operator=(pd);
+          AngularObservations::operator=(pd);
+          points_ = pd.points_;
+          reindex();
+          return *this;
+        }
+
       double xNorthAngle() const;
+
+      iterator       begin()       { return points_.begin(); }
+      const_iterator begin() const { return points_.begin(); }
+      iterator       end()         { return points_.end();   }
+      const_iterator end()   const { return points_.end();   }
+      const_iterator cbegin() const { return points_.cbegin(); }
+      const_iterator cend()   const { return points_.cend();   }
+      size_type      size()  const { return points_.size();  }
+      bool           empty() const { return points_.empty(); }
+
+      LocalPoint& operator[](const PointID& id)
+        {
+          iterator i = find(id);
+          if (i == end()) i = insert(value_type(id, LocalPoint())).first;
+          return i->second;
+        }
+      iterator find(const PointID& id)
+        {
+          if (slots_.empty()) return end();
+          return slots_[slot(id)];
+        }
+      const_iterator find(const PointID& id) const
+        {
+          if (slots_.empty()) return end();
+          return slots_[slot(id)];
+        }
+      size_type count(const PointID& id) const
+        {
+          return find(id) == end() ? 0 : 1;
+        }
+      std::pair<iterator, bool> insert(const value_type& p)
+        {
+          iterator i = find(p.first);
+          if (i != end()) return { i, false };
+
+          i = points_.insert(p).first;
+          if (2*points_.size() > slots_.size()) reindex();
+          else slots_[slot(p.first)] = i;
+          return { i, true };
+        }
+
+      size_type erase(const PointID& id)
+        {
+          iterator i = find(id);
+          if (i == end()) return 0;
+          erase(i);
+          return 1;
+        }
+      iterator erase(const_iterator i)
+        {
+          unset_slot(slot(i->first));
+          return points_.erase(i);
+        }
+      iterator erase(const_iterator first, const_iterator last)
+        {
+          while (first != last) first = erase(first);
+          return points_.erase(last, last);
+        }
+      void clear()
+        {
+          points_.clear();
+          slots_.clear();
+        }
+
+    private:
+      Map points_;
+
+      /* power of two size, at most half full, empty slots hold end() */
+      std::vector<iterator> slots_;
+
+      std::size_t slot(const PointID& id) const
+        {
+          const std::size_t mask = slots_.size() - 1;
+          std::size_t s = id.hash() & mask;
+          while (slots_[s] != points_.end() && !(slots_[s]->first == id))
+            s = (s + 1) & mask;
+          return s;
+        }
+      void unset_slot(std::size_t s)
+        {
+          /* backward shift deletion of linear probing */
+          const std::size_t mask = slots_.size() - 1;
+          std::size_t e = s;
+          for (std::size_t n = (s + 1) & mask;
+               slots_[n] != points_.end(); n = (n + 1) & mask)
+            {
+              const std::size_t home = slots_[n]->first.hash() & mask;
+              if (((n - home) & mask) >= ((n - e) & mask))
+                {
+                  slots_[e] = slots_[n];
+                  e = n;
+                }
+            }
+          slots_[e] = points_.end();
+        }
+      void reindex()
+        {
+          std::size_t n = 16;
+          while (n < 2*points_.size()) n *= 2;
+          slots_.assign(points_.empty() ? 0 : n, points_.end());
+          for (iterator i=points_.begin(); i!=points_.end(); ++i)
+            slots_[slot(i->first)] = i;
+        }
     };
 
 }}   // namepsace GNU_gama::local
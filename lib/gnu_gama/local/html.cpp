@@ -155,69 +155,69 @@ public:
 
   void visit(GNU_gama::local::Direction* /*element*/)
   {
-    out << tdLeft(T_GaMa_direction);
+    out << tdLeft(lnet->texts().T_GaMa_direction);
     angular();
   }
   void visit(GNU_gama::local::Distance* /*element*/)
   {
-    out << tdLeft(T_GaMa_distance);
+    out << tdLeft(lnet->texts().T_GaMa_distance);
     linear();
   }
   void visit(GNU_gama::local::Angle* element)
   {
     out << "</tr>\n<tr><td></td><td></td>"
         << tdRight(element->fs().str(), 2,2)
-        << tdLeft(T_GaMa_angle);
+        << tdLeft(lnet->texts().T_GaMa_angle);
     angular();
   }
   void visit(GNU_gama::local::H_Diff* /*element*/)
   {
-    out << tdLeft(T_GaMa_levell);
+    out << tdLeft(lnet->texts().T_GaMa_levell);
     linear();
   }
   void visit(GNU_gama::local::S_Distance* /*element*/)
   {
-    out << tdLeft(T_GaMa_s_distance);
+    out << tdLeft(lnet->texts().T_GaMa_s_distance);
     linear();
   }
   void visit(GNU_gama::local::Z_Angle* /*element*/)
   {
-    out << tdLeft(T_GaMa_z_angle);
+    out << tdLeft(lnet->texts().T_GaMa_z_angle);
     angular();
   }
   void visit(GNU_gama::local::X* /*element*/)
   {
-    out << tdLeft(T_GaMa_x);
+    out << tdLeft(lnet->texts().T_GaMa_x);
     linear();
   }
   void visit(GNU_gama::local::Y* /*element*/)
   {
-    out << tdLeft(T_GaMa_y);
+    out << tdLeft(lnet->texts().T_GaMa_y);
     linear();
   }
   void visit(GNU_gama::local::Z* /*element*/)
   {
-    out << tdLeft(T_GaMa_z);
+    out << tdLeft(lnet->texts().T_GaMa_z);
     linear();
   }
   void visit(GNU_gama::local::Xdiff* /*element*/)
   {
-    out << tdLeft(T_GaMa_xdiff);
+    out << tdLeft(lnet->texts().T_GaMa_xdiff);
     linear();
   }
   void visit(GNU_gama::local::Ydiff* /*element*/)
   {
-    out << tdLeft(T_GaMa_ydiff);
+    out << tdLeft(lnet->texts().T_GaMa_ydiff);
     linear();
   }
   void visit(GNU_gama::local::Zdiff* /*element*/)
   {
-    out << tdLeft(T_GaMa_zdiff);
+    out << tdLeft(lnet->texts().T_GaMa_zdiff);
     linear();
   }
   void visit(GNU_gama::local::Azimuth* /*element*/)
   {
-    out << tdLeft(T_GaMa_azimuth);
+    out << tdLeft(lnet->texts().T_GaMa_azimuth);
     angular();
   }
 
@@ -265,21 +265,21 @@ public:
   {
     out << "<tr>"
         << "<th>i</th>"
-        << "<th>" << T_GaMa_standpoint << tdSpace(2) << "</th>"
-        << "<th>" << T_GaMa_target << tdSpace(2) << "</th>"
+        << "<th>" << lnet->texts().T_GaMa_standpoint << tdSpace(2) << "</th>"
+        << "<th>" << lnet->texts().T_GaMa_target << tdSpace(2) << "</th>"
         << "<th></th>"
-        << "<th>" << T_HTML_observed << "</th>"
-        << "<th>" << T_HTML_adjusted << "</th>"
-        << "<th colspan='2'>" << T_HTML_stddev_confi << "</th>"
+        << "<th>" << lnet->texts().T_HTML_observed << "</th>"
+        << "<th>" << lnet->texts().T_HTML_adjusted << "</th>"
+        << "<th colspan='2'>" << lnet->texts().T_HTML_stddev_confi << "</th>"
         << "</tr>\n";
     out << "<tr><th colspan='4'></th>"
-        << "<th>" << T_HTML_value << "</th>";
+        << "<th>" << lnet->texts().T_HTML_value << "</th>";
     if (lnet->gons())
-      out << "<th>" << T_HTML_mg << "</th>"
-          << "<th colspan='2'>" << T_HTML_mmcc << "</th>";
+      out << "<th>" << lnet->texts().T_HTML_mg << "</th>"
+          << "<th colspan='2'>" << lnet->texts().T_HTML_mmcc << "</th>";
     else
-      out << "<th>" << T_HTML_md << "</th>"
-          << "<th colspan='2'>" << T_HTML_mmss << "</th>";
+      out << "<th>" << lnet->texts().T_HTML_md << "</th>"
+          << "<th colspan='2'>" << lnet->texts().T_HTML_mmss << "</th>";
     out << "</tr>";
   }
 
@@ -339,22 +339,22 @@ public:
   {
     out << "<tr>"
         << "<th>i</th>"
-        << "<th>" << T_GaMa_standpoint << tdSpace(2) << "</th>"
-        << "<th>" << T_GaMa_target << tdSpace(2) << "</th>"
+        << "<th>" << lnet->texts().T_GaMa_standpoint << tdSpace(2) << "</th>"
+        << "<th>" << lnet->texts().T_GaMa_target << tdSpace(2) << "</th>"
         << "<th></th>"
-        << "<th>" << T_HTML_f_proc << "</th><th></th>"
-        << "<th>" << T_HTML_r      << "</th>"
-        << "<th>" << T_HTML_rstud  << "</th><th></th>"
+        << "<th>" << lnet->texts().T_HTML_f_proc << "</th><th></th>"
+        << "<th>" << lnet->texts().T_HTML_r      << "</th>"
+        << "<th>" << lnet->texts().T_HTML_rstud  << "</th><th></th>"
         << "<th colspan='2'>"
-        << T_HTML_e_obs_adj << "</th>"
+        << lnet->texts().T_HTML_e_obs_adj << "</th>"
         << "</tr>\n";
     out << "<tr><th colspan='6'></th>";
     if (lnet->gons())
-      out << "<th>" << T_HTML_mmcc << "</th><th colspan='2'></th>"
-          << "<th colspan='2'>"<< T_HTML_mmcc << "</th>";
+      out << "<th>" << lnet->texts().T_HTML_mmcc << "</th><th colspan='2'></th>"
+          << "<th colspan='2'>"<< lnet->texts().T_HTML_mmcc << "</th>";
     else
-      out << "<th>" << T_HTML_mmss << "</th><th colspan='2'></th>"
-          << "<th colspan='2'>"<< T_HTML_mmss << "</th>";
+      out << "<th>" << lnet->texts().T_HTML_mmss << "</th><th colspan='2'></th>"
+          << "<th colspan='2'>"<< lnet->texts().T_HTML_mmss << "</th>";
     out << "</tr>";
 
     init_studres();
@@ -399,9 +399,9 @@ private:
     double f  = lnet->obs_control(index);
     out << tdRight(f, 'F', 1, 2,0);
     if (f < 0.1)
-      out << "<td>" << T_GaMa_resobs_no_control   << "</td>"; // uncontrolled
+      out << "<td>" << lnet->texts().T_GaMa_resobs_no_control   << "</td>"; // uncontrolled
     else if (f < 5)
-      out << "<td>" << T_GaMa_resobs_weak_control << "</td>"; // weak control
+      out << "<td>" << lnet->texts().T_GaMa_resobs_weak_control << "</td>"; // weak control
     else
       out << "<td></td>";
 
@@ -416,13 +416,13 @@ private:
         if (index == imax)
           {
             if (no > kki)
-              out << "<td>" << T_GaMa_resobs_mc_max_critical << "</td>";
+              out << "<td>" << lnet->texts().T_GaMa_resobs_mc_max_critical << "</td>";
             else
-              out << "<td>" << T_GaMa_resobs_mc_max << "</td>";
+              out << "<td>" << lnet->texts().T_GaMa_resobs_mc_max << "</td>";
           }
         else if (no > kki)
           {
-            out << "<td>" << T_GaMa_resobs_mc_critical << "</td>";
+            out << "<td>" << lnet->texts().T_GaMa_resobs_mc_critical << "</td>";
           }
         else
           {
@@ -569,6 +569,8 @@ void GamaLocalHTML::htmlBegin()
 
 void GamaLocalHTML::htmlInfo()
 {
+  const Texts& texts = lnet->texts();
+
   std::string& str = info.str;
   str.clear();
   if (!lnet->is_adjusted()) return;
@@ -577,7 +579,7 @@ void GamaLocalHTML::htmlInfo()
 
   if (!lnet->description.empty())
     {
-      out << "<h2>" << T_GaMa_network_description << "</h2>\n";
+      out << "<h2>" << texts.T_GaMa_network_description << "</h2>\n";
 
       if (lnet->description[0] == '<') // description in HTML
         out << lnet->description;
@@ -609,7 +611,7 @@ void GamaLocalHTML::htmlInfo()
   out << "<!-- output angular format -->";
   if (lnet->gons()) out << "<h2 id='angles400'>";
   else              out << "<h2 id='angles360'>";
-  out << T_GaMa_General_solution_parameters << "</h2>";
+  out << texts.T_GaMa_General_solution_parameters << "</h2>";
 
   // summary of coordinates in adjustment
 
@@ -637,18 +639,18 @@ void GamaLocalHTML::htmlInfo()
   {
     const int N = 3;
     out << "<table id='coordinates_summary'>\n";
-    out << "<tr><th align='left'>" << T_GaMa_gpar1_coordinates << "</th>"
+    out << "<tr><th align='left'>" << texts.T_GaMa_gpar1_coordinates << "</th>"
         << "<th>xyz</th>" << "<th>xy</th>" << "<th>z</th>" <<  "</tr>\n";
-    out << "<tr>" << tdLeft(T_GaMa_gpar1_adjusted_coordinates,0,N)
+    out << "<tr>" << tdLeft(texts.T_GaMa_gpar1_adjusted_coordinates,0,N)
         << tdRight(a_xyz,N,N) << tdRight(a_xy,N,N)
         << tdRight(a_z,N,N) << "</tr>\n";
-    out << "<tr>" << tdLeft(T_GaMa_gpar1_constrained_coordinates,0,N)
+    out << "<tr>" << tdLeft(texts.T_GaMa_gpar1_constrained_coordinates,0,N)
         << tdRight(c_xyz,N,N) << tdRight(c_xy,N,N)
         << tdRight(c_z,N,N) << "</tr>\n";
-    out << "<tr>" << tdLeft(T_GaMa_gpar1_fixed_coordinates,0,N)
+    out << "<tr>" << tdLeft(texts.T_GaMa_gpar1_fixed_coordinates,0,N)
         << tdRight(f_xyz,N,N) << tdRight(f_xy,N,N)
         << tdRight(f_z,N,N) << "</tr>\n";
-    out << "<tr>" << tdLeft(T_GaMa_gpar1_total,0,N)
+    out << "<tr>" << tdLeft(texts.T_GaMa_gpar1_total,0,N)
         << tdRight(f_xyz + a_xyz,N,N)
         << tdRight(f_xy  + a_xy,N,N)
         << tdRight(f_z   + a_z,N,N) + "</tr>\n";
@@ -683,41 +685,41 @@ void GamaLocalHTML::htmlInfo()
     out << "<table id='observations_summary'>\n";
     if (pocsmer)
       {
-        out << "<tr id='count_dir'>" << tdLeft(T_GaMa_gpar1_directions,0,2)
+        out << "<tr id='count_dir'>" << tdLeft(texts.T_GaMa_gpar1_directions,0,2)
             << tdRight(pocsmer, 0,8)
-            << tdLeft(T_GaMa_gpar2_bearings,0,2)
+            << tdLeft(texts.T_GaMa_gpar2_bearings,0,2)
             << tdRight(pocosn) + "</tr>\n";
       }
     if (pocuhl)
       {
-        out << "<tr id='count_ang'>" << tdLeft(T_GaMa_gpar1_angles,0,2)
+        out << "<tr id='count_ang'>" << tdLeft(texts.T_GaMa_gpar1_angles,0,2)
             << tdRight(pocuhl,  0,8) << "<td/><td/></tr>\n";
       }
     if (pocdel)
       {
-        out << "<tr id='count_dist'>" << tdLeft(T_GaMa_gpar1_distances,0,2)
+        out << "<tr id='count_dist'>" << tdLeft(texts.T_GaMa_gpar1_distances,0,2)
             << tdRight(pocdel,  0,8) << "<td/><td/></tr>\n";
       }
     if (pocsour)
       {
         out << "<tr id='count_coord'>"
-            << tdLeft(T_GaMa_gpar1_observed_coords,0,2)
+            << tdLeft(texts.T_GaMa_gpar1_observed_coords,0,2)
             << tdRight(pocsour, 0,8) << "<td/><td/></tr>\n";
       }
     if (pocnivp) // && (pocnivp != lnet->sum_observations()))
       {
         out << "<tr id='count_level'>"
-            << tdLeft(T_GaMa_gpar1_leveling_diffs,0,2)
+            << tdLeft(texts.T_GaMa_gpar1_leveling_diffs,0,2)
             << tdRight(pocnivp, 0,8) << "<td/><td/></tr>\n";
       }
     if (poczeni)
       {
-        out << "<tr id='count_zang'>" << tdLeft(T_GaMa_gpar1_z_angles,0,2)
+        out << "<tr id='count_zang'>" << tdLeft(texts.T_GaMa_gpar1_z_angles,0,2)
             << tdRight(poczeni, 0,8) << "<td/><td/></tr>\n";
       }
     if (pocsikm)
       {
-        out << "<tr id='count_sdist'>" << tdLeft(T_GaMa_gpar1_s_dists,0,2)
+        out << "<tr id='count_sdist'>" << tdLeft(texts.T_GaMa_gpar1_s_dists,0,2)
             << tdRight(pocsikm, 0,8) << "<td/><td/></tr>\n";
       }
     if (pocvec)
@@ -743,14 +745,14 @@ void GamaLocalHTML::htmlInfo()
     if (pocazim) types++;
     if (types != 1)
       {
-        out << "<tr id='count_total'>" << tdLeft(T_GaMa_gpar1_obs_total,0,2)
+        out << "<tr id='count_total'>" << tdLeft(texts.T_GaMa_gpar1_obs_total,0,2)
             << tdRight(lnet->sum_observations(),0,8) << "<td/><td/></tr>\n";
       }
     out << "</table>\n";
 
     if (!lnet->connected_network())
       {
-        out << "<table><tr>" << tdLeft(T_GaMa_network_not_connected)
+        out << "<table><tr>" << tdLeft(texts.T_GaMa_network_not_connected)
             << "</tr></table>\n";
       }
   }
@@ -761,26 +763,26 @@ void GamaLocalHTML::htmlInfo()
     try {
       if (lnet->min_n() < d)
         throw MatVecException(GNU_gama::Exception::BadRegularization,
-                              T_GaMa_not_enough_constrained_points);
+                              texts.T_GaMa_not_enough_constrained_points);
       lnet->trans_VWV();  // now let's try to adjust the nework
     }
     catch (const MatVecException& vs)
       {
         if (vs.error() != GNU_gama::Exception::BadRegularization) throw;
 
-        out << "<h3>" << T_GaMa_Free_network << "</h3>\n";
+        out << "<h3>" << texts.T_GaMa_Free_network << "</h3>\n";
 
         out << "<p>";
-        out << T_GaMa_Free_network_defect_is << int2str(d) << ". ";
-        out << T_GaMa_Given_network_configuration_can_not_be_adjusted
+        out << texts.T_GaMa_Free_network_defect_is << int2str(d) << ". ";
+        out << texts.T_GaMa_Given_network_configuration_can_not_be_adjusted
             << std::string(".\n");
         if (lnet->min_n() < d)
-          out << T_GaMa_not_enough_constrained_points + std::string(".");
+          out << texts.T_GaMa_not_enough_constrained_points + std::string(".");
         out << "</p>";
 
-        out << "<h4>" << T_GaMa_detected_singular_variables << "</h4>";
+        out << "<h4>" << texts.T_GaMa_detected_singular_variables << "</h4>";
         out << "<table><caption id='caption'>";
-        out << T_GaMa_index_type_point;
+        out << texts.T_GaMa_index_type_point;
         out << "</caption>\n";
 
         for (int i=1; i<=lnet->sum_unknowns(); i++)
@@ -801,21 +803,21 @@ void GamaLocalHTML::htmlInfo()
       << (lnet->connected_network() ?
           " id='connected_network'" :
           " id='disconnected_network'")
-      << "><td>" << T_GaMa_gpar1_equations << "</td>"
+      << "><td>" << texts.T_GaMa_gpar1_equations << "</td>"
       << tdRight(lnet->sum_observations(), 2,8)
-      << tdLeft(T_GaMa_gpar2_number_of_unknowns)
+      << tdLeft(texts.T_GaMa_gpar2_number_of_unknowns)
       << tdRight(lnet->sum_unknowns(), 2,0) << "</tr>\n";
-  out << "<tr>" << tdLeft(T_GaMa_gpar1_redundancy)
+  out << "<tr>" << tdLeft(texts.T_GaMa_gpar1_redundancy)
       << tdRight(lnet->degrees_of_freedom(),2,8)
-      << tdLeft(T_GaMa_gpar2_network_defect)
+      << tdLeft(texts.T_GaMa_gpar2_network_defect)
       << tdRight(lnet->null_space(),2,0) + "</tr>\n";
   out << "</table>\n";
 
   out << "<table id='sum_of_squares'>\n";
-  out << "<tr>" + tdLeft(T_GaMa_m0_apriori)
+  out << "<tr>" + tdLeft(texts.T_GaMa_m0_apriori)
       << tdRight(lnet->apriori_m_0(), 'F',2, 2,8)
       << "<td>&nbsp;</td><td>&nbsp;</td></tr>\n"
-      << "<tr>" + tdLeft(T_GaMa_m0_empirical)
+      << "<tr>" + tdLeft(texts.T_GaMa_m0_empirical)
       << tdRight((lnet->degrees_of_freedom() > 0 ?
         sqrt(lnet->trans_VWV()/lnet->degrees_of_freedom()) : 0), 'F',2, 2,8)
       << tdLeft("[pvv]",5,2)
@@ -824,18 +826,18 @@ void GamaLocalHTML::htmlInfo()
   out << "</table>\n";
 
   out << "<table id='standard_deviation'>\n";
-  out << "<tr>" + tdLeft(T_GaMa_During_statistical_analysis_we_work) + "</tr>";
+  out << "<tr>" + tdLeft(texts.T_GaMa_During_statistical_analysis_we_work) + "</tr>";
   out << "<tr id="
       << std::string(lnet->m_0_aposteriori()
                      ? "'a_posteriori'>" : "'a_priori'>")
       << tdLeft((lnet->m_0_aposteriori() ?
-              std::string(T_GaMa_statan_with_empirical_standard_deviation) :
-              std::string(T_GaMa_statan_with_apriori_standard_deviation)),3,0)
+              std::string(texts.T_GaMa_statan_with_empirical_standard_deviation) :
+              std::string(texts.T_GaMa_statan_with_apriori_standard_deviation)),3,0)
       <<  tdRight(double2str(lnet->m_0(), 'F', 2))
       << "</tr>\n";
 
   out << "<tr>"
-      << tdLeft(std::string(T_GaMa_statan_with_confidence_level), 3,0)
+      << tdLeft(std::string(texts.T_GaMa_statan_with_confidence_level), 3,0)
       << tdRight(double2str(lnet->conf_pr()*100, 'F', 0))
       << "<td>%</td>"
       << "</tr>\n";
@@ -854,7 +856,7 @@ void GamaLocalHTML::htmlInfo()
           bool   passed = dolni<testm0 && horni>testm0;
 
           out << "<table id='standard_deviation_2'><tr><td>"
-              << T_GaMa_Ratio_empirical_to_apriori
+              << texts.T_GaMa_Ratio_empirical_to_apriori
               << "</td><td></td>"
               << tdLeft(double2str(testm0, 'F',3))
               << "</tr>\n"
@@ -862,10 +864,10 @@ void GamaLocalHTML::htmlInfo()
               << (passed ? "'test_m0_passed'" : "'test_m0_failed'")
               << "><td>"
               << double2str(lnet->conf_pr()*100, 'F', 0)
-              << " % " << T_GaMa_interval << " "
+              << " % " << texts.T_GaMa_interval << " "
               << (passed ?
-                  T_GaMa_interval_contains :
-                  T_GaMa_interval_doesnt_contain)
+                  texts.T_GaMa_interval_contains :
+                  texts.T_GaMa_interval_doesnt_contain)
               << "</td>"
               << "<td>&nbsp;(</td><td>" << double2str(dolni, 'F',3)
               << "</td><td>,&nbsp;</td>"
@@ -904,7 +906,7 @@ void GamaLocalHTML::htmlInfo()
             {
               double ma = lnet->apriori_m_0();
               if (itd)
-                out << "<tr>" << tdLeft(T_GaMa_m0_distances)
+                out << "<tr>" << tdLeft(texts.T_GaMa_m0_distances)
                     << "<td></td>"
                     << tdLeft(double2str(m0d/ma, 'F', 3))
                     << "</tr>\n";
@@ -912,9 +914,9 @@ void GamaLocalHTML::htmlInfo()
                 {
                   out << "<tr><td>";
                   switch (its+itu) {
-                  case 1: out << T_GaMa_m0_directions; break;
-                  case 2: out << T_GaMa_m0_angles; break;
-                  case 3: out << T_GaMa_m0_dirs_angs; break;
+                  case 1: out << texts.T_GaMa_m0_directions; break;
+                  case 2: out << texts.T_GaMa_m0_angles; break;
+                  case 3: out << texts.T_GaMa_m0_dirs_angs; break;
                   }
                   out << "</td><td colspan='1'></td>"
                       << tdLeft(double2str(m0s/ma, 'F', 3))
@@ -964,7 +966,7 @@ void GamaLocalHTML::htmlInfo()
           double v = lnet->residuals()(imax);
           double q = lnet->wcoef_res(imax);
           double m_0_red = sqrt(fabs(lnet->trans_VWV()-v*v/q)/(nadb-1));
-          out << "<p>" << T_GaMa_Maximal_decrease_of_m0
+          out << "<p>" << texts.T_GaMa_Maximal_decrease_of_m0
               << double2str(m_0_red/lnet->apriori_m_0(), 'F', 3)
               << "</p>";
         }
@@ -972,25 +974,26 @@ void GamaLocalHTML::htmlInfo()
       if (imax > 0)
         {
           out << "<p id='max_decrease'>";
-          if (aprm0) out << T_GaMa_Maximal_normalized_residual;
-          else       out << T_GaMa_genpar_Maximal_studentized_residual;
+          if (aprm0) out << texts.T_GaMa_Maximal_normalized_residual;
+          else       out << texts.T_GaMa_genpar_Maximal_studentized_residual;
 
           out << double2str(max_stud, 'F', 2);
 
-          if (max_stud > krit_opr) out << T_GaMa_genpar_exceeds;
-          else                     out << T_GaMa_genpar_doesnt_exceed;
+          if (max_stud > krit_opr) out << texts.T_GaMa_genpar_exceeds;
+          else                     out << texts.T_GaMa_genpar_doesnt_exceed;
 
-          out << T_GaMa_genpar_critical_value
+          out << texts.T_GaMa_genpar_critical_value
               <<  double2str(krit_opr, 'F', 2) + "<br/>"
-              << T_GaMa_genpar_on_significance_level
+              << texts.T_GaMa_genpar_on_significance_level
               << double2str( (1 - lnet->conf_pr())*100, 'F', 0 )
-              << T_GaMa_genpar_for_observation_ind
+              << texts.T_GaMa_genpar_for_observation_ind
               << int2str(imax) + "<br/>";
 
           std::ostringstream outv;
           outv.setf(std::ios_base::fixed, std::ios_base::floatfield);
           outv.precision(4);
-          WriteVisitor<std::ostringstream> write_visitor(outv, true);
+          WriteVisitor<std::ostringstream> write_visitor(outv, true, lnet->gons(),
+                                                   lnet->format());
           ptr->accept(&write_visitor);
           out << str2html(outv.str());
 
@@ -1001,13 +1004,15 @@ void GamaLocalHTML::htmlInfo()
 
 void GamaLocalHTML::htmlUnknowns()
 {
+  const Texts& texts = lnet->texts();
+
   std::string& str = unknowns.str;
   str.clear();
   if (!lnet->is_adjusted()) return;
 
   HtmlStringStream out(str);
 
-  out << "<h2>" << T_HTML_points << "</h2>\n";
+  out << "<h2>" << texts.T_HTML_points << "</h2>\n";
 
   // fixed points
   {
@@ -1027,10 +1032,10 @@ void GamaLocalHTML::htmlUnknowns()
 
     if (pocpevb != 0 || pocpevv != 0)
       {
-        out << "<h3>" << T_GaMa_Review_of_fixed_points << "</h3>\n";
+        out << "<h3>" << texts.T_GaMa_Review_of_fixed_points << "</h3>\n";
 
         out << "<table id='fixed_points'>\n";
-        out << "<tr><th>" << T_GaMa_point << tdSpace(N_fixed) << "</th>";
+        out << "<tr><th>" << texts.T_GaMa_point << tdSpace(N_fixed) << "</th>";
         if (pocpevb) out << "<th>x</th><th>y</th>";
         if (pocpevv) out << "<th>z</th>";
         out << "</tr>\n";
@@ -1077,19 +1082,19 @@ void GamaLocalHTML::htmlUnknowns()
       HtmlStringStream out(coordinates_table_header);
       out << "<tr>"
           << "<th>i</th>"
-          << "<th>" << T_GaMa_point        << "</th>"
+          << "<th>" << texts.T_GaMa_point        << "</th>"
           << "<th></th>"    // '*' for constrained points
-          << "<th>" << T_HTML_approximate << "</th>"
-          << "<th>" << T_HTML_correction  << "</th>"
-          << "<th>" << T_HTML_adjusted    << "</th>"
-          << "<th colspan='2'>" << T_HTML_stddev_confi << "</th>"
+          << "<th>" << texts.T_HTML_approximate << "</th>"
+          << "<th>" << texts.T_HTML_correction  << "</th>"
+          << "<th>" << texts.T_HTML_adjusted    << "</th>"
+          << "<th colspan='2'>" << texts.T_HTML_stddev_confi << "</th>"
           << "</tr>\n"
           << "<tr>"
           << "<th colspan='3'>&nbsp;</th>"
-          << "<th>" << T_HTML_value << "</th>"
-          << "<th>" << T_HTML_m     << "</th>"
-          << "<th>" << T_HTML_value << "</th>"
-          << "<th colspan='2'>" << T_HTML_mm << "</th>"
+          << "<th>" << texts.T_HTML_value << "</th>"
+          << "<th>" << texts.T_HTML_m     << "</th>"
+          << "<th>" << texts.T_HTML_value << "</th>"
+          << "<th colspan='2'>" << texts.T_HTML_mm << "</th>"
           << "</tr>\n";
     }
 
@@ -1102,7 +1107,7 @@ void GamaLocalHTML::htmlUnknowns()
         }
     if (coordinates)
       {
-        out << "<h3>" << T_GaMa_adjunk_Review_of_unknowns_coordidantes
+        out << "<h3>" << texts.T_GaMa_adjunk_Review_of_unknowns_coordidantes
             << "</h3>\n";
 
         out << "<table id='adjusted_coordinates'>\n";
@@ -1205,30 +1210,30 @@ void GamaLocalHTML::htmlUnknowns()
       {
         const double scale  = lnet->gons() ? 1.0 : 0.324;
 
-        out << "<h3>" << T_GaMa_adjunk_Review_of_unknowns_bearings
+        out << "<h3>" << texts.T_GaMa_adjunk_Review_of_unknowns_bearings
             << "</h3>\n";
 
         out << "<table id='adjusted_orientations'>"
             << "<tr>"
             << "<th>i</th>"
-            << "<th>" << T_GaMa_point << "</th>"
-            << "<th>" << T_HTML_approximate << "</th>"
-            << "<th>" << T_HTML_correction  << "</th>"
-            << "<th>" << T_HTML_adjusted    << "</th>"
-            << "<th colspan='2'>" << T_HTML_stddev_confi << "</th>"
+            << "<th>" << texts.T_GaMa_point << "</th>"
+            << "<th>" << texts.T_HTML_approximate << "</th>"
+            << "<th>" << texts.T_HTML_correction  << "</th>"
+            << "<th>" << texts.T_HTML_adjusted    << "</th>"
+            << "<th colspan='2'>" << texts.T_HTML_stddev_confi << "</th>"
             << "</tr>\n";
         out << "<tr>"
             << "<th colspan='2'></th>";
         if (lnet->gons())
-          out << "<th>" << T_HTML_value_g << "</th>"
-              << "<th>" << T_HTML_g       << "</th>"
-              << "<th>" << T_HTML_value_g << "</th>"
-              << "<th colspan='2'>" << T_HTML_cc << "</th>";
+          out << "<th>" << texts.T_HTML_value_g << "</th>"
+              << "<th>" << texts.T_HTML_g       << "</th>"
+              << "<th>" << texts.T_HTML_value_g << "</th>"
+              << "<th colspan='2'>" << texts.T_HTML_cc << "</th>";
         else
-          out << "<th>" << T_HTML_value_d << "</th>"
-              << "<th>" << T_HTML_d       << "</th>"
-              << "<th>" << T_HTML_value_d << "</th>"
-              << "<th colspan='2'>" << T_HTML_ss << "</th>";
+          out << "<th>" << texts.T_HTML_value_d << "</th>"
+              << "<th>" << texts.T_HTML_d       << "</th>"
+              << "<th>" << texts.T_HTML_value_d << "</th>"
+              << "<th colspan='2'>" << texts.T_HTML_ss << "</th>";
         out << "</tr>\n";
 
         for (int i=1; i<=pocnez; i++)
@@ -1285,7 +1290,7 @@ void GamaLocalHTML::htmlUnknowns()
       {
         PointID prev_id;
 
-        out << "<h3>" << T_GaMa_adjunk_Review_of_unknowns_heights
+        out << "<h3>" << texts.T_GaMa_adjunk_Review_of_unknowns_heights
             << "</h3>\n";
 
         out << "<table id='adjusted_heights'>\n";
@@ -1368,17 +1373,17 @@ void GamaLocalHTML::htmlUnknowns()
         int pocbod = 0;
 
         out << "<h3>"
-            << T_GaMa_errell_review_of_mean_errors_and_error_ellipses
+            << texts.T_GaMa_errell_review_of_mean_errors_and_error_ellipses
             << "</h3>\n";
 
         out << "<table id='error_ellipses'>\n";
 
         out << "<tr>"
-            << "<th>" << T_GaMa_point << "</th>"
-            << "<th>" << T_HTML_mp    << "</th>"
-            << "<th>" << T_HTML_mxy   << "</th>"
-            << "<th colspan='3'>" << T_HTML_mean_error_ellipse << "</th>"
-            << "<th colspan='2'>" << T_HTML_confidence << "</th>"
+            << "<th>" << texts.T_GaMa_point << "</th>"
+            << "<th>" << texts.T_HTML_mp    << "</th>"
+            << "<th>" << texts.T_HTML_mxy   << "</th>"
+            << "<th colspan='3'>" << texts.T_HTML_mean_error_ellipse << "</th>"
+            << "<th colspan='2'>" << texts.T_HTML_confidence << "</th>"
             << "<th>g</th>"
             << "</tr>\n";
 
@@ -1455,11 +1460,11 @@ void GamaLocalHTML::htmlUnknowns()
         if (pocbod >= 5)
           {
             out << "<p>"
-                << T_GaMa_adjunk_mean_position_error_maximal
+                << texts.T_GaMa_adjunk_mean_position_error_maximal
                 << double2str(mp_max, 'F', 1)
-                << T_GaMa_adjunk_mean_position_error_on_point
+                << texts.T_GaMa_adjunk_mean_position_error_on_point
                 << mp_max_cb.str() << "<br/>"
-                << T_GaMa_adjunk_mean_position_error_average
+                << texts.T_GaMa_adjunk_mean_position_error_average
                 << double2str(mp_prum/pocbod, 'F', 1)
                 << " mm</p>\n";
           }
@@ -1475,9 +1480,9 @@ void GamaLocalHTML::htmlObservations()
 
   HtmlStringStream out(str);
 
-  out << "<h2>" << T_HTML_observations << "</h2>\n";
+  out << "<h2>" << lnet->texts().T_HTML_observations << "</h2>\n";
 
-  out << "<h3>" << T_HTML_adjusted_observations << "</h3>\n";
+  out << "<h3>" << lnet->texts().T_HTML_adjusted_observations << "</h3>\n";
   out << "<table id='adjusted_observations'>\n";
 
   HtmlAdjustedObservationsVisitor visitor(out, lnet);
@@ -1498,7 +1503,7 @@ void GamaLocalHTML::htmlResiduals()
   HtmlStringStream out(str);
 
   out << "<h3>"
-      << T_GaMa_resobs_Review_of_residuals_analysis_obs << "</h3>\n";
+      << lnet->texts().T_GaMa_resobs_Review_of_residuals_analysis_obs << "</h3>\n";
   out << "<table id='residuals'>\n";
 
   std::vector<int> index;
@@ -1511,7 +1516,7 @@ void GamaLocalHTML::htmlResiduals()
 
   if (const int M = index.size())
     {
-      out << "<h3>" << T_GaMa_resobs_Outlying_observations << "</h3>\n";
+      out << "<h3>" << lnet->texts().T_GaMa_resobs_Outlying_observations << "</h3>\n";
       out << "<table id='outlying_observations'>\n";
 
       HtmlAdjustedResidualsVisitor rvis(out, lnet);
@@ -1526,6 +1531,8 @@ void GamaLocalHTML::htmlResiduals()
 
 void GamaLocalHTML::htmlRejected()
 {
+  const Texts& texts = lnet->texts();
+
   std::string& str = rejected.str;
   str.clear();
   if (!lnet->is_adjusted()) return;
@@ -1534,11 +1541,11 @@ void GamaLocalHTML::htmlRejected()
   bool obs    =  lnet->sum_rejected_observations().size() > 0;
   if (!points && !obs) return;
 
-  str  = "<h2>" + std::string(T_HTML_rejected) + "</h2>\n";
+  str  = "<h2>" + std::string(texts.T_HTML_rejected) + "</h2>\n";
 
   if (points)
     {
-      str += "<h3>" + std::string(T_HTML_points) + "</h3>\n";
+      str += "<h3>" + std::string(texts.T_HTML_points) + "</h3>\n";
       str += "<table id='rejected_points'>\n";
 
       const char* codes[] = { "missing xyz",
@@ -1575,7 +1582,7 @@ void GamaLocalHTML::htmlRejected()
 
   if (obs)
     {
-      str += "<h3>" + std::string(T_HTML_observations) + "</h3>\n";
+      str += "<h3>" + std::string(texts.T_HTML_observations) + "</h3>\n";
       str += "<table id='rejected_observations'>\n";
 
       for (ObservationList::const_iterator
@@ -1587,7 +1594,8 @@ void GamaLocalHTML::htmlRejected()
           Observation* obs = const_cast<Observation*>(*i);
           std::ostringstream out;
           out.setf(std::ios_base::fixed, std::ios_base::floatfield);
-          WriteVisitor<std::ostringstream> write_visitor(out, true);
+          WriteVisitor<std::ostringstream> write_visitor(out, true, lnet->gons(),
+                                                   lnet->format());
           obs->accept(&write_visitor);
 
           str += "<tr>" + tdLeft(out.str()) + "</tr>\n";
@@ -1604,6 +1612,8 @@ void GamaLocalHTML::htmlEnd()
 
 void GamaLocalHTML::htmlTerms()
 {
+  const Texts& texts = lnet->texts();
+
   std::string& str = terms.str;
   str.clear();
   if (!lnet->is_adjusted()) return;
@@ -1613,10 +1623,10 @@ void GamaLocalHTML::htmlTerms()
 
   if (iterations > 0 || lintest)
     {
-      str += "<h2>" + std::string(T_GaMa_linearization) + "</h2>\n";
+      str += "<h2>" + std::string(texts.T_GaMa_linearization) + "</h2>\n";
       str += "<table id='linearization_iterations'>\n";
       str += "<tr><td>";
-      str += T_GaMa_Number_of_linearization_iterations;
+      str += texts.T_GaMa_Number_of_linearization_iterations;
       str += "</td><td>" + std::to_string(iterations) + "</td></tr></table>\n";
     }
 
@@ -1625,14 +1635,14 @@ void GamaLocalHTML::htmlTerms()
   str += "<table id='linearization_errors'>";
   str += "<tr>";
   str += "<th colspan='4'>"
-      + std::string(T_GaMa_tstlin_Test_of_linearization_error) + "</th>";
+      + std::string(texts.T_GaMa_tstlin_Test_of_linearization_error) + "</th>";
   str += "<th>observed</th>";
   str += "<th>r</th><th colspan='2'>difference</th>";
   str += "</tr>\n";
   str += "<tr>";
   str += "<th>i</th>";
-  str += "<th>" + std::string(T_GaMa_standpoint) + "</th>";
-  str += "<th>" + std::string(T_GaMa_target) + "</th>";
+  str += "<th>" + std::string(texts.T_GaMa_standpoint) + "</th>";
+  str += "<th>" + std::string(texts.T_GaMa_target) + "</th>";
   str += "<th></th>";
   str += "<th>value</th>";
   if (lnet->gons())
@@ -29,10 +29,10 @@ using namespace GNU_gama::local;
 using namespace std;
 
 
-void LocalLinearization::direction(const Direction* obs) const
+void LocalLinearization::direction(const Direction* obs,
+                                   LocalPoint& sbod, LocalPoint& cbod,
+                                   double value) const
 {
-   LocalPoint& sbod = PD[obs->from()];
-   LocalPoint& cbod = PD[obs->to()];
    double s, d;
    bearing_distance(sbod, cbod, s, d);
    // const double p = m0 / obs->stdDev();
@@ -44,7 +44,7 @@ void LocalLinearization::direction(const Direction* obs) const
    StandPoint* sp = const_cast<StandPoint*>(csp);
 
    // double w = p*p;                                       // weight
-   double a = (obs->value() + sp->orientation() - s)*GNU_gama::RAD_TO_CC;  // rhs
+   double a = (value + sp->orientation() - s)*GNU_gama::RAD_TO_CC;         // rhs
 
    while (a > 200e4)
       a -= 400e4;
@@ -82,18 +82,17 @@ void LocalLinearization::direction(const Direction* obs) const
 }
 
 
-void LocalLinearization::distance(const Distance* obs) const
+void LocalLinearization::distance(LocalPoint& sbod, LocalPoint& cbod,
+                                  double value) const
 {
-   LocalPoint& sbod = PD[obs->from()];
-   LocalPoint& cbod = PD[obs->to()];
    double s, d;
-   bearing_distance(PD[obs->from()], PD[obs->to()], s, d);
+   bearing_distance(sbod, cbod, s, d);
    // double p = M_0 / stdDev();
    double ps = sin(s);
    double pc = cos(s);
 
    // double w = p*p;                  // weight
-   rhs = (obs->value() - d)*1e3;       // abs. term in millimetres
+   rhs = (value - d)*1e3;              // abs. term in millimetres
 
    size = 0;
    if (sbod.free_xy())
@@ -121,15 +120,14 @@ void LocalLinearization::distance(const Distance* obs) const
 }
 
 
-void LocalLinearization::h_diff(const H_Diff* obs) const
+void LocalLinearization::h_diff(LocalPoint& sbod, LocalPoint& cbod,
+                                double value) const
 {
-   LocalPoint& sbod = PD[obs->from()];
-   LocalPoint& cbod = PD[obs->to()];
    double h = cbod.z() - sbod.z();
    // double p = M_0 / stdDev();
 
    // double w = p*p;                  // weight
-   rhs = (obs->value() - h)*1e3;       // abs. term in millimetres
+   rhs = (value - h)*1e3;              // abs. term in millimetres
 
    size = 0;
    if (sbod.free_z())
@@ -149,10 +147,9 @@ void LocalLinearization::h_diff(const H_Diff* obs) const
 }
 
 
-void LocalLinearization::s_distance(const S_Distance* obs) const
+void LocalLinearization::s_distance(LocalPoint& sbod, LocalPoint& cbod,
+                                    double value) const
 {
-   LocalPoint& sbod = PD[obs->from()];
-   LocalPoint& cbod = PD[obs->to()];
    // double s, sd;
    // bearing_sdistance(PD[obs->from()], PD[obs->to()], s, sd);
    // double p = M_0 / stdDev();
@@ -161,14 +158,14 @@ void LocalLinearization::s_distance(const S_Distance* obs) const
    double dz = cbod.z() - sbod.z();
    double sd = sqrt(dx*dx + dy*dy + dz*dz);
    if (sd == 0)
-     throw GNU_gama::local::Exception(T_POBS_zero_or_negative_slope_distance);
+     throw GNU_gama::local::Exception(texts.T_POBS_zero_or_negative_slope_distance);
 
    double px = dx / sd;
    double py = dy / sd;
    double pz = dz / sd;
 
    // double w = p*p;                // weight
-   rhs = (obs->value() - sd)*1e3;    // abs. term in millimetres
+   rhs = (value - sd)*1e3;           // abs. term in millimetres
 
    size = 0;
    if (sbod.free_xy())
@@ -210,13 +207,12 @@ void LocalLinearization::s_distance(const S_Distance* obs) const
 }
 
 
-void LocalLinearization::x(const X* obs) const
+void LocalLinearization::x(LocalPoint& point, double value) const
 {
-   LocalPoint& point = PD[obs->from()];
    // double p = M_0 / stdDev();
 
    // double w = p*p;                          // weight
-   rhs = (obs->value() - point.x())*1e3;       // abs. term in millimetres
+   rhs = (value - point.x())*1e3;              // abs. term in millimetres
 
    size = 0;
    if (point.free_xy())
@@ -229,13 +225,12 @@ void LocalLinearization::x(const X* obs) const
 }
 
 
-void LocalLinearization::y(const Y* obs) const
+void LocalLinearization::y(LocalPoint& point, double value) const
 {
-   LocalPoint& point = PD[obs->from()];
    // double p = M_0 / stdDev();
 
    // double w = p*p;                          // weight
-   rhs = (obs->value() - point.y())*1e3;       // abs. term in millimetres
+   rhs = (value - point.y())*1e3;              // abs. term in millimetres
 
    size = 0;
    if (point.free_xy())
@@ -248,13 +243,12 @@ void LocalLinearization::y(const Y* obs) const
 }
 
 
-void LocalLinearization::z(const Z* obs) const
+void LocalLinearization::z(LocalPoint& point, double value) const
 {
-   LocalPoint& point = PD[obs->from()];
    // double p = M_0 / stdDev();
 
    // double w = p*p;                          // weight
-   rhs = (obs->value() - point.z())*1e3;       // abs. term in millimetres
+   rhs = (value - point.z())*1e3;              // abs. term in millimetres
 
    size = 0;
    if (point.free_z())
@@ -267,15 +261,14 @@ void LocalLinearization::z(const Z* obs) const
 }
 
 
-void LocalLinearization::xdiff(const Xdiff* obs) const
+void LocalLinearization::xdiff(LocalPoint& spoint, LocalPoint& tpoint,
+                               double value) const
 {
-  LocalPoint& spoint = PD[obs->from()];               // stand point
-  LocalPoint& tpoint = PD[obs-> to() ];               // target
   double df = tpoint.x() - spoint.x();
   // double p  = M_0 / stdDev();
 
   // double w = p*p;                             // weight
-  rhs = (obs->value() - df)*1e3;                 // abs. term in millimetres
+  rhs = (value - df)*1e3;                        // abs. term in millimetres
 
   size = 0;
   if (spoint.free_xy())
@@ -295,15 +288,14 @@ void LocalLinearization::xdiff(const Xdiff* obs) const
 }
 
 
-void LocalLinearization::ydiff(const Ydiff* obs) const
+void LocalLinearization::ydiff(LocalPoint& spoint, LocalPoint& tpoint,
+                               double value) const
 {
-  LocalPoint& spoint = PD[obs->from()];
-  LocalPoint& tpoint = PD[obs-> to() ];
   double df = tpoint.y() - spoint.y();
   // double p = M_0 / stdDev();
 
   // double w = p*p;
-  rhs = (obs->value() - df)*1e3;
+  rhs = (value - df)*1e3;
 
   size = 0;
   if (spoint.free_xy())
@@ -323,15 +315,14 @@ void LocalLinearization::ydiff(const Ydiff* obs) const
 }
 
 
-void LocalLinearization::zdiff(const Zdiff* obs) const
+void LocalLinearization::zdiff(LocalPoint& spoint, LocalPoint& tpoint,
+                               double value) const
 {
-  LocalPoint& spoint = PD[obs->from()];
-  LocalPoint& tpoint = PD[obs-> to() ];
   double df = tpoint.z() - spoint.z();
   // double p = M_0 / stdDev();
 
   // double w = p*p;
-  rhs = (obs->value() - df)*1e3;
+  rhs = (value - df)*1e3;
 
   size = 0;
   if (spoint.free_z())
@@ -351,10 +342,9 @@ void LocalLinearization::zdiff(const Zdiff* obs) const
 }
 
 
-void LocalLinearization::z_angle(const Z_Angle* obs) const
+void LocalLinearization::z_angle(LocalPoint& sbod, LocalPoint& cbod,
+                                 double value) const
 {
-   LocalPoint& sbod = PD[obs->from()];
-   LocalPoint& cbod = PD[obs->to()];
    // double s, d, sd;
    // bearing_distance(PD[obs->from()], PD[obs->to()], s, d);
    // bearing_sdistance(PD[obs->from()], PD[obs->to()], s, sd);
@@ -367,7 +357,7 @@ void LocalLinearization::z_angle(const Z_Angle* obs) const
    double d  = sqrt(d2);
    double sd = sqrt(d2 + dz*dz);
    if (d == 0 || sd == 0)
-     throw GNU_gama::local::Exception(T_POBS_zero_or_negative_zenith_angle);
+     throw GNU_gama::local::Exception(texts.T_POBS_zero_or_negative_zenith_angle);
 
    double k  = 10*GNU_gama::RAD_TO_GON/(d*sd*sd);
 
@@ -379,8 +369,8 @@ void LocalLinearization::z_angle(const Z_Angle* obs) const
 
    double za = acos(dz/sd);
 
-   if (obs->value() > GNU_gama::PI) za = 2*GNU_gama::PI - za;
-   double a  = (obs->value() - za);
+   if (value > GNU_gama::PI) za = 2*GNU_gama::PI - za;
+   double a  = (value - za);
 
    rhs = a * GNU_gama::RAD_TO_CC; // abs. term in cc
    size = 0;
@@ -423,14 +413,13 @@ void LocalLinearization::z_angle(const Z_Angle* obs) const
 }
 
 
-void LocalLinearization::angle(const Angle* obs) const
+void LocalLinearization::angle(LocalPoint& sbod,
+                               LocalPoint& cbod1, LocalPoint& cbod2,
+                               double value) const
 {
-   LocalPoint& sbod  = PD[obs->from()];
-   LocalPoint& cbod1 = PD[obs->bs()];
-   LocalPoint& cbod2 = PD[obs->fs()];
    double s1, d1, s2, d2;
-   bearing_distance(PD[obs->from()], PD[obs->bs()], s1, d1);
-   bearing_distance(PD[obs->from()], PD[obs->fs()], s2, d2);
+   bearing_distance(sbod, cbod1, s1, d1);
+   bearing_distance(sbod, cbod2, s2, d2);
    // double p = m0 / obs->stdDev();
    const double K1 = 10*GNU_gama::RAD_TO_GON/d1;
    const double K2 = 10*GNU_gama::RAD_TO_GON/d2;
@@ -442,7 +431,7 @@ void LocalLinearization::angle(const Angle* obs) const
    // double w = p*p;                          // weight
    double ds = s2 - s1;
    if (ds < 0) ds += 2*GNU_gama::PI;
-   double a = (obs->value() - ds)*GNU_gama::RAD_TO_CC;        // rhs
+   double a = (value - ds)*GNU_gama::RAD_TO_CC;               // rhs
    // "big" positive/negative angle transformed to "lesser" positive/negative
    while (a > 200e4)
       a -= 400e4;
@@ -487,10 +476,9 @@ void LocalLinearization::angle(const Angle* obs) const
 }
 
 
-void LocalLinearization::azimuth(const Azimuth* obs) const
+void LocalLinearization::azimuth(LocalPoint& sbod, LocalPoint& cbod,
+                                 double value) const
 {
-   LocalPoint& sbod = PD[obs->from()];
-   LocalPoint& cbod = PD[obs->to()];
    double s, d;
    bearing_distance(sbod, cbod, s, d);
    const double K = 10*GNU_gama::RAD_TO_GON/d;
@@ -500,7 +488,7 @@ void LocalLinearization::azimuth(const Azimuth* obs) const
    // const StandPoint*  csp = static_cast<const StandPoint*>(obs->ptr_cluster()); ... unused
    // StandPoint* sp = const_cast<StandPoint*>(csp); ... unused
 
-   double a = (obs->value() + PD.xNorthAngle() - s)*GNU_gama::RAD_TO_CC;  // rhs
+   double a = (value + PD.xNorthAngle() - s)*GNU_gama::RAD_TO_CC;         // rhs
 
    while (a > 200e4)
       a -= 400e4;
@@ -532,3 +520,78 @@ void LocalLinearization::azimuth(const Azimuth* obs) const
       size++;
    }
 }
+
+
+// ...  LocalLinearizationIndexes  .......................................
+
+
+void LocalLinearizationIndexes::xy(const PointID& id)
+{
+   LocalPoint& p = PD[id];
+   if (p.free_xy())
+   {
+      if (!p.index_x()) p.index_x() = ++maxn;
+      if (!p.index_y()) p.index_y() = ++maxn;
+   }
+}
+
+
+void LocalLinearizationIndexes::z(const PointID& id)
+{
+   LocalPoint& p = PD[id];
+   if (p.free_z())
+   {
+      if (!p.index_z()) p.index_z() = ++maxn;
+   }
+}
+
+
+void LocalLinearizationIndexes::visit(Direction* obs)
+{
+   const StandPoint* csp = static_cast<const StandPoint*>(obs->ptr_cluster());
+   StandPoint* sp = const_cast<StandPoint*>(csp);
+   if (!sp->index_orientation()) sp->index_orientation(++maxn);
+
+   xy(obs->from());
+   xy(obs->to());
+}
+
+
+void LocalLinearizationIndexes::visit(Angle* obs)
+{
+   xy(obs->from());
+   xy(obs->bs());
+   xy(obs->fs());
+}
+
+
+void LocalLinearizationIndexes::visit(X* obs)
+{
+   LocalPoint& p = PD[obs->from()];
+   if (p.free_xy() && !p.index_x()) p.index_x() = ++maxn;
+}
+
+
+void LocalLinearizationIndexes::visit(Y* obs)
+{
+   LocalPoint& p = PD[obs->from()];
+   if (p.free_xy() && !p.index_y()) p.index_y() = ++maxn;
+}
+
+
+void LocalLinearizationIndexes::visit(Xdiff* obs)
+{
+   LocalPoint& s = PD[obs->from()];
+   LocalPoint& t = PD[obs->to()];
+   if (s.free_xy() && !s.index_x()) s.index_x() = ++maxn;
+   if (t.free_xy() && !t.index_x()) t.index_x() = ++maxn;
+}
+
+
+void LocalLinearizationIndexes::visit(Ydiff* obs)
+{
+   LocalPoint& s = PD[obs->from()];
+   LocalPoint& t = PD[obs->to()];
+   if (s.free_xy() && !s.index_y()) s.index_y() = ++maxn;
+   if (t.free_xy() && !t.index_y()) t.index_y() = ++maxn;
+}
@@ -33,36 +33,92 @@
 
 #include <gnu_gama/local/observation.h>
 #include <gnu_gama/local/gamadata.h>
+#include <gnu_gama/local/observation_store.h>
 
 namespace GNU_gama { namespace local {
 
-  /** Local linearization class implemented as a visitor. */
-  class LocalLinearization : public AllObservationsVisitor
+  /** Local linearization class implemented as a visitor.
+   *
+   * Indexes of unknowns are assigned in the order of visited
+   * observations. If all indexes have been already assigned (see
+   * LocalLinearizationIndexes) points are not modified and separate
+   * instances can linearize observations in parallel.
+   */
+  class LocalLinearization final : public AllObservationsVisitor
     {
 
     public:
 
-      LocalLinearization(PointData& pd, double /*m*/)
-	: max_size(6), PD(pd), maxn(0) //, m0(m) ... unused
+      LocalLinearization(PointData& pd, double /*m*/, const Texts& t)
+	: PD(pd), texts(t), maxn(0) //, m0(m) ... unused
       {}
 
       int  unknowns() const { return maxn; }
 
-      void  visit(Direction *element)  { direction(element); }
-      void  visit(Distance *element)   { distance(element); }
-      void  visit(Angle *element)      { angle(element); }
-      void  visit(H_Diff *element)     { h_diff(element); }
-      void  visit(S_Distance *element) { s_distance(element); }
-      void  visit(Z_Angle *element)    { z_angle(element); }
-      void  visit(X *element)          { x(element); }
-      void  visit(Y *element)          { y(element); }
-      void  visit(Z *element)          { z(element); }
-      void  visit(Xdiff *element)      { xdiff(element); }
-      void  visit(Ydiff *element)      { ydiff(element); }
-      void  visit(Zdiff *element)      { zdiff(element); }
-      void  visit(Azimuth *element)    { azimuth(element); }
-
-      const   long    max_size; ///< maximal number of coefficients
+      void  visit(Direction *e)  { direction(e, from(e), to(e), e->value()); }
+      void  visit(Distance *e)   { distance(from(e), to(e), e->value()); }
+      void  visit(Angle *e)      { angle(from(e), to(e), fs(e), e->value()); }
+      void  visit(H_Diff *e)     { h_diff(from(e), to(e), e->value()); }
+      void  visit(S_Distance *e) { s_distance(from(e), to(e), e->value()); }
+      void  visit(Z_Angle *e)    { z_angle(from(e), to(e), e->value()); }
+      void  visit(X *e)          { x(from(e), e->value()); }
+      void  visit(Y *e)          { y(from(e), e->value()); }
+      void  visit(Z *e)          { z(from(e), e->value()); }
+      void  visit(Xdiff *e)      { xdiff(from(e), to(e), e->value()); }
+      void  visit(Ydiff *e)      { ydiff(from(e), to(e), e->value()); }
+      void  visit(Zdiff *e)      { zdiff(from(e), to(e), e->value()); }
+      void  visit(Azimuth *e)    { azimuth(from(e), to(e), e->value()); }
+
+      /* linearization of observation i of a block of ObservationStore,
+       * points and values are read from the block */
+
+      template <typename T> using Block = ObservationStore::Block<T>;
+
+      void  visit(const Block<Direction>& b, int i)
+      {
+        direction(b.obs[i], *b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<Distance>& b, int i)
+      {
+        distance(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<Angle>& b, int i)
+      {
+        angle(*b.from[i], *b.to[i], *b.fs[i], b.value[i]);
+      }
+      void  visit(const Block<H_Diff>& b, int i)
+      {
+        h_diff(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<S_Distance>& b, int i)
+      {
+        s_distance(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<Z_Angle>& b, int i)
+      {
+        z_angle(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<X>& b, int i) { x(*b.from[i], b.value[i]); }
+      void  visit(const Block<Y>& b, int i) { y(*b.from[i], b.value[i]); }
+      void  visit(const Block<Z>& b, int i) { z(*b.from[i], b.value[i]); }
+      void  visit(const Block<Xdiff>& b, int i)
+      {
+        xdiff(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<Ydiff>& b, int i)
+      {
+        ydiff(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<Zdiff>& b, int i)
+      {
+        zdiff(*b.from[i], *b.to[i], b.value[i]);
+      }
+      void  visit(const Block<Azimuth>& b, int i)
+      {
+        azimuth(*b.from[i], *b.to[i], b.value[i]);
+      }
+
+      static constexpr long max_size = 6; ///< maximal number of coefficients
       mutable double  rhs;
       mutable double  coeff[6];
       mutable long    index[6];
@@ -71,22 +127,82 @@ namespace GNU_gama { namespace local {
     private:
 
       PointData&           PD;
+      const Texts&         texts;   // texts of exceptions
       mutable int          maxn;
       // double               m0; ... unused
 
-      void direction  (const Direction  *obs) const;
-      void distance   (const Distance   *obs) const;
-      void angle      (const Angle      *obs) const;
-      void h_diff     (const H_Diff     *obs) const;
-      void s_distance (const S_Distance *obs) const;
-      void z_angle    (const Z_Angle    *obs) const;
-      void x          (const X          *obs) const;
-      void y          (const Y          *obs) const;
-      void z          (const Z          *obs) const;
-      void xdiff      (const Xdiff      *obs) const;
-      void ydiff      (const Ydiff      *obs) const;
-      void zdiff      (const Zdiff      *obs) const;
-      void azimuth    (const Azimuth    *obs) const;
+      // no insertion to the map for existing points (thread safe)
+      LocalPoint& find_point(const PointID& id) const
+      {
+        PointData::iterator p = PD.find(id);
+        return p != PD.end() ? p->second : PD[id];
+      }
+
+      LocalPoint& from(const Observation* obs) const
+      {
+        return find_point(obs->from());
+      }
+      LocalPoint& to(const Observation* obs) const
+      {
+        return find_point(obs->to());
+      }
+      LocalPoint& fs(const Angle* obs) const
+      {
+        return find_point(obs->fs());
+      }
+
+      void direction  (const Direction* obs,
+                       LocalPoint& from, LocalPoint& to, double value) const;
+      void distance   (LocalPoint& from, LocalPoint& to, double value) const;
+      void angle      (LocalPoint& from, LocalPoint& bs, LocalPoint& fs,
+                       double value) const;
+      void h_diff     (LocalPoint& from, LocalPoint& to, double value) const;
+      void s_distance (LocalPoint& from, LocalPoint& to, double value) const;
+      void z_angle    (LocalPoint& from, LocalPoint& to, double value) const;
+      void x          (LocalPoint& point, double value) const;
+      void y          (LocalPoint& point, double value) const;
+      void z          (LocalPoint& point, double value) const;
+      void xdiff      (LocalPoint& from, LocalPoint& to, double value) const;
+      void ydiff      (LocalPoint& from, LocalPoint& to, double value) const;
+      void zdiff      (LocalPoint& from, LocalPoint& to, double value) const;
+      void azimuth    (LocalPoint& from, LocalPoint& to, double value) const;
+    };
+
+
+  /** Assigns indexes of unknowns in the same order as the class
+   *  LocalLinearization, so that linearization of observations can
+   *  be done in parallel without modifying point data. */
+  class LocalLinearizationIndexes : public AllObservationsVisitor
+    {
+
+    public:
+
+      LocalLinearizationIndexes(PointData& pd) : PD(pd), maxn(0) {}
+
+      int  unknowns() const { return maxn; }
+
+      void  visit(Direction *element);
+      void  visit(Distance *element)   { xy(element->from()); xy(element->to()); }
+      void  visit(Angle *element);
+      void  visit(H_Diff *element)     { z (element->from()); z (element->to()); }
+      void  visit(S_Distance *element) { xyz(element->from()); xyz(element->to()); }
+      void  visit(Z_Angle *element)    { xyz(element->from()); xyz(element->to()); }
+      void  visit(X *element);
+      void  visit(Y *element);
+      void  visit(Z *element)          { z (element->from()); }
+      void  visit(Xdiff *element);
+      void  visit(Ydiff *element);
+      void  visit(Zdiff *element)      { z (element->from()); z (element->to()); }
+      void  visit(Azimuth *element)    { xy(element->from()); xy(element->to()); }
+
+    private:
+
+      PointData&  PD;
+      int         maxn;
+
+      void xy (const PointID&);
+      void z  (const PointID&);
+      void xyz(const PointID& id) { xy(id); z(id); }
     };
 
 }}
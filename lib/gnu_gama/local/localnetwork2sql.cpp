@@ -29,28 +29,32 @@
 #include <Math/Business/Core/radian.h>
 #include <Utilities/Service/size_to.h>
 #include <Utilities/Business/version.h>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 using namespace GNU_gama::local;
 
 namespace {
 
-class WriteSQLVisitor : public GNU_gama::local::AllObservationsVisitor
+/* columns obs_type, from_id, to_id, to_id2, obs, adj and analysis of
+   observations in table gnu_gama_local_adj_observations */
+
+class AdjObservationRow : public GNU_gama::local::AllObservationsVisitor
 {
 private:
-    std::ostream&                  ostr;
+    SqlRows&                       rows;
     GNU_gama::local::LocalNetwork* netinfo;
     const GNU_gama::local::Vec&    residuals;
     int                            index;
-    const double                   y_sign;
     const double                   kki;
 
 public:
-    WriteSQLVisitor(std::ostream& outStream, GNU_gama::local::LocalNetwork* net)
-        : ostr(outStream), netinfo(net),
+    AdjObservationRow(SqlRows& sqlRows, GNU_gama::local::LocalNetwork* net)
+        : rows(sqlRows), netinfo(net),
           residuals(netinfo->residuals()),
-          index(0), y_sign(netinfo->y_sign()),
+          index(0),
           kki(netinfo->conf_int_coef())
     {
     }
@@ -68,12 +72,15 @@ public:
       double qrr = netinfo->wcoef_res(index);
       double f   = netinfo->obs_control(index);
 
-      ostr << ", " << angular << ", " << ml << ", " << qrr << ", " << f << ", ";
+      rows.set("angular", angular);
+      rows.set("stdev", ml);
+      rows.set("qrr", qrr);
+      rows.set("f", f);
 
       if (f >= 0.1)
       {
           double sr  = netinfo->studentized_residual(index);
-          ostr << sr << ", ";
+          rows.set("std_resid", sr);
 
           if ( (obs->ptr_cluster())->covariance_matrix.bandWidth() == 0 &&
                           (f >=5 || (f >= 0.1 && sr > kki)))
@@ -81,114 +88,184 @@ public:
               double em = residuals(index)/(netinfo->wcoef_res(index)*netinfo->weight_obs(index));
               double ev = em - residuals(index);
 
-              ostr << em << ", " << ev;
-          }
-          else
-          {
-              ostr << "NULL, NULL";
+              rows.set("err_obs", em);
+              rows.set("err_adj", ev);
           }
       }
-      else
-      {
-          ostr << "NULL, NULL, NULL";
-      }
-
-      ostr << ");\n";
     }
 
-    void visit(Distance* obs)
-    {
-      double m = obs->value();
-      double r = residuals(index)/1000;
-
-      ostr << "'distance', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
-    }
-    void visit(Direction* obs)
+    void visit(Distance* obs)   { linear ("distance",       obs); }
+    void visit(Direction* obs)  { angular("direction",      obs); }
+    void visit(H_Diff* obs)     { linear ("height-diff",    obs); }
+    void visit(S_Distance* obs) { linear ("slope-distance", obs); }
+    void visit(Z_Angle* obs)    { angular("zenith-angle",   obs); }
+    void visit(X* obs)          { linear ("coordinate-x",   obs); }
+    void visit(Y* obs)          { linear ("coordinate-y",   obs); }
+    void visit(Z* obs)          { linear ("coordinate-z",   obs); }
+    void visit(Xdiff* obs)      { linear ("dx",             obs); }
+    void visit(Ydiff* obs)      { linear ("dy",             obs); }
+    void visit(Zdiff* obs)      { linear ("dz",             obs); }
+    void visit(Azimuth* obs)    { angular("azimuth",        obs); }
+    void visit(Angle* obs)
     {
       double m = obs->value()*GNU_gama::RAD_TO_GON;
       double r = residuals(index)/10000;
 
-      ostr << "'direction', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      rows.set("obs_type", "angle");
+      rows.set("from_id", obs->from().str());
+      rows.set("to_id",   obs->bs().str());
+      rows.set("to_id2",  obs->fs().str());
+      rows.set("obs", m);
+      rows.set("adj", m+r);
     }
-    void visit(Angle* obs)
-    {
-        double m = obs->value()*GNU_gama::RAD_TO_GON;
-        double r = residuals(index)/10000;
 
-        ostr << "'angle', '" << obs->from() << "', '" << obs->bs() << "', '"
-	     << obs->fs() << "', " << m << ", " << m+r;
-    }
-    void visit(H_Diff* obs)
-    {
-      double m = obs->value();
-      double r = residuals(index)/1000;
+private:
 
-      ostr << "'height-diff', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
-    }
-    void visit(S_Distance* obs)
+    void linear(const char* tag, const Observation* obs)
     {
       double m = obs->value();
       double r = residuals(index)/1000;
-
-      ostr << "'slope-distance', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      row(tag, obs, m, m+r);
     }
-    void visit(Z_Angle* obs)
+    void angular(const char* tag, const Observation* obs)
     {
       double m = obs->value()*GNU_gama::RAD_TO_GON;
       double r = residuals(index)/10000;
-
-      ostr << "'zenith-angle', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      row(tag, obs, m, m+r);
     }
-    void visit(X* obs)
+    void row(const char* tag, const Observation* obs, double m, double a)
     {
-      double m = obs->value();
-      double r = residuals(index)/1000;
-
-      ostr << "'coordinate-x', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      rows.set("obs_type", tag);
+      rows.set("from_id", obs->from().str());
+      rows.set("to_id",   obs->to().str());
+      rows.set("obs", m);
+      rows.set("adj", a);
     }
-    void visit(Y* obs)
+};
+
+
+/* rows of an SQL script, configuration id is given by a subquery */
+
+class SqlScriptRows : public SqlRows
+{
+private:
+    std::ostream&      ostr;
+    const std::string  cnfg;
+    std::string        conf_id;
+    std::string        columns;
+    std::ostringstream values;
+
+public:
+    SqlScriptRows(std::ostream& outStream, std::string conf_id)
+      : ostr(outStream), cnfg(std::move(conf_id))
     {
-      double m = obs->value();
-      double r = residuals(index)/1000;
+      values.flags(ostr.flags());
+      values.precision(ostr.precision());
+    }
 
-      ostr << "'coordinate-y', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+    void remove(const char* table) override
+    {
+      ostr << "DELETE FROM " << table << " WHERE conf_id = " << cnfg << ";\n";
     }
-    void visit(Z* obs)
+    void insert(const char* table) override
     {
-      double m = obs->value();
-      double r = residuals(index)/1000;
-
-      ostr << "'coordinate-z', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      // a new configuration gets the next free id
+      conf_id = std::strcmp(table, "gnu_gama_local_configurations")
+        ? cnfg
+        : "(select new_id from (select coalesce(max(conf_id), 0)+1 as "
+          "new_id from gnu_gama_local_configurations)x)";
+      columns = std::string("insert into ") + table + " (conf_id";
+      values.str("");
     }
-    void visit(Xdiff* obs)
+    void set(const char* column, int value) override
     {
-      double m = obs->value();
-      double r = residuals(index)/1000;
-
-      ostr << "'dx', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      columns += std::string(", ") + column;
+      values << ", " << value;
     }
-    void visit(Ydiff* obs)
+    void set(const char* column, double value) override
     {
-      double m = obs->value();
-      double r = residuals(index)/1000;
-
-      ostr << "'dy', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      columns += std::string(", ") + column;
+      values << ", " << value;
     }
-    void visit(Zdiff* obs)
+    void set(const char* column, const std::string& value) override
     {
-      double m = obs->value();
-      double r = residuals(index)/1000;
-
-      ostr << "'dz', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+      columns += std::string(", ") + column;
+      values << ", '";
+      for (char c : value)
+        {
+          if (c == '\'') values << c;
+          values << c;
+        }
+      values << "'";
     }
-    void visit(Azimuth* obs)
+    using SqlRows::set;
+    void exec() override
     {
-      double m = obs->value()*GNU_gama::RAD_TO_GON;
-      double r = residuals(index)/10000;
+      ostr << columns << ") values (" << conf_id << values.str() << ");\n";
+    }
+};
+
+
+
+/* columns tag, from_id, to_id, to_id2, val, from_dh, to_dh, to_dh2 and
+   dist of table gnu_gama_local_obs, coordinates and vectors are stored
+   in their own tables */
+
+class ObsRow : public GNU_gama::local::AllObservationsVisitor
+{
+private:
+    SqlRows& rows;
 
-      ostr << "'azimuth', '" << obs->from() << "', '" << obs->to() << "', NULL, " << m << ", " << m+r;
+public:
+    ObsRow(SqlRows& sqlRows) : rows(sqlRows), stored(false) {}
+
+    bool stored;
+
+    void visit(Distance* obs)   { row("distance",   obs); }
+    void visit(Direction* obs)  { row("direction",  obs); }
+    void visit(S_Distance* obs) { row("s-distance", obs); }
+    void visit(Z_Angle* obs)    { row("z-angle",    obs); }
+    void visit(Azimuth* obs)    { row("azimuth",    obs); }
+    void visit(Angle* obs)
+    {
+      rows.set("tag", "angle");
+      rows.set("from_id", obs->from().str());
+      rows.set("to_id",   obs->bs().str());
+      rows.set("to_id2",  obs->fs().str());
+      rows.set("val", obs->value());
+      if (obs->from_dh()) rows.set("from_dh", obs->from_dh());
+      if (obs->bs_dh())   rows.set("to_dh",   obs->bs_dh());
+      if (obs->fs_dh())   rows.set("to_dh2",  obs->fs_dh());
+      stored = true;
+    }
+    void visit(H_Diff* obs)
+    {
+      rows.set("tag", "dh");
+      rows.set("from_id", obs->from().str());
+      rows.set("to_id",   obs->to().str());
+      rows.set("val", obs->value());
+      if (obs->dist()) rows.set("dist", obs->dist());
+      stored = true;
     }
+    void visit(X*)     {}
+    void visit(Y*)     {}
+    void visit(Z*)     {}
+    void visit(Xdiff*) {}
+    void visit(Ydiff*) {}
+    void visit(Zdiff*) {}
 
+private:
+
+    void row(const char* tag, const Observation* obs)
+    {
+      rows.set("tag", tag);
+      rows.set("from_id", obs->from().str());
+      rows.set("to_id",   obs->to().str());
+      rows.set("val", obs->value());
+      if (obs->from_dh()) rows.set("from_dh", obs->from_dh());
+      if (obs->to_dh())   rows.set("to_dh",   obs->to_dh());
+      stored = true;
+    }
 };
 
 }   // unnamed namespace
@@ -225,774 +302,621 @@ void LocalNetwork2sql::write(std::ostream& ostr, std::string conf)
        << " */\n"
        << "begin;\n\n";     // begin transaction
 
+  SqlScriptRows rows(ostr, cnfg());
+
   if (getDelete())
     {
-      ostr << "DELETE FROM gnu_gama_local_covmat         WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_descriptions   WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_points         WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_obs            WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_coordinates    WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_vectors        WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_clusters       WHERE conf_id = " << cnfg() << ";\n"
-
-           << "DELETE FROM gnu_gama_local_adj_network_general_parameters  WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_coordinates_summary         WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_observations_summary        WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_project_equations           WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_standard_deviation          WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_coordinates                 WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_orientation_shifts          WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_covmat                      WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_original_indexes            WHERE conf_id = " << cnfg() << ";\n"
-           << "DELETE FROM gnu_gama_local_adj_observations                WHERE conf_id = " << cnfg() << ";\n"
-
-           << "DELETE FROM gnu_gama_local_configurations WHERE conf_id = " << cnfg() << ";\n\n";
+      remove_configuration(rows);
+      ostr << "\n";
     }
 
+  write_configuration(rows, config);
+  ostr << "\n";
+  write_points(rows);
+
+  int cluster = 1;
+  for (const Cluster* c : observations.clusters)
+    {
+      ostr << "\n";
+      write_cluster(rows, c, cluster++);
+    }
+
+  /* adjusted results only when the network is adjusted */
+  if (localNetwork.is_adjusted())
+    {
+      write_results(rows);
+    }
+
+  ostr << "\ncommit;\n";  // commit transaction
+}
+
+
+void LocalNetwork2sql::remove_configuration(SqlRows& rows) const
+{
+  for (const char* table : {
+      "gnu_gama_local_covmat",
+      "gnu_gama_local_descriptions",
+      "gnu_gama_local_points",
+      "gnu_gama_local_obs",
+      "gnu_gama_local_coordinates",
+      "gnu_gama_local_vectors",
+      "gnu_gama_local_clusters" })
+    {
+      rows.remove(table);
+    }
+
+  remove_results(rows);
+  rows.remove("gnu_gama_local_configurations");
+}
+
+
+void LocalNetwork2sql::write_configuration(SqlRows& rows, const std::string& conf)
+{
   std::string axes = "ne";
   switch(localNetwork.PD.local_coordinate_system)
   {
-      case LocalCoordinateSystem::CS::EN: axes = "'en', "; break;
-      case LocalCoordinateSystem::CS::NW: axes = "'nw', "; break;
-      case LocalCoordinateSystem::CS::SE: axes = "'se', "; break;
-      case LocalCoordinateSystem::CS::WS: axes = "'ws', "; break;
-      case LocalCoordinateSystem::CS::NE: axes = "'ne', "; break;
-      case LocalCoordinateSystem::CS::SW: axes = "'sw', "; break;
-      case LocalCoordinateSystem::CS::ES: axes = "'es', "; break;
-      case LocalCoordinateSystem::CS::WN: axes = "'wn', "; break;
+      case LocalCoordinateSystem::CS::EN: axes = "en"; break;
+      case LocalCoordinateSystem::CS::NW: axes = "nw"; break;
+      case LocalCoordinateSystem::CS::SE: axes = "se"; break;
+      case LocalCoordinateSystem::CS::WS: axes = "ws"; break;
+      case LocalCoordinateSystem::CS::NE: axes = "ne"; break;
+      case LocalCoordinateSystem::CS::SW: axes = "sw"; break;
+      case LocalCoordinateSystem::CS::ES: axes = "es"; break;
+      case LocalCoordinateSystem::CS::WN: axes = "wn"; break;
       default:
-             axes =  "'ne', "; //break;*/
+             axes =  "ne"; //break;*/
   }
 
-  {
-    ostr <<  "insert into gnu_gama_local_configurations"
-         <<  " (conf_id, conf_name, sigma_apr, conf_pr, tol_abs, sigma_act,"
-         <<  " axes_xy, angles, ang_units,"
-         <<  " cov_band, algorithm, epoch, latitude, ellipsoid) values ("
-         <<  "(select new_id from (select coalesce(max(conf_id), 0)+1 as "
-         <<  "new_id from gnu_gama_local_configurations)x),"
-         <<  " '" + config +"', "
-         <<  localNetwork.apriori_m_0() << ", "
-         <<  localNetwork.conf_pr() << ", "
-         <<  localNetwork.tol_abs() << ", "
-         << (localNetwork.m_0_apriori()
-             ? "'apriori'" : "'aposteriori'") << ", "
-         <<  axes
-         << (localNetwork.PD.left_handed_angles()
-             ? "'left-handed'" : "'right-handed'") << ", "
-         << (localNetwork.gons() ? 400 : 360) << ", "
-         << localNetwork.adj_covband() << ", ";
-    // nullable data
-    if (localNetwork.has_algorithm()) ostr << "'" << localNetwork.algorithm()
-                                           << "', ";
-    else                              ostr << "NULL, ";
-    if (localNetwork.has_epoch())     ostr << localNetwork.epoch() << ", ";
-    else                              ostr << "NULL, ";
-    if (localNetwork.has_latitude())  ostr << localNetwork.latitude() << ", ";
-    else                              ostr << "NULL, ";
-    if (localNetwork.has_ellipsoid()) ostr << "'" << localNetwork.ellipsoid()
-                                           << "'";
-    else                              ostr << "NULL";
-    ostr << ");\n";
-  }
+  rows.insert("gnu_gama_local_configurations");
+  rows.set("conf_name", conf);
+  rows.set("sigma_apr", localNetwork.apriori_m_0());
+  rows.set("conf_pr",   localNetwork.conf_pr());
+  rows.set("tol_abs",   localNetwork.tol_abs());
+  rows.set("sigma_act", localNetwork.m_0_apriori() ? "apriori" : "aposteriori");
+  rows.set("axes_xy",   axes);
+  rows.set("angles",    localNetwork.PD.left_handed_angles()
+                        ? "left-handed" : "right-handed");
+  rows.set("ang_units", localNetwork.gons() ? 400 : 360);
+  rows.set("cov_band",  localNetwork.adj_covband());
+  // nullable data
+  if (localNetwork.has_algorithm()) rows.set("algorithm", localNetwork.algorithm());
+  if (localNetwork.has_epoch())     rows.set("epoch",     localNetwork.epoch());
+  if (localNetwork.has_latitude())  rows.set("latitude",  localNetwork.latitude());
+  if (localNetwork.has_ellipsoid()) rows.set("ellipsoid", localNetwork.ellipsoid());
+  rows.exec();
 
-  /* <points-observations> atributes */
-  // {
-  //   double da = gkfparser->implicit_stdev_distance_a();
-  //   double db = gkfparser->implicit_stdev_distance_b();
-  //   double dc = gkfparser->implicit_stdev_distance_c();
-  //   if (da + db != 0)
-  //     {
-  //    ostr << "insert into gnu_gama_local_atributes"
-  //         << " (conf_id, atribute, tag, value) values ("
-  //         << cnfg() << ", 'distance-stdev', 'points-observations', '" << da;
-  //    if (db)
-  //      ostr << " " << db << " " << dc;
-  //    ostr << "');\n";
-  //     }
-  //
-  //   if (double dir=gkfparser->implicit_stdev_direction())
-  //     {
-  //    ostr << "insert into gnu_gama_local_atributes (conf_id, atribute, tag, value) values ("
-  //         << cnfg() << ", 'direction-stdev', 'points-observations', '" << dir << "');\n";
-  //     }
-  //
-  //   if (double angle=gkfparser->implicit_stdev_angle())
-  //     {
-  //    ostr << "insert into gnu_gama_local_atributes (conf_id, atribute, tag, value) values ("
-  //         << cnfg() << ", 'angle-stdev', 'points-observations', '" << angle << "');\n";
-  //     }
-  //
-  //     if (double zangle=gkfparser->implicit_stdev_zangle())
-  //     {
-  //    ostr << "insert into gnu_gama_local_atributes (conf_id, atribute, tag, value) values ("
-  //         << cnfg() << ", 'zenith-angle-stdev', 'points-observations', '" << zangle << "');\n";
-  //     }
-  // }
+  /* <description> */
+  const std::string::size_type N = 1000;  // varchar('N') in gnu_gama_local_descriptions table;
+  const std::string& text = localNetwork.description;
+  for (std::string::size_type indx = 0; indx*N < text.length(); indx++)
+    {
+      rows.insert("gnu_gama_local_descriptions");
+      rows.set("indx", int(indx+1));
+      rows.set("text", text.substr(indx*N, N));
+      rows.exec();
+    }
+}
 
 
-  /* <description> */
-  if (!localNetwork.description.empty())
+void LocalNetwork2sql::write_points(SqlRows& rows)
+{
+  for (PointData::const_iterator i=points.begin(); i!=points.end(); ++i)
     {
-      const int N = 1000;  // varchar('N') in gnu_gama_local_descriptions table;
-      int indx = 0;
-      while (indx*N < size_to<int>(localNetwork.description.length()))
+      const PointID&    id = i->first;
+      const LocalPoint& pt = i->second;
+
+      rows.insert("gnu_gama_local_points");
+      rows.set("id", id.str());
+
+      if (pt.test_xy())
         {
-          const std::string& s = localNetwork.description.substr(indx*N, N);
-          std::string description;
-          for (std::string::const_iterator i=s.begin(); i!=s.end(); ++i)
-            if (*i == '\'')
-              description += "''";
-            else
-              description += *i;
-          ostr << "insert into gnu_gama_local_descriptions"
-               << " (conf_id, indx, text) values ("
-               << cnfg() << ", " << (indx+1) << ", '" << description << "');\n";
-          indx++;
+          rows.set("x", pt.x());
+          rows.set("y", pt.y());
         }
-    }
 
+      if (pt.test_z())
+        {
+          rows.set("z", pt.z());
+        }
 
-  /* <points-observations><point /> */
-  {
-    using namespace GNU_gama::local;
-    ostr << "\n";
-    for (PointData::const_iterator i=points.begin(); i!=points.end(); ++i)
-      {
-        const PointID&    id = i->first;
-        const LocalPoint& pt = i->second;
+      if (pt.active_xy())
+        {
+          if      (pt.fixed_xy()      )  rows.set("txy", "fixed");
+          else if (pt.constrained_xy())  rows.set("txy", "constrained");
+          else if (pt.free_xy()       )  rows.set("txy", "adjusted");
+        }
 
-        std::string atr = "conf_id, id";
-        std::ostringstream val;
-        val.setf(std::ios_base::fixed, std::ios_base::floatfield);
-        val.precision(17);
-        val << cnfg() << ", '" << id << "'";
+      if (pt.active_z())
+        {
+          if      (pt.fixed_z()      )  rows.set("tz", "fixed");
+          else if (pt.constrained_z())  rows.set("tz", "constrained");
+          else if (pt.free_z()       )  rows.set("tz", "adjusted");
+        }
 
-        if (pt.test_xy())
-          {
-            atr += ", x, y";
-            val << ", " << pt.x() << ", " << pt.y();
-          }
+      rows.exec();
+    }
+}
 
-        if (pt.test_z())
-          {
-            atr += ", z";
-            val << ", " << pt.z();
-          }
 
-        if (pt.active_xy())
-          {
-            atr += ", txy";
-            if      (pt.fixed_xy()      )  val << ", 'fixed'";
-            else if (pt.constrained_xy())  val << ", 'constrained'";
-            else if (pt.free_xy()       )  val << ", 'adjusted'";
-          }
+void LocalNetwork2sql::write_cluster(SqlRows& rows, const Cluster* c, int cluster)
+{
+  const ObservationList& list = c->observation_list;
 
-        if (pt.active_z())
-          {
-            atr += ", tz";
-            if      (pt.fixed_z()      )  val << ", 'fixed'";
-            else if (pt.constrained_z())  val << ", 'constrained'";
-            else if (pt.free_z()       )  val << ", 'adjusted'";
-          }
+  if (dynamic_cast<const StandPoint*>(c) ||
+      dynamic_cast<const HeightDifferences*>(c))
+    {
+      /* xml <obs> atributes from, orientation and from_dh,
+       * defined in gama-local.dtd, are ignored in database
+       * schema (from_dh is not even implemented in class
+       * StandPoint)
+       */
+      write_covmat(rows, c, cluster, dynamic_cast<const StandPoint*>(c)
+                                     ? "obs" : "height-differences");
+
+      ObsRow obsRow(rows);
+      int index = 1;
+      for (Observation* m : list)
+        {
+          rows.insert("gnu_gama_local_obs");
+          rows.set("ccluster", cluster);
+          rows.set("indx", index);
 
-        ostr << "insert into gnu_gama_local_points (" << atr << ") "
-             << "values (" << val.str() << ");\n";
-      }
-  }
+          obsRow.stored = false;
+          m->accept(&obsRow);
+          if (!obsRow.stored) continue;
 
+          rows.set("rejected", rejected(m));
+          rows.exec();
+          index++;
+        }
+    }
+  else if (dynamic_cast<const Coordinates*>(c))
+    {
+      write_covmat(rows, c, cluster, "coordinates");
 
-  /* clusters */
-  {
-    using namespace GNU_gama::local;
+      int index = 1, inc;
+      for (ObservationList::const_iterator
+             b = list.begin(), e = list.end();  b != e;  ++b)
+        {
+          inc = 0;
+          int rejected_point = 0;
+          std::string pointid = (*b)->from().str();
 
-    int cluster = 1;
-    for (GNU_gama::local::ObservationData::ClusterList::const_iterator
-           i=observations.clusters.begin(); i!=observations.clusters.end(); ++i)
-      {
-        const Cluster* c = *i;
-        if (/*const StandPoint* sp = */ dynamic_cast<const StandPoint*>(c))
-          {
-            /* xml <obs> atributes from, orientation and from_dh,
-             * defined in gama-local.dtd, are ignored in database
-             * schema (from_dh is not even implemented in class
-             * StandPoint)
-             */
-            write_cluster(ostr, c, cluster, "obs");
-
-            int index = 1;
-            for (ObservationList::const_iterator
-                   b = c->observation_list.begin(),
-                   e = c->observation_list.end();  b != e;  ++b)
-              {
-                // tag, from_id, to_id, to_id2, val, stdev, from_dh, to_dh, to_dh2, dist
-                if      (const Distance*   m = dynamic_cast<const Distance*  >(*b))
-                {
-                  ostr << "insert into gnu_gama_local_obs "
-                       << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                       << "val, from_dh, to_dh, rejected) values ("
-                       << cnfg() << ", " << cluster << ", "
-                       << index++ << ", 'distance', '"
-                       << m->from() << "', '" << m->to() << "', "
-                       << m->value();
-                  if (m->from_dh()) ostr << ", " << m->from_dh(); else ostr << ", null";
-                  if (m->to_dh()  ) ostr << ", " << m->to_dh();   else ostr << ", null";
-                  ostr << ", " << rejected(m) << ");\n";
-                }
-                else if (const Direction*  m = dynamic_cast<const Direction* >(*b))
-                {
-                  ostr << "insert into gnu_gama_local_obs "
-                       << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                       << "val, from_dh, to_dh, rejected) values ("
-                       << cnfg() << ", " << cluster << ", "
-                       << index++ << ", 'direction', '"
-                       << m->from() << "', '" << m->to() << "', "
-                       << m->value();
-                  if (m->from_dh()) ostr << ", " << m->from_dh(); else ostr << ", null";
-                  if (m->to_dh()  ) ostr << ", " << m->to_dh();   else ostr << ", null";
-                  ostr  << ", " << rejected(m) << ");\n";
-                }
-                else if (const S_Distance* m = dynamic_cast<const S_Distance*>(*b))
-                {
-                  ostr << "insert into gnu_gama_local_obs "
-                       << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                       << "val, from_dh, to_dh, rejected) values ("
-                       << cnfg() << ", " << cluster << ", "
-                       << index++ << ", 's-distance', '"
-                       << m->from() << "', '" << m->to() << "', "
-                       << m->value();
-                  if (m->from_dh()) ostr << ", " << m->from_dh(); else ostr << ", null";
-                  if (m->to_dh()  ) ostr << ", " << m->to_dh();   else ostr << ", null";
-                  ostr  << ", " << rejected(m) << ");\n";
-                }
-                else if (const Z_Angle*    m = dynamic_cast<const Z_Angle*   >(*b))
-                {
-                  ostr << "insert into gnu_gama_local_obs "
-                       << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                       << "val, from_dh, to_dh, rejected) values ("
-                       << cnfg() << ", " << cluster << ", "
-                       << index++ << ", 'z-angle', '"
-                       << m->from() << "', '" << m->to() << "', "
-                       << m->value();
-                  if (m->from_dh()) ostr << ", " << m->from_dh(); else ostr << ", null";
-                  if (m->to_dh()  ) ostr << ", " << m->to_dh();   else ostr << ", null";
-                  ostr  << ", " << rejected(m) << ");\n";
-                }
-                else if (const Azimuth*    m = dynamic_cast<const Azimuth*   >(*b))
+          rows.insert("gnu_gama_local_coordinates");
+          rows.set("ccluster", cluster);
+          rows.set("indx", index);
+          rows.set("id", pointid);
+
+          if (const X* xcoord = dynamic_cast<const X*>(*b))
+            {
+              inc++;
+              rows.set("x", xcoord->value());
+              if (rejected(*b)) rejected_point = rejected(*b);
+              ObservationList::const_iterator t = b;
+              ++t;
+              if (t != e)
                 {
-                  ostr << "insert into gnu_gama_local_obs "
-                       << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                       << "val, from_dh, to_dh, rejected) values ("
-                       << cnfg() << ", " << cluster << ", "
-                       << index++ << ", 'azimuth', '"
-                       << m->from() << "', '" << m->to() << "', "
-                       << m->value();
-                  if (m->from_dh()) ostr << ", " << m->from_dh(); else ostr << ", null";
-                  if (m->to_dh()  ) ostr << ", " << m->to_dh();   else ostr << ", null";
-                  ostr  << ", " << rejected(m) << ");\n";
+                  inc++;
+                  ++b;
+                  rows.set("y", (*b)->value());
+                  if (rejected(*b)) rejected_point = rejected(*b);
+                  ++t;
+                  if (t != e && dynamic_cast<const Z*>(*t)
+                      && (*t)->from().str()==pointid)
+                    {
+                      inc++;
+                      ++b;
+                      rows.set("z", (*b)->value());
+                      if (rejected(*b)) rejected_point = rejected(*b);
+                    }
                 }
-                else if (const Angle*      m = dynamic_cast<const Angle*     >(*b))
-                  {
-                    ostr << "insert into gnu_gama_local_obs "
-                         << "(conf_id, ccluster, indx, tag, from_id, to_id, to_id2, "
-                         << "val, from_dh, to_dh, to_dh2, rejected) values ("
-                         << cnfg() << ", " << cluster << ", "
-                         << index++ << ", 'angle', '"
-                         << m->from() << "', '" << m->bs() << "', '" << m->fs() << "', "
-                         << m->value();
-                    if (m->from_dh()) ostr << ", " << m->from_dh(); else ostr << ", null";
-                    if (m->bs_dh()  ) ostr << ", " << m->bs_dh();   else ostr << ", null";
-                    if (m->fs_dh()  ) ostr << ", " << m->fs_dh();   else ostr << ", null";
-                    ostr  << ", " << rejected(m) << ");\n";
-                  }
-                // xsd 0.91 else if (const H_Diff*     m = dynamic_cast<const H_Diff*    >(*b))
-                // xsd 0.91   {
-                // xsd 0.91     ostr << "insert into gnu_gama_local_obs "
-                // xsd 0.91          << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                // xsd 0.91          << "val, dist, rejected) values (" << cnfg() << ", " << cluster << ", "
-                // xsd 0.91          << index++ << ", 'dh', '"
-                // xsd 0.91          << m->from() << "', '" << m->to() << "', "
-                // xsd 0.91          << m->value() << ", ";
-                // xsd 0.91     if (m->dist())
-                // xsd 0.91       ostr << ", " << m->dist();
-                // xsd 0.91     else
-                // xsd 0.91       ostr << "null";
-                // xsd 0.91     ostr << ", " << rejected(m) << ");\n";
-                // xsd 0.91   }
-                else
-                  {
-                  }
-              }
-          }
-        else if (/* const HeightDifferences* sp = */ dynamic_cast<const HeightDifferences*>(c))
-          {
-            write_cluster(ostr, c, cluster, "height-differences");
-
-            int index = 1;
-            for (ObservationList::const_iterator
-                   b = c->observation_list.begin(),
-                   e = c->observation_list.end();  b != e;  ++b)
-              {
-                const H_Diff* hd = dynamic_cast<const H_Diff*>(*b);
-                ostr << "insert into gnu_gama_local_obs "
-                     << "(conf_id, ccluster, indx, tag, from_id, to_id, "
-                     << "val, dist, rejected) values (" << cnfg() << ", " << cluster << ", "
-                     << index++ << ", 'dh', '"
-                     << hd->from() << "', '" << hd->to() << "', "
-                     << hd->value() << ", ";
-                if (hd->dist())
-                  ostr << hd->dist();
-                else
-                  ostr << "null";
-                ostr << ", " << rejected(hd) << ");\n";
-              }
-          }
-        else if (/*const Coordinates* sp = */dynamic_cast<const Coordinates*>(c))
-          {
-            write_cluster(ostr, c, cluster, "coordinates");
-            int index = 1, inc;
-            for (ObservationList::const_iterator
-                   b = c->observation_list.begin(),
-                   e = c->observation_list.end();  b != e;  ++b)
-              {
-                inc = 0;
-                std::string        ats;
-                std::ostringstream xyz;
-                int                rejected_point = 0;
-                xyz.precision(17);
-                std::string pointid = (*b)->from().str();
-                if (const X* xcoord = dynamic_cast<const X*>(*b))
-                  {
-                    inc++;
-                    ats += ", x";
-                    xyz << ", " << xcoord->value();
-                    if (rejected(*b)) rejected_point = rejected(*b);
-                    ObservationList::const_iterator t = b;
-                    ++t;
-                    if (t != e)
-                      {
-                        inc++;
-                        ++b;
-                        ats += ", y";
-                        xyz << ", " << (*b)->value();
-                        if (rejected(*b)) rejected_point = rejected(*b);
-                        ++t;
-                        if (t != e && dynamic_cast<const Z*>(*t)
-                            && (*t)->from().str()==pointid)
-                          {
-                            inc++;
-                            ++b;
-                            ats += ", z";
-                            xyz << ", " << (*b)->value();
-                            if (rejected(*b)) rejected_point = rejected(*b);
-                          }
-                      }
-                  }
-                else if (const Z* zcoord = dynamic_cast<const Z*>(*b))
-                  {
-                    inc  = 1;
-                    ats += ", z";
-                    xyz << ", " << zcoord->value();
-                    rejected_point = rejected(zcoord);
-                  }
-                ostr << "insert into gnu_gama_local_coordinates "
-                     << "(conf_id, ccluster, indx, id" << ats
-                     << ", rejected) "
-                     << "values (" << cnfg() << ", " << cluster << ", "
-                     << index << ", '" << pointid << "'"
-                     << xyz.str() << ", " << rejected_point << ");\n";
-                index += inc;
-              }
-          }
-        else if (/*const Vectors* sp = */ dynamic_cast<const Vectors*>(c))
-          {
-            write_cluster(ostr, c, cluster, "vectors");
-            int index = 1;
-            for (ObservationList::const_iterator
-                   b = c->observation_list.begin(),
-                   e = c->observation_list.end();  b != e;  ++b)
-              {
-                const Xdiff* xd = dynamic_cast<const Xdiff*>(*b++);
-                const Ydiff* yd = dynamic_cast<const Ydiff*>(*b++);
-                const Zdiff* zd = dynamic_cast<const Zdiff*>(*b);
-                int rejected_point = 0;
-                if (rejected(xd)) rejected_point = rejected(xd);
-                if (rejected(yd)) rejected_point = rejected(yd);
-                if (rejected(zd)) rejected_point = rejected(zd);
-                ostr << "insert into gnu_gama_local_vectors "
-                     << "(conf_id, ccluster, indx, from_id, to_id, "
-                     << "dx, dy, dz, from_dh, to_dh, rejected) values ("
-                     << cnfg() << ", " << cluster << ", " << index << ", '"
-                     << xd->from().str() << "', '" << xd->to().str() << "', "
-                     << xd->value() << ", "
-                     << yd->value() << ", "
-                     << zd->value() << ", "
-                     << " null, null"  // from_dh to_dh (are they really used?)
-                     << ", " << rejected_point << ");\n";
-                index += 3;
-              }
-          }
-        else
-          throw GNU_gama::local::Exception("gkf2sql --- unknown cluster type");
+            }
+          else if (const Z* zcoord = dynamic_cast<const Z*>(*b))
+            {
+              inc  = 1;
+              rows.set("z", zcoord->value());
+              rejected_point = rejected(zcoord);
+            }
 
-        cluster++;
-      }
-  }
+          rows.set("rejected", rejected_point);
+          rows.exec();
+          index += inc;
+        }
+    }
+  else if (dynamic_cast<const Vectors*>(c))
+    {
+      write_covmat(rows, c, cluster, "vectors");
 
-  /* adjusted results only when the network is adjusted */
-  if (localNetwork.is_adjusted())
+      int index = 1;
+      for (ObservationList::const_iterator
+             b = list.begin(), e = list.end();  b != e;  ++b)
+        {
+          const Observation* xd = *b++;
+          const Observation* yd = *b++;
+          const Observation* zd = *b;
+          int rejected_point = 0;
+          if (rejected(xd)) rejected_point = rejected(xd);
+          if (rejected(yd)) rejected_point = rejected(yd);
+          if (rejected(zd)) rejected_point = rejected(zd);
+
+          rows.insert("gnu_gama_local_vectors");
+          rows.set("ccluster", cluster);
+          rows.set("indx", index);
+          rows.set("from_id", xd->from().str());
+          rows.set("to_id",   xd->to().str());
+          rows.set("dx", xd->value());
+          rows.set("dy", yd->value());
+          rows.set("dz", zd->value());
+          rows.set("rejected", rejected_point);
+          rows.exec();
+          index += 3;
+        }
+    }
+  else
+    throw GNU_gama::local::Exception("gkf2sql --- unknown cluster type");
+}
+
+
+void LocalNetwork2sql::remove_results(SqlRows& rows) const
+{
+  for (const char* table : {
+      "gnu_gama_local_adj_network_general_parameters",
+      "gnu_gama_local_adj_coordinates_summary",
+      "gnu_gama_local_adj_observations_summary",
+      "gnu_gama_local_adj_project_equations",
+      "gnu_gama_local_adj_standard_deviation",
+      "gnu_gama_local_adj_coordinates",
+      "gnu_gama_local_adj_orientation_shifts",
+      "gnu_gama_local_adj_covmat",
+      "gnu_gama_local_adj_original_indexes",
+      "gnu_gama_local_adj_observations" })
     {
-      LocalNetwork* netinfo = &localNetwork;
-      const double y_sign = netinfo->y_sign();
-      const Vec& x = netinfo->solve();
-
-      { // general parameters
-        ostr << "insert into gnu_gama_local_adj_network_general_parameters "
-             << "(conf_id, gmversion, algorithm, compiler, epoch, axes, angles) "
-             << "values ("
-             << cnfg() << ", '" << GNU_gama::GNU_gama_version() << "', "
-             << (netinfo->algorithm().length() ? ("'"+netinfo->algorithm()+"'") : "NULL")
-             << ", '" << GNU_gama::GNU_gama_compiler() << "', ";
-
-        if (netinfo->has_epoch()) ostr << netinfo->epoch() << ", ";  else  ostr << "NULL, ";
-
-        std::string axes = "ne";
-        switch(localNetwork.PD.local_coordinate_system)
-          {
-          case LocalCoordinateSystem::CS::EN: axes = "'en', "; break;
-          case LocalCoordinateSystem::CS::NW: axes = "'nw', "; break;
-          case LocalCoordinateSystem::CS::SE: axes = "'se', "; break;
-          case LocalCoordinateSystem::CS::WS: axes = "'ws', "; break;
-          case LocalCoordinateSystem::CS::NE: axes = "'ne', "; break;
-          case LocalCoordinateSystem::CS::SW: axes = "'sw', "; break;
-          case LocalCoordinateSystem::CS::ES: axes = "'es', "; break;
-          case LocalCoordinateSystem::CS::WN: axes = "'wn', "; break;
-          default:
-            axes =  "'ne', "; //break;*/
-          }
+      rows.remove(table);
+    }
+}
 
-        ostr << axes
-             << (localNetwork.PD.left_handed_angles() ? "'left-handed'" : "'right-handed'")
-             << ");\n";
+
+void LocalNetwork2sql::write_results(SqlRows& rows)
+{
+  LocalNetwork* netinfo = &localNetwork;
+  const double y_sign = netinfo->y_sign();
+  const Vec& x = netinfo->solve();
+
+  { // general parameters
+    rows.insert("gnu_gama_local_adj_network_general_parameters");
+    rows.set("gmversion", GNU_gama::GNU_gama_version());
+    if (netinfo->algorithm().length())
+      rows.set("algorithm", netinfo->algorithm());
+    rows.set("compiler", GNU_gama::GNU_gama_compiler());
+    if (netinfo->has_epoch()) rows.set("epoch", netinfo->epoch());
+
+    std::string axes = "ne";
+    switch(localNetwork.PD.local_coordinate_system)
+      {
+      case LocalCoordinateSystem::CS::EN: axes = "en"; break;
+      case LocalCoordinateSystem::CS::NW: axes = "nw"; break;
+      case LocalCoordinateSystem::CS::SE: axes = "se"; break;
+      case LocalCoordinateSystem::CS::WS: axes = "ws"; break;
+      case LocalCoordinateSystem::CS::NE: axes = "ne"; break;
+      case LocalCoordinateSystem::CS::SW: axes = "sw"; break;
+      case LocalCoordinateSystem::CS::ES: axes = "es"; break;
+      case LocalCoordinateSystem::CS::WN: axes = "wn"; break;
+      default:
+        axes =  "ne"; //break;*/
       }
 
+    rows.set("axes", axes);
+    rows.set("angles", localNetwork.PD.left_handed_angles()
+                       ? "left-handed" : "right-handed");
+    rows.exec();
+  }
+
 
-      { // summary of coordinates in adjustment
-        int a_xyz = 0, a_xy = 0, a_z = 0;      // adjusted
-        int c_xyz = 0, c_xy = 0, c_z = 0;      // constrained
-        int f_xyz = 0, f_xy = 0, f_z = 0;      // fixed
+  { // summary of coordinates in adjustment
+    int a_xyz = 0, a_xy = 0, a_z = 0;      // adjusted
+    int c_xyz = 0, c_xy = 0, c_z = 0;      // constrained
+    int f_xyz = 0, f_xy = 0, f_z = 0;      // fixed
 
-        for (PointData::const_iterator
-               i=netinfo->PD.begin(); i!=netinfo->PD.end(); ++i)
+    for (PointData::const_iterator
+           i=netinfo->PD.begin(); i!=netinfo->PD.end(); ++i)
+      {
+        const LocalPoint& p = (*i).second;
+        if (p.active())
           {
-            const LocalPoint& p = (*i).second;
-            if (p.active())
-              {
-                if (p.free_xy() && p.free_z()) a_xyz++;
-                else if (p.free_xy()) a_xy++;
-                else if (p.free_z())  a_z++;
-
-                if (p.constrained_xy() && p.constrained_z()) c_xyz++;
-                else if (p.constrained_xy()) c_xy++;
-                else if (p.constrained_z())  c_z++;
-
-                if (p.fixed_xy() && p.fixed_z()) f_xyz++;
-                else if (p.fixed_xy()) f_xy++;
-                else if (p.fixed_z())  f_z++;
-              }
-          }
+            if (p.free_xy() && p.free_z()) a_xyz++;
+            else if (p.free_xy()) a_xy++;
+            else if (p.free_z())  a_z++;
 
-        ostr << "insert into gnu_gama_local_adj_coordinates_summary "
-             << "(conf_id, adj_xyz, adj_xy, adj_z, con_xyz, con_xy, con_z, fix_xyz, fix_xy, fix_z) "
-             << "values ("
-             << cnfg() << ", "
-             << a_xyz << ", " << a_xy << ", " << a_z << ", "
-             << c_xyz << ", " << c_xy << ", " << c_z << ", "
-             << f_xyz << ", " << f_xy << ", " << f_z << " "
-             << ");\n";
+            if (p.constrained_xy() && p.constrained_z()) c_xyz++;
+            else if (p.constrained_xy()) c_xy++;
+            else if (p.constrained_z())  c_z++;
+
+            if (p.fixed_xy() && p.fixed_z()) f_xyz++;
+            else if (p.fixed_xy()) f_xy++;
+            else if (p.fixed_z())  f_z++;
+          }
       }
 
+    rows.insert("gnu_gama_local_adj_coordinates_summary");
+    rows.set("adj_xyz", a_xyz);
+    rows.set("adj_xy",  a_xy);
+    rows.set("adj_z",   a_z);
+    rows.set("con_xyz", c_xyz);
+    rows.set("con_xy",  c_xy);
+    rows.set("con_z",   c_z);
+    rows.set("fix_xyz", f_xyz);
+    rows.set("fix_xy",  f_xy);
+    rows.set("fix_z",   f_z);
+    rows.exec();
+  }
 
-      { // observations summary
-        class ObservationSummaryCounter : public GNU_gama::local::AllObservationsVisitor
-        {
-        public:
-          ObservationSummaryCounter() :
-            dirs(0),  angles(0), dists(0), coords(0),
-            hdiffs(0), zangles(0), chords(0), vectors(0), azimuth(0)
-          {}
-
-          void visit(Direction*)  { dirs++; }
-          void visit(Distance*)   { dists++; }
-          void visit(Angle*)      { angles++; }
-          void visit(H_Diff*)     { hdiffs++; }
-          void visit(S_Distance*) { chords++; }
-          void visit(Z_Angle*)    { zangles++; }
-          void visit(X*)          { coords++; }
-          void visit(Y*)          { }
-          void visit(Z*)          { }
-          void visit(Xdiff*)      { vectors++; }
-          void visit(Ydiff*)      { }
-          void visit(Zdiff*)      { }
-          void visit(Azimuth*)    { azimuth++; }
-
-          int dirs,  angles, dists, coords,
-              hdiffs, zangles, chords, vectors,
-              azimuth;
-        };
-
-        ObservationSummaryCounter counter;
-
-        for (int i=1; i<=netinfo->sum_observations(); i++)
-          netinfo->ptr_obs(i)->accept(&counter);
-
-        ostr << "insert into gnu_gama_local_adj_observations_summary "
-             << "(conf_id, distances, directions, angles, xyz_coords, h_diffs, z_angles, s_dists, vectors, azimuths) "
-             << "values ("
-             << cnfg() << ", "
-             << counter.dists   << ", "
-             << counter.dirs    << ", "
-             << counter.angles  << ", "
-             << counter.coords  << ", "
-             << counter.hdiffs  << ", "
-             << counter.zangles << ", "
-             << counter.chords  << ", "
-             << counter.vectors << ", "
-             << counter.azimuth << ");\n";
-      }
 
+  { // observations summary
+    class ObservationSummaryCounter : public GNU_gama::local::AllObservationsVisitor
+    {
+    public:
+      ObservationSummaryCounter() :
+        dirs(0),  angles(0), dists(0), coords(0),
+        hdiffs(0), zangles(0), chords(0), vectors(0), azimuth(0)
+      {}
+
+      void visit(Direction*)  { dirs++; }
+      void visit(Distance*)   { dists++; }
+      void visit(Angle*)      { angles++; }
+      void visit(H_Diff*)     { hdiffs++; }
+      void visit(S_Distance*) { chords++; }
+      void visit(Z_Angle*)    { zangles++; }
+      void visit(X*)          { coords++; }
+      void visit(Y*)          { }
+      void visit(Z*)          { }
+      void visit(Xdiff*)      { vectors++; }
+      void visit(Ydiff*)      { }
+      void visit(Zdiff*)      { }
+      void visit(Azimuth*)    { azimuth++; }
+
+      int dirs,  angles, dists, coords,
+          hdiffs, zangles, chords, vectors,
+          azimuth;
+    };
+
+    ObservationSummaryCounter counter;
+
+    for (int i=1; i<=netinfo->sum_observations(); i++)
+      netinfo->ptr_obs(i)->accept(&counter);
+
+    rows.insert("gnu_gama_local_adj_observations_summary");
+    rows.set("distances",  counter.dists);
+    rows.set("directions", counter.dirs);
+    rows.set("angles",     counter.angles);
+    rows.set("xyz_coords", counter.coords);
+    rows.set("h_diffs",    counter.hdiffs);
+    rows.set("z_angles",   counter.zangles);
+    rows.set("s_dists",    counter.chords);
+    rows.set("vectors",    counter.vectors);
+    rows.set("azimuths",   counter.azimuth);
+    rows.exec();
+  }
 
-      { // project equations
-        ostr << "insert into gnu_gama_local_adj_project_equations "
-             << "(conf_id, equations, unknowns, deg_freedom, defect, sum_squares, connected) "
-             << "values ("
-             << cnfg()                        << ", "
-             << netinfo->sum_observations()   << ", "
-             << netinfo->sum_unknowns()       << ", "
-             << netinfo->degrees_of_freedom() << ", "
-             << netinfo->null_space()         << ", "
-             << netinfo->trans_VWV()          << ", "
-             << (netinfo->connected_network() ? 1 : 0) << ");\n";
-      }
 
+  { // project equations
+    rows.insert("gnu_gama_local_adj_project_equations");
+    rows.set("equations",   netinfo->sum_observations());
+    rows.set("unknowns",    netinfo->sum_unknowns());
+    rows.set("deg_freedom", netinfo->degrees_of_freedom());
+    rows.set("defect",      netinfo->null_space());
+    rows.set("sum_squares", netinfo->trans_VWV());
+    rows.set("connected",   netinfo->connected_network() ? 1 : 0);
+    rows.exec();
+  }
 
-      { // standard deviation
-        const int dof = netinfo->degrees_of_freedom();
-        double test=0, lower=0, upper=0;
 
-        test  = netinfo->m_0_aposteriori_value() / netinfo->apriori_m_0();
-        if (dof)
-          {
-            const double alfa_pul = (1 - netinfo->conf_pr())/2;
-            lower = sqrt(GNU_gama::Chi_square(1-alfa_pul,dof)/dof);
-            upper = sqrt(GNU_gama::Chi_square(  alfa_pul,dof)/dof);
-          }
+  { // standard deviation
+    const int dof = netinfo->degrees_of_freedom();
+    double test=0, lower=0, upper=0;
 
-        ostr << "insert into gnu_gama_local_adj_standard_deviation "
-             << "(conf_id, apriori, aposteriori, used, probability, ratio, rlower, rupper, passed, conf_scale) "
-             << "values ("
-             << cnfg() << ", "
-             << netinfo->apriori_m_0() << ", "
-             << (netinfo->degrees_of_freedom() > 0 ? sqrt(netinfo->trans_VWV()/netinfo->degrees_of_freedom()) : 0) << ", "
-             << (netinfo->m_0_aposteriori() ? "'aposteriori'" : "'apriori'") << ", "
-             << netinfo->conf_pr() << ", "
-             << test  << ", "
-             << lower << ", "
-             << upper << ", "
-             << ((lower < test && test < upper) ? 1 : 0) << ", "
-             << netinfo->conf_int_coef() << ");\n";
+    test  = netinfo->m_0_aposteriori_value() / netinfo->apriori_m_0();
+    if (dof)
+      {
+        const double alfa_pul = (1 - netinfo->conf_pr())/2;
+        lower = sqrt(GNU_gama::Chi_square(1-alfa_pul,dof)/dof);
+        upper = sqrt(GNU_gama::Chi_square(  alfa_pul,dof)/dof);
       }
 
+    rows.insert("gnu_gama_local_adj_standard_deviation");
+    rows.set("apriori", netinfo->apriori_m_0());
+    rows.set("aposteriori", netinfo->degrees_of_freedom() > 0
+             ? sqrt(netinfo->trans_VWV()/netinfo->degrees_of_freedom()) : 0.0);
+    rows.set("used", netinfo->m_0_aposteriori() ? "aposteriori" : "apriori");
+    rows.set("probability", netinfo->conf_pr());
+    rows.set("ratio",  test);
+    rows.set("rlower", lower);
+    rows.set("rupper", upper);
+    rows.set("passed", (lower < test && test < upper) ? 1 : 0);
+    rows.set("conf_scale", netinfo->conf_int_coef());
+    rows.exec();
+  }
 
-      { // coordinates
-        for (PointData::const_iterator ii=netinfo->PD.begin(); ii!=netinfo->PD.end(); ii++)
-          {
-            const PointID point_id = (*ii).first;
-            const LocalPoint&  b   = (*ii).second;
-            if (!b.active()) continue;
-
-            int indx = 0;
-            if (b.free_z()  && b.index_z()) indx = b.index_z();
-            if (b.free_xy() && b.index_x()) indx = b.index_x();
-
-
-            ostr << "insert into gnu_gama_local_adj_coordinates "
-                 << "(conf_id, indx, id, x, y, z, txy, tz, x_approx, y_approx, z_approx) "
-                 << "values ("
-                 << cnfg() << ", " << indx << ", '" << point_id << "', ";
-
-            if (b.fixed_xy())
-              {
-                ostr << b.x() << ", " << b.y() << ", ";
-              }
-            else if (b.free_xy() && b.index_x())
-              {
-                double adj_x = b.x()+x(b.index_x())/1000;
-                double adj_y = y_sign*(b.y()+x(b.index_y())/1000);
-                ostr << adj_x << ", " << adj_y << ", ";
-              }
-            else
-              {
-                ostr << "NULL, NULL, ";
-              }
-
-            if (b.fixed_z())
-              {
-                ostr << b.z() << ", ";
-              }
-            else if (b.free_z() && b.index_z())
-              {
-                ostr << (b.z()+x(b.index_z())/1000) << ", ";
-              }
-            else
-              {
-                ostr << "NULL, ";
-              }
-
-            if (b.fixed_xy())            ostr << "'fixed', ";
-            else if (b.constrained_xy()) ostr << "'constrained', ";
-            else if (b.free_xy())        ostr << "'adjusted', ";
-            else                         ostr << "NULL, ";
-
-            if (b.fixed_z())             ostr << "'fixed', ";
-            else if (b.constrained_z())  ostr << "'constrained', ";
-            else if (b.free_z())         ostr << "'adjusted', ";
-            else                         ostr << "NULL, ";
-
-            if (b.free_xy()) {
-              ostr << b.x_0() << ", " << y_sign*b.y_0() << ", ";
-            }
-            else {
-              ostr << "NULL, NULL, ";
-            }
 
-            if (b.free_z()) {
-              ostr << b.z_0() << ");\n";
-            }
-            else {
-              ostr << "NULL);\n";
-            }
-          }
-      }
+  { // coordinates
+    for (PointData::const_iterator ii=netinfo->PD.begin(); ii!=netinfo->PD.end(); ii++)
+      {
+        const PointID point_id = (*ii).first;
+        const LocalPoint&  b   = (*ii).second;
+        if (!b.active()) continue;
 
+        int indx = 0;
+        if (b.free_z()  && b.index_z()) indx = b.index_z();
+        if (b.free_xy() && b.index_x()) indx = b.index_x();
 
-      { // orientation shifts
-        for (int i=1; i<=netinfo->sum_unknowns(); i++)
+        rows.insert("gnu_gama_local_adj_coordinates");
+        rows.set("indx", indx);
+        rows.set("id", point_id.str());
+
+        if (b.fixed_xy())
+          {
+            rows.set("x", b.x());
+            rows.set("y", b.y());
+          }
+        else if (b.free_xy() && b.index_x())
           {
-            if (netinfo->unknown_type(i) != 'R') continue;
+            rows.set("x", b.x()+x(b.index_x())/1000);
+            rows.set("y", y_sign*(b.y()+x(b.index_y())/1000));
+          }
+
+        if (b.fixed_z())
+          rows.set("z", b.z());
+        else if (b.free_z() && b.index_z())
+          rows.set("z", b.z()+x(b.index_z())/1000);
+
+        if (b.fixed_xy())            rows.set("txy", "fixed");
+        else if (b.constrained_xy()) rows.set("txy", "constrained");
+        else if (b.free_xy())        rows.set("txy", "adjusted");
 
-            StandPoint* k = netinfo->unknown_standpoint(i);
-            double z = y_sign*( k->orientation() )*GNU_gama::RAD_TO_GON;
-            double c = y_sign*x(i)/10000;
+        if (b.fixed_z())             rows.set("tz", "fixed");
+        else if (b.constrained_z())  rows.set("tz", "constrained");
+        else if (b.free_z())         rows.set("tz", "adjusted");
 
-            ostr << "insert into gnu_gama_local_adj_orientation_shifts "
-                 << "(conf_id, indx, id, approx, adj) "
-                 << "values ("
-                 << cnfg() << ", " << i << ", '" << netinfo->unknown_pointid(i) << "', "
-                 << z << ", " << (z + c) << ");\n";
+        if (b.free_xy())
+          {
+            rows.set("x_approx", b.x_0());
+            rows.set("y_approx", y_sign*b.y_0());
           }
+        if (b.free_z())
+          rows.set("z_approx", b.z_0());
+
+        rows.exec();
       }
+  }
+
 
-      std::vector<int> ind(netinfo->sum_unknowns() + 1);
+  { // orientation shifts
+    for (int i=1; i<=netinfo->sum_unknowns(); i++)
       {
-        int dim = 0;
-        for (PointData::const_iterator
-               i=netinfo->PD.begin(); i!=netinfo->PD.end(); ++i)
-          {
-            const LocalPoint& p = (*i).second;
-            if (p.active_xy() && p.index_x() != 0) {
-              ind[++dim] = p.index_x();
-              ind[++dim] = p.index_y();
-            }
+        if (netinfo->unknown_type(i) != 'R') continue;
+
+        StandPoint* k = netinfo->unknown_standpoint(i);
+        double z = y_sign*( k->orientation() )*GNU_gama::RAD_TO_GON;
+        double c = y_sign*x(i)/10000;
+
+        rows.insert("gnu_gama_local_adj_orientation_shifts");
+        rows.set("indx", i);
+        rows.set("id", netinfo->unknown_pointid(i).str());
+        rows.set("approx", z);
+        rows.set("adj", z + c);
+        rows.exec();
+      }
+  }
 
-            if (p.active_z () && p.index_z() != 0) {
-              ind[++dim] = p.index_z();
-            }
-          }
+  std::vector<int> ind(netinfo->sum_unknowns() + 1);
+  {
+    int dim = 0;
+    for (PointData::const_iterator
+           i=netinfo->PD.begin(); i!=netinfo->PD.end(); ++i)
+      {
+        const LocalPoint& p = (*i).second;
+        if (p.active_xy() && p.index_x() != 0) {
+          ind[++dim] = p.index_x();
+          ind[++dim] = p.index_y();
+        }
 
-        for (int i=1; i<=netinfo->sum_unknowns(); i++)
-          if (netinfo->unknown_type(i) == 'R')
-            {
-              StandPoint* k = netinfo->unknown_standpoint(i);
-              ind[++dim] =  k->index_orientation();
-            }
+        if (p.active_z () && p.index_z() != 0) {
+          ind[++dim] = p.index_z();
+        }
       }
 
+    for (int i=1; i<=netinfo->sum_unknowns(); i++)
+      if (netinfo->unknown_type(i) == 'R')
+        {
+          StandPoint* k = netinfo->unknown_standpoint(i);
+          ind[++dim] =  k->index_orientation();
+        }
+  }
 
-      { // covariance matrix
-        int dim  = netinfo->sum_unknowns();
-        int band = netinfo->adj_covband();
-        if (band < 0) band = dim-1;
 
-        const double m2 = netinfo->m_0() * netinfo->m_0();
-        for (int i=1; i<=dim; i++)
-          for (int j=i; j<=std::min(dim, i+band); j++)
-            {
-              ostr << "insert into gnu_gama_local_adj_covmat "
-                   << "(conf_id, rind, cind, val) "
-                   << "values ("
-                   << cnfg() << ", " << i << ", " << j << ", "
-                   << m2*netinfo->qxx(ind[i], ind[j])
-                   << ");\n";
-            }
-      }
+  { // covariance matrix, weight coefficients are computed by rows
+    int dim  = netinfo->sum_unknowns();
+    int band = netinfo->adj_covband();
+    if (band < 0) band = dim-1;
 
+    const double m2 = netinfo->m_0() * netinfo->m_0();
+    std::vector<int> qi, qj;
+    std::vector<double> qxx;
+    for (int i=1; i<=dim; i++)
+      {
+        qi.clear();
+        qj.clear();
+        for (int j=i; j<=std::min(dim, i+band); j++)
+          {
+            qi.push_back(ind[i]);
+            qj.push_back(ind[j]);
+          }
+        qxx.resize(qi.size());
+        netinfo->qxx(int(qi.size()), qi.data(), qj.data(), qxx.data());
 
-      { // original indexes
-        for (int i=1; i<= netinfo->sum_unknowns(); i++)
+        for (int n=0, j=i; j<=std::min(dim, i+band); j++, n++)
           {
-            ostr << "insert into gnu_gama_local_adj_original_indexes "
-                 << "(conf_id, indx, adj_indx) "
-                 << "values ("
-                 << cnfg() << ", " << i << ", " << ind[i] << ");\n";
+            rows.insert("gnu_gama_local_adj_covmat");
+            rows.set("rind", i);
+            rows.set("cind", j);
+            rows.set("val", m2*qxx[n]);
+            rows.exec();
           }
       }
+  }
 
 
-      { // observations
-        WriteSQLVisitor writeVisitor(ostr, netinfo);
+  { // original indexes
+    for (int i=1; i<= netinfo->sum_unknowns(); i++)
+      {
+        rows.insert("gnu_gama_local_adj_original_indexes");
+        rows.set("indx", i);
+        rows.set("adj_indx", ind[i]);
+        rows.exec();
+      }
+  }
 
-        for (int indx=1; indx<=netinfo->sum_observations(); indx++)
-          {
-            Observation* pm = netinfo->ptr_obs(indx);
 
-            ostr << "insert into gnu_gama_local_adj_observations "
-                 << "(conf_id, indx, obs_type, from_id, to_id, to_id2, obs, adj, "
-                 << "angular, stdev, qrr, f, std_resid, err_obs, err_adj) "
-                 << "values ("
-                 << cnfg() << ", " << indx << ", ";
+  { // observations
+    AdjObservationRow observationRow(rows, netinfo);
 
-            writeVisitor.setObservationIndex(indx);
-            pm->accept(&writeVisitor);
-            writeVisitor.residualsAndAnalysisOfObservations(pm);
-          }
+    for (int indx=1; indx<=netinfo->sum_observations(); indx++)
+      {
+        Observation* pm = netinfo->ptr_obs(indx);
 
-      }
-    }
+        rows.insert("gnu_gama_local_adj_observations");
+        rows.set("indx", indx);
 
-  ostr << "\ncommit;\n";  // commit transaction
+        observationRow.setObservationIndex(indx);
+        pm->accept(&observationRow);
+        observationRow.residualsAndAnalysisOfObservations(pm);
+        rows.exec();
+      }
+  }
 }
 
 
-void LocalNetwork2sql::write_cluster(std::ostream& ostr, const Cluster* c,
-                                     int cluster, std::string tag)
+void LocalNetwork2sql::write_covmat(SqlRows& rows, const Cluster* c,
+                                    int cluster, const char* tag)
 {
   const GNU_gama::local::Observation::CovarianceMatrix& covmat = c->covariance_matrix;
   int dim  = covmat.rows();
   int band = covmat.bandWidth();
 
-  ostr << "\ninsert into gnu_gama_local_clusters "
-       << "(conf_id, ccluster, dim, band, tag) "
-       << "values (" << cnfg() << ", "
-       << cluster << ", " << dim << ", " << band << ", '" << tag
-       << "');\n";
+  rows.insert("gnu_gama_local_clusters");
+  rows.set("ccluster", cluster);
+  rows.set("dim", dim);
+  rows.set("band", band);
+  rows.set("tag", tag);
+  rows.exec();
 
   for (int i=1; i<=dim; i++)
     for (int j=i; j<=i+band && j <= dim; j++)
       {
-        ostr << "insert into gnu_gama_local_covmat "
-             << "(conf_id, ccluster, rind, cind, val) "
-             << "values (" << cnfg() << ", " << cluster
-             << ", " << i << ", " << j << "," << covmat(i,j) << ");\n";
+        rows.insert("gnu_gama_local_covmat");
+        rows.set("ccluster", cluster);
+        rows.set("rind", i);
+        rows.set("cind", j);
+        rows.set("val", covmat(i,j));
+        rows.exec();
       }
 }
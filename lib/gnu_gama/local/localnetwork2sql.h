@@ -29,9 +29,40 @@
 
 namespace GNU_gama { namespace local
 {
+  /** \brief Rows of database tables of a configuration.
+
+      LocalNetwork2sql generates rows of gama-local tables through
+      this interface, they are written as an SQL script or inserted
+      directly into a database. Column conf_id is set by the
+      implementation (a row of gnu_gama_local_configurations gets the
+      id of the new configuration), columns not set in a row are NULL.
+  */
+  class SqlRows {
+  public:
+
+    virtual ~SqlRows() {}
+
+    /** deletes all rows of the configuration from \a table */
+    virtual void remove(const char* table) = 0;
+    /** starts a new row of \a table */
+    virtual void insert(const char* table) = 0;
+    virtual void set(const char* column, int value) = 0;
+    virtual void set(const char* column, double value) = 0;
+    virtual void set(const char* column, const std::string& value) = 0;
+    void set(const char* column, const char* value)
+      {
+        set(column, std::string(value));
+      }
+    /** writes the row started by insert() */
+    virtual void exec() = 0;
+  };
+
+
   class LocalNetwork2sql {
   public:
 
+    typedef GNU_gama::Cluster<GNU_gama::local::Observation> Cluster;
+
     LocalNetwork2sql(LocalNetwork& lnet);
 
     void readGkf(std::istream& istr);
@@ -39,6 +70,20 @@ namespace GNU_gama { namespace local
     void setDelete(bool del) { delrec = del;  }
     bool getDelete() const   { return delrec; }
 
+    /** deletes input data, adjustment results and the configuration */
+    void remove_configuration(SqlRows& rows) const;
+    /** writes configuration named \a conf and its description */
+    void write_configuration(SqlRows& rows, const std::string& conf);
+    /** writes points of the network */
+    void write_points(SqlRows& rows);
+    /** writes cluster \a c with index \a cluster and its observations */
+    void write_cluster(SqlRows& rows, const Cluster* c, int cluster);
+
+    /** deletes adjustment results (tables gnu_gama_local_adj_*) */
+    void remove_results(SqlRows& rows) const;
+    /** writes adjustment results of adjusted network */
+    void write_results (SqlRows& rows);
+
   private:
     GNU_gama::local::LocalNetwork&    localNetwork;
     GNU_gama::local::PointData&       points;
@@ -46,10 +91,8 @@ namespace GNU_gama { namespace local
     std::string config;
     bool        delrec;
 
-    typedef GNU_gama::Cluster<GNU_gama::local::Observation> Cluster;
-
-    void write_cluster(std::ostream& ostr, const Cluster* c,
-                       int cluster, std::string tag);
+    void write_covmat(SqlRows& rows, const Cluster* c,
+                      int cluster, const char* tag);
     int  rejected(const GNU_gama::local::Observation* m) const
       {
         return m->active() ? 0 : 1;
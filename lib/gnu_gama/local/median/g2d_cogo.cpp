@@ -44,8 +44,8 @@ using namespace std;
 namespace GNU_gama { namespace local {
 
 
-    double CoordinateGeometry2D::small_angle_limit_    = 0;
-    bool   CoordinateGeometry2D::small_angle_detected_ = false;
+    thread_local double CoordinateGeometry2D::small_angle_limit_    = 0;
+    thread_local bool   CoordinateGeometry2D::small_angle_detected_ = false;
 
     double CoordinateGeometry2D::small_angle_limit()
     {
@@ -50,8 +50,10 @@ namespace GNU_gama { namespace local {
       PointData*   SB;
       virtual void observation_check(Observation*, Observation*) = 0;
 
-      static double small_angle_limit_;
-      static bool   small_angle_detected_;
+      // thread local, approximate coordinates of independent networks
+      // can be computed concurrently
+      static thread_local double small_angle_limit_;
+      static thread_local bool   small_angle_detected_;
 
     private:
 
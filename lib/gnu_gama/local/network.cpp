@@ -33,6 +33,13 @@
 #include <cctype>
 #include <memory>
 #include <set>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <cstdint>
+#include <type_traits>
 
 #include <gnu_gama/local/network.h>
 #include <gnu_gama/local/local_linearization.h>
@@ -41,7 +48,10 @@
 #include <Math/Business/Core/statan.h>
 #include <Math/Business/Core/radian.h>
 #include <Math/Service/smatrix_graph.h>
+#include <Math/Business/Adjustment/adj_supernodal.h>
+#include <Math/Business/Adjustment/adj_svd.h>
 #include <Utilities/Business/version.h>
+#include <Utilities/Service/profile.h>
 #include <gnu_gama/ellipsoids.h>
 
 using namespace std;
@@ -54,6 +64,59 @@ typedef GNU_gama::Cluster<Observation>             Cluster_;  // 1.10
 namespace
 {
   const char* UNKNOWN_ALGORITHM="### network.cpp : unknown algorithm ###";
+
+  // number of contiguous parts of n observations processed in parallel
+
+  int parallel_parts(int n, int threads)
+  {
+    if (threads <= 0) threads = std::thread::hardware_concurrency();
+    const int min_part = 1024;
+    return std::max(1, std::min(threads, n/min_part));
+  }
+
+  // f(part, first, last) is called for parts [first, last) of [0, n) in
+  // separate threads, the first exception in the order of parts is
+  // rethrown as if the parts were processed sequentially
+
+  template <typename Function>
+  void parallel_for(int n, int parts, Function f)
+  {
+    if (parts <= 1)
+      {
+        f(0, 0, n);
+        return;
+      }
+
+    std::vector<std::exception_ptr> error(parts);
+    auto part = [&](int p)
+      {
+        try
+          {
+            f(p, int(std::int64_t(n)*p/parts), int(std::int64_t(n)*(p+1)/parts));
+          }
+        catch (...)
+          {
+            error[p] = std::current_exception();
+          }
+      };
+
+    // parts of threads which cannot be created run in the calling thread
+    std::vector<std::thread> pool;
+    pool.reserve(parts - 1);
+    int started = 1;
+    try
+      {
+        for (; started<parts; started++) pool.emplace_back(part, started);
+      }
+    catch (const std::system_error&)
+      {
+      }
+    part(0);
+    for (int p=started; p<parts; p++) part(p);
+    for (auto& t : pool) t.join();
+
+    for (auto& e : error) if (e) std::rethrow_exception(e);
+  }
 }
 
 /** \brief %Visitor for absolute term testing.
@@ -215,10 +278,10 @@ LocalNetwork::LocalNetwork()
   : pocbod_(0), tst_redbod_(false), pocmer_(0), tst_redmer_(false),
     m_0_apr_(10), konf_pr_(0.95), tol_abs_(1000), typ_m_0_(empiricka_),
     tst_rov_opr_(false), tst_vyrovnani_(false), min_n_(0), min_x_(nullptr),
-    gons_(true)
+    gons_(true), language_(get_gama_language()),
+    texts_(&gama_texts(language_))
 {
   least_squares = nullptr;
-  Asp = nullptr;
 
   set_adj_covband();
   set_max_linearization_iterations();
@@ -237,7 +300,6 @@ LocalNetwork::LocalNetwork()
 LocalNetwork::~LocalNetwork()
 {
   delete[] min_x_;
-  delete   Asp;
   delete   least_squares;
 }
 
@@ -273,6 +335,7 @@ void LocalNetwork::set_algorithm(LocalNetwork::Algorithm alg)
   typedef GNU_gama::AdjGSO     <double, int, MVE> OLS_gso;
   typedef GNU_gama::AdjSVD     <double, int, MVE> OLS_svd;
   typedef GNU_gama::AdjCholDec <double, int, MVE> OLS_chol;
+  typedef GNU_gama::AdjSupernodal<double, int, MVE> OLS_snode;
 
   AdjBase* adjb;
 
@@ -290,6 +353,10 @@ void LocalNetwork::set_algorithm(LocalNetwork::Algorithm alg)
       algorithm_ = "cholesky";
       adjb = new OLS_chol;
       break;
+    case Algorithm::supernodal:
+      algorithm_ = "supernodal";
+      adjb = new OLS_snode;
+      break;
     case Algorithm::envelope:
       [[fallthrough]];
     default:
@@ -307,6 +374,37 @@ void LocalNetwork::set_algorithm(LocalNetwork::Algorithm alg)
 }
 
 
+bool LocalNetwork::has_ordering() const
+{
+  return has_ordering_;
+}
+
+
+void LocalNetwork::set_ordering(GNU_gama::SparseOrdering ord)
+{
+  ordering_ = ord;
+  has_ordering_ = true;
+}
+
+
+double LocalNetwork::factor_nonzeroes() const
+{
+  if (const AdjBaseSparse* sparse = dynamic_cast<const AdjBaseSparse*>(least_squares))
+    return sparse->factor_nonzeroes();
+
+  return 0;
+}
+
+
+double LocalNetwork::factor_flops() const
+{
+  if (const AdjBaseSparse* sparse = dynamic_cast<const AdjBaseSparse*>(least_squares))
+    return sparse->factor_flops();
+
+  return 0;
+}
+
+
 int LocalNetwork::adj_covband() const
 {
   return adj_covband_;
@@ -512,6 +610,7 @@ void LocalNetwork::revision_observations()
       else             removed_obs.push_back(m);
     }
   pocmer_ = RSM.size();
+  RSM_types.build(RSM, PD);
 
   tst_redmer_ = true;
   update(Residuals);
@@ -523,6 +622,8 @@ void LocalNetwork::project_equations()
   if (tst_rov_opr_) return;
   if (!tst_redmer_) revision_observations();
 
+  GNU_gama::Profile::Scope profile("project_equations");
+
   for (PointData::iterator bod=PD.begin(); bod!=PD.end(); ++bod)
     {
       LocalPoint& b = (*bod).second;
@@ -539,53 +640,88 @@ void LocalNetwork::project_equations()
       standpoint->index_orientation(0);
 
   {
-    LocalLinearization  loclin(PD, m_0_apr_);
+    // indexes of unknowns are assigned sequentially in the order of
+    // observations, after that LocalLinearization does not modify
+    // point data and observations are linearized in parallel parts,
+    // each with its own visitor and row buffer
+
+    LocalLinearizationIndexes indexes(PD);
+    for (RevisedObsList::iterator m=RSM.begin(); m!=RSM.end(); ++m)
+      (*m)->accept(&indexes);
+    pocet_neznamych_ = indexes.unknowns();
 
     const int V = pocmer_;               // vectors
-    const int M = V * loclin.max_size;   // reserved memory
+    const int S = LocalLinearization::max_size;
+
+    // observations are linearized by types (see ObservationStore) into
+    // fixed slots of their rows, the design matrix is assembled in the
+    // order of rows; values of observations could have been reduced
+    // since the store was built
+
+    RSM_types.gather();
+
+    std::vector<double> rhs  (V);
+    std::vector<int>    size (V);
+    std::vector<double> coeff(std::size_t(V)*S);
+    std::vector<int>    index(std::size_t(V)*S);
+
+    try
+      {
+        parallel_for(V, parallel_parts(V, threads_), [&](int, int first, int last)
+          {
+            LocalLinearization loclin(PD, m_0_apr_, texts());
+            RSM_types.for_items(first, last, [&](const auto& block, int n)
+              {
+                const int m = block.row[n];
+                loclin.visit(block, n);
+                rhs [m] = loclin.rhs;
+                size[m] = int(loclin.size);
+                for (long i=0; i<loclin.size; i++)
+                  {
+                    coeff[std::size_t(m)*S + i] = loclin.coeff[i];
+                    index[std::size_t(m)*S + i] = int(loclin.index[i]);
+                  }
+              });
+          });
+      }
+    catch (...)
+      {
+        // report the error of the first observation in the order of rows
+        LocalLinearization loclin(PD, m_0_apr_, texts());
+        for (RevisedObsList::iterator m=RSM.begin(); m!=RSM.end(); ++m)
+          (*m)->accept(&loclin);
+        throw;
+      }
 
+    // the design matrix is kept only in its sparse form, dense matrix A
+    // is needed only for full matrix algorithms (gso, svd, cholesky)
 
-    GNU_gama::SparseMatrix<double, int>*
-       tmp = new GNU_gama::SparseMatrix<double, int>(M, V, 0);
+    std::size_t nonzeroes = 0;
+    for (int n : size) nonzeroes += n;
+
+    GNU_gama::SparseMatrix<double, int>* mat =
+      new GNU_gama::SparseMatrix<double, int>(int(nonzeroes), V,
+                                              pocet_neznamych_);
 
     b.reset(pocmer_);   // initialisation of base class OLS
     rhs_.reset(pocmer_);
 
-    int  r = 0;
-    pocet_neznamych_ = 0;
-    for (RevisedObsList::iterator m=RSM.begin(); m!=RSM.end(); ++m)
+    for (int r=0; r<V; r++)
       {
-        Observation* obs = *m;
-        obs->accept(&loclin);
-        b(++r)  = loclin.rhs;
-        rhs_(r) = loclin.rhs;
-        tmp->new_row();
-        for (long i=0; i<loclin.size; i++)
-            tmp->add_element(loclin.coeff[i], loclin.index[i]);
-    }
-
-    pocet_neznamych_ = loclin.unknowns();
-    A.reset(pocmer_, pocet_neznamych_);   // initialization of base class OLS
-    A.set_zero();
+        b(r+1)    = rhs[r];
+        rhs_(r+1) = rhs[r];
+        mat->new_row();
+        for (int n=0; n<size[r]; n++)
+          mat->add_element(coeff[std::size_t(r)*S + n], index[std::size_t(r)*S + n]);
+      }
 
-    delete Asp;
-    Asp =  tmp->replicate(tmp->nonzeroes(), pocmer_, pocet_neznamych_ );
-    delete tmp;
+    input.set_mat(mat);
 
     {
-      GNU_gama::SparseMatrixGraph<double, int> graph(Asp);
+      GNU_gama::SparseMatrixGraph<double, int> graph(input.mat());
 
       design_matrix_graph_is_connected = graph.connected();
     }
-
-    double* a = Asp->begin(1);
-    int*  i = Asp->ibegin(1);
-    for (int n, row=1; row<=pocmer_; row++)
-      {
-        n = Asp->size(row);
-        while (n--)
-          A(row, *i++) = *a++;
-      }
   }
 
   seznez_.erase(seznez_.begin(), seznez_.end());
@@ -635,15 +771,24 @@ void LocalNetwork::project_equations()
 
   vybocujici_abscl_ = false;
   {   // for ...
-    for (long r=1; r<=pocmer_; r++)
+    std::atomic<bool> huge {false};
+    parallel_for(pocmer_, parallel_parts(pocmer_, threads_),
+                 [this, &huge](int, int first, int last)
       {
-        if (test_abs_term(r)) vybocujici_abscl_ = true;
-      }
+        RSM_types.for_items(first, last, [&](const auto& block, int n)
+          {
+            const LocalPoint* to = block.to[n] ? block.to[n] : block.from[n];
+            if (abs_term(block.obs[n], block.row[n]+1, *block.from[n], *to))
+              huge = true;
+          });
+      });
+    vybocujici_abscl_ = huge;
   }   // for ...
 
-  prepareProjectEquations();  // [A, b] scaled by chol. dec. of weight matrix
+  Homogenization hom;
+  prepareProjectEquations(hom);  // [A, b] scaled by chol. dec. of weight matrix
 
-  if (singular_coords(A))
+  if (singular_coords(*hom.mat()))
     {
       update(Points);
       project_equations();
@@ -652,53 +797,31 @@ void LocalNetwork::project_equations()
 
   if (AdjBaseFull* full = dynamic_cast<AdjBaseFull*>(least_squares))
     {
-      full->reset(A, b);
-    }
-  else if (AdjBaseSparse* sparse = dynamic_cast<AdjBaseSparse*>(least_squares))
-    {
-      /*********************************/
-      /*  reset AdjInputData structure */
-      /*********************************/
-
-      // design matrix
-
-      input.set_mat(Asp);
-      Asp = nullptr;
-
-      // ---  cofactors  --------------------------------------------------
+      const GNU_gama::SparseMatrix<double, int>* Asc = hom.mat();
 
-      int count = 0;   // number of diagonal blocks
-      int msize = 0;   // memory size
+      A.reset(pocmer_, pocet_neznamych_);
+      A.set_zero();
 
-      for (ClusterList::const_iterator
-             cluster=OD.clusters.begin(); cluster!=OD.clusters.end(); ++cluster)
-        if (const int N = (*cluster)->activeObs())
+      for (int row=1; row<=pocmer_; row++)
         {
-          int W = (*cluster)->covariance_matrix.bandWidth();
-          count++;
-          msize += 1+(N+N-W)*(W+1)/2;   // += number of band matrix elements
+          const double* a = Asc->begin (row);
+          const double* e = Asc->end   (row);
+          const int*    i = Asc->ibegin(row);
+          while (a != e)
+            A(row, *i++) = *a++;
         }
 
-      GNU_gama::BlockDiagonal<> *bd = new GNU_gama::BlockDiagonal<>(count, msize);
-
-      for (ClusterList::const_iterator
-             cluster=OD.clusters.begin(); cluster!=OD.clusters.end(); ++cluster)
-        if (const int N = (*cluster)->activeObs())
-        {
-          CovMat C = (*cluster)->activeCov();
-          C /= (m_0_apr_*m_0_apr_);        // covariances ==> cofactors
-          bd->add_block(N, C.bandWidth(), C.begin());
-        }
-
-      input.set_cov(bd);
-      bd = 0;
-
-      // ---  right-hand side  --------------------------------------------
-
-      GNU_gama::Vec<> bb(b.dim());
-      for (int i=1; i<=b.dim(); i++) bb(i) = rhs_(i);
-      input.set_rhs(bb);     // right-hand side before homogenization
+      full->set_threads(threads_);
+      typedef GNU_gama::AdjSVD<double, int, GNU_gama::local::MatVecException> OLS_svd;
+      if (OLS_svd* svd = dynamic_cast<OLS_svd*>(full)) svd->set_method(svd_method_);
+      full->reset(A, b);
+    }
+  else if (AdjBaseSparse* sparse = dynamic_cast<AdjBaseSparse*>(least_squares))
+    {
+      A.reset();   // no dense design matrix for sparse algorithms
 
+      if (has_ordering_) sparse->set_ordering(ordering_);
+      sparse->set_threads(threads_);
       sparse->reset(&input);
     }
   else
@@ -749,12 +872,48 @@ void LocalNetwork::project_equations()
 }
 
 
-bool LocalNetwork::singular_coords(const Mat& A)
+bool LocalNetwork::singular_coords(const GNU_gama::SparseMatrix<double, int>& As)
 {
   bool result = false;
 
-  double a, b, aa, ab, bb, D;          // testing xy submatrix is sufficient
-  int  indx, indy, r;
+  // testing xy submatrix is sufficient; for each point with unknown
+  // coordinates index_y() is paired with index_x() and the sums of
+  // squares and cross products of columns are computed in one pass
+  // over nonzero elements of the scaled design matrix
+
+  const int N = pocet_neznamych_;
+  std::vector<int>    pair (N+1, 0);
+  std::vector<double> sqr  (N+1, 0.0);
+  std::vector<double> cross(N+1, 0.0);
+  std::vector<double> row  (N+1, 0.0);
+
+  for (PointData::const_iterator i=PD.begin(); i!=PD.end(); ++i)
+    {
+      const LocalPoint&  p  = (*i).second;
+      if (p.fixed_xy() || !p.active_xy()) continue;
+      if (p.index_x() && p.index_y()) pair[p.index_x()] = p.index_y();
+    }
+
+  for (int r=1; r<=As.rows(); r++)
+    {
+      const double* b = As.begin (r);
+      const double* e = As.end   (r);
+      const int*    n = As.ibegin(r);
+      for (const double* a=b; a!=e; ++a) row[*n++] = *a;
+
+      n = As.ibegin(r);
+      for (const double* a=b; a!=e; ++a, ++n)
+        {
+          sqr[*n] += *a * *a;
+          if (const int y = pair[*n]) cross[*n] += *a * row[y];
+        }
+
+      n = As.ibegin(r);
+      for (const double* a=b; a!=e; ++a) row[*n++] = 0;
+    }
+
+  double aa, ab, bb, D;
+  int  indx, indy;
 
   for (PointData::iterator i=PD.begin(); i!=PD.end(); ++i)
     {
@@ -772,15 +931,9 @@ bool LocalNetwork::singular_coords(const Mat& A)
       indx = p.index_x();
       indy = p.index_y();
 
-      aa = ab = bb = 0;
-      for (r=1; r<=A.rows(); r++)
-        {
-          a = A(r,indx);
-          b = A(r,indy);
-          aa += a*a;
-          ab += a*b;
-          bb += b*b;
-        }
+      aa = sqr[indx];
+      ab = cross[indx];
+      bb = sqr[indy];
 
       if (bb > aa) std::swap(aa, bb);
       if (aa == 0)
@@ -806,6 +959,8 @@ void LocalNetwork::project_equations(std::ostream& out)
   using namespace std;
   project_equations();
 
+  const GNU_gama::SparseMatrix<double, int>* Asp = input.mat();
+
   out << "\n" << pocet_neznamych_ << " " << pocmer_ << "\n\n";
 
   int*    ib;
@@ -843,10 +998,12 @@ void LocalNetwork::project_equations(Mat& A_, Vec& b_, Vec& w_)
 {
   project_equations();
 
-  A_.reset(A.rows(), A.cols());
+  const GNU_gama::SparseMatrix<double, int>* Asp = input.mat();
+
+  A_.reset(pocmer_, pocet_neznamych_);
   A_.set_zero();
-  b_.reset(A.rows());
-  w_.reset(A.rows());
+  b_.reset(pocmer_);
+  w_.reset(pocmer_);
 
   int*  ib;
   double* nb;
@@ -872,7 +1029,7 @@ void LocalNetwork::project_equations(Mat& A_, Vec& b_, Vec& w_)
 void LocalNetwork::conf_pr(double p)
 {
   if (p <= 0 || p >= 1)
-    throw GNU_gama::local::Exception(T_LN_undefined_confidence_level);
+    throw GNU_gama::local::Exception(texts().T_LN_undefined_confidence_level);
   konf_pr_ = p;
 }
 
@@ -892,7 +1049,7 @@ double LocalNetwork::m_0()
     }
   else
     {
-      throw GNU_gama::local::Exception(T_LN_undefined_type_of_actual_sigma);
+      throw GNU_gama::local::Exception(texts().T_LN_undefined_type_of_actual_sigma);
     }
 }
 
@@ -925,7 +1082,7 @@ double LocalNetwork::conf_int_coef()
     }
   else
     {
-      throw GNU_gama::local::Exception(T_LN_undefined_type_of_actual_sigma);
+      throw GNU_gama::local::Exception(texts().T_LN_undefined_type_of_actual_sigma);
     }
 }
 
@@ -944,16 +1101,37 @@ void LocalNetwork::update(Update etapa)
 
 double LocalNetwork::test_abs_term(int indm)
 {
-  Observation* m = RSM[indm-1];
+  return abs_term(RSM[indm-1], indm);
+}
+
 
-  const LocalPoint& stan = PD[m->from()];
-  const LocalPoint& cil  = PD[m->to()];   // ignoring second angle target here
+template <typename Obs>
+double LocalNetwork::abs_term(Obs* m, int indm)
+{
+  // points are searched without insertion of existing points,
+  // project_equations() takes points from the blocks of RSM_types
 
+  const PointData::const_iterator s = PD.find(m->from());
+  const PointData::const_iterator c = PD.find(m->to());
+  const LocalPoint& stan = s != PD.end() ? s->second : PD[m->from()];
+  const LocalPoint& cil  = c != PD.end() ? c->second : PD[m->to()];   // ignoring second angle target here
+
+  return abs_term(m, indm, stan, cil);
+}
+
+
+template <typename Obs>
+double LocalNetwork::abs_term(Obs* m, int indm,
+                              const LocalPoint& stan, const LocalPoint& cil)
+{
   TestAbsTermVisitor testVisitor(b, tol_abs_);
   testVisitor.setIndex(indm);
   testVisitor.setFromTo(stan, cil);
 
-  m->accept(&testVisitor);
+  if constexpr (std::is_same<Obs, Observation>::value)
+    m->accept(&testVisitor);
+  else
+    testVisitor.visit(m);
 
   return testVisitor.value();
 }
@@ -1112,40 +1290,43 @@ void LocalNetwork::forwardSubstitution(const CovMat& chol, Vec& v)
 */
 
 
-void LocalNetwork::prepareProjectEquations()
+void LocalNetwork::prepareProjectEquations(Homogenization& hom)
 {
-  int ind_0 = 0;
+  // ---  cofactors  --------------------------------------------------
+
+  int count = 0;   // number of diagonal blocks
+  int msize = 0;   // memory size
 
   for (ClusterList::const_iterator
          cluster=OD.clusters.begin(); cluster!=OD.clusters.end(); ++cluster)
     if (const int N = (*cluster)->activeObs())
-        {
-          Vec t(N);
-          CovMat C = (*cluster)->activeCov();
-          C /= (m_0_apr_*m_0_apr_);        // covariances ==> cofactors
-          Adj::choldec(C);                     // cofactors   ==> weights
+    {
+      int W = (*cluster)->covariance_matrix.bandWidth();
+      count++;
+      msize += 1+(N+N-W)*(W+1)/2;   // += number of band matrix elements
+    }
 
-          for (int j=1; j<=A.cols(); j++)
-            {
-              bool empty = true;
-              for (int k=1; k<=N; k++)
-                {
-                  double tmp = A(ind_0+k,j);
-                  t(k) = tmp;
-                  if (tmp) empty = false;
-                }
-                if (empty) continue;
+  GNU_gama::BlockDiagonal<> *bd = new GNU_gama::BlockDiagonal<>(count, msize);
 
-                Adj::forwardSubstitution(C, t);
-                for (int l=1; l<=N; l++) A(ind_0+l,j) = t(l);
-            }
+  for (ClusterList::const_iterator
+         cluster=OD.clusters.begin(); cluster!=OD.clusters.end(); ++cluster)
+    if (const int N = (*cluster)->activeObs())
+    {
+      CovMat C = (*cluster)->activeCov();
+      C /= (m_0_apr_*m_0_apr_);        // covariances ==> cofactors
+      bd->add_block(N, C.bandWidth(), C.begin());
+    }
 
-          for (int k=1; k<=N; k++) t(k) = b(ind_0+k);
-          Adj::forwardSubstitution(C, t);
-          for (int l=1; l<=N; l++) b(ind_0+l) = t(l);
+  input.set_cov(bd);
 
-          ind_0 += N;
-        }
+  // ---  right-hand side  --------------------------------------------
+
+  input.set_rhs(rhs_);     // right-hand side before homogenization
+
+  // ---  sparse design matrix and rhs scaled by chol. dec. of weights
+
+  hom.reset(&input);
+  b = hom.rhs();
 }
 
 
@@ -1154,15 +1335,18 @@ void LocalNetwork::vyrovnani_()
   using namespace GNU_gama::local;
   if (tst_vyrovnani_) return;
 
+  GNU_gama::Profile::Scope profile("adjustment");
+  GNU_gama::MemArena arena(mem_pool_);   // MemAlloc::Policy::pool
+
   do {
 
     project_equations();
     if (sum_unknowns()     == 0)
-      throw GNU_gama::local::Exception(T_GaMa_No_unknowns_defined);
+      throw GNU_gama::local::Exception(texts().T_GaMa_No_unknowns_defined);
     if (sum_observations() == 0)
-      throw GNU_gama::local::Exception(T_GaMa_No_observations_available);
+      throw GNU_gama::local::Exception(texts().T_GaMa_No_observations_available);
     if (sum_points()      == 0)
-      throw GNU_gama::local::Exception(T_GaMa_No_points_available);
+      throw GNU_gama::local::Exception(texts().T_GaMa_No_points_available);
 
     tst_vyrovnani_ = true;
 
@@ -1259,6 +1443,14 @@ void LocalNetwork::vyrovnani_()
     }
 
 
+  // weight coefficients of adjusted observations shared by sigma_L,
+  // vahkopr and obs_control()
+
+  {
+    GNU_gama::Profile::Scope profile("q_bb");
+    least_squares->q_bb_diagonal(q_bb_diag_);
+  }
+
   { /* ----------------------------------------------------------------- */
     sigma_L.reset(pocmer_);
 
@@ -1283,7 +1475,7 @@ void LocalNetwork::vyrovnani_()
                 if ((*i)->active())
                   {
                     // sigma_L = m0() * sqrt(least_squares->q_bb(n,n)) / weight_l
-                    sigma_L(n) = MM * sqrt(least_squares->q_bb(n,n)) * (*i)->stdDev();
+                    sigma_L(n) = MM * sqrt(q_bb_diag_(n)) * (*i)->stdDev();
                     n++;
                   }
             }
@@ -1300,7 +1492,7 @@ void LocalNetwork::vyrovnani_()
       {
         // F.Charamza: Geodet/PC p. 171
         // 1.1.56 double  qv = (1.0 - q_bb(i, i))/w(i);
-        double  qv = (1.0 - least_squares->q_bb(i, i))/ weight_obs(i);
+        double  qv = (1.0 - q_bb_diag_(i))/ weight_obs(i);
         vahkopr(i) = (qv >= 0) ? qv : 0;       // removing noise
       }
   }
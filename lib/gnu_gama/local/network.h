@@ -34,8 +34,14 @@
 #include <Math/Business/Adjustment/adj_basefull.h>
 #include <Math/Business/Adjustment/adj_basesparse.h>
 #include <gnu_gama/local/cluster.h>
+#include <gnu_gama/local/format.h>
+#include <gnu_gama/local/language.h>
 #include <gnu_gama/local/local_revision.h>
+#include <gnu_gama/local/observation_store.h>
 #include <Math/Business/Adjustment/adj.h>
+#include <Math/Business/Adjustment/homogenization.h>
+#include <Math/Service/memalloc.h>
+#include <Math/Service/svd.h>
 
 namespace GNU_gama { namespace local
 {
@@ -48,13 +54,14 @@ namespace GNU_gama { namespace local
     typedef GNU_gama::AdjBaseFull<double, int, MVE>  AdjBaseFull;
     typedef GNU_gama::AdjBaseSparse<double, int, MVE,
                                     GNU_gama::AdjInputData>  AdjBaseSparse;
+    typedef GNU_gama::Homogenization<double, int>    Homogenization;
 
     AdjBase                *least_squares {nullptr};
     GNU_gama::AdjInputData  input;
 
   public:
 
-    enum class Algorithm {gso, svd, cholesky, envelope};
+    enum class Algorithm {gso, svd, cholesky, envelope, supernodal};
 
     LocalNetwork();
     virtual ~LocalNetwork();
@@ -168,17 +175,17 @@ namespace GNU_gama { namespace local
     int sum_unknowns()
     {
       project_equations();
-      return A.cols();
+      return pocet_neznamych_;
     }
     int sum_observations()
     {
       project_equations();
-      return A.rows();
+      return pocmer_;
     }
     int degrees_of_freedom()
     {
       vyrovnani_();
-      return A.rows() - A.cols() + least_squares->defect();
+      return pocmer_ - pocet_neznamych_ + least_squares->defect();
     }
     int null_space();
 
@@ -187,6 +194,10 @@ namespace GNU_gama { namespace local
     double apriori_m_0() const   { return m_0_apr_; }
 
     double qxx(int i, int j) { return least_squares->q_xx(i,j); }
+    void   qxx(int n, const int i[], const int j[], double q[])
+    {
+      least_squares->q_xx_selected(n, i, j, q);
+    }
     double qbb(int i, int j) { return least_squares->q_bb(i,j); }
     double qbx(int i, int j) { return least_squares->q_bx(i,j); }
 
@@ -227,7 +238,8 @@ namespace GNU_gama { namespace local
        */
       // 1.1.20 return 100*fabs((1-sqrt(q_bb(i,i)*w(i))));
       using namespace std;
-      return 100*fabs(1-sqrt(least_squares->q_bb(i,i)));
+      vyrovnani_();
+      return 100*fabs(1-sqrt(q_bb_diag_(i)));
     }
     void std_error_ellipse(const PointID&, double& a,
                            double& b, double& alfa);
@@ -254,8 +266,23 @@ namespace GNU_gama { namespace local
 
     bool gons()    const { return  gons_; }
     bool degrees() const { return !gons_; }
-    void set_gons()      { gons_ = true;  Observation::gons = true;  }
-    void set_degrees()   { gons_ = false; Observation::gons = false; }
+    void set_gons()      { gons_ = true;  }
+    void set_degrees()   { gons_ = false; }
+
+    /** Output precisions of observations, see WriteVisitor. */
+    const Format& format() const { return format_; }
+    Format&       format()       { return format_; }
+
+    /** Language of output texts and messages of the network; the
+     *  language of the process (set_gama_language()) is used if not
+     *  set. */
+    gama_language language() const { return language_; }
+    void set_language(gama_language lang)
+    {
+      language_ = lang;
+      texts_ = &gama_texts(lang);
+    }
+    const Texts& texts() const { return *texts_; }
 
     // ...  connected network  .............................................
 
@@ -264,6 +291,14 @@ namespace GNU_gama { namespace local
     std::string algorithm() const;
     bool        has_algorithm() const;
     void        set_algorithm(Algorithm alg = Algorithm::envelope);
+    bool        has_ordering() const;
+    void        set_ordering(GNU_gama::SparseOrdering ord);
+    GNU_gama::SVDMethod svd_method() const { return svd_method_; }
+    void        set_svd_method(GNU_gama::SVDMethod m) { svd_method_ = m; }
+    double      factor_nonzeroes() const;
+    double      factor_flops() const;
+    int         threads() const { return threads_; }
+    void        set_threads(int n) { threads_ = n; }
     int         adj_covband() const;
     void        set_adj_covband(int value=-1);
     double      epoch() const;
@@ -308,6 +343,11 @@ namespace GNU_gama { namespace local
     int         iterations_ {};
     std::string algorithm_;           // algorithm name or empty string
     bool        has_algorithm_;
+    GNU_gama::SparseOrdering ordering_ {GNU_gama::SparseOrdering::rcm};
+    bool        has_ordering_ {false};
+    GNU_gama::SVDMethod svd_method_ {GNU_gama::SVDMethod::golub_reinsch};
+    int         threads_ {1};         // threads in linearization and decomposition
+    GNU_gama::MemPool mem_pool_;      // matrices and vectors of adjustment
     double      epoch_;
     bool        has_epoch_;
     double      latitude_;
@@ -315,7 +355,13 @@ namespace GNU_gama { namespace local
     std::string ellipsoid_;
     bool        has_ellipsoid_;
 
+    template <typename Obs> double abs_term(Obs* m, int indm);
+    template <typename Obs> double abs_term(Obs* m, int indm,
+                                            const LocalPoint& from,
+                                            const LocalPoint& to);
+
     RevisedObsList          RSM;
+    ObservationStore        RSM_types;  // RSM partitioned by types
 
     PointIDList undefined_xy_z_;      // revision of points
     int pocbod_;
@@ -349,14 +395,14 @@ namespace GNU_gama { namespace local
 
     std::vector<neznama_> seznez_;  // list of unknowns
 
-    Mat A;
+    Mat A;                // dense design matrix for AdjBaseFull only
     Vec b;
     Vec rhs_;             // right-hand side
     Vec r;
     Vec sigma_L;          // standard deviation of adjusted observation
     Vec vahkopr;          // weight coefficient of residuals
+    Vec q_bb_diag_;       // diagonal of weight coefficients q_bb(i,i)
     double suma_pvv_;
-    GNU_gama::SparseMatrix<double, int>*  Asp;
 
     bool design_matrix_graph_is_connected;
 
@@ -369,6 +415,9 @@ namespace GNU_gama { namespace local
     int* min_x_;
 
     bool   gons_;
+    Format format_;
+    gama_language language_;
+    const Texts*  texts_;
 
     // preparation for design matrix
 
@@ -382,8 +431,8 @@ namespace GNU_gama { namespace local
     */
 
     // void backwardSubstitution(const Cov& chol, Vec& v);
-    void prepareProjectEquations();
-    bool singular_coords(const Mat&);
+    void prepareProjectEquations(Homogenization&);
+    bool singular_coords(const GNU_gama::SparseMatrix<double, int>&);
 
     // fixing inconsitent systems
 
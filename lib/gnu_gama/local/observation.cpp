@@ -27,16 +27,6 @@
 #include <Math/Business/Core/radian.h>
 
 
-namespace GNU_gama { namespace local
-{
-  // the static member Observation::gons was introduced in 1.7.09 to
-  // enable selection between grades and degrees in virtual functions
-  // Observation::write() with minimal changes in existing old code of
-  // GNU_gama::local
-
-  bool Observation::gons = true;
-}}
-
 using namespace GNU_gama::local;
 using namespace std;
 
@@ -0,0 +1,230 @@
+/*
+  GNU Gama C++ library
+  Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library
+
+  GNU Gama is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GNU Gama is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file observation_store.h
+ * \brief #GNU_gama::local::ObservationStore class header file
+ */
+
+#ifndef gama_local_ObservationStore_h
+#define gama_local_ObservationStore_h
+
+#include <gnu_gama/local/observation.h>
+#include <gnu_gama/local/gamadata.h>
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace GNU_gama { namespace local {
+
+  /** \brief Revised observations partitioned by their types.
+   *
+   * Observations remain owned by their clusters, the store keeps for
+   * each observation type a contiguous block (structure of arrays) of
+   * typed pointers, rows (0-based indexes in the list of revised
+   * observations), points of observations and observed values.
+   * Observations are dispatched by accept() and their points are
+   * looked up only once in build(), values are copied by gather()
+   * (observations can be reduced after the store was built). Loops
+   * over the store then call the visit functions of concrete visitors
+   * resolved at compile time, without dynamic_cast of the acyclic
+   * visitor, and read numeric fields from the arrays.
+   *
+   * Blocks are concatenated in a fixed order of types, position
+   * ranges used by for_range() can be processed in parallel.
+   */
+  class ObservationStore
+    {
+    public:
+
+      template <typename T> struct Block
+      {
+        std::vector<T*>          obs;    ///< observations of type T
+        std::vector<int>         row;    ///< rows of observations
+        std::vector<double>      value;  ///< observed values, see gather()
+        std::vector<LocalPoint*> from;   ///< standpoints
+        std::vector<LocalPoint*> to;     ///< targets (null for X, Y, Z)
+        std::vector<LocalPoint*> fs;     ///< foresights (only angles)
+
+        void clear()
+        {
+          obs.clear(); row.clear(); value.clear();
+          from.clear(); to.clear(); fs.clear();
+        }
+      };
+
+      /** Partitions list of revised observations and looks up their
+       *  points, missing points are inserted into \a pd. */
+      void build(const std::vector<Observation*>& list, PointData& pd)
+      {
+        clear();
+        Partition partition(*this, pd);
+        for (int r=0; r<int(list.size()); r++)
+          {
+            partition.row = r;
+            list[r]->accept(&partition);
+          }
+      }
+
+      /** Copies observed values into the blocks. */
+      void gather()
+      {
+        std::apply([](auto&... b) { (gather_block(b), ...); }, blocks_);
+      }
+
+      void clear()
+      {
+        std::apply([](auto&... b) { (b.clear(), ...); }, blocks_);
+        size_ = 0;
+      }
+
+      int size() const { return size_; }
+
+      template <typename T> const Block<T>& block() const
+      {
+        return std::get<Block<T>>(blocks_);
+      }
+
+      /** Calls f(obs, row) for observations at positions [first, last)
+       *  of the concatenated blocks, \a obs is a pointer to concrete
+       *  observation type. */
+      template <typename Function>
+      void for_range(int first, int last, Function&& f) const
+      {
+        int offset = 0;
+        std::apply([&](const auto&... b) { (range(b, offset, first, last, f), ...); },
+                   blocks_);
+      }
+
+      /** Calls f(block, i) for observations at positions [first, last)
+       *  of the concatenated blocks, \a i is the index of the
+       *  observation in its block. */
+      template <typename Function>
+      void for_items(int first, int last, Function&& f) const
+      {
+        int offset = 0;
+        std::apply([&](const auto&... b) { (items(b, offset, first, last, f), ...); },
+                   blocks_);
+      }
+
+      template <typename Function>
+      void for_each(Function&& f) const
+      {
+        for_range(0, size_, f);
+      }
+
+      /** Adapter for visitors, observations are visited block by block. */
+      void accept(AllObservationsVisitor* visitor) const
+      {
+        for_each([visitor](auto* obs, int)
+          {
+            using T = std::remove_pointer_t<decltype(obs)>;
+            static_cast<Visitor<T>*>(visitor)->visit(obs);
+          });
+      }
+
+    private:
+
+      std::tuple<Block<Distance>,  Block<Direction>, Block<Angle>,
+                 Block<H_Diff>,    Block<S_Distance>, Block<Z_Angle>,
+                 Block<X>,         Block<Y>,          Block<Z>,
+                 Block<Xdiff>,     Block<Ydiff>,      Block<Zdiff>,
+                 Block<Azimuth>>   blocks_;
+      int size_ {0};
+
+      template <typename T, typename Function>
+      static void range(const Block<T>& b, int& offset, int first, int last,
+                        Function& f)
+      {
+        const int n = int(b.obs.size());
+        const int s = std::max(first - offset, 0);
+        const int e = std::min(last  - offset, n);
+        for (int i=s; i<e; i++) f(b.obs[i], b.row[i]);
+        offset += n;
+      }
+
+      template <typename T, typename Function>
+      static void items(const Block<T>& b, int& offset, int first, int last,
+                        Function& f)
+      {
+        const int n = int(b.obs.size());
+        const int s = std::max(first - offset, 0);
+        const int e = std::min(last  - offset, n);
+        for (int i=s; i<e; i++) f(b, i);
+        offset += n;
+      }
+
+      template <typename T> static void gather_block(Block<T>& b)
+      {
+        const int n = int(b.obs.size());
+        for (int i=0; i<n; i++) b.value[i] = b.obs[i]->value();
+      }
+
+      class Partition : public AllObservationsVisitor
+      {
+      public:
+        Partition(ObservationStore& s, PointData& p)
+          : store(s), pd(p), row(0)
+        {
+        }
+
+        ObservationStore& store;
+        PointData& pd;
+        int row;
+
+        void visit(Distance* obs)   { add(obs); }
+        void visit(Direction* obs)  { add(obs); }
+        void visit(Angle* obs)      { add(obs); }
+        void visit(H_Diff* obs)     { add(obs); }
+        void visit(S_Distance* obs) { add(obs); }
+        void visit(Z_Angle* obs)    { add(obs); }
+        void visit(X* obs)          { add(obs); }
+        void visit(Y* obs)          { add(obs); }
+        void visit(Z* obs)          { add(obs); }
+        void visit(Xdiff* obs)      { add(obs); }
+        void visit(Ydiff* obs)      { add(obs); }
+        void visit(Zdiff* obs)      { add(obs); }
+        void visit(Azimuth* obs)    { add(obs); }
+
+      private:
+        template <typename T> void add(T* obs)
+        {
+          Block<T>& b = std::get<Block<T>>(store.blocks_);
+          b.obs.push_back(obs);
+          b.row.push_back(row);
+          b.value.push_back(obs->value());
+          b.from.push_back(point(obs->from()));
+          b.to.push_back(obs->to() == PointID() ? nullptr : point(obs->to()));
+          if constexpr (std::is_same<T, Angle>::value)
+            b.fs.push_back(point(obs->fs()));
+          store.size_++;
+        }
+
+        LocalPoint* point(const PointID& id)
+        {
+          PointData::iterator p = pd.find(id);
+          return p != pd.end() ? &p->second : &pd[id];
+        }
+      };
+    };
+
+}}
+
+#endif
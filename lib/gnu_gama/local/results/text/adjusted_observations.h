@@ -80,7 +80,7 @@ public:
 
     void visit(Distance* obs)
     {
-        out << T_GaMa_distance;
+        out << IS->texts().T_GaMa_distance;
         out.precision(distPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -92,7 +92,7 @@ public:
 
     void visit(Direction* obs)
     {
-        out << T_GaMa_direction;
+        out << IS->texts().T_GaMa_direction;
         out.precision(angularPrecision);
         out.width(maxval);
         double m = GNU_gama::RAD_TO_GON*(obs->value());
@@ -115,7 +115,7 @@ public:
         out << '\n';
         const int w = IS->maxw_obs() + 2 + 2*(IS->maxw_id());
         out << Utf8::leftPad(obs->fs().str(), w);
-        out << T_GaMa_angle;
+        out << IS->texts().T_GaMa_angle;
         out.precision(angularPrecision);
         out.width(maxval);
         double m = GNU_gama::RAD_TO_DEG*(obs->value());
@@ -135,7 +135,7 @@ public:
 
     void visit(H_Diff* obs)
     {
-        out << T_GaMa_levell;
+        out << IS->texts().T_GaMa_levell;
         out.precision(distPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -147,7 +147,7 @@ public:
 
     void visit(S_Distance* obs)
     {
-        out << T_GaMa_s_distance;
+        out << IS->texts().T_GaMa_s_distance;
         out.precision(distPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -159,7 +159,7 @@ public:
 
     void visit(Z_Angle* obs)
     {
-        out << T_GaMa_z_angle;
+        out << IS->texts().T_GaMa_z_angle;
         out.precision(angularPrecision);
         out.width(maxval);
         double m = GNU_gama::RAD_TO_DEG*(obs->value());
@@ -176,7 +176,7 @@ public:
     }
     void visit(X* obs)
     {
-        out << T_GaMa_x;
+        out << IS->texts().T_GaMa_x;
         out.precision(coordPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -187,7 +187,7 @@ public:
     }
     void visit(Y* obs)
     {
-        out << T_GaMa_y;
+        out << IS->texts().T_GaMa_y;
         out.precision(coordPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -199,7 +199,7 @@ public:
 
     void visit(Z* obs)
     {
-        out << T_GaMa_z;
+        out << IS->texts().T_GaMa_z;
         out.precision(coordPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -210,7 +210,7 @@ public:
     }
     void visit(Xdiff* obs)
     {
-        out << T_GaMa_xdiff;
+        out << IS->texts().T_GaMa_xdiff;
         out.precision(coordPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -222,7 +222,7 @@ public:
 
     void visit(Ydiff* obs)
     {
-        out << T_GaMa_ydiff;
+        out << IS->texts().T_GaMa_ydiff;
         out.precision(coordPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -234,7 +234,7 @@ public:
 
     void visit(Zdiff* obs)
     {
-        out << T_GaMa_zdiff;
+        out << IS->texts().T_GaMa_zdiff;
         out.precision(coordPrecision);
         out.width(maxval);
         double m = obs->value();
@@ -246,7 +246,7 @@ public:
 
     void visit(Azimuth* obs)
     {
-        out << T_GaMa_azimuth;
+        out << IS->texts().T_GaMa_azimuth;
         out.precision(angularPrecision);
         out.width(maxval);
         double m = GNU_gama::RAD_TO_DEG*(obs->value());
@@ -272,13 +272,15 @@ void AdjustedObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
    using namespace std;
    using namespace GNU_gama::local;
 
+   const Texts& texts = IS->texts();
+
    const int    y_sign = IS->y_sign();
    const Vec&   v      = IS->residuals();
    const int    pocmer = IS->sum_observations();
    const double scale  = IS->gons() ? 1.0 : 0.324;
 
-   out << T_GaMa_adjobs_Adjusted_observations << "\n"
-       << underline(T_GaMa_adjobs_Adjusted_observations, '*') << "\n\n";
+   out << texts.T_GaMa_adjobs_Adjusted_observations << "\n"
+       << underline(texts.T_GaMa_adjobs_Adjusted_observations, '*') << "\n\n";
 
    int minval = 12;
    int maxval = minval;   // maximal value field width (coordinates!)
@@ -307,18 +309,18 @@ void AdjustedObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
    out.width(IS->maxw_obs());
    out << "i" << " ";
    out.width(IS->maxw_id());
-   out << T_GaMa_standpoint << " ";
+   out << texts.T_GaMa_standpoint << " ";
    out.width(IS->maxw_id());
-   out << T_GaMa_target << "       ";
+   out << texts.T_GaMa_target << "       ";
    out.width(maxval);
-   out << T_GaMa_adjobs_observed << " ";
+   out << texts.T_GaMa_adjobs_observed << " ";
    out.width(maxval);
-   out << T_GaMa_adjobs_adjusted << T_GaMa_adjobs_header1;
+   out << texts.T_GaMa_adjobs_adjusted << texts.T_GaMa_adjobs_header1;
    {   // for ...
      int kk = 13 + maxval-minval;
      for (int i=0; i < (IS->maxw_obs()+2*(IS->maxw_id())+kk); i++) out << "=";
    }   // for ...
-   out << T_GaMa_adjobs_value;
+   out << texts.T_GaMa_adjobs_value;
    {
      for (int i=minval; i<maxval; i++) out << "=";
    }
@@ -34,6 +34,8 @@ void AdjustedUnknowns(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   using namespace std;
   using namespace GNU_gama::local;
 
+  const Texts& texts = IS->texts();
+
   const int y_sign = IS->y_sign();
 
   const Vec& x = IS->solve();
@@ -55,16 +57,16 @@ void AdjustedUnknowns(GNU_gama::local::LocalNetwork* IS, OutStream& out)
       PointID mp_max_cb, prev_id;
       int pocbod = 0;
 
-      out << T_GaMa_adjunk_Review_of_unknowns_coordidantes << "\n"
-          << underline(T_GaMa_adjunk_Review_of_unknowns_coordidantes, '*')
+      out << texts.T_GaMa_adjunk_Review_of_unknowns_coordidantes << "\n"
+          << underline(texts.T_GaMa_adjunk_Review_of_unknowns_coordidantes, '*')
           << "\n\n";
       out.width(IS->maxw_unk());
       out << "i" << " ";
       out.width(IS->maxw_id());
-      out << T_GaMa_point;
-      out << T_GaMa_adjunk_header1;
+      out << texts.T_GaMa_point;
+      out << texts.T_GaMa_adjunk_header1;
       for (int i=0; i<IS->maxw_unk()+IS->maxw_id()+1; i++) out << '=';
-      out << T_GaMa_adjunk_header2;
+      out << texts.T_GaMa_adjunk_header2;
       out.setf(ios_base::fixed, ios_base::floatfield);
 
       for (PointData::const_iterator ii=IS->PD.begin(); ii!=IS->PD.end(); ii++)
@@ -178,10 +180,10 @@ void AdjustedUnknowns(GNU_gama::local::LocalNetwork* IS, OutStream& out)
       if (pocbod >= 5)
         {
           out.precision(1);
-          out << T_GaMa_adjunk_mean_position_error_maximal << mp_max
-              << T_GaMa_adjunk_mean_position_error_on_point
+          out << texts.T_GaMa_adjunk_mean_position_error_maximal << mp_max
+              << texts.T_GaMa_adjunk_mean_position_error_on_point
               << mp_max_cb << '\n'
-              << T_GaMa_adjunk_mean_position_error_average << mp_prum/pocbod
+              << texts.T_GaMa_adjunk_mean_position_error_average << mp_prum/pocbod
               << " mm\n\n";
         }
 
@@ -199,18 +201,18 @@ void AdjustedUnknowns(GNU_gama::local::LocalNetwork* IS, OutStream& out)
     {
       const double scale  = IS->gons() ? 1.0 : 0.324;
 
-      out << T_GaMa_adjunk_Review_of_unknowns_bearings << "\n"
-          << underline(T_GaMa_adjunk_Review_of_unknowns_bearings, '*')
+      out << texts.T_GaMa_adjunk_Review_of_unknowns_bearings << "\n"
+          << underline(texts.T_GaMa_adjunk_Review_of_unknowns_bearings, '*')
           << "\n\n";
       out.width(IS->maxw_unk());
       out << "i" << " ";
       out.width(IS->maxw_id());
-      out << T_GaMa_standpoint;
+      out << texts.T_GaMa_standpoint;
       if (IS->degrees()) out << "   ";
-      out << T_GaMa_adjunk_header3;
+      out << texts.T_GaMa_adjunk_header3;
       for (int i=0; i<IS->maxw_unk()+IS->maxw_id()+1; i++) out << '=';
       if (IS->gons())
-        out  << T_GaMa_adjunk_header4;
+        out  << texts.T_GaMa_adjunk_header4;
       else
         out <<
           "====== [d] ========= [d] ======== [d] =========== [ss] ===\n\n";
@@ -276,16 +278,16 @@ void AdjustedUnknowns(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   }
   if (vysky && !sour)
     {
-      out << T_GaMa_adjunk_Review_of_unknowns_heights << "\n"
-          << underline(T_GaMa_adjunk_Review_of_unknowns_heights, '*')
+      out << texts.T_GaMa_adjunk_Review_of_unknowns_heights << "\n"
+          << underline(texts.T_GaMa_adjunk_Review_of_unknowns_heights, '*')
           << "\n\n";
       out.width(IS->maxw_unk());
       out << "i" << " ";
       out.width(IS->maxw_id());
-      out << T_GaMa_point;
-      out << T_GaMa_adjunk_header5;
+      out << texts.T_GaMa_point;
+      out << texts.T_GaMa_adjunk_header5;
       { for (int i=0; i<IS->maxw_unk()+IS->maxw_id()+1; i++) out << '='; }
-      out << T_GaMa_adjunk_header6;
+      out << texts.T_GaMa_adjunk_header6;
       out.setf(ios_base::fixed, ios_base::floatfield);
 
       for (int i=1; i<=pocnez; i++)
@@ -22,6 +22,7 @@
 #ifndef GaMa_GaMaProg_Priblizne_Souradnice_h_
 #define GaMa_GaMaProg_Priblizne_Souradnice_h_
 
+#include <gnu_gama/local/language.h>
 #include <gnu_gama/local/results/text/underline.h>
 #include <cctype>
 #include <iomanip>
@@ -29,7 +30,8 @@
 namespace GNU_gama { namespace local {
 
 template <typename Stats, typename OutStream>
-void ApproximateCoordinates(Stats* acord, OutStream& out)
+void ApproximateCoordinates(Stats* acord, OutStream& out,
+                            const Texts& texts = gama_texts(get_gama_language()))
 {
    using namespace std;
    using namespace GNU_gama::local;
@@ -39,37 +41,37 @@ void ApproximateCoordinates(Stats* acord, OutStream& out)
        acord->given_xy  == acord->total_xy  &&
        acord->given_z   == acord->total_z   ) return;
 
-   out << T_GaMa_approx_Review_of_approximate_coordinates << "\n"
-       << underline(T_GaMa_approx_Review_of_approximate_coordinates, '*')
+   out << texts.T_GaMa_approx_Review_of_approximate_coordinates << "\n"
+       << underline(texts.T_GaMa_approx_Review_of_approximate_coordinates, '*')
        << "\n\n";
 
    const int aw = 10;
-   out << T_GaMa_approx_header1
+   out << texts.T_GaMa_approx_header1
        << setw(aw) << "xyz" << setw(aw) << "xy" << setw(aw) << "z" << "\n\n";
-   out << T_GaMa_approx_given_coordinates
+   out << texts.T_GaMa_approx_given_coordinates
        << setw(aw) << acord->given_xyz
        << setw(aw) << acord->given_xy
        << setw(aw) << acord->given_z
        << "\n";
-   out << T_GaMa_approx_computed_coordinates
+   out << texts.T_GaMa_approx_computed_coordinates
        << setw(aw) << acord->computed_xyz
        << setw(aw) << acord->computed_xy
        << setw(aw) << acord->computed_z
        << "\n";
-   out << T_GaMa_approx_separator << "\n"
-       << T_GaMa_approx_total
+   out << texts.T_GaMa_approx_separator << "\n"
+       << texts.T_GaMa_approx_total
        << setw(aw) << acord->total_xyz
        << setw(aw) << acord->total_xy
        << setw(aw) << acord->total_z
        << "\n\n";
-   out << T_GaMa_approx_observations
+   out << texts.T_GaMa_approx_observations
        << setw(aw) << acord->observations << "\n\n";
 
    if (acord->missing_coordinates)
      {
        PointData& PD = acord->PD;
-       out << T_GaMa_missing_coordinates << "\n"
-           << underline(T_GaMa_missing_coordinates, '-') << "\n";
+       out << texts.T_GaMa_missing_coordinates << "\n"
+           << underline(texts.T_GaMa_missing_coordinates, '-') << "\n";
        for (PointData::const_iterator i=PD.begin(); i!=PD.end(); ++i)
          {
            const LocalPoint& p = (*i).second;
@@ -34,6 +34,8 @@ void ErrorEllipses(GNU_gama::local::LocalNetwork* IS, OutStream& out)
    using namespace std;
    using namespace GNU_gama::local;
 
+   const Texts& texts = IS->texts();
+
    const int y_sign = IS->y_sign();
 
    const Vec& x = IS->solve();
@@ -74,15 +76,15 @@ void ErrorEllipses(GNU_gama::local::LocalNetwork* IS, OutStream& out)
      out.precision(1);
 
      out
-       << T_GaMa_errell_review_of_mean_errors_and_error_ellipses << "\n"
-       << underline(T_GaMa_errell_review_of_mean_errors_and_error_ellipses,'*')
+       << texts.T_GaMa_errell_review_of_mean_errors_and_error_ellipses << "\n"
+       << underline(texts.T_GaMa_errell_review_of_mean_errors_and_error_ellipses,'*')
        << "\n\n";
      out.width(IS->maxw_id());
-     out << T_GaMa_point << ' ';
-     out << T_GaMa_errell_header1;
+     out << texts.T_GaMa_point << ' ';
+     out << texts.T_GaMa_errell_header1;
      for (int i=0; i<IS->maxw_id()+1; i++) out << '=';
      if (IS->gons())
-       out << T_GaMa_errell_header2;
+       out << texts.T_GaMa_errell_header2;
      else
        out <<
          "== [mm] == [mm] ==== a [mm] b ==== [d] ===== a' [mm] b' ========";
@@ -194,10 +196,10 @@ void ErrorEllipses(GNU_gama::local::LocalNetwork* IS, OutStream& out)
        {
          out.precision(1);
          out << '\n'
-             << T_GaMa_adjunk_mean_position_error_maximal << mp_max
-             << T_GaMa_adjunk_mean_position_error_on_point
+             << texts.T_GaMa_adjunk_mean_position_error_maximal << mp_max
+             << texts.T_GaMa_adjunk_mean_position_error_on_point
              << mp_max_cb << '\n'
-             << T_GaMa_adjunk_mean_position_error_average << mp_prum/pocbod
+             << texts.T_GaMa_adjunk_mean_position_error_average << mp_prum/pocbod
              << " mm\n";
        }
 
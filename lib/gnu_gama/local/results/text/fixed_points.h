@@ -35,6 +35,8 @@ void FixedPoints(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   using namespace std;
   using namespace GNU_gama::local;
 
+  const Texts& texts = IS->texts();
+
   const int y_sign = IS->y_sign();
 
   int pocpevb=0, pocpevv=0;
@@ -47,12 +49,12 @@ void FixedPoints(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   }   // for ...
   if (pocpevb == 0 && pocpevv == 0) return;
 
-  out << T_GaMa_Review_of_fixed_points << "\n"
-      << underline(T_GaMa_Review_of_fixed_points, '*') << "\n\n";
+  out << texts.T_GaMa_Review_of_fixed_points << "\n"
+      << underline(texts.T_GaMa_Review_of_fixed_points, '*') << "\n\n";
 
 
   out.width(IS->maxw_id());
-  out << T_GaMa_point;
+  out << texts.T_GaMa_point;
   int table=0;
   if (pocpevb)
     {
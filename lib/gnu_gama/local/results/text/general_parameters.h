@@ -53,13 +53,15 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   using namespace std;
   using namespace GNU_gama::local;
 
+  const Texts& texts = IS->texts();
+
   IS->null_space();   // triggers adjusment; needed for printing removed points
 
   {
     if (!IS->removed_points.empty())
       {
-        out << T_LN_rm_removed_points << "\n"
-            << underline(T_LN_rm_removed_points, '*') << "\n\n";
+        out << texts.T_LN_rm_removed_points << "\n"
+            << underline(texts.T_LN_rm_removed_points, '*') << "\n\n";
 
         list<LocalNetwork::rm_points>::iterator c = IS->removed_code.begin();
 
@@ -71,21 +73,21 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
             switch ( *c )
               {
               case LocalNetwork::rm_missing_xyz :
-                out << T_LN_rm_missing_xyz;     break;
+                out << texts.T_LN_rm_missing_xyz;     break;
               case LocalNetwork::rm_missing_xy  :
-                out << T_LN_rm_missing_xy;      break;
+                out << texts.T_LN_rm_missing_xy;      break;
               case LocalNetwork::rm_missing_z   :
-                out << T_LN_rm_missing_z;       break;
+                out << texts.T_LN_rm_missing_z;       break;
               case LocalNetwork::rm_singular_xy :
-                out << T_LN_rm_singular_xy;     break;
+                out << texts.T_LN_rm_singular_xy;     break;
               case LocalNetwork::rm_singular_z  :
-                out << T_LN_rm_singular_z;      break;
+                out << texts.T_LN_rm_singular_z;      break;
               case LocalNetwork::rm_huge_cov_xyz:
-                out << T_LN_rm_huge_cov_xyz;    break;
+                out << texts.T_LN_rm_huge_cov_xyz;    break;
               case LocalNetwork::rm_huge_cov_xy :
-                out << T_LN_rm_huge_cov_xy;     break;
+                out << texts.T_LN_rm_huge_cov_xy;     break;
               case LocalNetwork::rm_huge_cov_z  :
-                out << T_LN_rm_huge_cov_z;      break;
+                out << texts.T_LN_rm_huge_cov_z;      break;
               default:
                 ;
               }
@@ -96,8 +98,8 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
 
   }
 
-  out << T_GaMa_General_solution_parameters << "\n"
-      << underline(T_GaMa_General_solution_parameters, '*') << "\n\n";
+  out << texts.T_GaMa_General_solution_parameters << "\n"
+      << underline(texts.T_GaMa_General_solution_parameters, '*') << "\n\n";
 
   {
     // summary of coordinates in adjustment
@@ -128,36 +130,36 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
     int w1 = 0, w_ = 8;
     {
       int n;
-      n = Utf8::length(T_GaMa_gpar1_coordinates);            if (n > w1) w1 = n;
-      n = Utf8::length(T_GaMa_gpar1_adjusted_coordinates);   if (n > w1) w1 = n;
-      n = Utf8::length(T_GaMa_gpar1_constrained_coordinates);if (n > w1) w1 = n;
-      n = Utf8::length(T_GaMa_gpar1_fixed_coordinates);      if (n > w1) w1 = n;
-      n = Utf8::length(T_GaMa_gpar1_total);                  if (n > w1) w1 = n;
+      n = Utf8::length(texts.T_GaMa_gpar1_coordinates);            if (n > w1) w1 = n;
+      n = Utf8::length(texts.T_GaMa_gpar1_adjusted_coordinates);   if (n > w1) w1 = n;
+      n = Utf8::length(texts.T_GaMa_gpar1_constrained_coordinates);if (n > w1) w1 = n;
+      n = Utf8::length(texts.T_GaMa_gpar1_fixed_coordinates);      if (n > w1) w1 = n;
+      n = Utf8::length(texts.T_GaMa_gpar1_total);                  if (n > w1) w1 = n;
     }
 
     out.setf(ios_base::left,  ios_base::adjustfield);
-    out << setw(w1) << T_GaMa_gpar1_coordinates << " ";
+    out << setw(w1) << texts.T_GaMa_gpar1_coordinates << " ";
     out.setf(ios_base::right, ios_base::adjustfield);
     out << setw(w_+1) << "xyz"
         << setw(w_-1) << "xy"
         << setw(w_)   << "z"  << "\n\n";
 
     out.setf(ios_base::left,  ios_base::adjustfield);
-    out << Utf8::rightPad(T_GaMa_gpar1_adjusted_coordinates, w1) << ":";
+    out << Utf8::rightPad(texts.T_GaMa_gpar1_adjusted_coordinates, w1) << ":";
     out.setf(ios_base::right, ios_base::adjustfield);
     out << setw(w_)  << a_xyz
         << setw(w_)  << a_xy
         << setw(w_)  << a_z
         << '\n';
     out.setf(ios_base::left,  ios_base::adjustfield);
-    out << Utf8::rightPad(T_GaMa_gpar1_constrained_coordinates, w1) << ":";
+    out << Utf8::rightPad(texts.T_GaMa_gpar1_constrained_coordinates, w1) << ":";
     out.setf(ios_base::right, ios_base::adjustfield);
     out << setw(w_)  << c_xyz
         << setw(w_)  << c_xy
         << setw(w_)  << c_z
         << '\n';
     out.setf(ios_base::left,  ios_base::adjustfield);
-    out << Utf8::rightPad(T_GaMa_gpar1_fixed_coordinates, w1) << ":";
+    out << Utf8::rightPad(texts.T_GaMa_gpar1_fixed_coordinates, w1) << ":";
     out.setf(ios_base::right, ios_base::adjustfield);
     out << setw(w_)  << f_xyz
         << setw(w_)  << f_xy
@@ -168,7 +170,7 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
     out << "\n";
 
     out.setf(ios_base::left,  ios_base::adjustfield);
-    out << Utf8::rightPad(T_GaMa_gpar1_total, w1) << ":";
+    out << Utf8::rightPad(texts.T_GaMa_gpar1_total, w1) << ":";
     out.setf(ios_base::right, ios_base::adjustfield);
     out << setw(w_)  << (a_xyz + f_xyz)
         << setw(w_)  << (a_xy  + f_xy )
@@ -179,16 +181,16 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   int w1 = 0;
   {
     int n;
-    n = Utf8::length(T_GaMa_gpar1_directions);       if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_angles);           if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_distances);        if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_observed_coords);  if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_leveling_diffs);   if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_z_angles);         if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_s_dists);          if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_obs_total);        if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_equations);        if (n > w1) w1 = n;
-    n = Utf8::length(T_GaMa_gpar1_redundancy);       if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_directions);       if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_angles);           if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_distances);        if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_observed_coords);  if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_leveling_diffs);   if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_z_angles);         if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_s_dists);          if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_obs_total);        if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_equations);        if (n > w1) w1 = n;
+    n = Utf8::length(texts.T_GaMa_gpar1_redundancy);       if (n > w1) w1 = n;
   }
 
   int pocosn = 0;
@@ -201,10 +203,10 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
     int n;
     if (pocosn)
       {
-        n = Utf8::length(T_GaMa_gpar2_bearings);        if (n > w2) w2 = n;
+        n = Utf8::length(texts.T_GaMa_gpar2_bearings);        if (n > w2) w2 = n;
       }
-    n = Utf8::length(T_GaMa_gpar2_number_of_unknowns);  if (n > w2) w2 = n;
-    n = Utf8::length(T_GaMa_gpar2_network_defect);      if (n > w2) w2 = n;
+    n = Utf8::length(texts.T_GaMa_gpar2_number_of_unknowns);  if (n > w2) w2 = n;
+    n = Utf8::length(texts.T_GaMa_gpar2_network_defect);      if (n > w2) w2 = n;
   }
   const char* tab_sep = "            ";
 
@@ -227,39 +229,39 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
 
   if (pocosn)
     {
-      out << set_width(T_GaMa_gpar1_directions, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_directions, w1) << ":"
           << setw(6) << pocsmer << tab_sep
-          << set_width(T_GaMa_gpar2_bearings, w2) << ":"
+          << set_width(texts.T_GaMa_gpar2_bearings, w2) << ":"
           << setw(6) << pocosn << '\n';
     }
   if (pocuhl)
     {
-      out << set_width(T_GaMa_gpar1_angles, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_angles, w1) << ":"
           << setw(6) << pocuhl << '\n';
     }
   if (pocdel)
     {
-      out << set_width(T_GaMa_gpar1_distances, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_distances, w1) << ":"
           << setw(6) << pocdel << '\n';
     }
   if (pocsour)
     {
-      out << set_width(T_GaMa_gpar1_observed_coords, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_observed_coords, w1) << ":"
           << setw(6) << pocsour << '\n';
     }
   if (pocnivp && (pocnivp != IS->sum_observations()))
     {
-      out << set_width(T_GaMa_gpar1_leveling_diffs, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_leveling_diffs, w1) << ":"
           << setw(6) << pocnivp << '\n';
     }
   if (poczeni)
     {
-      out << set_width(T_GaMa_gpar1_z_angles, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_z_angles, w1) << ":"
           << setw(6) << poczeni << '\n';
     }
   if (pocsikm)
     {
-      out << set_width(T_GaMa_gpar1_s_dists, w1) << ":"
+      out << set_width(texts.T_GaMa_gpar1_s_dists, w1) << ":"
           << setw(6) << pocsikm << '\n';
     }
   int types = 0;
@@ -271,7 +273,7 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   if (poczeni) types++;
   if (pocsikm) types++;
   if (types != 1)
-    out << set_width(T_GaMa_gpar1_obs_total, w1) << ":"
+    out << set_width(texts.T_GaMa_gpar1_obs_total, w1) << ":"
         << setw(6) << IS->sum_observations() << "\n";
   out << '\n';
   out.flush();
@@ -283,24 +285,24 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
     try {
       if (IS->min_n() < d)
         throw MatVecException(GNU_gama::Exception::BadRegularization,
-                              T_GaMa_not_enough_constrained_points);
+                              texts.T_GaMa_not_enough_constrained_points);
       IS->trans_VWV();  // now I try to adjust the nework
     }
     catch (const MatVecException& vs)
       {
         if (vs.error() != GNU_gama::Exception::BadRegularization) throw;
 
-        out << T_GaMa_Free_network << "\n"
-            << underline(T_GaMa_Free_network, '*') << "\n\n";
+        out << texts.T_GaMa_Free_network << "\n"
+            << underline(texts.T_GaMa_Free_network, '*') << "\n\n";
 
-        out << T_GaMa_Free_network_defect_is << d << ". ";
-        out << T_GaMa_Given_network_configuration_can_not_be_adjusted << ".\n";
+        out << texts.T_GaMa_Free_network_defect_is << d << ". ";
+        out << texts.T_GaMa_Given_network_configuration_can_not_be_adjusted << ".\n";
         if (IS->min_n() < d)
-          out <<T_GaMa_not_enough_constrained_points << ".\n";
+          out <<texts.T_GaMa_not_enough_constrained_points << ".\n";
         out << "\n";
 
-        out << T_GaMa_detected_singular_variables << "\n\n";
-        out << T_GaMa_index_type_point << "\n"
+        out << texts.T_GaMa_detected_singular_variables << "\n\n";
+        out << texts.T_GaMa_index_type_point << "\n"
             << "-----------------------------\n\n";
 
         for (int i=1; i<=IS->sum_unknowns(); i++)
@@ -315,22 +317,22 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
       }
   }
 
-  out << set_width(T_GaMa_gpar1_equations, w1) << ":"
+  out << set_width(texts.T_GaMa_gpar1_equations, w1) << ":"
       << setw(6) << IS->sum_observations()      << tab_sep
-      << set_width(T_GaMa_gpar2_number_of_unknowns, w2) << ":"
+      << set_width(texts.T_GaMa_gpar2_number_of_unknowns, w2) << ":"
       << setw(6) << IS->sum_unknowns()
       << '\n'
-      << set_width(T_GaMa_gpar1_redundancy, w1) << ":"
+      << set_width(texts.T_GaMa_gpar1_redundancy, w1) << ":"
       << setw(6) << IS->degrees_of_freedom() << tab_sep
-      << set_width(T_GaMa_gpar2_network_defect, w2) << ":"
+      << set_width(texts.T_GaMa_gpar2_network_defect, w2) << ":"
       << setw(6) << IS->null_space()
       << '\n';
   out.setf(ios_base::fixed, ios_base::floatfield);
 
   out << "\n"
-      << T_GaMa_m0_apriori << ":"
+      << texts.T_GaMa_m0_apriori << ":"
       << setprecision(2) << setw(9) << IS->apriori_m_0() << '\n';
-  out << T_GaMa_m0_empirical << ":"
+  out << texts.T_GaMa_m0_empirical << ":"
       << setprecision(2) << setw(9)
       << (IS->degrees_of_freedom() > 0 ?
           sqrt(IS->trans_VWV()/IS->degrees_of_freedom()) : 0);
@@ -343,12 +345,12 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
 
   out.setf(ios_base::fixed, ios_base::floatfield);
   out << "\n";
-  out << T_GaMa_During_statistical_analysis_we_work << "\n\n"
+  out << texts.T_GaMa_During_statistical_analysis_we_work << "\n\n"
       << (IS->m_0_aposteriori() ?
-          T_GaMa_statan_with_empirical_standard_deviation :
-          T_GaMa_statan_with_apriori_standard_deviation);
+          texts.T_GaMa_statan_with_empirical_standard_deviation :
+          texts.T_GaMa_statan_with_apriori_standard_deviation);
   out << setprecision(2) << IS->m_0() << "\n"
-      <<  T_GaMa_statan_with_confidence_level
+      <<  texts.T_GaMa_statan_with_confidence_level
       << setprecision(0) << IS->conf_pr()*100 << " %\n\n";
   out.flush();
 
@@ -362,16 +364,16 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
           float dolni = sqrt(GNU_gama::Chi_square(1-alfa_pul,nadb)/nadb);
           float horni = sqrt(GNU_gama::Chi_square(  alfa_pul,nadb)/nadb);
 
-          out << T_GaMa_Ratio_empirical_to_apriori << setprecision(3)
+          out << texts.T_GaMa_Ratio_empirical_to_apriori << setprecision(3)
               << testm0 << '\n'
               << setprecision(0) << IS->conf_pr()*100
-              << " % " << T_GaMa_interval << " ("
+              << " % " << texts.T_GaMa_interval << " ("
               << setprecision(3) << dolni
               << ", " << horni
               << ") "
               << (dolni<testm0 && horni>testm0 ?
-                  T_GaMa_interval_contains :
-                  T_GaMa_interval_doesnt_contain)
+                  texts.T_GaMa_interval_contains :
+                  texts.T_GaMa_interval_doesnt_contain)
               << "\n";
           out.flush();
 
@@ -407,13 +409,13 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
             {
               float ma = IS->apriori_m_0();
               if (itd)
-                out << T_GaMa_m0_distances << m0d/ma << "   ";
+                out << texts.T_GaMa_m0_distances << m0d/ma << "   ";
               if (its+itu)
                 {
                   switch (its+itu) {
-                  case 1: out << T_GaMa_m0_directions; break;
-                  case 2: out << T_GaMa_m0_angles; break;
-                  case 3: out << T_GaMa_m0_dirs_angs; break;
+                  case 1: out << texts.T_GaMa_m0_directions; break;
+                  case 2: out << texts.T_GaMa_m0_angles; break;
+                  case 3: out << texts.T_GaMa_m0_dirs_angs; break;
                   }
                   out << m0s/ma;
                 }
@@ -457,7 +459,7 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
           double v = IS->residuals()(imax);
           double q = IS->wcoef_res(imax);
           double m_0_red = sqrt(fabs(IS->trans_VWV()-v*v/q)/(nadb-1));
-          out << T_GaMa_Maximal_decrease_of_m0
+          out << texts.T_GaMa_Maximal_decrease_of_m0
               << setprecision(3) << m_0_red/IS->apriori_m_0()
               << "\n\n";
         }
@@ -466,20 +468,21 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
         {
           out.setf(ios_base::fixed, ios_base::floatfield);
           if (aprm0)
-            out << T_GaMa_Maximal_normalized_residual;
+            out << texts.T_GaMa_Maximal_normalized_residual;
           else
-            out << T_GaMa_genpar_Maximal_studentized_residual;
+            out << texts.T_GaMa_genpar_Maximal_studentized_residual;
           out << setprecision(2) << max_stud;
           if (max_stud > krit_opr)
-            out << T_GaMa_genpar_exceeds;
+            out << texts.T_GaMa_genpar_exceeds;
           else
-            out << T_GaMa_genpar_doesnt_exceed;
-          out << T_GaMa_genpar_critical_value <<  krit_opr << "\n"
-              << T_GaMa_genpar_on_significance_level
+            out << texts.T_GaMa_genpar_doesnt_exceed;
+          out << texts.T_GaMa_genpar_critical_value <<  krit_opr << "\n"
+              << texts.T_GaMa_genpar_on_significance_level
               << setprecision(0) << (1 - IS->conf_pr())*100
-              << T_GaMa_genpar_for_observation_ind
+              << texts.T_GaMa_genpar_for_observation_ind
               << imax << "\n";
-          WriteVisitor<OutStream> write_visitor(out, true);
+          WriteVisitor<OutStream> write_visitor(out, true,
+                                                IS->gons(), IS->format());
           ptr->accept(&write_visitor);
           out << "\n";
         }
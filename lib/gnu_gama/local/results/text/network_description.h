@@ -29,15 +29,16 @@
 namespace GNU_gama { namespace local {
 
 template <typename OutStream>
-void NetworkDescription(const std::string& description, OutStream& out)
+void NetworkDescription(const std::string& description, OutStream& out,
+                        const Texts& texts = gama_texts(get_gama_language()))
 {
    using namespace std;
    using namespace GNU_gama::local;
 
    if (description.empty()) return;
 
-   out << T_GaMa_network_description << '\n'
-       << underline(T_GaMa_network_description, '*') << '\n'
+   out << texts.T_GaMa_network_description << '\n'
+       << underline(texts.T_GaMa_network_description, '*') << '\n'
        << description << "\n\n";
 
    if ((*description.rbegin()) != '\n')
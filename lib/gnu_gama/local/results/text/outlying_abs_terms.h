@@ -67,7 +67,7 @@ public:
 
     void  visit(Distance* obs)
     {
-        out << T_GaMa_distance;
+        out << IS->texts().T_GaMa_distance;
         out.precision(distPrecision);
         out.width(width);
         double m = obs->value();
@@ -76,7 +76,7 @@ public:
 
     void  visit(Direction* obs)
     {
-        out << T_GaMa_direction;
+        out << IS->texts().T_GaMa_direction;
         out.precision(angularPrecision);
         out.width(width);
         double m = GNU_gama::RAD_TO_GON*(obs->value());
@@ -91,7 +91,7 @@ public:
         out << '\n';
         out.width(IS->maxw_obs() + 2 + 2*(IS->maxw_id()));
         out << Utf8::leftPad(obs->fs().str(), IS->maxw_id());
-        out << T_GaMa_angle;
+        out << IS->texts().T_GaMa_angle;
         out.precision(angularPrecision);
         out.width(width);
         double m = GNU_gama::RAD_TO_GON*(obs->value());
@@ -103,7 +103,7 @@ public:
 
     void  visit(H_Diff* obs)
     {
-        out << T_GaMa_levell;
+        out << IS->texts().T_GaMa_levell;
         out.precision(distPrecision);
         out.width(width);
         double m = obs->value();
@@ -112,7 +112,7 @@ public:
 
     void  visit(S_Distance* obs)
     {
-        out << T_GaMa_s_distance;
+        out << IS->texts().T_GaMa_s_distance;
         out.precision(distPrecision);
         out.width(width);
         double m = obs->value();
@@ -121,7 +121,7 @@ public:
 
     void  visit(Z_Angle* obs)
     {
-        out << T_GaMa_z_angle;
+        out << IS->texts().T_GaMa_z_angle;
         out.precision(angularPrecision);
         out.width(width);
         double m = GNU_gama::RAD_TO_GON*(obs->value());
@@ -133,7 +133,7 @@ public:
 
     void  visit(X* obs)
     {
-        out << T_GaMa_x;
+        out << IS->texts().T_GaMa_x;
         out.precision(coordPrecision);
         out.width(width);
         double m = obs->value();
@@ -142,7 +142,7 @@ public:
 
     void  visit(Y* obs)
     {
-        out << T_GaMa_y;
+        out << IS->texts().T_GaMa_y;
         out.precision(coordPrecision);
         out.width(width);
         double m = obs->value();
@@ -151,7 +151,7 @@ public:
 
     void  visit(Z* obs)
     {
-        out << T_GaMa_z;
+        out << IS->texts().T_GaMa_z;
         out.precision(coordPrecision);
         out.width(width);
         double m = obs->value();
@@ -160,7 +160,7 @@ public:
 
     void  visit(Xdiff* obs)
     {
-        out << T_GaMa_xdiff;
+        out << IS->texts().T_GaMa_xdiff;
         out.precision(coordPrecision);
         out.width(width);
         double m = obs->value();
@@ -169,7 +169,7 @@ public:
 
     void  visit(Ydiff* obs)
     {
-        out << T_GaMa_ydiff;
+        out << IS->texts().T_GaMa_ydiff;
         out.precision(coordPrecision);
         out.width(width);
         double m = obs->value();
@@ -178,7 +178,7 @@ public:
 
     void  visit(Zdiff* obs)
     {
-        out << T_GaMa_zdiff;
+        out << IS->texts().T_GaMa_zdiff;
         out.precision(coordPrecision);
         out.width(width);
         double m = obs->value();
@@ -187,7 +187,7 @@ public:
 
     void  visit(Azimuth* obs)
     {
-        out << T_GaMa_azimuth;
+        out << IS->texts().T_GaMa_azimuth;
         out.precision(angularPrecision);
         out.width(width);
         double m = GNU_gama::RAD_TO_GON*(obs->value());
@@ -207,22 +207,24 @@ void OutlyingAbsoluteTerms(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   using namespace std;
   using namespace GNU_gama::local;
 
+  const Texts& texts = IS->texts();
+
   if (!IS->huge_abs_terms()) return;
 
-  out << T_GaMa_abstrm_Review_of_outlying_abs_terms << "\n"
-      << underline(T_GaMa_abstrm_Review_of_outlying_abs_terms, '*') << "\n\n";
+  out << texts.T_GaMa_abstrm_Review_of_outlying_abs_terms << "\n"
+      << underline(texts.T_GaMa_abstrm_Review_of_outlying_abs_terms, '*') << "\n\n";
 
   out.width(IS->maxw_obs());
   out << "i" << " ";
   out.width(IS->maxw_id());
-  out << T_GaMa_standpoint << " ";
+  out << texts.T_GaMa_standpoint << " ";
   out.width(IS->maxw_id());
-  out << T_GaMa_target << T_GaMa_abstrm_header1;
+  out << texts.T_GaMa_target << texts.T_GaMa_abstrm_header1;
   {  // for ...
     for (int i=0; i < (IS->maxw_obs() + 2*(IS->maxw_id()) + 13); i++)
       out << "=";
   }  // for ...
-  out << T_GaMa_abstrm_header2;
+  out << texts.T_GaMa_abstrm_header2;
   out.flush();
 
   PointID predcs = "";   // previous standpoint ID
@@ -50,11 +50,13 @@ void ReducedObservationsText(GNU_gama::local::LocalNetwork* IS,
    using namespace std;
    using namespace GNU_gama::local;
 
+   const Texts& texts = IS->texts();
+
    if ( !reduced->size() )
        return;
 
-   out << T_GaMa_reduced_Review_of_reduced_observations << "\n"
-       << underline(T_GaMa_reduced_Review_of_reduced_observations, '*')
+   out << texts.T_GaMa_reduced_Review_of_reduced_observations << "\n"
+       << underline(texts.T_GaMa_reduced_Review_of_reduced_observations, '*')
        << "\n\n";
 
    /* [-Wempty-body]
@@ -116,22 +118,22 @@ void ReducedObservationsText(GNU_gama::local::LocalNetwork* IS,
    //   out << "i" << " ";
 
    out.width(IS->maxw_id());
-   out << T_GaMa_standpoint << " ";
+   out << texts.T_GaMa_standpoint << " ";
    out.width(IS->maxw_id());
-   out << T_GaMa_target << "       ";
+   out << texts.T_GaMa_target << "       ";
    out.width(maxval_obs);
-   out << T_GaMa_reduced_observed << " ";
+   out << texts.T_GaMa_reduced_observed << " ";
    out.width(maxval_obs);
-   out << T_GaMa_reduced_reduced << " ";
+   out << texts.T_GaMa_reduced_reduced << " ";
    out.width(maxval_dh);
-   out << T_GaMa_reduced_header1;
+   out << texts.T_GaMa_reduced_header1;
 
    {
      int kk = 12 + 2*IS->maxw_id() + maxval_obs - minval_obs;
      for (int i=0; i < kk; i++) out << "=";
    }
 
-   out << T_GaMa_reduced_value;
+   out << texts.T_GaMa_reduced_value;
 
    {
      int kk = maxval_obs - minval_obs + 1;
@@ -177,7 +179,7 @@ void ReducedObservationsText(GNU_gama::local::LocalNetwork* IS,
       {   // ***************************************************
         if (/* S_Distance* sd = */ dynamic_cast<S_Distance*>(pm))
           {
-            out << T_GaMa_s_distance;
+            out << texts.T_GaMa_s_distance;
             out.precision(5);
             out.width(maxval_obs);
 	    out << it->orig_value() << " ";
@@ -191,7 +193,7 @@ void ReducedObservationsText(GNU_gama::local::LocalNetwork* IS,
 
         else if (/* Z_Angle* za = */ dynamic_cast<Z_Angle*>(pm))
           {
-	    out << T_GaMa_z_angle;
+	    out << texts.T_GaMa_z_angle;
             out.precision(6);
             out.width(maxval_obs);
 	    if (IS->gons())
@@ -212,7 +214,7 @@ void ReducedObservationsText(GNU_gama::local::LocalNetwork* IS,
           }
         else if (/* H_Diff* h = */ dynamic_cast<H_Diff*>(pm))
           {
-            out << T_GaMa_levell;
+            out << texts.T_GaMa_levell;
             out.precision(5);
             out.width(maxval_obs);
             out << it->orig_value() << " ";
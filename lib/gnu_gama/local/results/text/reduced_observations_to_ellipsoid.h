@@ -48,11 +48,13 @@ void ReducedObservationsToEllipsoidText(GNU_gama::local::LocalNetwork* IS,
    using namespace std;
    using namespace GNU_gama::local;
 
+   const Texts& texts = IS->texts();
+
    if ( !reduced.size() )
        return;
 
-   out << T_GaMa_reduced_Review_of_reduced_observations_to_ellipsoid << "\n"
-       << underline(T_GaMa_reduced_Review_of_reduced_observations_to_ellipsoid, '*')
+   out << texts.T_GaMa_reduced_Review_of_reduced_observations_to_ellipsoid << "\n"
+       << underline(texts.T_GaMa_reduced_Review_of_reduced_observations_to_ellipsoid, '*')
        << "\n\n";
 
    int minval_obs = 12;
@@ -116,22 +118,22 @@ void ReducedObservationsToEllipsoidText(GNU_gama::local::LocalNetwork* IS,
    //   out << "i" << " ";
 
    out.width(IS->maxw_id());
-   out << T_GaMa_standpoint << " ";
+   out << texts.T_GaMa_standpoint << " ";
    out.width(IS->maxw_id());
-   out << T_GaMa_target << "       ";
+   out << texts.T_GaMa_target << "       ";
    out.width(maxval_obs);
-   out << T_GaMa_reduced_observed << " ";
+   out << texts.T_GaMa_reduced_observed << " ";
    out.width(maxval_obs);
-   out << T_GaMa_reduced_reduced << " ";
+   out << texts.T_GaMa_reduced_reduced << " ";
    out.width(maxval_dh);
-   out << T_GaMa_reduced_to_ellipsoid_header1;
+   out << texts.T_GaMa_reduced_to_ellipsoid_header1;
 
    {
      int kk = 12 + 2*IS->maxw_id() + maxval_obs - minval_obs;
      for (int i=0; i < kk; i++) out << "=";
    }
 
-   out << T_GaMa_reduced_value;
+   out << texts.T_GaMa_reduced_value;
 
    {
      int kk = maxval_obs - minval_obs + 1;
@@ -189,7 +191,7 @@ void ReducedObservationsToEllipsoidText(GNU_gama::local::LocalNetwork* IS,
           if (// Z_Angle* za =
               dynamic_cast<Z_Angle*>(pm))
           {
-              out << T_GaMa_z_angle;
+              out << texts.T_GaMa_z_angle;
               out.precision(6);
               out.width(maxval_obs);
               if (IS->gons())
@@ -206,7 +208,7 @@ void ReducedObservationsToEllipsoidText(GNU_gama::local::LocalNetwork* IS,
           else if (// Direction* d =
                    dynamic_cast<Direction*>(pm))
           {
-              out << T_GaMa_direction;
+              out << texts.T_GaMa_direction;
               out.precision(6);
               out.width(maxval_obs);
               if (IS->gons())
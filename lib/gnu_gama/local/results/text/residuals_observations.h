@@ -74,23 +74,25 @@ class WriteShortObservationName : public GNU_gama::local::AllObservationsVisitor
 {
 private:
     OutStream& out;
+    const Texts& texts;
 public:
-    WriteShortObservationName(OutStream& outStream) : out(outStream)
+    WriteShortObservationName(OutStream& outStream, const Texts& t)
+      : out(outStream), texts(t)
     {}
 
-    void visit(Distance* /*obs*/) { out << T_GaMa_distance; }
-    void visit(Direction* /*obs*/) { out << T_GaMa_direction; }
-    void visit(Angle* /*obs*/) { out << T_GaMa_angle; }
-    void visit(H_Diff* /*obs*/) { out << T_GaMa_levell; }
-    void visit(S_Distance* /*obs*/) { out << T_GaMa_s_distance; }
-    void visit(Z_Angle* /*obs*/) { out << T_GaMa_z_angle; }
-    void visit(X* /*obs*/) { out << T_GaMa_x; }
-    void visit(Y* /*obs*/) { out << T_GaMa_y; }
-    void visit(Z* /*obs*/) { out << T_GaMa_z; }
-    void visit(Xdiff* /*obs*/) { out << T_GaMa_xdiff; }
-    void visit(Ydiff* /*obs*/) { out << T_GaMa_ydiff; }
-    void visit(Zdiff* /*obs*/) { out << T_GaMa_zdiff; }
-    void visit(Azimuth* /*obs*/) { out << T_GaMa_azimuth; }
+    void visit(Distance* /*obs*/) { out << texts.T_GaMa_distance; }
+    void visit(Direction* /*obs*/) { out << texts.T_GaMa_direction; }
+    void visit(Angle* /*obs*/) { out << texts.T_GaMa_angle; }
+    void visit(H_Diff* /*obs*/) { out << texts.T_GaMa_levell; }
+    void visit(S_Distance* /*obs*/) { out << texts.T_GaMa_s_distance; }
+    void visit(Z_Angle* /*obs*/) { out << texts.T_GaMa_z_angle; }
+    void visit(X* /*obs*/) { out << texts.T_GaMa_x; }
+    void visit(Y* /*obs*/) { out << texts.T_GaMa_y; }
+    void visit(Z* /*obs*/) { out << texts.T_GaMa_z; }
+    void visit(Xdiff* /*obs*/) { out << texts.T_GaMa_xdiff; }
+    void visit(Ydiff* /*obs*/) { out << texts.T_GaMa_ydiff; }
+    void visit(Zdiff* /*obs*/) { out << texts.T_GaMa_zdiff; }
+    void visit(Azimuth* /*obs*/) { out << texts.T_GaMa_azimuth; }
 
 };
 
@@ -102,6 +104,8 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
   using namespace std;
   using namespace GNU_gama::local;
 
+  const Texts& texts = IS->texts();
+
   const Vec&    v      = IS->residuals();
   const int     pocmer = IS->sum_observations();
   const double  scale  = IS->gons() ? 1.0 : 0.324;
@@ -137,21 +141,21 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
     {
 
       if (pruchod == 1)
-        out << T_GaMa_resobs_Review_of_residuals_analysis_obs << "\n"
-            << underline(T_GaMa_resobs_Review_of_residuals_analysis_obs, '*')
+        out << texts.T_GaMa_resobs_Review_of_residuals_analysis_obs << "\n"
+            << underline(texts.T_GaMa_resobs_Review_of_residuals_analysis_obs, '*')
             << "\n\n";
       else
         out << "\n\n"
-            << T_GaMa_resobs_Outlying_observations << "\n"
-            << underline(T_GaMa_resobs_Outlying_observations, '*') << "\n\n";
+            << texts.T_GaMa_resobs_Outlying_observations << "\n"
+            << underline(texts.T_GaMa_resobs_Outlying_observations, '*') << "\n\n";
 
       out.width(IS->maxw_obs());
       out << "i" << " ";
       out.width(IS->maxw_id());
-      out << T_GaMa_standpoint << " ";
+      out << texts.T_GaMa_standpoint << " ";
       out.width(IS->maxw_id());
-      out << T_GaMa_target
-          << T_GaMa_resobs_header1;
+      out << texts.T_GaMa_target
+          << texts.T_GaMa_resobs_header1;
       {   // for ...
         for (int i=0; i < (IS->maxw_obs() + 2*(IS->maxw_id()) + 10); i++)
           out << "=";
@@ -163,7 +167,7 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
         out << "======== [mm|ss] =========== [mm|ss] ===\n\n";
       out.flush();
 
-      WriteShortObservationName<OutStream> nameVisitor(out);
+      WriteShortObservationName<OutStream> nameVisitor(out, texts);
 
       PointID predcs = "";   // previous standpoint ID
       int max_ii = pruchod==1 ? pocmer : odlehla.size();
@@ -198,8 +202,8 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
           out.precision(1);
           out.width(5);
           out << f;
-          if (f < 0.1)    out << T_GaMa_resobs_no_control;   // uncontrolled
-          else if (f < 5) out << T_GaMa_resobs_weak_control; // weak control
+          if (f < 0.1)    out << texts.T_GaMa_resobs_no_control;   // uncontrolled
+          else if (f < 5) out << texts.T_GaMa_resobs_weak_control; // weak control
           else            out << "  ";
           out << ' ';
 
@@ -225,10 +229,10 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
 
               if (i == imax)
                 {
-                  if (no > kki)  out << T_GaMa_resobs_mc_max_critical;
-                  else           out << T_GaMa_resobs_mc_max;
+                  if (no > kki)  out << texts.T_GaMa_resobs_mc_max_critical;
+                  else           out << texts.T_GaMa_resobs_mc_max;
                 }
-              else if (no > kki) out << T_GaMa_resobs_mc_critical;
+              else if (no > kki) out << texts.T_GaMa_resobs_mc_critical;
               else               out << "   ";
 
 
@@ -258,8 +262,8 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
       using namespace GNU_gama::local;
 
       out << "\n\n"
-          << T_GaMa_resobs_normality_test << "\n"
-          << underline(T_GaMa_resobs_normality_test, '=') << "\n\n";
+          << texts.T_GaMa_resobs_normality_test << "\n"
+          << underline(texts.T_GaMa_resobs_normality_test, '=') << "\n\n";
 
       { // ****** Kolmogorov-Smirnov
 
@@ -309,7 +313,7 @@ void ResidualsObservations(GNU_gama::local::LocalNetwork* IS, OutStream& out)
       out.setf(ios_base::scientific, ios_base::floatfield);
       out.precision(1);
       out << "\n"
-          << T_GaMa_resobs_condition_number << cond << "\n";
+          << texts.T_GaMa_resobs_condition_number << cond << "\n";
     }
 
   out << "\n\n";
@@ -24,187 +24,31 @@
 #include <Math/Business/Core/radian.h>
 
 #include <gnu_gama/local/sqlitereader.h>
+#include <gnu_gama/local/sqlitestatement.h>
 #include <gnu_gama/local/network.h>
 #include <gnu_gama/xml/dataobject.h>
-#include <Math/Business/Core/intfloat.h>
 
+#include <chrono>
 #include <string>
-#include <sstream>
-
-#include <sqlite3.h>
+#include <unordered_map>
+#include <vector>
 
 /**
   \internal
   \file sqlitereader.cpp
   \brief Implementation of #GNU_gama::local::sqlite_db::SqliteReader.
+
+  All tables are read by prepared statements inside a single (read)
+  transaction (see sqlitestatement.h). Numeric columns are fetched with
+  \c sqlite3_column_double and \c sqlite3_column_int64, text conversion
+  is used only for values which were stored as text. Observations, vectors, coordinates and
+  covariance matrices are read by one query per table for the whole
+  configuration and distributed to clusters by their \c ccluster id.
   */
 
 namespace {
-  const char* T_gamalite_database_not_open =
-    "database not open"; ///< error message, used in #GNU_gama::local::sqlite_db::SqliteReader::SqliteReader
-  const char* T_gamalite_invalid_column_value =
-    "invalid column value"; ///< error message, used in callbacks' to indicate bad value of database field
-  const char* T_gamalite_conversion_to_double_failed =
-    "conversion to double failed"; ///< error message, used in conversion function when no better message can be used
-  const char* T_gamalite_conversion_to_integer_failed =
-    "conversion to integer failed"; ///< \copydoc T_gamalite_conversion_to_double_failed()
-  const char* T_gamalite_unknown_exception_in_callback =
-    "unknown exception in SqliteReader's callback"; ///< error message, used in callbacks' catch(...)
   const char* T_gamalite_stand_point_cluster_with_multi_dir_sets =
-    "StandPoint cluster with multiple directions sets"; ///< error message, used in #sqlite_db_readObservations
-  const char* T_gamalite_configuration_not_found =
-    "configuration not found"; ///< error message, used in #GNU_gama::local::sqlite_db::SqliteReader::retrieve
-}
-
-extern "C" {
-    /**
-      \brief Reads configuration information from table \c gnu_gama_local_configurations.
-
-      Reads from table means: parameter \a argv points to values selected from that table.
-
-      \param data pointer to \c struct #GNU_gama::local::sqlite_db::ReaderData
-      \param argc number of strings in \a argv
-      \param argv strings with column values (\c NULL pointer means \c NULL value)
-
-      Last parameter is unused.
-
-      Callback can not throw any exception because it interfaces with C library.
-      If callback threw an exception, program would crash.
-      Program compiled by GCC writes this message:
-      \verbatim
-      terminate called after throwing an instance of 'GNU_gama::Exception::string'
-        what():  from callback
-      \endverbatim
-      Note that \c what() message is available only if exception is derived from \c std::exception.
-      Callbacks should have it's body enclosed by try-catch block.
-      \code
-    int readSomething(void* data, int argc, char** argv, char**) {
-            ReaderData* d = static_cast<ReaderData*>(data);
-            try {
-                    // ... callback's code
-                    return 0;
-                }
-            catch (GNU_gama::Exception::base& e) { d->exception = e.clone(); }
-            catch (std::exception& e) { d->exception = new GNU_gama::Exception::string(e.what()); }
-            catch (...) { d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback); }
-            return 1;
-        }
-      \endcode
-
-      We can be quite sure that callback's corresponding statement is ok. But we can not control the field values.
-      SQLite database doesn't enforce the field type declared in CREATE statement.
-      And there is no guarantee that database we are reading from is created with the GNU Gama official database schema.
-      The conclusion is the fields have to checked in callback.
-      The critical test of \c NULL values is done in the beginning (we can also check the expected number of fields).
-      Note that only some fields could be supposed to have non-\c NULL values.
-      \code
-      try {
-             if (argc == 7 && argv[0] && argv[1]) {
-                   // it is sure that argv[0-6] is ok
-                   // and std::string s(argv[0-1]) doesn't throw exception
-                   // ... callback's code
-                   return 0;
-                } else {
-                   throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
-                }
-          }
-      \endcode
-
-      \note If \c std::string \c const \c char \c * ctor parameter is \c NULL pointer,
-      std::logic_error is thrown.
-      With GCC the \c what() message is <tt>"basic_string::_S_construct NULL not valid"</tt>.
-
-      \sa #SqliteReaderCallbackType
-      */
-    int sqlite_db_readConfigurationInfo(void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads configuration description from table \c gnu_gama_local_descriptions.
-      #GNU_gama::local::sqlite_db::ReaderData::configurationId has to be set before calling this function.
-
-     \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readConfigurationText(void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads points from table \c gnu_gama_local_points.
-
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readPoints           (void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads clusters from table \c gnu_gama_local_clusters.
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readClusters         (void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads observations from table \c gnu_gama_local_obs.
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readObservations     (void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads vectors from table \c gnu_gama_local_vectors.
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readVectors          (void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads HeightDifferences from table \c gnu_gama_local_vectors.
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readCoordinates      (void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads vectors from table \c gnu_gama_local_vectors.
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readHeightDifferences(void* data, int argc, char** argv, char**);
-
-    /**
-      \brief Reads covariance matrix from table \c gnu_gama_local_covmat.
-
-      \sa sqlite_db_readConfigurationInfo()
-      */
-    int sqlite_db_readCovarianceMatrix (void* data, int argc, char** argv, char**);
-
-    /**
-        \brief The type for a callback function of function \c sqlite3_exec.
-
-        Header file \c <sqlite3.h> contains similar typedef but it is deprecated.
-        It has to by declared in <tt>extern "C"</tt> block because it is pointer to function with C linkage.
-        Unfortunately if functions is declared in <tt>extern "C"</tt> block,
-        unnamed namespace can't be used because it is ignored. Function is global.
-        Keyword \c static can be used to declare function visible only in one file (translation unit) in C.
-        This works also with <tt>extern "C"</tt> functions with GCC, but it is not sure that this works with other compilers.
-
-        \warning GCC does't warn if you use pointer to C function when pointer to C++ is expected and vice versa.
-
-       Next rows cite SQLite C API documentation <http://www.sqlite.org/capi3ref.html#sqlite3_exec>.
-
-       The 4th argument to \c sqlite3_exec() is relayed through to the 1st argument of each callback invocation.
-
-       The 2nd argument to the \c sqlite3_exec() callback function is the number of columns in the result.
-       The 3rd argument to the \c sqlite3_exec() callback is an array of pointers to strings obtained as if from \c sqlite3_column_text(),
-       one for each column.
-       If an element of a result row is \c NULL then the corresponding string pointer for the \c sqlite3_exec() callback is a \c NULL pointer.
-       The 4th argument to the \c sqlite3_exec() callback is an array of pointers to strings
-       where each entry represents the name of corresponding result column as obtained from \c sqlite3_column_name().
-
-       If an \c sqlite3_exec() callback returns non-zero,
-       the \c sqlite3_exec() routine returns SQLITE_ABORT without invoking
-       the callback again and without running any subsequent SQL statements.
-      */
-
-  typedef int (*SqliteReaderCallbackType)(void*, int, char**, char**);
+    "StandPoint cluster with multiple directions sets"; ///< error message, used in #readObservations
 }
 
 namespace GNU_gama { namespace local { namespace sqlite_db {
@@ -215,50 +59,19 @@ namespace GNU_gama { namespace local { namespace sqlite_db {
 
    Contains all private data. In file sqlitereader.h is forward declaration of this struct.
    But declaration is only available in this file (translation unit).
-   All members are public. Functions especially (<tt>extern "C"</tt>) callbacks can easy manipulate with this members.
-   This is no OOP violation because we can think about functions in this file as ReaderData member functions.
-   Functions outside this file can't access this structure because they know only forward declaration
-   and #GNU_gama::local::sqlite_db::SqliteReader has declared pointer to this struct private of course.
-   However, there are some problems with callbacks visibility
-   (see #SqliteReaderCallbackType or #sqlite_db_readConfigurationInfo for details).
-
-   Callbacks #sqlite_db_readObservations, ... and #sqlite_db_readCovarianceMatrix have to share data between it's invocations.
-   So they needs access to the same \c StandPoint, \c Vectors, etc.
-   They also needs access to #exception.
-   This is the reason why ReaderData contains pointer to \c StandPoint etc.
-   Pointers #currentStandPoint, #currentVectors, #currentCoordinates, #currentHeightDifferences
-   and #currentCovarianceMatrix temporary points to objects which are in use at the moment
-   by the #exec() caller and corresponding callback invocations.
-   When processing of one object is finished, this pointer should by set to \c NULL pointer.
   */
 struct ReaderData
 {
-    /**
-       It sets all member variables. Pointers are set to \c NULL pointers.
-       Strings are initialised by \c "" to satisfied GCC \c -Weffc++ warning options.
-      */
-
-  ReaderData() : lnet(0),
-                 exception(0), sqlite3Handle(0), configurationId(""),
-                 currentStandPoint(0), currentVectors(0),
-                 currentCoordinates(0), currentHeightDifferences(0),
-                 currentCovarianceMatrix(0)
+  ReaderData() : lnet(0), sqlite3Handle(0), configurationId(0)
   {
   }
 
   GNU_gama::local::LocalNetwork* lnet; ///< pointer to network object
 
-  GNU_gama::Exception::base* exception; ///< an exception which was caught in callback or \c NULL if no exception was thrown
-  sqlite3*  sqlite3Handle; ///< pointer to \c struct \c sqlite3
-  std::string configurationId; ///< configuration id in database
+  sqlite3*      sqlite3Handle;   ///< pointer to \c struct \c sqlite3
+  sqlite3_int64 configurationId; ///< configuration id in database
 
-  /** provides access to same stand point for callback ::readObservations and caller of #exec() function */
-  GNU_gama::local::StandPoint*        currentStandPoint;
-  GNU_gama::local::Vectors*           currentVectors;
-  GNU_gama::local::Coordinates*       currentCoordinates;
-  GNU_gama::local::HeightDifferences* currentHeightDifferences;
-  /** provides access to same covariance matrix for callback ::readCovarianceMatrix and caller of #exec() function */
-  GNU_gama::local::CovMat*            currentCovarianceMatrix;
+  std::vector<SqliteTableLoad> load; ///< statistics of the last retrieve
 
 private:
   /** disabled copy constructor */
@@ -279,9 +92,11 @@ SqliteReader::SqliteReader(const std::string& fileName)
   int resCode = sqlite3_open(fileName.c_str(), &readerData->sqlite3Handle);
 
   if (resCode) {
+    sqlite3_close(readerData->sqlite3Handle);
     delete readerData;
     throw GNU_gama::Exception::sqlitexc(T_gamalite_database_not_open);
   }
+  sqlite3_busy_timeout(readerData->sqlite3Handle, busy_timeout);
 }
 
 /**
@@ -296,193 +111,77 @@ SqliteReader::~SqliteReader()
       readerData->sqlite3Handle = 0;
     }
 
-  if (readerData->exception) {
-    delete readerData->exception;
-    readerData->exception = 0;
-  }
   delete readerData;
 }
 
-namespace {
-
-  /**
-     \internal
-     \brief A C++ wrapper around \c sqlite3_exec function.
-
-     Connection to database has to be open. If the \a callback is \c NULL pointer,
-     then no callback function is called (result rows are ignored).
-     If callback requests query execution abort (by returning non-zero value),
-     no other callbacks is called and exception is thrown
-     (\c sqlite3_exec returns a value which differs from \c SQLITE_OK, see also <http://www.sqlite.org/capi3ref.html#SQLITE_ABORT>).
-
-     If callback stores pointer to an exception to #GNU_gama::local::sqlite_db::ReaderData::exception
-     and callback requests query execution abort, exception will be rethrown.
-     If #GNU_gama::local::sqlite_db::ReaderData::exception is \c NULL pointer,
-     #GNU_gama::Exception::sqlitexc will be thrown with SQLite error message.
-
-     \param sqlite3Handle pointer to \c struct \c sqlite3
-     \param query query string
-     \param callback pointer to callback function
-     \param readerData pointer to \c struct ReaderData
-
-     \throws #GNU_gama::Exception::sqlitexc if error occurs when reading from database
-     \throws GNU_gama::Exception::base if is error occurred by something another -- it depends on callback
-     It can also throw any other exception derived from this class.
-
-     Callback functions are expected to handle exceptions like this:
-     \code
-            \\ ... try block
-            catch (GNU_gama::Exception::base& e)
-                {
-                    d->exception = e.clone();
-                }
-            catch (std::exception& e)
-                {
-                    d->exception = new GNU_gama::Exception::string(e.what());
-                }
-            catch (...)
-                {
-                    d->exception = new GNU_gama::Exception::string("unknown");
-                }
-            return 1;
-      \endcode
-
-      \sa #GNU_gama::local::sqlite_db::ReaderData, #SqliteReaderCallbackType, #GNU_gama::Exception::sqlitexc
-      */
-  void exec(sqlite3 *sqlite3Handle, const std::string& query, SqliteReaderCallbackType callback, ReaderData* readerData)
-  {
-    char * errorMsg = 0;
-    int rc = 0;
-    rc = sqlite3_exec(sqlite3Handle, query.c_str(), callback, readerData, &errorMsg);
-    if (rc != SQLITE_OK)
-      {
-        if (readerData->exception != 0)
-          {
-            readerData->exception->raise();
-          }
-        else if (errorMsg)
-          {
-            std::string s = errorMsg;
-            sqlite3_free(errorMsg);
-            throw GNU_gama::Exception::sqlitexc(s);
-          }
-      }
-  }
-} // unnamed namespace
-
-
-void SqliteReader::retrieve(LocalNetwork*& locnet, const std::string& configuration)
+const std::vector<SqliteTableLoad>& SqliteReader::load_statistics() const
 {
-  // at this point we do not know if locnet is defined yet
-  readerData->lnet = locnet;
-
-  // configuration info
-  std::string query("select conf_id, "
-                    "       algorithm, sigma_apr, conf_pr, tol_abs, sigma_act, "
-                    "       axes_xy, angles, epoch, ang_units, "
-                    "       latitude, ellipsoid, cov_band "
-                    "  from gnu_gama_local_configurations "
-                    " where conf_name = '" + configuration + "'");
-  exec(readerData->sqlite3Handle, query, sqlite_db_readConfigurationInfo, readerData);
-
-  if (readerData->configurationId.empty())
-    throw GNU_gama::Exception::sqlitexc(T_gamalite_configuration_not_found);
-
-  locnet = readerData->lnet; // now the pointer must be defined externally or in the callback
-
-  // configuration description
-  query = "select text from gnu_gama_local_descriptions "
-    " where conf_id = " + readerData->configurationId +
-    " order by indx asc";
-  exec(readerData->sqlite3Handle, query, sqlite_db_readConfigurationText, readerData);
-
-  // points
-  query = "select id, x, y, z, txy, tz "
-          "  from gnu_gama_local_points where conf_id = " + readerData->configurationId;
-  exec(readerData->sqlite3Handle, query, sqlite_db_readPoints, readerData);
-
-  // changed cluster to ccluster
-  query = "select ccluster, dim, band, tag "
-         "  from gnu_gama_local_clusters where conf_id = " + readerData->configurationId;
-  exec(readerData->sqlite3Handle, query, sqlite_db_readClusters, readerData);
+  return readerData->load;
 }
 
 
 namespace {
-  /**
-     \brief Converts string to double.
 
-     Parameter \a s can not be \c NULL pointer.
-     If conversion fails, exception is thrown.
+  using GNU_gama::Exception::sqlitexc;
 
-     \param s string to convert
-     \param m error message if conversion fails
+  /**
+     \internal
+     \brief Cluster read from table \c gnu_gama_local_clusters.
 
-     \throws #GNU_gama::Exception::sqlitexc
+     Exactly one of the typed pointers is set according to the cluster tag.
   */
-  double ToDouble(const char* s, const std::string& m = T_gamalite_conversion_to_double_failed)
+  struct ClusterEntry
   {
-    std::string ss = s;
-    if (!GNU_gama::IsFloat(ss))
-      throw GNU_gama::Exception::sqlitexc(m);
-    std::istringstream istr(ss);
-    double d;
-    istr >> d;
-    return  d;
-  }
+    GNU_gama::Cluster<GNU_gama::local::Observation>* cluster = nullptr;
+    GNU_gama::local::StandPoint*        standPoint        = nullptr;
+    GNU_gama::local::Vectors*           vectors           = nullptr;
+    GNU_gama::local::Coordinates*       coordinates       = nullptr;
+    GNU_gama::local::HeightDifferences* heightDifferences = nullptr;
 
-  /**
-     \brief Converts string to integer
+    std::string directions;  ///< station of the directions set in StandPoint
+  };
 
-     \copydetails ToDouble()
-  */
-  int ToInteger(const char* s, const std::string& m = T_gamalite_conversion_to_integer_failed)
-  {
-    std::string ss = s;
-    if (!GNU_gama::IsInteger(ss)) throw GNU_gama::Exception::sqlitexc(m);
-    std::istringstream istr(ss);
-    int n;
-    istr >> n;
-    return  n;
-  }
-} // unnamed namespace
+  typedef std::unordered_map<sqlite3_int64, ClusterEntry> ClusterMap;
 
 
-/////////////// callbacks - extern "C" ///////////////////
-int sqlite_db_readConfigurationInfo(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-
-  /* Changes in gama-2.10  Aleš Čepek 2020
-   * --------------------
-   *
-   * Input XML parameter update_constrainded coordinates was removed,
-   * it is now considered always true/'yes'. The corresponding column
-   * was also removed from sql table 'gnu_gama_local_configurations',
-   * column name 'update_cc' defined in 'gama-local-schema.sql'.
-   *
-   * In SqliteReader::retrieve 'update_cc' column name was removed in
-   * the query (configuration info) and SqlReader now should read both
-   * previous and current sql schema.
-   *
-   * In this function we must change number of arguments from 14 to
-   * 13, and decrease index values from 'axes_xy' to 'cov_band'
-   */
-
-  try {
-    if (argc == 13 /* was 14, see the comment above */ && argv[0])
-      {
-        d->configurationId = argv[0];
+  /**
+     \brief Reads configuration information from table \c gnu_gama_local_configurations.
 
-        if (argv[1])
-        {
-            if(argv[1] == "gso") d->lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::gso);
-            else if (argv[1] == "svd") d->lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::svd);
-            else if (argv[1] == "cholesky") d->lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::cholesky);
-            else if (argv[1] == "envelope") d->lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::envelope);
-        }
+     If \c ReaderData::lnet is a \c NULL pointer new \c LocalNetwork is created.
 
-        using namespace GNU_gama::local;
+     \return number of rows read (0 if configuration was not found)
+  */
+  std::size_t readConfigurationInfo(ReaderData* d, const std::string& configuration)
+  {
+    using namespace GNU_gama::local;
+
+    /* Changes in gama-2.10  Aleš Čepek 2020
+     * --------------------
+     *
+     * Input XML parameter update_constrainded coordinates was removed,
+     * it is now considered always true/'yes'. The corresponding column
+     * was also removed from sql table 'gnu_gama_local_configurations',
+     * column name 'update_cc' defined in 'gama-local-schema.sql'.
+     *
+     * In SqliteReader::retrieve 'update_cc' column name was removed in
+     * the query (configuration info) and SqlReader now should read both
+     * previous and current sql schema.
+     */
+
+    Statement stmt(d->sqlite3Handle,
+                   "select conf_id, "
+                   "       algorithm, sigma_apr, conf_pr, tol_abs, sigma_act, "
+                   "       axes_xy, angles, epoch, ang_units, "
+                   "       latitude, ellipsoid, cov_band "
+                   "  from gnu_gama_local_configurations "
+                   " where conf_name = ?1");
+    stmt.bind(1, configuration);
+
+    std::size_t rows = 0;
+    while (stmt.next())
+      {
+        rows++;
+        d->configurationId = stmt.integer(0);
 
         // create a new local newtwork if not defined
         if (d->lnet == 0)
@@ -490,19 +189,26 @@ int sqlite_db_readConfigurationInfo(void* data, int argc, char** argv, char**)
             d->lnet = new LocalNetwork;
           }
 
-        d->lnet->apriori_m_0(ToDouble(argv[2]));
-        d->lnet->conf_pr(ToDouble(argv[3]));
-        d->lnet->tol_abs(ToDouble(argv[4]));
+        if (!stmt.null(1))
+          {
+            std::string alg = stmt.text(1);
+            if      (alg == "gso")        d->lnet->set_algorithm(LocalNetwork::Algorithm::gso);
+            else if (alg == "svd")        d->lnet->set_algorithm(LocalNetwork::Algorithm::svd);
+            else if (alg == "cholesky")   d->lnet->set_algorithm(LocalNetwork::Algorithm::cholesky);
+            else if (alg == "envelope")   d->lnet->set_algorithm(LocalNetwork::Algorithm::envelope);
+            else if (alg == "supernodal") d->lnet->set_algorithm(LocalNetwork::Algorithm::supernodal);
+          }
+
+        d->lnet->apriori_m_0(stmt.real(2));
+        d->lnet->conf_pr(stmt.real(3));
+        d->lnet->tol_abs(stmt.real(4));
 
-        if (std::string(argv[5]) == "apriori")
+        if (stmt.text(5) == "apriori")
           d->lnet->set_m_0_apriori();
         else
           d->lnet->set_m_0_aposteriori();
 
-        // !!! UNUSED from gama-2.10 !!!
-        // d->lnet->update_constrained_coordinates((std::string(argv[6]) == "yes"));
-
-        std::string val = argv[6]/* was 7 */;
+        std::string val = stmt.text(6);
         LocalCoordinateSystem::CS& lcs = d->lnet->PD.local_coordinate_system;
         if      (val == "ne") lcs = LocalCoordinateSystem::CS::NE;
         else if (val == "sw") lcs = LocalCoordinateSystem::CS::SW;
@@ -514,536 +220,436 @@ int sqlite_db_readConfigurationInfo(void* data, int argc, char** argv, char**)
         else if (val == "ws") lcs = LocalCoordinateSystem::CS::WS;
         else lcs = LocalCoordinateSystem::CS::NE;
 
-        // d->lnet->PD.right_handed_angles = (std::string(argv[8]) == "right-handed");
-	if (std::string(argv[7]/* was 8 */) == "right-handed")
-	  d->lnet->PD.setAngularObservations_Righthanded();
-	else
-	  d->lnet->PD.setAngularObservations_Lefthanded();
+        if (stmt.text(7) == "right-handed")
+          d->lnet->PD.setAngularObservations_Righthanded();
+        else
+          d->lnet->PD.setAngularObservations_Lefthanded();
 
-        if (argv[8]/* was 9 */)
-          d->lnet->set_epoch(ToDouble(argv[8]/* was 9 */));
+        if (!stmt.null(8))
+          d->lnet->set_epoch(stmt.real(8));
 
-        if (std::string(argv[9]/* was 10 */) == "400")
+        if (stmt.integer(9) == 400)
           d->lnet->set_gons();
         else
-          d->lnet->degrees();
-
-        using namespace std;
+          d->lnet->set_degrees();
 
-        if (argv[10]/* was 11 */)
-          d->lnet->set_latitude(atoi(argv[10]/* was 11 */) * GNU_gama::PI / 200);
+        if (!stmt.null(10))
+          d->lnet->set_latitude(stmt.real(10) * GNU_gama::PI / 200);
 
-        if (argv[11]/* was 12 */)
-          d->lnet->set_ellipsoid(argv[11]/* was 12 */);
+        if (!stmt.null(11))
+          d->lnet->set_ellipsoid(stmt.text(11));
 
-        d->lnet->set_adj_covband(atoi(argv[12]/* was 13 */));
-
-        return 0;
-      }
-    else
-      {
-        throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
+        d->lnet->set_adj_covband(int(stmt.integer(12)));
       }
+
+    return rows;
   }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
 
-int sqlite_db_readConfigurationText(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc == 1 && argv[0])
+  /**
+     \brief Reads configuration description from table \c gnu_gama_local_descriptions.
+  */
+  std::size_t readConfigurationText(ReaderData* d)
+  {
+    Statement stmt(d->sqlite3Handle,
+                   "select text from gnu_gama_local_descriptions "
+                   " where conf_id = ?1 order by indx asc");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    while (stmt.next())
       {
-        d->lnet->description += argv[0];
-        return 0;
+        rows++;
+        d->lnet->description += stmt.text(0);
       }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
+    return rows;
   }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
 
-int sqlite_db_readPoints(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc == 6 && argv[0])
+  /**
+     \brief Reads points from table \c gnu_gama_local_points.
+  */
+  std::size_t readPoints(ReaderData* d)
+  {
+    Statement stmt(d->sqlite3Handle,
+                   "select id, x, y, z, txy, tz "
+                   "  from gnu_gama_local_points where conf_id = ?1");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    while (stmt.next())
       {
+        rows++;
+
         GNU_gama::local::LocalPoint p;
-        if (argv[1] && argv[2])
-          p.set_xy(ToDouble(argv[1]), ToDouble(argv[2]));
-        if (argv[3])
-          p.set_z(ToDouble(argv[3]));
-        if (argv[4])
+        if (!stmt.null(1) && !stmt.null(2))
+          p.set_xy(stmt.real(1), stmt.real(2));
+        if (!stmt.null(3))
+          p.set_z(stmt.real(3));
+        if (!stmt.null(4))
           {
-            std::string txy = argv[4];
+            std::string txy = stmt.text(4);
             if      (txy == "fixed")       p.set_fixed_xy();
             else if (txy == "adjusted")    p.set_free_xy();
             else if (txy == "constrained") p.set_constrained_xy();
           }
-        if (argv[5])
+        if (!stmt.null(5))
           {
-            std::string tz = argv[5];
+            std::string tz = stmt.text(5);
             if      (tz == "fixed")       p.set_fixed_z();
             else if (tz == "adjusted")    p.set_free_z();
             else if (tz == "constrained") p.set_constrained_z();
           }
-        std::string pid = argv[0];
-        d->lnet->PD[pid] = p;
-
-        return 0;
+        d->lnet->PD[stmt.text(0)] = p;
       }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
+    return rows;
   }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
 
-int sqlite_db_readClusters(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc ==4 && argv[0] && argv[1] && argv[2] && argv[3])
+  /**
+     \brief Reads clusters from table \c gnu_gama_local_clusters.
+
+     Empty clusters are appended to the observation data and registered
+     in \a clusters; \a order keeps the order in which they were read.
+  */
+  std::size_t readClusters(ReaderData* d, ClusterMap& clusters,
+                           std::vector<sqlite3_int64>& order)
+  {
+    using namespace GNU_gama::local;
+
+    Statement stmt(d->sqlite3Handle,
+                   "select ccluster, dim, band, tag "
+                   "  from gnu_gama_local_clusters "
+                   " where conf_id = ?1 order by ccluster");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    while (stmt.next())
       {
-        std::string currentClusterId = argv[0];
-        std::string tag = argv[3];
+        rows++;
 
-        GNU_gama::Cluster<GNU_gama::local::Observation>* c = 0;
+        sqlite3_int64 id = stmt.integer(0);
+        int dim  = int(stmt.integer(1));
+        int band = int(stmt.integer(2));
+        std::string tag = stmt.text(3);
 
+        ClusterEntry e;
         if (tag == "obs")
-          {
-            d->currentStandPoint = new GNU_gama::local::StandPoint(&d->lnet->OD);
-
-            std::string query =
-              "select indx, tag, from_id, to_id, to_id2, val, stdev, "
-              "       from_dh, to_dh, to_dh2, dist, rejected "
-              "  from gnu_gama_local_obs "
-              " where conf_id = " + d->configurationId +
-              "   and ccluster = " + currentClusterId ;
-            exec(d->sqlite3Handle, query.c_str(), sqlite_db_readObservations, d);
-
-            c = d->currentStandPoint;
-            d->currentStandPoint = 0;
-          }
+          e.cluster = e.standPoint = new StandPoint(&d->lnet->OD);
         else if (tag == "vectors")
-          {
-            d->currentVectors = new GNU_gama::local::Vectors(&d->lnet->OD);
-
-            std::string query =
-              "select indx, from_id, to_id, dx, dy, dz, "
-              "       from_dh, to_dh, rejected "
-              "  from gnu_gama_local_vectors "
-              " where conf_id = " + d->configurationId +
-              "   and ccluster = " + currentClusterId ;
-            exec(d->sqlite3Handle, query.c_str(), sqlite_db_readVectors, d);
-
-            c = d->currentVectors;
-            d->currentVectors = 0;
-          }
+          e.cluster = e.vectors = new Vectors(&d->lnet->OD);
         else if (tag == "coordinates")
-          {
-            d->currentCoordinates = new GNU_gama::local::Coordinates(&d->lnet->OD);
-
-            std::string query =
-              "select indx, id, x, y, z, rejected "
-              "  from gnu_gama_local_coordinates "
-              " where conf_id = " + d->configurationId +
-              "   and ccluster = " + currentClusterId ;
-            exec(d->sqlite3Handle, query.c_str(), sqlite_db_readCoordinates, d);
-
-            c = d->currentCoordinates;
-            d->currentCoordinates = 0;
-          }
+          e.cluster = e.coordinates = new Coordinates(&d->lnet->OD);
         else if (tag == "height-differences")
-          {
-            d->currentHeightDifferences = new GNU_gama::local::HeightDifferences(&d->lnet->OD);
-
-            // clusters HeightDifferences share the same table with clusters StandPoint
-            std::string query =
-              "select indx, tag, from_id, to_id, to_id2, val, stdev, "
-              "       from_dh, to_dh, to_dh2, dist, rejected "
-              "  from gnu_gama_local_obs "
-              " where conf_id = " + d->configurationId +
-              "   and ccluster = " + currentClusterId ;
-            exec(d->sqlite3Handle, query.c_str(), sqlite_db_readHeightDifferences, d);
-
-            c = d->currentHeightDifferences;
-            d->currentHeightDifferences = 0;
-          }
+          e.cluster = e.heightDifferences = new HeightDifferences(&d->lnet->OD);
+        else
+          throw sqlitexc(T_gamalite_invalid_column_value);
 
-        d->lnet->OD.clusters.push_back(c);
+        d->lnet->OD.clusters.push_back(e.cluster);
+        e.cluster->covariance_matrix.reset(dim, band);
 
-        int dim = ToInteger(argv[1]); // index is unsigned
-        int band = ToInteger(argv[2]);
+        clusters[id] = e;
+        order.push_back(id);
+      }
+    return rows;
+  }
 
-        c->covariance_matrix.reset(dim, band);
-        d->currentCovarianceMatrix = &c->covariance_matrix;
+  /**
+     \brief Reads observations of all StandPoint and HeightDifferences
+     clusters from table \c gnu_gama_local_obs.
+  */
+  std::size_t readObservations(ReaderData* d, ClusterMap& clusters)
+  {
+    using namespace GNU_gama::local;
+
+    //    0         1    2        3      4       5    6        7      8       9     10
+    //  ccluster, tag, from_id, to_id, to_id2, val, from_dh, to_dh, to_dh2, dist, rejected
+    Statement stmt(d->sqlite3Handle,
+                   "select ccluster, tag, from_id, to_id, to_id2, val, "
+                   "       from_dh, to_dh, to_dh2, dist, rejected "
+                   "  from gnu_gama_local_obs "
+                   " where conf_id = ?1 order by ccluster, indx");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    ClusterEntry* e = nullptr;
+    sqlite3_int64 current = 0;
+    while (stmt.next())
+      {
+        rows++;
 
-        std::string query =
-          "select rind, cind, val "
-          "  from gnu_gama_local_covmat "
-          " where conf_id = " + d->configurationId +
-          "   and ccluster = " + currentClusterId ;
-        exec(d->sqlite3Handle, query.c_str(), sqlite_db_readCovarianceMatrix, d);
+        sqlite3_int64 id = stmt.integer(0);
+        if (e == nullptr || id != current)
+          {
+            auto c = clusters.find(id);
+            e = c != clusters.end() ? &c->second : nullptr;
+            current = id;
+          }
+        if (e == nullptr) continue;    // row without a cluster
 
-        d->currentCovarianceMatrix = 0;
-        c->update();
+        std::string tag  = stmt.text(1);
+        std::string from = stmt.text(2);
+        std::string to   = stmt.text(3);
+        double      val  = stmt.real(5);
+        sqlite3_int64 rejected = stmt.integer(10);
 
-        return 0;
-      }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
-  }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
+        if (e->heightDifferences)
+          {
+            double dist = 0;
+            if (!stmt.null(9)) dist = stmt.real(9);
 
-int sqlite_db_readObservations(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc ==12 && argv[1] && argv[2] && argv[3] && argv[5] && argv[11])
-      {
-        //    0    1       2      3       4     5      6      7       8      9      10     11
-        //  indx, tag, from_id, to_id, to_id2, val, stdev, from_dh, to_dh, to_dh2, dist, rejected
-        // 1 2 3 5 11  tested for NULL on input
-        // 0 4 6 7 8 9 10  not tested
-        // indx = argv[0] shouldn't be NULL but gama doesn't use it
+            e->heightDifferences->observation_list.push_back
+              (new H_Diff(from, to, val, dist));
+            continue;
+          }
 
-        std::string dir_from;
-        std::string tag  = argv[1];
-        std::string from = argv[2];
-        std::string to   = argv[3];
-        double      val  = ToDouble(argv[5]);
+        if (e->standPoint == nullptr)
+          throw sqlitexc(T_gamalite_invalid_column_value);
 
-        GNU_gama::local::Observation* obs = 0;
+        Observation* obs = 0;
 
         if (tag == "direction")
           {
-            obs = new GNU_gama::local::Direction(from, to, val);
-            if (dir_from.empty())
-              {
-                d->currentStandPoint->station = dir_from = from;
-              }
-            if (dir_from != from)
-              {
-                throw GNU_gama::Exception::sqlitexc(T_gamalite_stand_point_cluster_with_multi_dir_sets);
-              }
+            if (e->directions.empty())
+              e->standPoint->station = e->directions = from;
+            else if (e->directions != from)
+              throw sqlitexc(T_gamalite_stand_point_cluster_with_multi_dir_sets);
+
+            obs = new Direction(from, to, val);
           }
         else if (tag == "distance")
           {
-            obs = new GNU_gama::local::Distance  (from, to, val);
+            obs = new Distance  (from, to, val);
           }
-        else if (tag == "angle" && argv[4])
+        else if (tag == "angle" && !stmt.null(4))
           {
-            GNU_gama::local::Angle*
-              ang = new GNU_gama::local::Angle (from, to, argv[4], val);
-            if (argv[9]) ang->set_fs_dh(ToDouble(argv[9]));
+            Angle* ang = new Angle(from, to, stmt.text(4), val);
+            if (!stmt.null(8)) ang->set_fs_dh(stmt.real(8));
             obs = ang;
           }
         else if (tag == "s-distance")
           {
-            obs = new GNU_gama::local::S_Distance(from, to, val);
+            obs = new S_Distance(from, to, val);
           }
         else if (tag == "z-angle")
           {
-            obs = new GNU_gama::local::Z_Angle   (from, to, val);
+            obs = new Z_Angle   (from, to, val);
           }
         else if (tag == "azimuth")
           {
-            obs = new GNU_gama::local::Azimuth   (from, to, val);
+            obs = new Azimuth   (from, to, val);
           }
         else if (tag == "dh")
           {
-            GNU_gama::local::H_Diff*
-              dh = new GNU_gama::local::H_Diff    (from, to, val);
-            if (argv[10]) dh->set_dist(ToDouble(argv[10]));
+            H_Diff* dh = new H_Diff(from, to, val);
+            if (!stmt.null(9)) dh->set_dist(stmt.real(9));
             obs = dh;
           }
+        else
+          throw sqlitexc(T_gamalite_invalid_column_value);
 
-        if (argv[7]) obs->set_from_dh(ToDouble(argv[7]));
-        if (argv[8]) obs->set_to_dh  (ToDouble(argv[8]));
-
-        if(d->currentStandPoint)
-          d->currentStandPoint->observation_list.push_back(obs);
+        e->standPoint->observation_list.push_back(obs);
 
-        int rejected = ToInteger(argv[11]);
+        if (!stmt.null(6)) obs->set_from_dh(stmt.real(6));
+        if (!stmt.null(7)) obs->set_to_dh  (stmt.real(7));
         if (rejected) obs->set_passive();
-
-        return 0;
       }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
+    return rows;
   }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
-
 
-int sqlite_db_readVectors(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc ==9 && argv[1] && argv[2] && argv[3] && argv[4] && argv[5] && argv[8])
+  /**
+     \brief Reads vectors of all Vectors clusters from table \c gnu_gama_local_vectors.
+  */
+  std::size_t readVectors(ReaderData* d, ClusterMap& clusters)
+  {
+    using namespace GNU_gama::local;
+
+    //  0         1        2      3   4   5   6        7      8
+    //  ccluster, from_id, to_id, dx, dy, dz, from_dh, to_dh, rejected
+    Statement stmt(d->sqlite3Handle,
+                   "select ccluster, from_id, to_id, dx, dy, dz, "
+                   "       from_dh, to_dh, rejected "
+                   "  from gnu_gama_local_vectors "
+                   " where conf_id = ?1 order by ccluster, indx");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    while (stmt.next())
       {
-        //  0     1        2      3   4   5   6        7      8
-        //  indx, from_id, to_id, dx, dy, dz, from_dh, to_dh, rejected
-
-        std::string from = argv[1];
-        std::string to   = argv[2];
-        double      dx   = ToDouble(argv[3]);
-        double      dy   = ToDouble(argv[4]);
-        double      dz   = ToDouble(argv[5]);
-
-        GNU_gama::local::Xdiff* xdiff = new GNU_gama::local::Xdiff(from, to, dx);
-        GNU_gama::local::Ydiff* ydiff = new GNU_gama::local::Ydiff(from, to, dy);
-        GNU_gama::local::Zdiff* zdiff = new GNU_gama::local::Zdiff(from, to, dz);
-
-        if (argv[6])
+        rows++;
+
+        auto c = clusters.find(stmt.integer(0));
+        if (c == clusters.end()) continue;
+        Vectors* vectors = c->second.vectors;
+        if (vectors == nullptr)
+          throw sqlitexc(T_gamalite_invalid_column_value);
+
+        std::string from = stmt.text(1);
+        std::string to   = stmt.text(2);
+        double      dx   = stmt.real(3);
+        double      dy   = stmt.real(4);
+        double      dz   = stmt.real(5);
+        sqlite3_int64 rejected = stmt.integer(8);
+
+        Xdiff* xdiff = new Xdiff(from, to, dx);
+        Ydiff* ydiff = new Ydiff(from, to, dy);
+        Zdiff* zdiff = new Zdiff(from, to, dz);
+
+        vectors->observation_list.push_back(xdiff);
+        vectors->observation_list.push_back(ydiff);
+        vectors->observation_list.push_back(zdiff);
+
+        if (!stmt.null(6))
           {
-            double from_dh = ToDouble(argv[7]);
+            double from_dh = stmt.real(6);
             xdiff->set_from_dh(from_dh);
             ydiff->set_from_dh(from_dh);
             zdiff->set_from_dh(from_dh);
           }
 
-        if (argv[7])
+        if (!stmt.null(7))
           {
-            double to_dh = ToDouble(argv[8]);
+            double to_dh = stmt.real(7);
             xdiff->set_to_dh(to_dh);
             ydiff->set_to_dh(to_dh);
             zdiff->set_to_dh(to_dh);
           }
 
-        if (/*int rejected = */ ToInteger(argv[8]))
+        if (rejected)
           {
             xdiff->set_passive();
             ydiff->set_passive();
             zdiff->set_passive();
           }
-
-        d->currentVectors->observation_list.push_back(xdiff);
-        d->currentVectors->observation_list.push_back(ydiff);
-        d->currentVectors->observation_list.push_back(zdiff);
-
-        return 0;
       }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
+    return rows;
   }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
-
 
-int sqlite_db_readCoordinates(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc ==6 && argv[1])
+  /**
+     \brief Reads coordinates of all Coordinates clusters from table \c gnu_gama_local_coordinates.
+  */
+  std::size_t readCoordinates(ReaderData* d, ClusterMap& clusters)
+  {
+    using namespace GNU_gama::local;
+
+    //  0         1   2  3  4  5
+    //  ccluster, id, x, y, z, rejected
+    Statement stmt(d->sqlite3Handle,
+                   "select ccluster, id, x, y, z, rejected "
+                   "  from gnu_gama_local_coordinates "
+                   " where conf_id = ?1 order by ccluster, indx");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    while (stmt.next())
       {
-        //  0     1   2  3  4  5
-        //  indx, id, x, y, z, rejected
+        rows++;
 
-        std::string id = argv[1];
+        auto c = clusters.find(stmt.integer(0));
+        if (c == clusters.end()) continue;
+        Coordinates* coordinates = c->second.coordinates;
+        if (coordinates == nullptr)
+          throw sqlitexc(T_gamalite_invalid_column_value);
 
-        int reject = 0;
-        if (argv[5]) reject = ToInteger(argv[5]);
+        std::string id = stmt.text(1);
 
-        GNU_gama::local::X* x = 0;
-        GNU_gama::local::Y* y = 0;
-        GNU_gama::local::Z* z = 0;
+        sqlite3_int64 reject = 0;
+        if (!stmt.null(5)) reject = stmt.integer(5);
 
-        if (argv[2] && argv[3])
+        if (!stmt.null(2) && !stmt.null(3))
           {
-            x = new GNU_gama::local::X(id, ToDouble(argv[2]));
-            y = new GNU_gama::local::Y(id, ToDouble(argv[3]));
+            X* x = new X(id, stmt.real(2));
+            coordinates->observation_list.push_back(x);
+            Y* y = new Y(id, stmt.real(3));
+            coordinates->observation_list.push_back(y);
             if (reject)
               {
                 x->set_passive();
                 y->set_passive();
-             }
+              }
           }
 
-        if (argv[4])
+        if (!stmt.null(4))
           {
-            z = new GNU_gama::local::Z(id, ToDouble(argv[4]));
+            Z* z = new Z(id, stmt.real(4));
+            coordinates->observation_list.push_back(z);
             if (reject)
               {
                 z->set_passive();
               }
           }
+      }
+    return rows;
+  }
+
+  /**
+     \brief Reads covariance matrices of all clusters from table \c gnu_gama_local_covmat.
+  */
+  std::size_t readCovarianceMatrices(ReaderData* d, ClusterMap& clusters)
+  {
+    Statement stmt(d->sqlite3Handle,
+                   "select ccluster, rind, cind, val "
+                   "  from gnu_gama_local_covmat where conf_id = ?1");
+    stmt.bind(1, d->configurationId);
+
+    std::size_t rows = 0;
+    while (stmt.next())
+      {
+        rows++;
 
-        if (x) d->currentCoordinates->observation_list.push_back(x);
-        if (y) d->currentCoordinates->observation_list.push_back(y);
-        if (z) d->currentCoordinates->observation_list.push_back(z);
+        auto c = clusters.find(stmt.integer(0));
+        if (c == clusters.end()) continue;
 
-        return 0;
+        int r = int(stmt.integer(1));
+        int k = int(stmt.integer(2));
+        c->second.cluster->covariance_matrix(r, k) = stmt.real(3);
       }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
+    return rows;
   }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
+
+} // unnamed namespace
 
 
-int sqlite_db_readHeightDifferences(void* data, int argc, char** argv, char**)
+void SqliteReader::retrieve(LocalNetwork*& locnet, const std::string& configuration)
 {
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc ==12 && argv[1] && argv[2] && argv[3] && argv[5] && argv[11])
-      {
-        //  0     1    2        3      4       5    6      7        8      9       10    11
-        //  indx, tag, from_id, to_id, to_id2, val, stdev, from_dh, to_dh, to_dh2, dist, rejected
-        // 1 2 3 5 10 11  tested for NULL on input
-        // 0 4 6 7 8 9  not tested
-        // indx = argv[0] shouldn't be NULL but gama doesn't use it
+  typedef std::chrono::steady_clock Clock;
 
-        std::string   tag  = argv[1];
-        std::string   from = argv[2];
-        std::string   to   = argv[3];
-        double        val  = ToDouble(argv[5]);
-        double        dist = 0;
-        if (argv[10]) dist = ToDouble(argv[10]);
+  ReaderData* d = readerData;
 
-        GNU_gama::local::H_Diff* hdiff = new GNU_gama::local::H_Diff(from, to, val, dist);
+  // at this point we do not know if locnet is defined yet
+  d->lnet = locnet;
+  d->load.clear();
 
-        d->currentHeightDifferences->observation_list.push_back(hdiff);
+  Transaction transaction(d->sqlite3Handle);
 
-        return 0;
-      }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
-  }
-  catch (GNU_gama::Exception::base& e)
+  Clock::time_point start = Clock::now();
+  auto record = [&](const char* table, std::size_t rows)
     {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
+      Clock::time_point stop = Clock::now();
+      d->load.push_back({table, rows,
+            std::chrono::duration<double>(stop - start).count()});
+      start = stop;
+    };
 
+  std::size_t rows = readConfigurationInfo(d, configuration);
+  record("gnu_gama_local_configurations", rows);
 
-int sqlite_db_readCovarianceMatrix(void* data, int argc, char** argv, char**)
-{
-  ReaderData* d = static_cast<ReaderData*>(data);
-  try {
-    if (argc == 3 && argv[0] && argv[1] && argv[2])
-      {
-        int r = ToInteger(argv[0]);
-        int c = ToInteger(argv[1]);
-        double v = ToDouble (argv[2]);
+  if (rows == 0)
+    throw GNU_gama::Exception::sqlitexc(T_gamalite_configuration_not_found);
 
-        (*d->currentCovarianceMatrix)(r,c) = v;
+  locnet = d->lnet; // now the pointer must be defined externally or created
 
-        return 0;
-      }
-    else
-      throw GNU_gama::Exception::sqlitexc(T_gamalite_invalid_column_value);
-  }
-  catch (GNU_gama::Exception::base& e)
-    {
-      d->exception = e.clone();
-    }
-  catch (std::exception& e)
-    {
-      d->exception = new GNU_gama::Exception::string(e.what());
-    }
-  catch (...)
-    {
-      d->exception = new GNU_gama::Exception::string(T_gamalite_unknown_exception_in_callback);
-    }
-  return 1;
-}
+  record("gnu_gama_local_descriptions", readConfigurationText(d));
+  record("gnu_gama_local_points",       readPoints(d));
 
-/////////////// end of callbacks ///////////////////
+  ClusterMap clusters;
+  std::vector<sqlite3_int64> order;
+  record("gnu_gama_local_clusters",    readClusters(d, clusters, order));
+  record("gnu_gama_local_obs",         readObservations(d, clusters));
+  record("gnu_gama_local_vectors",     readVectors(d, clusters));
+  record("gnu_gama_local_coordinates", readCoordinates(d, clusters));
+  record("gnu_gama_local_covmat",      readCovarianceMatrices(d, clusters));
+
+  for (sqlite3_int64 id : order) clusters[id].cluster->update();
+
+  transaction.commit();
+}
 
 #endif  // GNU_GAMA_LOCAL_SQLITE_READER
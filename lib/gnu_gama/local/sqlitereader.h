@@ -24,7 +24,9 @@
 #ifndef SQLITEREADER_H
 #define SQLITEREADER_H
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "gnu_gama/exception.h"
 
@@ -48,32 +50,10 @@ namespace GNU_gama {
             : string(message)
             { }
 
-        /**
-          Clones an exception.
-          \internal
-          The way as it is used in callback functions:
-          \code
-            // ... try block
-            catch (GNU_gama::Exception::base& e)
-                {
-                    d->exception = e.clone();
-                }
-            return 1;
-          \endcode
-          */
+        /** Clones an exception. */
         virtual sqlitexc* clone() const { return new sqlitexc(*this); }
 
-        /**
-          Rethrows an exception polymorphically.
-          \internal
-          The way as it is used in function \c exec in file sqlitereader.cpp:
-          \code
-            if (readerData->exception != 0)
-                {
-                    readerData->exception->raise();
-                }
-          \endcode
-          */
+        /** Rethrows an exception polymorphically. */
         virtual void raise() const { throw *this; }
     };
 
@@ -87,6 +67,16 @@ namespace sqlite_db {
 
 struct ReaderData;
 
+/**
+  \brief Number of rows read from a table and the time it took.
+  */
+struct SqliteTableLoad
+{
+    std::string table;    ///< table name
+    std::size_t rows;     ///< number of rows read
+    double      seconds;  ///< elapsed time in seconds
+};
+
 /**
   \brief Reads LocalNetwork from SQLite 3 database.
   */
@@ -113,6 +103,10 @@ public:
       */
     void retrieve(LocalNetwork*& lnet, const std::string& configuration);
 
+    /** \brief Tables read by the last call of #retrieve in the order
+        they were read, with the number of rows and the load time. */
+    const std::vector<SqliteTableLoad>& load_statistics() const;
+
 private:
     /** disabled copy constructor */
     SqliteReader(const SqliteReader&);
@@ -0,0 +1,262 @@
+/*
+    GNU Gama C++ library
+    Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef  GNU_GAMA_LOCAL_SQLITE_READER
+
+#ifndef GNU_gama_local_sqlite_db_sqlitestatement_h
+#define GNU_gama_local_sqlite_db_sqlitestatement_h
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <sqlite3.h>
+
+#include <gnu_gama/local/sqlitereader.h>
+#include <Math/Business/Core/intfloat.h>
+
+/**
+  \internal
+  \file sqlitestatement.h
+  \brief Prepared statements and transactions shared by
+  #GNU_gama::local::sqlite_db::SqliteReader and
+  #GNU_gama::local::sqlite_db::SqliteWriter.
+  */
+
+namespace GNU_gama { namespace local { namespace sqlite_db {
+
+/**
+   \internal
+   \brief Milliseconds a connection waits for a lock held by another
+   connection (concurrent jobs of gama-local --batch) before an
+   operation fails with \c SQLITE_BUSY.
+*/
+const int busy_timeout = 60000;
+
+/** \internal error message of SqliteReader and SqliteWriter constructors */
+const char* const T_gamalite_database_not_open = "database not open";
+/** \internal error message, configuration name is not in the database */
+const char* const T_gamalite_configuration_not_found =
+  "configuration not found";
+/** \internal error message, bad value of a database field */
+const char* const T_gamalite_invalid_column_value = "invalid column value";
+
+/**
+   \internal
+   \brief A prepared statement, finalized in destructor.
+
+   Parameters are bound by their position (starting from 1), columns
+   are indexed from 0. A statement can be executed repeatedly, #exec
+   resets it and clears the bindings after each insert.
+
+   SQLite does not enforce the column types declared in CREATE
+   statement, so the typed accessors check the storage class of each
+   value: \c NULL values throw #GNU_gama::Exception::sqlitexc (callers
+   test optional columns by #null first) and values stored as text
+   are converted and validated.
+*/
+class Statement
+{
+public:
+  Statement(sqlite3* db, const char* sql) : db_(db), stmt_(0)
+  {
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt_, 0) != SQLITE_OK)
+      throw Exception::sqlitexc(sqlite3_errmsg(db_));
+  }
+  ~Statement() { sqlite3_finalize(stmt_); }
+
+  void bind(int i, sqlite3_int64 n)
+  {
+    check(sqlite3_bind_int64(stmt_, i, n));
+  }
+  void bind(int i, int n)
+  {
+    check(sqlite3_bind_int64(stmt_, i, n));
+  }
+  void bind(int i, double d)
+  {
+    check(sqlite3_bind_double(stmt_, i, d));
+  }
+  void bind(int i, const std::string& s)
+  {
+    check(sqlite3_bind_text(stmt_, i, s.c_str(), int(s.size()),
+                            SQLITE_TRANSIENT));
+  }
+  void bind(int i, const char* s)
+  {
+    check(sqlite3_bind_text(stmt_, i, s, -1, SQLITE_STATIC));
+  }
+  void bind_null(int i)
+  {
+    check(sqlite3_bind_null(stmt_, i));
+  }
+
+  /** \brief Steps to the next row, returns \c false when done. */
+  bool next()
+  {
+    int rc = sqlite3_step(stmt_);
+    if (rc == SQLITE_ROW)  return true;
+    if (rc == SQLITE_DONE) return false;
+    throw Exception::sqlitexc(sqlite3_errmsg(db_));
+  }
+
+  /** \brief Executes statement with the bound parameters and resets it. */
+  void exec()
+  {
+    int rc = sqlite3_step(stmt_);
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+    if (rc != SQLITE_DONE && rc != SQLITE_ROW)
+      throw Exception::sqlitexc(sqlite3_errmsg(db_));
+  }
+
+  bool null(int c) const
+  {
+    return sqlite3_column_type(stmt_, c) == SQLITE_NULL;
+  }
+
+  double real(int c) const
+  {
+    switch (sqlite3_column_type(stmt_, c))
+      {
+      case SQLITE_FLOAT:
+      case SQLITE_INTEGER:
+        return sqlite3_column_double(stmt_, c);
+      case SQLITE_TEXT:
+        {
+          std::string s = chars(c);
+          double d;
+          std::istringstream istr(s);
+          if (!IsFloat(s) || !(istr >> d))
+            throw Exception::sqlitexc("conversion to double failed");
+          return d;
+        }
+      }
+    throw Exception::sqlitexc(T_gamalite_invalid_column_value);
+  }
+
+  sqlite3_int64 integer(int c) const
+  {
+    switch (sqlite3_column_type(stmt_, c))
+      {
+      case SQLITE_INTEGER:
+        return sqlite3_column_int64(stmt_, c);
+      case SQLITE_FLOAT:
+        {
+          double d = sqlite3_column_double(stmt_, c);
+          if (d != std::floor(d))
+            throw Exception::sqlitexc("conversion to integer failed");
+          return sqlite3_int64(d);
+        }
+      case SQLITE_TEXT:
+        {
+          std::string s = chars(c);
+          sqlite3_int64 n;
+          std::istringstream istr(s);
+          if (!IsInteger(s) || !(istr >> n))
+            throw Exception::sqlitexc("conversion to integer failed");
+          return n;
+        }
+      }
+    throw Exception::sqlitexc(T_gamalite_invalid_column_value);
+  }
+
+  std::string text(int c) const
+  {
+    if (null(c)) throw Exception::sqlitexc(T_gamalite_invalid_column_value);
+    const char* s = chars(c);
+    return std::string(s, sqlite3_column_bytes(stmt_, c));
+  }
+
+private:
+  Statement(const Statement&);
+  Statement& operator= (const Statement&);
+
+  const char* chars(int c) const
+  {
+    return reinterpret_cast<const char*>(sqlite3_column_text(stmt_, c));
+  }
+  void check(int rc) const
+  {
+    if (rc != SQLITE_OK) throw Exception::sqlitexc(sqlite3_errmsg(db_));
+  }
+
+  sqlite3*      db_;
+  sqlite3_stmt* stmt_;
+};
+
+
+/**
+   \internal
+   \brief A transaction, rolled back in destructor if not committed.
+
+   Reading all tables in one transaction gives a consistent snapshot
+   and SQLite acquires the lock only once; writing in one transaction
+   avoids a journal sync after each insert.
+
+   A writing transaction is started as #immediate: it takes the write
+   lock before its first read, so that concurrent writers wait in the
+   busy handler (#busy_timeout) instead of failing with \c SQLITE_BUSY
+   when a read lock cannot be upgraded.
+*/
+class Transaction
+{
+public:
+  enum Mode { deferred, immediate };
+
+  explicit Transaction(sqlite3* db, Mode mode = deferred)
+    : db_(db), active_(false)
+  {
+    exec(mode == immediate ? "begin immediate" : "begin");
+    active_ = true;
+  }
+  ~Transaction()
+  {
+    if (active_) sqlite3_exec(db_, "rollback", 0, 0, 0);
+  }
+  void commit()
+  {
+    exec("commit");
+    active_ = false;
+  }
+
+private:
+  Transaction(const Transaction&);
+  Transaction& operator= (const Transaction&);
+
+  void exec(const char* sql)
+  {
+    char* errorMsg = 0;
+    if (sqlite3_exec(db_, sql, 0, 0, &errorMsg) != SQLITE_OK)
+      {
+        std::string s = errorMsg ? errorMsg : sqlite3_errmsg(db_);
+        sqlite3_free(errorMsg);
+        throw Exception::sqlitexc(s);
+      }
+  }
+
+  sqlite3* db_;
+  bool     active_;
+};
+
+}}} // namespace GNU_gama local sqlite_db
+
+#endif
+#endif  // GNU_GAMA_LOCAL_SQLITE_READER
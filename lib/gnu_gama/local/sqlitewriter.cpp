@@ -0,0 +1,239 @@
+/*
+    GNU Gama C++ library
+    Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef   GNU_GAMA_LOCAL_SQLITE_READER
+
+#include <gnu_gama/local/sqlitewriter.h>
+#include <gnu_gama/local/sqlitestatement.h>
+#include <gnu_gama/local/network.h>
+#include <gnu_gama/local/localnetwork2sql.h>
+#include <gnu_gama/xml/gkfparser.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+  \internal
+  \file sqlitewriter.cpp
+  \brief Implementation of #GNU_gama::local::sqlite_db::SqliteWriter.
+  */
+
+using namespace GNU_gama::local;
+using namespace GNU_gama::local::sqlite_db;
+
+namespace {
+
+  /** \brief Rows of LocalNetwork2sql inserted by prepared statements */
+  class SqliteRows : public SqlRows
+  {
+  public:
+    SqliteRows(sqlite3* db, sqlite3_int64 id) : db_(db), conf_id(id) {}
+
+    void remove(const char* table) override
+    {
+      Statement stmt(db_, (std::string("delete from ") + table
+                           + " where conf_id = ?1").c_str());
+      stmt.bind(1, conf_id);
+      stmt.exec();
+    }
+    void insert(const char* table) override
+    {
+      table_ = table;
+      values.clear();
+    }
+    void set(const char* column, int value) override
+    {
+      values.push_back({column, Value::integer, value, 0, {}});
+    }
+    void set(const char* column, double value) override
+    {
+      values.push_back({column, Value::real, 0, value, {}});
+    }
+    void set(const char* column, const std::string& value) override
+    {
+      values.push_back({column, Value::text, 0, 0, value});
+    }
+    using SqlRows::set;
+    void exec() override;
+
+  private:
+    struct Value
+    {
+      enum Type { integer, real, text };
+
+      const char* column;
+      Type        type;
+      int         i;
+      double      d;
+      std::string s;
+    };
+
+    sqlite3*           db_;
+    sqlite3_int64      conf_id;
+    std::string        table_;
+    std::vector<Value> values;
+
+    // statements are reused for rows with the same set of columns
+    std::map<std::string, std::unique_ptr<Statement>> statements;
+  };
+
+
+  void SqliteRows::exec()
+  {
+    std::string sql = "insert into " + table_ + " (conf_id";
+    for (const Value& v : values) sql += std::string(", ") + v.column;
+    sql += ") values (?1";
+    for (std::size_t n=2; n<=values.size()+1; n++)
+      sql += ", ?" + std::to_string(n);
+    sql += ")";
+
+    std::unique_ptr<Statement>& stmt = statements[sql];
+    if (!stmt) stmt.reset(new Statement(db_, sql.c_str()));
+
+    stmt->bind(1, conf_id);
+    int n = 2;
+    for (const Value& v : values)
+      {
+        switch (v.type)
+          {
+          case Value::integer: stmt->bind(n++, v.i); break;
+          case Value::real:    stmt->bind(n++, v.d); break;
+          case Value::text:    stmt->bind(n++, v.s); break;
+          }
+      }
+    stmt->exec();
+  }
+
+
+  /** \brief Deletes configuration \a name if it exists, returns a new id */
+  sqlite3_int64 replace_configuration(sqlite3* db, const LocalNetwork2sql& input,
+                                      const std::string& name)
+  {
+    {
+      Statement stmt(db, "select conf_id from gnu_gama_local_configurations "
+                         " where conf_name = ?1");
+      stmt.bind(1, name);
+      if (stmt.next())
+        {
+          SqliteRows rows(db, stmt.integer(0));
+          input.remove_configuration(rows);
+        }
+    }
+
+    Statement stmt(db, "select coalesce(max(conf_id), 0)+1 "
+                       "from gnu_gama_local_configurations");
+    stmt.next();
+    return stmt.integer(0);
+  }
+
+}   // unnamed namespace
+
+
+SqliteWriter::SqliteWriter(const std::string& fileName)
+  : sqlite3Handle(0)
+{
+  if (sqlite3_open(fileName.c_str(), &sqlite3Handle))
+    {
+      sqlite3_close(sqlite3Handle);
+      throw GNU_gama::Exception::sqlitexc(T_gamalite_database_not_open);
+    }
+  sqlite3_busy_timeout(sqlite3Handle, busy_timeout);
+}
+
+
+SqliteWriter::~SqliteWriter()
+{
+  sqlite3_close(sqlite3Handle);
+}
+
+
+void SqliteWriter::write(LocalNetwork* netinfo, const std::string& configuration)
+{
+  Transaction transaction(sqlite3Handle, Transaction::immediate);
+
+  sqlite3_int64 conf_id = 0;
+  {
+    Statement stmt(sqlite3Handle,
+                   "select conf_id from gnu_gama_local_configurations "
+                   " where conf_name = ?1");
+    stmt.bind(1, configuration);
+    if (!stmt.next())
+      throw GNU_gama::Exception::sqlitexc(T_gamalite_configuration_not_found);
+    conf_id = stmt.integer(0);
+  }
+
+  SqliteRows rows(sqlite3Handle, conf_id);
+  LocalNetwork2sql results(*netinfo);
+  results.remove_results(rows);
+  results.write_results(rows);
+
+  transaction.commit();
+}
+
+
+
+void SqliteWriter::write_input(LocalNetwork* lnet, const std::string& configuration)
+{
+  Transaction transaction(sqlite3Handle, Transaction::immediate);
+
+  LocalNetwork2sql input(*lnet);
+  SqliteRows rows(sqlite3Handle,
+                  replace_configuration(sqlite3Handle, input, configuration));
+
+  input.write_configuration(rows, configuration);
+  int ccluster = 0;
+  for (const auto* c : lnet->OD.clusters) input.write_cluster(rows, c, ++ccluster);
+  input.write_points(rows);
+
+  transaction.commit();
+}
+
+
+void SqliteWriter::write_input(std::istream& xml, const std::string& configuration)
+{
+  Transaction transaction(sqlite3Handle, Transaction::immediate);
+
+  LocalNetwork     lnet;
+  LocalNetwork2sql input(lnet);
+  SqliteRows rows(sqlite3Handle,
+                  replace_configuration(sqlite3Handle, input, configuration));
+
+  // configuration attributes and description precede all clusters
+  bool started = false;
+  int  ccluster = 0;
+  GKFparser::read(xml, lnet, [&](GNU_gama::Cluster<Observation>* c)
+    {
+      if (!started) input.write_configuration(rows, configuration);
+      started = true;
+      input.write_cluster(rows, c, ++ccluster);
+
+      lnet.OD.clusters.pop_back();
+      delete c;
+    });
+
+  if (!started) input.write_configuration(rows, configuration);
+  input.write_points(rows);
+
+  transaction.commit();
+}
+
+#endif  // GNU_GAMA_LOCAL_SQLITE_READER
@@ -0,0 +1,112 @@
+/*
+    GNU Gama C++ library
+    Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef  GNU_GAMA_LOCAL_SQLITE_READER
+
+#ifndef SQLITEWRITER_H
+#define SQLITEWRITER_H
+
+#include <istream>
+#include <string>
+
+#include <gnu_gama/local/sqlitereader.h>
+
+/**
+  \file sqlitewriter.h
+  \brief #GNU_gama::local::sqlite_db::SqliteWriter header file.
+  */
+
+struct sqlite3;
+
+namespace GNU_gama { namespace local {
+
+    class LocalNetwork;
+
+namespace sqlite_db {
+
+/**
+  \brief Writes input data and adjustment results of LocalNetwork to
+  SQLite 3 database.
+
+  Input data of a network (#write_input) are the same rows as in the
+  SQL script of LocalNetwork2sql, the configuration id is looked up
+  only once and all rows are inserted by prepared statements in a
+  single transaction.
+
+  Adjustment results (#write) are stored for a configuration already
+  defined in the database (typically the one read by #SqliteReader) in
+  tables gnu_gama_local_adj_*, the rows are the same as generated by
+  LocalNetwork2sql::write_results(). Previous results of the
+  configuration are deleted, all rows are inserted by prepared
+  statements in a single transaction.
+  */
+class SqliteWriter
+{
+public:
+    /**
+      \brief Opens a database connection.
+      \param fileName name of database file
+      */
+    explicit SqliteWriter(const std::string& fileName);
+
+    /**
+      \brief Closes a database connection.
+      */
+    ~SqliteWriter();
+
+    /** \brief Writes results of adjusted network \a lnet for \a configuration.
+
+        \throws #GNU_gama::Exception::sqlitexc
+      */
+    void write(LocalNetwork* lnet, const std::string& configuration);
+
+    /** \brief Writes input data of network \a lnet as \a configuration.
+
+        Existing configuration of the same name is replaced.
+
+        \throws #GNU_gama::Exception::sqlitexc
+      */
+    void write_input(LocalNetwork* lnet, const std::string& configuration);
+
+    /** \brief Reads XML input of gama-local and writes it as \a configuration.
+
+        Each cluster of observations is written and released as soon
+        as it is parsed, only points are kept in memory.
+
+        \throws #GNU_gama::Exception::sqlitexc
+        \throws #GNU_gama::Exception::parser
+      */
+    void write_input(std::istream& xml, const std::string& configuration);
+
+private:
+    /** disabled copy constructor */
+    SqliteWriter(const SqliteWriter&);
+    /** disabled assignment operator */
+    SqliteWriter& operator= (const SqliteWriter&);
+
+    sqlite3* sqlite3Handle;
+};
+
+} // namespace sqlite_db
+} // namespace local
+} // namespace GNU_gama
+
+#endif // SQLITEWRITER_H
+#endif // GNU_GAMA_LOCAL_SQLITE_READER
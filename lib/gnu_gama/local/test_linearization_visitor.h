@@ -147,14 +147,14 @@ public:
     void visit(Distance* obs)
       {
         dms = false;
-        out << T_GaMa_distance;
+        out << IS->texts().T_GaMa_distance;
         mer = obs->value();
         out.precision(distPrecision);
       }
     void visit(Direction* obs)
       {
         dms = IS->degrees();
-        out << T_GaMa_direction;
+        out << IS->texts().T_GaMa_direction;
         mer = (obs->value())*GNU_gama::RAD_TO_GON;
         out.precision(angularPrecision);
       }
@@ -164,14 +164,14 @@ public:
         out << '\n';
         const int w = IS->maxw_obs() + 2 + 2*(IS->maxw_id());
         out << Utf8::leftPad((obs->fs()).str(), w);
-        out << T_GaMa_angle;
+        out << IS->texts().T_GaMa_angle;
         mer = (obs->value())*GNU_gama::RAD_TO_GON;
         out.precision(angularPrecision);
       }
     void visit(S_Distance* obs)
     {
       dms = false;
-      out << T_GaMa_s_distance;
+      out << IS->texts().T_GaMa_s_distance;
       mer = obs->value();
       out.precision(distPrecision);
     }
@@ -211,6 +211,8 @@ TestLinearization(GNU_gama::local::LocalNetwork* IS, OutStream& out,
   using namespace std;
   using namespace GNU_gama::local;
 
+  const Texts& texts = IS->texts();
+
   bool test  = false;     // result of bad linearization test
 
   // difference in adjusted observations computed from residuals and
@@ -270,27 +272,27 @@ TestLinearization(GNU_gama::local::LocalNetwork* IS, OutStream& out,
         {
           // if (!test) out << hlavicka;
           if (!test)
-            out << T_GaMa_tstlin_Test_of_linearization_error << "\n"
-                << underline(T_GaMa_tstlin_Test_of_linearization_error, '*')
+            out << texts.T_GaMa_tstlin_Test_of_linearization_error << "\n"
+                << underline(texts.T_GaMa_tstlin_Test_of_linearization_error, '*')
                 << "\n";
           test = true;
 
           out << "\n"
-               << T_GaMa_tstlin_Differences
+               << texts.T_GaMa_tstlin_Differences
               << "\n"
-              << underline(T_GaMa_tstlin_Differences, '*')
+              << underline(texts.T_GaMa_tstlin_Differences, '*')
               << "\n\n";
 
           out.width(IS->maxw_obs());
           out << "i" << " ";
           out.width(IS->maxw_id());
-          out << T_GaMa_standpoint << " ";
+          out << texts.T_GaMa_standpoint << " ";
           out.width(IS->maxw_id());
-          out << T_GaMa_target << "      ";
-          out << T_GaMa_tstlin_obs_r_diff << "\n";
+          out << texts.T_GaMa_target << "      ";
+          out << texts.T_GaMa_tstlin_obs_r_diff << "\n";
 
           for (int i=0; i<(IS->maxw_obs()+2*IS->maxw_id()+8); i++) out << '=';
-          out << T_GaMa_tstlin_header_value;
+          out << texts.T_GaMa_tstlin_header_value;
           if (IS->gons())
             out << "= [mm|cc] == [cc] == [mm] =\n\n";
           else
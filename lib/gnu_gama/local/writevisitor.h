@@ -43,7 +43,9 @@ template <typename OutStream>
 class WriteVisitor : public AllObservationsVisitor
 {
 public:
-    WriteVisitor(OutStream& out, bool print_at) : out_(out), print_at_(print_at) {}
+    WriteVisitor(OutStream& out, bool print_at, bool gons = true,
+                 const Format& format = Format())
+      : out_(out), print_at_(print_at), gons_(gons), format_(format) {}
 
     void visit(Angle *obs) { write(*obs, out_, print_at_); }
     void visit(Direction *obs) { write(*obs, out_, print_at_); }
@@ -66,16 +68,16 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " bs=\"" << obs.bs()  << '"' << " fs=\"" << obs.fs() << '"' << " val=\"";
-      if (Observation::gons)
-        out << std::setprecision(Format::gon_p()) << obs.value()*GNU_gama::RAD_TO_GON;
+      if (gons_)
+        out << std::setprecision(format_.gon_p()) << obs.value()*GNU_gama::RAD_TO_GON;
       else
-        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, Format::gon_p());
+        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, format_.gon_p());
       out << '"';
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
-          out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
+          out << " stdev=\"" << std::setprecision(format_.stdev_p()) << stddev << '"';
         }
 
       out << " />";
@@ -88,16 +90,16 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " to=\"" << obs.to() << '"' << " val=\"";
-      if (Observation::gons)
-        out << std::setprecision(Format::gon_p()  ) << obs.value()*GNU_gama::RAD_TO_GON;
+      if (gons_)
+        out << std::setprecision(format_.gon_p()  ) << obs.value()*GNU_gama::RAD_TO_GON;
       else
-        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, Format::gon_p());
+        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, format_.gon_p());
       out << '"';
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
-          out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
+          out << " stdev=\"" << std::setprecision(format_.stdev_p()) << stddev << '"';
         }
 
       out << " />";
@@ -110,9 +112,9 @@ public:
       if (print_at)
         out << " from=\"" << obs.from() << '"';
       out << " to=\"" << obs.to() << '"'
-          << " val=\""   << std::setprecision(Format::coord_p()) << obs.value()  << '"';
+          << " val=\""   << std::setprecision(format_.coord_p()) << obs.value()  << '"';
       if (obs.check_std_dev())
-        out << " stdev=\"" << std::setprecision(Format::stdev_p()) << obs.stdDev() << '"';
+        out << " stdev=\"" << std::setprecision(format_.stdev_p()) << obs.stdDev() << '"';
       out << " />";
     }
 
@@ -122,9 +124,9 @@ public:
       // if (print_at) ... always print from="..."
       out << " from=\"" << obs.from() << '"';
       out << " to=\"" << obs.to() << '"'
-          << " val=\""   << std::setprecision(Format::coord_p()) << obs.value()  << '"';
+          << " val=\""   << std::setprecision(format_.coord_p()) << obs.value()  << '"';
       if (obs.check_std_dev())
-        out << " stdev=\"" << std::setprecision(Format::stdev_p()) << obs.stdDev() << '"';;
+        out << " stdev=\"" << std::setprecision(format_.stdev_p()) << obs.stdDev() << '"';;
       if (obs.dist())
         out << " dist=\"" << obs.dist() << "\"";
       out << " />";
@@ -137,9 +139,9 @@ public:
       if (print_at)
         out << " from=\"" << obs.from() << '"';
       out << " to=\"" << obs.to() << '"'
-          << " val=\""   << std::setprecision(Format::coord_p()) << obs.value()  << '"';
+          << " val=\""   << std::setprecision(format_.coord_p()) << obs.value()  << '"';
       if (obs.check_std_dev())
-        out << " stdev=\"" << std::setprecision(Format::stdev_p()) << obs.stdDev() << '"';
+        out << " stdev=\"" << std::setprecision(format_.stdev_p()) << obs.stdDev() << '"';
       out << " />";
     }
 
@@ -147,7 +149,7 @@ public:
     {
       using namespace std;
       out << "<!-- " << obs.from() << " x = "
-          << std::setprecision(Format::coord_p()) << obs.value() << " --!>";
+          << std::setprecision(format_.coord_p()) << obs.value() << " --!>";
     }
 
 
@@ -155,7 +157,7 @@ public:
     {
       using namespace std;
       out << "<!-- " << obs.from() << " y = "
-          << std::setprecision(Format::coord_p()) << obs.value() << " --!>";
+          << std::setprecision(format_.coord_p()) << obs.value() << " --!>";
     }
 
 
@@ -163,7 +165,7 @@ public:
     {
       using namespace std;
       out << "<!-- " << obs.from() << " z = "
-          << std::setprecision(Format::coord_p()) << obs.value() << " --!>";
+          << std::setprecision(format_.coord_p()) << obs.value() << " --!>";
     }
 
     void write(const Xdiff& obs, OutStream& out, bool) const
@@ -171,7 +173,7 @@ public:
       using namespace std;
       out << "<!-- from='" << obs.from() << "' to='" << obs.to() << "'"
           << " diff x = "
-          << std::setprecision(Format::coord_p()) << obs.value() << " --!>";
+          << std::setprecision(format_.coord_p()) << obs.value() << " --!>";
     }
 
 
@@ -180,7 +182,7 @@ public:
       using namespace std;
       out << "<!-- from='" << obs.from() << "' to='" << obs.to() << "'"
           << " diff y = "
-          << std::setprecision(Format::coord_p()) << obs.value() << " --!>";
+          << std::setprecision(format_.coord_p()) << obs.value() << " --!>";
     }
 
 
@@ -189,7 +191,7 @@ public:
       using namespace std;
       out << "<!-- from='" << obs.from() << "' to='" << obs.to() << "'"
           << " diff z = "
-          << std::setprecision(Format::coord_p()) << obs.value() << " --!>";
+          << std::setprecision(format_.coord_p()) << obs.value() << " --!>";
     }
 
     void write(const Z_Angle& obs, OutStream& out, bool print_at) const
@@ -199,16 +201,16 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " to=\"" << obs.to() << '"' << " val=\"";
-      if (Observation::gons)
-        out << std::setprecision(Format::gon_p()) << obs.value()*GNU_gama::RAD_TO_GON;
+      if (gons_)
+        out << std::setprecision(format_.gon_p()) << obs.value()*GNU_gama::RAD_TO_GON;
       else
-        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, Format::gon_p());
+        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, format_.gon_p());
       out << '"';
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
-          out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
+          out << " stdev=\"" << std::setprecision(format_.stdev_p()) << stddev << '"';
         }
 
       out << " />";
@@ -221,16 +223,16 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " to=\"" << obs.to() << '"' << " val=\"";
-      if (Observation::gons)
-        out << std::setprecision(Format::gon_p()  ) << obs.value()*GNU_gama::RAD_TO_GON;
+      if (gons_)
+        out << std::setprecision(format_.gon_p()  ) << obs.value()*GNU_gama::RAD_TO_GON;
       else
-        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, Format::gon_p());
+        out << GNU_gama::gon2deg(obs.value()*GNU_gama::RAD_TO_GON, 2, format_.gon_p());
       out << '"';
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
-          out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
+          out << " stdev=\"" << std::setprecision(format_.stdev_p()) << stddev << '"';
         }
 
       out << " />";
@@ -239,6 +241,8 @@ public:
 private:
     OutStream& out_;
     bool print_at_;
+    bool gons_;
+    Format format_;
 };
 
 }} // namespace GNU_gama local
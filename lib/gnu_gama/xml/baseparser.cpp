@@ -22,6 +22,17 @@
 #include <gnu_gama/xml/baseparser.h>
 #include <Parsing/Service/encoding.h>
 #include <cstdlib>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define GNU_GAMA_XML_MMAP
+#endif
 
 using namespace std;
 using namespace GNU_gama;
@@ -128,6 +139,96 @@ bool CoreParser::toIndex(const std::string& s, int& index) const
 }
 
 
+namespace
+{
+  // blocks of input end after the last '>' so that character data of
+  // an element is not split into two calls of the data handler
+
+  std::size_t block_size(const char* p, std::size_t size)
+  {
+    for (std::size_t n=size; n>0; n--)
+      if (p[n-1] == '>') return n;
+
+    return size;
+  }
+}
+
+
+bool CoreParser::xml_parse_file(const char* file)
+{
+  // expat is given large blocks of input instead of individual lines
+
+#ifdef GNU_GAMA_XML_MMAP
+  const std::size_t chunk = std::size_t(1) << 24;
+
+  int fd = ::open(file, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      const std::size_t size = std::size_t(st.st_size);
+      void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED)
+        {
+          ::close(fd);
+          ::madvise(map, size, MADV_SEQUENTIAL);
+
+          try
+            {
+              const char* p = static_cast<const char*>(map);
+              for (std::size_t n=0, b; n<size; n+=b)
+                {
+                  b = std::min(chunk, size-n);
+                  if (n+b < size) b = block_size(p+n, b);
+                  xml_parse(p+n, int(b), 0);
+                }
+              xml_parse("", 0, 1);
+            }
+          catch (...)
+            {
+              ::munmap(map, size);
+              throw;
+            }
+
+          ::munmap(map, size);
+          return true;
+        }
+    }
+  ::close(fd);
+#endif
+
+  // fallback for systems without mmap and for empty or special files
+
+  std::ifstream input(file, std::ios_base::binary);
+  if (!input) return false;
+
+  xml_parse_stream(input);
+  return true;
+}
+
+
+void CoreParser::xml_parse_stream(std::istream& input)
+{
+  const std::size_t chunk = std::size_t(1) << 20;
+
+  std::vector<char> buffer(chunk);
+  std::size_t tail = 0;
+  while (input.read(buffer.data()+tail, std::streamsize(chunk-tail)) ||
+         input.gcount() > 0)
+    {
+      const std::size_t size = tail + std::size_t(input.gcount());
+      const std::size_t b = input ? block_size(buffer.data(), size) : size;
+      xml_parse(buffer.data(), int(b), 0);
+
+      tail = size - b;
+      std::copy(buffer.data()+b, buffer.data()+size, buffer.data());
+    }
+  if (tail) xml_parse(buffer.data(), int(tail), 0);
+  xml_parse("", 0, 1);
+}
+
+
 int CoreParser::error(const char* text)
 {
   // store only the first detected error
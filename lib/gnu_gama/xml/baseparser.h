@@ -28,6 +28,7 @@
 #include <Parsing/Service/xml_expat.h>
 #include <Math/Business/Core/intfloat.h>
 #include <Utilities/Service/size_to.h>
+#include <istream>
 #include <string>
 #include <list>
 
@@ -47,6 +48,12 @@ namespace GNU_gama {
     {
       xml_parse(s.c_str(), size_to<int>(s.length()), isFinal ? 1 : 0);
     }
+    /** Parses the whole file passed to expat in large chunks (memory
+     *  mapped if supported). Returns false if the file cannot be read. */
+    bool xml_parse_file(const char* file);
+    /** Parses the whole input stream passed to expat in large blocks,
+     *  used also by xml_parse_file() if the file cannot be mapped. */
+    void xml_parse_stream(std::istream& input);
     virtual int characterDataHandler(const char* s, int len) = 0;
     virtual int startElement(const char *cname, const char **atts) = 0;
     virtual int endElement(const char * name) = 0;
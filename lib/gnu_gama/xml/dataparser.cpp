@@ -21,11 +21,95 @@
 #include <gnu_gama/xml/dataparser.h>
 #include <Math/Business/Core/radian.h>
 #include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <charconv>
 
 using namespace std;
 using namespace GNU_gama;
 
 
+namespace
+{
+  inline bool space(char c)
+  {
+    return std::isspace(static_cast<unsigned char>(c));
+  }
+
+  inline const char* skip_spaces(const char* p, const char* e)
+  {
+    while (p != e && space(*p)) ++p;
+    return p;
+  }
+
+  // number from the beginning of a whitespace delimited token
+
+  template <typename T> bool scan_number(const char*& p, const char* e, T& t)
+  {
+    const char* b = skip_spaces(p, e);
+    if (b != e && *b == '+' && b+1 != e &&
+        (std::isdigit(static_cast<unsigned char>(*(b+1))) || *(b+1) == '.'))
+      ++b;
+
+    auto r = std::from_chars(b, e, t);
+    if (r.ec != std::errc() || (r.ptr != e && !space(*r.ptr))) return false;
+
+    p = r.ptr;
+    return true;
+  }
+}
+
+
+bool DataParser::scan_value(const char*& p, const char* e, double& d)
+{
+#if defined(__cpp_lib_to_chars)
+  return scan_number(p, e, d);
+#else
+  // floating point std::from_chars is not available
+
+  const char* b = skip_spaces(p, e);
+  const char* t = b;
+  while (t != e && !space(*t)) ++t;
+  if (b == t) return false;
+
+  const std::string token(b, t);
+  char* end;
+  d = std::strtod(token.c_str(), &end);
+  if (*end) return false;
+
+  p = t;
+  return true;
+#endif
+}
+
+bool DataParser::scan_value(const char*& p, const char* e, int& n)
+{
+  return scan_number(p, e, n);
+}
+
+bool DataParser::scan_value(const char*& p, const char* e, std::size_t& n)
+{
+  return scan_number(p, e, n);
+}
+
+bool DataParser::scan_value(const char*& p, const char* e, std::string& s)
+{
+  const char* b = skip_spaces(p, e);
+  const char* t = b;
+  while (t != e && !space(*t)) ++t;
+  if (b == t) return false;
+
+  s.assign(b, t);
+  p = t;
+  return true;
+}
+
+bool DataParser::scan_end(const char* p, const char* e)
+{
+  return skip_spaces(p, e) == e;
+}
+
+
 DataParser::~DataParser()
 {
   close_adj();
@@ -837,6 +837,26 @@ namespace GNU_gama {
       int  g3_get_float (const char *name, double&);
       bool pure_data(std::istream&);   // test for trailing junk in input data
 
+      // whitespace separated values are parsed directly from character
+      // data without string streams, scan_data() fails on trailing junk
+
+      static bool scan_value(const char*& p, const char* e, double&);
+      static bool scan_value(const char*& p, const char* e, int&);
+      static bool scan_value(const char*& p, const char* e, std::size_t&);
+      static bool scan_value(const char*& p, const char* e, std::string&);
+      static bool scan_end  (const char*  p, const char* e);
+
+      template <typename... T>
+      static bool scan_data(const char* p, const char* e, T&... t)
+      {
+        return (scan_value(p, e, t) && ...) && scan_end(p, e);
+      }
+      template <typename... T>
+      static bool scan_data(const std::string& s, T&... t)
+      {
+        return scan_data(s.data(), s.data() + s.size(), t...);
+      }
+
 
       // ***  DataObject::g3_model ***
 
@@ -198,8 +198,7 @@ int DataParser::sparse_mat(const char *name)
 int DataParser::sparse_mat_nonz(const char *name)
 {
   std::size_t  rows, cols;
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> rows >> cols >> adj_sparse_mat_nonz))
+  if (scan_data(text_buffer, rows, cols, adj_sparse_mat_nonz))
     {
       text_buffer.erase();
       adj_sparse_mat =
@@ -226,8 +225,7 @@ int DataParser::sparse_mat_row(const char *name)
 
 int DataParser::sparse_mat_row_n(const char *name)
 {
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> adj_sparse_mat_row_nonz))
+  if (scan_data(text_buffer, adj_sparse_mat_row_nonz))
     {
       text_buffer.erase();
       return end_tag(name);
@@ -237,11 +235,10 @@ int DataParser::sparse_mat_row_n(const char *name)
 
 int DataParser::sparse_mat_row_f(const char *name)
 {
-  istringstream inp(text_buffer.c_str());
   std::size_t  indx;
   double       flt;
   if (adj_sparse_mat_nonz-- && adj_sparse_mat_row_nonz--)
-    if (pure_data(inp >> indx >> flt))
+    if (scan_data(text_buffer, indx, flt))
       {
         adj_sparse_mat->add_element(flt, indx);
         text_buffer.erase();
@@ -262,8 +259,7 @@ int DataParser::block_diagonal(const char *name)
 
 int DataParser::block_diagonal_nonz(const char *name)
 {
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> block_diagonal_blocks_ >> block_diagonal_nonz_))
+  if (scan_data(text_buffer, block_diagonal_blocks_, block_diagonal_nonz_))
     {
       text_buffer.erase();
       adj_block_diagonal = new BlockDiagonal<>
@@ -275,9 +271,8 @@ int DataParser::block_diagonal_nonz(const char *name)
 
 int DataParser::block_diagonal_block_w(const char *name)
 {
-  istringstream inp(text_buffer.c_str());
   std::size_t dim, width;                     // unsigned
-  if (pure_data(inp >> dim >> width) && dim>0 /*&& width>=0*/ && width<dim)
+  if (scan_data(text_buffer, dim, width) && dim>0 /*&& width>=0*/ && width<dim)
     {
       block_diagonal_dim   = dim;
       block_diagonal_width = width;
@@ -297,8 +292,7 @@ int DataParser::block_diagonal_vec_flt(const char *name)
     return error("### too many <flt> elements in <block-diagonal>");
 
   double flt;
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> flt))
+  if (scan_data(text_buffer, flt))
     {
       bd_vector_dim--;
       block_diagonal_nonz_--;
@@ -338,8 +332,7 @@ int DataParser::vector(const char *name)
 
 int DataParser::vector_dim(const char *name)
 {
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> adj_vector_dim))
+  if (scan_data(text_buffer, adj_vector_dim))
     {
       text_buffer.erase();
       adj_vector.reset(adj_vector_dim);
@@ -357,8 +350,7 @@ int DataParser::vector_flt(const char *name)
     return error("### too many <flt> elements in <vector>");
 
   double flt;
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> flt))
+  if (scan_data(text_buffer, flt))
     {
       adj_vector_dim--;
       text_buffer.erase();
@@ -380,8 +372,7 @@ int DataParser::array(const char *name)
 
 int DataParser::array_dim(const char *name)
 {
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> adj_array_dim))
+  if (scan_data(text_buffer, adj_array_dim))
     {
       text_buffer.erase();
       adj_array = new IntegerList<>(adj_array_dim);
@@ -398,8 +389,7 @@ int DataParser::array_int(const char *name)
     return error("### too many <int> elements in <array>");
 
   int index;
-  istringstream inp(text_buffer.c_str());
-  if (pure_data(inp >> index))
+  if (scan_data(text_buffer, index))
     {
       adj_array_dim--;
       text_buffer.erase();
@@ -676,8 +676,7 @@ int DataParser::g3_point_l(const char *name)
 
 int DataParser::g3_point_h(const char *name)
 {
-  stringstream istr(text_buffer);
-  if (!(istr >> blh.h))
+  if (!scan_data(text_buffer, blh.h))
     {
       return error("### bad format of numerical data in <point> <h> ");
     }
@@ -692,10 +691,9 @@ int DataParser::g3_point_h(const char *name)
 
 int DataParser::g3_point_z(const char *name)
 {
-  stringstream istr(text_buffer);
   double x, y, z;
 
-  if (!(istr >> x >> y >> z))
+  if (!scan_data(text_buffer, x, y, z))
     {
       return error("### bad format of numerical data in <point> xyz ");
     }
@@ -709,10 +707,9 @@ int DataParser::g3_point_z(const char *name)
 
 int DataParser::g3_point_height(const char *name)
 {
-  stringstream istr(text_buffer);
   double h;
 
-  if (!(istr >> h))
+  if (!scan_data(text_buffer, h))
     {
       return error("### bad format of numerical data in <point> height ");
     }
@@ -726,10 +723,9 @@ int DataParser::g3_point_height(const char *name)
 
 int DataParser::g3_point_geoid(const char *name)
 {
-  stringstream istr(text_buffer);
   double g;
 
-  if (!(istr >> g))
+  if (!scan_data(text_buffer, g))
     {
       return error("### bad format of numerical data in <point> geoid ");
     }
@@ -743,10 +739,9 @@ int DataParser::g3_point_geoid(const char *name)
 
 int DataParser::g3_point_dl(const char *name)
 {
-  stringstream istr(text_buffer);
   double db, dl;
 
-  if (!(istr >> db >> dl))
+  if (!scan_data(text_buffer, db, dl))
     {
       return error("### bad format of numerical data in <point> db dl ");
     }
@@ -843,21 +838,23 @@ int DataParser::g3_obs(const char *name)
 int DataParser::g3_obs_cov(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
+  const char* p = text_buffer.data();
+  const char* e = text_buffer.data() + text_buffer.size();
   int     d, b;
   double  f;
 
-  if (!(istr >> d >> b))  return error("### bad cov-mat");
+  if (!(scan_value(p, e, d) && scan_value(p, e, b)))
+    return error("### bad cov-mat");
 
   DataParser_g3::Cov cov(d, b);
   cov.set_zero();
   for (int i=1; i<=d; i++)          // upper triangular matrix by rows
     for (int j=i; j<=i+b && j<=d; j++)
-      if (istr >> f)
+      if (scan_value(p, e, f))
         cov(i,j) = f;
       else        return error("### bad cov-mat / some data missing");
 
-  if (!pure_data(istr)) return error("### bad cov-mat / redundant data");
+  if (!scan_end(p, e)) return error("### bad cov-mat / redundant data");
 
   text_buffer.clear();
   g3->cov_list.push_back(cov);
@@ -868,11 +865,10 @@ int DataParser::g3_obs_cov(const char *name)
 int DataParser::optional_stdev(const char *s, int len)
 {
   using namespace g3;
-  stringstream istr(string(s, size_t(len))); // explicit conversion to avoid warning
   DataParser_g3::Cov   cov(1,0);
   double  f;
 
-  if (!pure_data(istr >> f)) return error("### bad <stdev>");
+  if (!scan_data(s, s+len, f)) return error("### bad <stdev>");
 
   cov(1,1) = f*f;
   g3->cov_list.push_back(cov);
@@ -883,11 +879,10 @@ int DataParser::optional_stdev(const char *s, int len)
 int DataParser::optional_variance(const char *s, int len)
 {
   using namespace g3;
-  stringstream istr(string(s, size_t(len)));
   DataParser_g3::Cov   cov(1,0);
   double  f;
 
-  if (!pure_data(istr >> f)) return error("### bad <variance>");
+  if (!scan_data(s, s+len, f)) return error("### bad <variance>");
 
   cov(1,1) = f;
   g3->cov_list.push_back(cov);
@@ -898,9 +893,8 @@ int DataParser::optional_variance(const char *s, int len)
 int DataParser::optional_from_dh(const char *s, int len)
 {
   using namespace g3;
-  stringstream istr(string(s,size_t(len)));
 
-  if (g3->model != nullptr && pure_data(istr >> g3->from_dh)) return 0;
+  if (g3->model != nullptr && scan_data(s, s+len, g3->from_dh)) return 0;
 
   return error("### bad data in <from-dh>");
 }
@@ -908,9 +902,8 @@ int DataParser::optional_from_dh(const char *s, int len)
 int DataParser::optional_to_dh(const char *s, int len)
 {
   using namespace g3;
-  stringstream istr(string(s,size_t(len)));
 
-  if (g3->model != nullptr && pure_data(istr >> g3->to_dh)) return 0;
+  if (g3->model != nullptr && scan_data(s, s+len, g3->to_dh)) return 0;
 
   return error("### bad data in <to-dh>");
 }
@@ -918,9 +911,8 @@ int DataParser::optional_to_dh(const char *s, int len)
 int DataParser::optional_left_dh(const char *s, int len)
 {
   using namespace g3;
-  stringstream istr(string(s,size_t(len)));
 
-  if (g3->model != nullptr && pure_data(istr >> g3->left_dh)) return 0;
+  if (g3->model != nullptr && scan_data(s, s+len, g3->left_dh)) return 0;
 
   return error("### bad data in <left-dh>");
 }
@@ -928,9 +920,8 @@ int DataParser::optional_left_dh(const char *s, int len)
 int DataParser::optional_right_dh(const char *s, int len)
 {
   using namespace g3;
-  stringstream istr(string(s,size_t(len)));
 
-  if (g3->model != nullptr && pure_data(istr >> g3->right_dh)) return 0;
+  if (g3->model != nullptr && scan_data(s, s+len, g3->right_dh)) return 0;
 
   return error("### bad data in <right-dh>");
 }
@@ -938,11 +929,10 @@ int DataParser::optional_right_dh(const char *s, int len)
 int DataParser::g3_obs_dist(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       from, to;
   double       val;
 
-  if (g3->model != nullptr && pure_data(istr >> from >> to >> val))
+  if (g3->model != nullptr && scan_data(text_buffer, from, to, val))
     {
       text_buffer.clear();
 
@@ -964,11 +954,10 @@ int DataParser::g3_obs_dist(const char *name)
 int DataParser::g3_obs_zenith(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       from, to;
   string       sval;
 
-  if (g3->model != nullptr && pure_data(istr >> from >> to >> sval))
+  if (g3->model != nullptr && scan_data(text_buffer, from, to, sval))
     {
       text_buffer.clear();
 
@@ -979,8 +968,8 @@ int DataParser::g3_obs_zenith(const char *name)
         }
       else
         {
-          istringstream istr(sval);
-          istr >> val;
+          const char* p = sval.c_str();
+          scan_value(p, p + sval.size(), val);
 
           g3->scale.push_back(1.0);
         }
@@ -1002,19 +991,18 @@ int DataParser::g3_obs_zenith(const char *name)
 int DataParser::g3_obs_azimuth(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       from, to;
   string       sval;
 
-  if (g3->model != nullptr && pure_data(istr >> from >> to >> sval))
+  if (g3->model != nullptr && scan_data(text_buffer, from, to, sval))
     {
       text_buffer.clear();
 
       double val;
       if (!deg2gon(sval, val))
         {
-          istringstream istr(sval);
-          istr >> val;
+          const char* p = sval.c_str();
+          scan_value(p, p + sval.size(), val);
         }
 
       Azimuth* azimuth = new Azimuth;
@@ -1034,11 +1022,10 @@ int DataParser::g3_obs_azimuth(const char *name)
 int DataParser::g3_obs_vector(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string from, to;
   double dx, dy, dz;
 
-  if (g3->model != nullptr && pure_data(istr >> from >> to >> dx >> dy >> dz))
+  if (g3->model != nullptr && scan_data(text_buffer, from, to, dx, dy, dz))
     {
       text_buffer.clear();
 
@@ -1063,11 +1050,10 @@ int DataParser::g3_obs_vector(const char *name)
 int DataParser::g3_obs_xyz(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string id;
   double x, y, z;
 
-  if (g3->model != nullptr && pure_data(istr >> id >> x >> y >> z))
+  if (g3->model != nullptr && scan_data(text_buffer, id, x, y, z))
     {
       text_buffer.clear();
 
@@ -1089,11 +1075,10 @@ int DataParser::g3_obs_xyz(const char *name)
 int DataParser::g3_obs_hdiff(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       from, to;
   double       val;
 
-  if (g3->model != nullptr && pure_data(istr >> from >> to >> val))
+  if (g3->model != nullptr && scan_data(text_buffer, from, to, val))
    {
      text_buffer.clear();
 
@@ -1115,11 +1100,10 @@ int DataParser::g3_obs_hdiff(const char *name)
 int DataParser::g3_obs_height(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       id;
   double       val;
 
-  if (g3->model != nullptr && pure_data(istr >> id >> val))
+  if (g3->model != nullptr && scan_data(text_buffer, id, val))
    {
      text_buffer.clear();
 
@@ -1138,10 +1122,9 @@ int DataParser::g3_obs_height(const char *name)
 int DataParser::g3_const_apriori_sd(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   double       sd;
 
-  if (g3->model != nullptr && pure_data(istr >> sd))
+  if (g3->model != nullptr && scan_data(text_buffer, sd))
    {
      text_buffer.clear();
 
@@ -1156,10 +1139,9 @@ int DataParser::g3_const_apriori_sd(const char *name)
 int DataParser::g3_const_conf_level(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   double       cl;
 
-  if (g3->model != nullptr && pure_data(istr >> cl))
+  if (g3->model != nullptr && scan_data(text_buffer, cl))
    {
      text_buffer.clear();
 
@@ -1174,10 +1156,9 @@ int DataParser::g3_const_conf_level(const char *name)
 int DataParser::g3_const_tol_abs(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   double       ta;
 
-  if (g3->model != nullptr && pure_data(istr >> ta))
+  if (g3->model != nullptr && scan_data(text_buffer, ta))
    {
      text_buffer.clear();
 
@@ -1192,10 +1173,9 @@ int DataParser::g3_const_tol_abs(const char *name)
 int DataParser::g3_const_ellipsoid_id(const char * /*name*/)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       s;
 
-  if (g3->model != nullptr && pure_data(istr >> s))
+  if (g3->model != nullptr && scan_data(text_buffer, s))
    {
      text_buffer.clear();
      const char* const name = s.c_str();
@@ -1212,10 +1192,9 @@ int DataParser::g3_const_ellipsoid_id(const char * /*name*/)
 int DataParser::g3_const_ellipsoid_b(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   double       a, b;
 
-  if (g3->model != nullptr && pure_data(istr >> a >> b))
+  if (g3->model != nullptr && scan_data(text_buffer, a, b))
    {
      text_buffer.clear();
 
@@ -1231,10 +1210,9 @@ int DataParser::g3_const_ellipsoid_b(const char *name)
 int DataParser::g3_const_ellipsoid_inv_f(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   double       a, inv_f;
 
-  if (g3->model != nullptr && pure_data(istr >> a >> inv_f))
+  if (g3->model != nullptr && scan_data(text_buffer, a, inv_f))
    {
      text_buffer.clear();
 
@@ -1266,11 +1244,10 @@ int DataParser::g3_const_ang_gons(const char *name)
 int DataParser::g3_obs_angle(const char *name)
 {
   using namespace g3;
-  stringstream istr(text_buffer);
   string       from, left, right;
   string       sval;
 
-  if (g3->model != nullptr && pure_data(istr >> from >> left >> right >> sval))
+  if (g3->model != nullptr && scan_data(text_buffer, from, left, right, sval))
    {
      text_buffer.clear();
 
@@ -1281,8 +1258,8 @@ int DataParser::g3_obs_angle(const char *name)
        }
      else
        {
-          istringstream istr(sval);
-          istr >> val;
+          const char* p = sval.c_str();
+          scan_value(p, p + sval.size(), val);
 
           g3->scale.push_back(1.0);
        }
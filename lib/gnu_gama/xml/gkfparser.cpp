@@ -22,6 +22,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <exception>
 #include <fstream>
 #include <string>
 #include <utility>
@@ -59,9 +60,13 @@ namespace GKFparser
 class GKFparserImpl : public GNU_gama::BaseParser<ParserException>
 {
 public:
-    GKFparserImpl(GNU_gama::local::LocalNetwork& locnet);
+    GKFparserImpl(GNU_gama::local::LocalNetwork& locnet,
+                  const ClusterHandler& handler = ClusterHandler());
     ~GKFparserImpl();
 
+    /** exception thrown by the cluster handler, if any */
+    std::exception_ptr handler_exception() const { return m_handler_exception; }
+
 private:
     int characterDataHandler(const char* s, int len) final;
     int startElement(const char* cname, const char** atts) final;
@@ -83,6 +88,10 @@ private:
     GNU_gama::local::ObservationData& m_OD;  // observation list
     std::string m_description;  // network description
 
+    ClusterHandler     m_cluster_handler;
+    std::exception_ptr m_handler_exception;
+    int cluster_finished(GNU_gama::Cluster<Observation>* cluster);
+
     enum gkf_tag
     {
         tag_unknown,
@@ -237,7 +246,6 @@ int GKFparserImpl::characterDataHandler(const char* s, int len)
     {
         m_cov_mat_data += std::string(s, len);
         m_cov_mat_data += '\n';
-        std::cout << m_cov_mat_data << std::endl;
     }
     else
     {
@@ -246,7 +254,7 @@ int GKFparserImpl::characterDataHandler(const char* s, int len)
         while(b < len && isspace(s[b])) b++;
         if(b == len) return 0;
 
-        error(T_GKF_illegal_text);
+        error(m_lnet.texts().T_GKF_illegal_text);
     }
     
     return 0;
@@ -265,14 +273,14 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         switch(ntag)
         {
         case tag_gama_xml: return process_gama_xml(atts);
-        default: return error(T_GKF_must_start_with_gama_xml);
+        default: return error(m_lnet.texts().T_GKF_must_start_with_gama_xml);
         }
 
     case state_gama_xml:
         switch(ntag)
         {
         case tag_network: return process_network(atts);
-        default: return error(T_GKF_missing_tag_network);
+        default: return error(m_lnet.texts().T_GKF_missing_tag_network);
         }
 
     case state_network:
@@ -283,7 +291,7 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         case tag_points_observations: return process_point_obs(atts);
         default:
             return error(
-                T_GKF_e01a_illegal_tag + string(cname) + T_GKF_e01b_after_tag + " <network>");
+                m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + m_lnet.texts().T_GKF_e01b_after_tag + " <network>");
         }
 
     case state_point_obs:
@@ -296,7 +304,7 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         case tag_vectors: return process_vectors(atts);
         default:
             return error(
-                T_GKF_e01a_illegal_tag + string(cname) + T_GKF_e01b_after_tag
+                m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + m_lnet.texts().T_GKF_e01b_after_tag
                 + " <points-observations>");
         }
 
@@ -311,7 +319,7 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         case tag_azimuth: return process_azimuth(atts);
         case tag_cov_mat: return process_obs_cov(atts);
         default:
-            return error(T_GKF_e01a_illegal_tag + string(cname) + T_GKF_e01b_after_tag + " <obs>");
+            return error(m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + m_lnet.texts().T_GKF_e01b_after_tag + " <obs>");
         }
 
     case state_coords:
@@ -321,7 +329,7 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         case tag_cov_mat: return process_coords_cov(atts);
         default:
             return error(
-                T_GKF_e01a_illegal_tag + string(cname) + T_GKF_e01b_after_tag + " <coordinates>");
+                m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + m_lnet.texts().T_GKF_e01b_after_tag + " <coordinates>");
         }
 
     case state_hdiffs:
@@ -331,7 +339,7 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         case tag_cov_mat: return process_hdiffs_cov(atts);
         default:
             return error(
-                T_GKF_e01a_illegal_tag + string(cname) + T_GKF_e01b_after_tag
+                m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + m_lnet.texts().T_GKF_e01b_after_tag
                 + " <height-differences>");
         }
 
@@ -340,16 +348,16 @@ int GKFparserImpl::startElement(const char* cname, const char** atts)
         {
         case tag_vec: return process_vec(atts);
         case tag_cov_mat: return process_vectors_cov(atts);
-        default: return error(T_GKF_e01a_illegal_tag + string(cname) + ">");
+        default: return error(m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + ">");
         }
 
     case state_obs_after_cov:
     case state_coords_after_cov:
     case state_hdiffs_after_cov:
-    case state_vectors_after_cov: { return error(T_GKF_no_observations_after_cov_mat);
+    case state_vectors_after_cov: { return error(m_lnet.texts().T_GKF_no_observations_after_cov_mat);
     }
 
-    default: return error(T_GKF_e01a_illegal_tag + string(cname) + ">");
+    default: return error(m_lnet.texts().T_GKF_e01a_illegal_tag + string(cname) + ">");
     }
 
     return 0;
@@ -478,7 +486,9 @@ GKFparserImpl::gkf_tag GKFparserImpl::tag(const char* c)
 
 
 
-GKFparserImpl::GKFparserImpl(GNU_gama::local::LocalNetwork& locnet) : m_lnet(locnet), m_SB(m_lnet.PD), m_OD(m_lnet.OD)
+GKFparserImpl::GKFparserImpl(GNU_gama::local::LocalNetwork& locnet,
+                             const ClusterHandler& handler)
+    : m_lnet(locnet), m_SB(m_lnet.PD), m_OD(m_lnet.OD), m_cluster_handler(handler)
 {
     m_lnet.apriori_m_0(10);
     m_lnet.conf_pr(0.95);
@@ -523,7 +533,7 @@ int GKFparserImpl::process_gama_xml(const char** atts)
         }
         else
         {
-            return error(T_GKF_undefined_attribute_of_gama_xml + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_gama_xml + nam + " = " + val);
         }
     }
 
@@ -565,7 +575,7 @@ int GKFparserImpl::process_network(const char** atts)
             else if(val == "ws")
                 lcs = LocalCoordinateSystem::CS::WS;
             else
-                return error(T_GKF_undefined_value_of_attribute + nam + " = " + val);
+                return error(m_lnet.texts().T_GKF_undefined_value_of_attribute + nam + " = " + val);
         }
         else if(nam == "angles")
         {
@@ -574,18 +584,18 @@ int GKFparserImpl::process_network(const char** atts)
             else if(val == "left-handed")
                 m_SB.setAngularObservations_Lefthanded();
             else
-                return error(T_GKF_undefined_value_of_attribute + nam + " = " + val);
+                return error(m_lnet.texts().T_GKF_undefined_value_of_attribute + nam + " = " + val);
         }
         else if(nam == "epoch")
         {
             double epoch;
             if(!toDouble(val, epoch))
-                return error(T_GKF_error_on_reading_of_epoch + nam + " = " + val);
+                return error(m_lnet.texts().T_GKF_error_on_reading_of_epoch + nam + " = " + val);
             m_lnet.set_epoch(epoch);
         }
         else
         {
-            return error(T_GKF_undefined_attribute_of_gama_xml + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_gama_xml + nam + " = " + val);
         }
     }
 
@@ -607,24 +617,24 @@ int GKFparserImpl::process_parameters(const char** atts)
 
         if(jmeno == "sigma-apr")
         {
-            if(!toDouble(hodnota, dhod)) return error(T_GKF_error_on_reading_of_standard_deviation);
-            if(dhod <= 0) return error(T_GKF_error_on_reading_of_standard_deviation);
+            if(!toDouble(hodnota, dhod)) return error(m_lnet.texts().T_GKF_error_on_reading_of_standard_deviation);
+            if(dhod <= 0) return error(m_lnet.texts().T_GKF_error_on_reading_of_standard_deviation);
 
             m_lnet.apriori_m_0(dhod);
         }
         else if(jmeno == "conf-pr")
         {
             if(!toDouble(hodnota, dhod))
-                return error(T_GKF_error_on_reading_of_confidence_probability);
-            if(dhod <= 0) return error(T_GKF_error_on_reading_of_confidence_probability);
+                return error(m_lnet.texts().T_GKF_error_on_reading_of_confidence_probability);
+            if(dhod <= 0) return error(m_lnet.texts().T_GKF_error_on_reading_of_confidence_probability);
 
             m_lnet.conf_pr(dhod);
         }
         else if(jmeno == "tol-abs")
         {
             if(!toDouble(hodnota, dhod))
-                return error(T_GKF_error_on_reading_of_absolute_terms_tolerance);
-            if(dhod <= 0) return error(T_GKF_error_on_reading_of_absolute_terms_tolerance);
+                return error(m_lnet.texts().T_GKF_error_on_reading_of_absolute_terms_tolerance);
+            if(dhod <= 0) return error(m_lnet.texts().T_GKF_error_on_reading_of_absolute_terms_tolerance);
 
             m_lnet.tol_abs(dhod);
         }
@@ -635,7 +645,7 @@ int GKFparserImpl::process_parameters(const char** atts)
             else if(hodnota == "apriori")
                 m_lnet.set_m_0_apriori();
             else
-                return error(T_GKF_wrong_type_of_standard_deviation);
+                return error(m_lnet.texts().T_GKF_wrong_type_of_standard_deviation);
         }
         else if(jmeno == "angles")
         {
@@ -644,7 +654,7 @@ int GKFparserImpl::process_parameters(const char** atts)
             else if(hodnota == "360")
                 m_lnet.set_degrees();
             else
-                error(T_GKF_bad_network_configuration_unknown_parameter + jmeno + " = " + hodnota);
+                error(m_lnet.texts().T_GKF_bad_network_configuration_unknown_parameter + jmeno + " = " + hodnota);
         }
         else if(jmeno == "algorithm")
         {
@@ -656,12 +666,14 @@ int GKFparserImpl::process_parameters(const char** atts)
                 m_lnet.set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::cholesky);
             else if(hodnota == "envelope")
                 m_lnet.set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::envelope);
+            else if(hodnota == "supernodal")
+                m_lnet.set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::supernodal);
         }
         else if(jmeno == "cov-band")
         {
             int ival;
             if(!toInteger(hodnota, ival))
-                return error(T_GKF_undefined_value_of_attribute + jmeno + " = " + hodnota);
+                return error(m_lnet.texts().T_GKF_undefined_value_of_attribute + jmeno + " = " + hodnota);
 
             m_lnet.set_adj_covband(ival);
         }
@@ -671,7 +683,7 @@ int GKFparserImpl::process_parameters(const char** atts)
             if(!GNU_gama::deg2gon(hodnota, dm))
             {
                 if(!toDouble(hodnota, dm))
-                    return error(T_GKF_undefined_value_of_attribute + jmeno + " = " + hodnota);
+                    return error(m_lnet.texts().T_GKF_undefined_value_of_attribute + jmeno + " = " + hodnota);
             }
             m_lnet.set_latitude(dm * GNU_gama::PI / 200);
         }
@@ -681,7 +693,7 @@ int GKFparserImpl::process_parameters(const char** atts)
         }
         else
         {
-            return error(T_GKF_bad_network_configuration_unknown_parameter + jmeno + " = " + hodnota);
+            return error(m_lnet.texts().T_GKF_bad_network_configuration_unknown_parameter + jmeno + " = " + hodnota);
         }
     }
 
@@ -734,7 +746,7 @@ int GKFparserImpl::process_point_obs(const char** atts)
             }
             while(i != val.end() && isspace(*i)) ++i;
 
-            if(i != val.end()) return error(T_GKF_bad_attribute_distance_dev + sds_abc);
+            if(i != val.end()) return error(m_lnet.texts().T_GKF_bad_attribute_distance_dev + sds_abc);
         }
         else if(nam == "direction-stdev")
             str_dir = val;
@@ -745,7 +757,7 @@ int GKFparserImpl::process_point_obs(const char** atts)
         else if(nam == "azimuth-stdev")
             str_azi = val;
         else
-            return error(T_GKF_undefined_attribute_of_points_observations + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_points_observations + nam + " = " + val);
     }
 
     if(sds == "") sds = "0";
@@ -753,12 +765,12 @@ int GKFparserImpl::process_point_obs(const char** atts)
     if(sde == "") sde = "1";
     if(!toDouble(sds, distance_stdev_) || !toDouble(sdk, distance_stdev_km_)
        || !toDouble(sde, distance_stdev_exp_))
-        return error(T_GKF_bad_attribute_distance_dev + sds_abc);
+        return error(m_lnet.texts().T_GKF_bad_attribute_distance_dev + sds_abc);
     if(!toDouble(str_dir, direction_stdev_))
-        return error(T_GKF_bad_attribute_direction_dev + str_dir);
-    if(!toDouble(str_ang, angle_stdev_)) return error(T_GKF_bad_attribute_angle_dev + str_ang);
-    if(!toDouble(str_zen, zenith_stdev_)) return error(T_GKF_bad_attribute_angle_dev + str_zen);
-    if(!toDouble(str_azi, azimuth_stdev_)) return error(T_GKF_bad_attribute_angle_dev + str_azi);
+        return error(m_lnet.texts().T_GKF_bad_attribute_direction_dev + str_dir);
+    if(!toDouble(str_ang, angle_stdev_)) return error(m_lnet.texts().T_GKF_bad_attribute_angle_dev + str_ang);
+    if(!toDouble(str_zen, zenith_stdev_)) return error(m_lnet.texts().T_GKF_bad_attribute_angle_dev + str_zen);
+    if(!toDouble(str_azi, azimuth_stdev_)) return error(m_lnet.texts().T_GKF_bad_attribute_angle_dev + str_azi);
 
     return 0;
 }
@@ -789,22 +801,22 @@ int GKFparserImpl::process_point(const char** atts)
         else if(nam == "adj")
             sa = val;
         else
-            return error(T_GKF_undefined_attribute_of_points + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_points + nam + " = " + val);
     }
 
-    if(m_pp_id == "") return error(T_GKF_missing_point_ID);
+    if(m_pp_id == "") return error(m_lnet.texts().T_GKF_missing_point_ID);
 
-    if(sy != "" && sx == "") return error(T_GKF_coordinate_x_is_not_defined);
-    if(sx != "" && sy == "") return error(T_GKF_coordinate_y_is_not_defined);
+    if(sy != "" && sx == "") return error(m_lnet.texts().T_GKF_coordinate_x_is_not_defined);
+    if(sx != "" && sy == "") return error(m_lnet.texts().T_GKF_coordinate_y_is_not_defined);
 
     if(sx != "")
     {
         double dy, dx;
-        if(!toDouble(sx, dx)) return error(T_GKF_bad_coordinate_x + sx);
-        if(!toDouble(sy, dy)) return error(T_GKF_bad_coordinate_y + sy);
+        if(!toDouble(sx, dx)) return error(m_lnet.texts().T_GKF_bad_coordinate_x + sx);
+        if(!toDouble(sy, dy)) return error(m_lnet.texts().T_GKF_bad_coordinate_y + sy);
         m_SB[m_pp_id].set_xy(dx, dy);
 
-        if(m_pp_xydef) return error(T_GKF_multiple_definition_of_xy_in_tag_point);
+        if(m_pp_xydef) return error(m_lnet.texts().T_GKF_multiple_definition_of_xy_in_tag_point);
         m_pp_x = dx;
         m_pp_y = dy;
         m_pp_xydef = true;
@@ -813,10 +825,10 @@ int GKFparserImpl::process_point(const char** atts)
     if(sv != "")
     {
         double dz;
-        if(!toDouble(sv, dz)) return error(T_GKF_bad_height + sv);
+        if(!toDouble(sv, dz)) return error(m_lnet.texts().T_GKF_bad_height + sv);
         m_SB[m_pp_id].set_z(dz);
 
-        if(m_pp_zdef) return error(T_GKF_multiple_definition_of_z_in_tag_point);
+        if(m_pp_zdef) return error(m_lnet.texts().T_GKF_multiple_definition_of_z_in_tag_point);
         m_pp_z = dz;
         m_pp_zdef = true;
     }
@@ -840,7 +852,7 @@ int GKFparserImpl::process_point(const char** atts)
         else if(sa == "Z")
             m_SB[m_pp_id].set_constrained_z();
         else
-            return error(T_GKF_undefined_point_type + sa);
+            return error(m_lnet.texts().T_GKF_undefined_point_type + sa);
     }
 
     if(sf != "")
@@ -862,7 +874,7 @@ int GKFparserImpl::process_point(const char** atts)
         else if(sf == "Z")
             m_SB[m_pp_id].set_fixed_z();
         else
-            return error(T_GKF_undefined_point_type + sf);
+            return error(m_lnet.texts().T_GKF_undefined_point_type + sf);
     }
 
     return 0;
@@ -894,24 +906,24 @@ int GKFparserImpl::process_distance(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_distance + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_distance + nam + " = " + val);
     }
 
-    if(ss == "") return error(T_GKF_missing_standpoint_id);
-    if(sc == "") return error(T_GKF_missing_forepoint_id);
-    if(sm == "") return error(T_GKF_missing_observed_value);
+    if(ss == "") return error(m_lnet.texts().T_GKF_missing_standpoint_id);
+    if(sc == "") return error(m_lnet.texts().T_GKF_missing_forepoint_id);
+    if(sm == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
-    if(!toDouble(sm, dm)) return error(T_GKF_bad_distance + sm);
+    if(!toDouble(sm, dm)) return error(m_lnet.texts().T_GKF_bad_distance + sm);
     double dv = implicit_stdev_distance(dm);
     if(sv != "")
-        if(!toDouble(sv, dv)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(sv, dv)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
     double df = obs_from_dh;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
 
     try
     {
@@ -971,32 +983,32 @@ int GKFparserImpl::process_angle(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_angle + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_angle + nam + " = " + val);
     }
 
-    if(ss == "") return error(T_GKF_missing_standpoint_id);
-    if(sl == "") return error(T_GKF_missing_left_forepoint_id);
-    if(sp == "") return error(T_GKF_missing_right_forepoint_id);
-    if(sm == "") return error(T_GKF_missing_observed_value);
+    if(ss == "") return error(m_lnet.texts().T_GKF_missing_standpoint_id);
+    if(sl == "") return error(m_lnet.texts().T_GKF_missing_left_forepoint_id);
+    if(sp == "") return error(m_lnet.texts().T_GKF_missing_right_forepoint_id);
+    if(sm == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
     if(GNU_gama::deg2gon(sm, dm))
         degrees = true;
     else if(!toDouble(sm, dm))
-        return error(T_GKF_bad_angle + sm);
+        return error(m_lnet.texts().T_GKF_bad_angle + sm);
 
     double dv = implicit_stdev_angle();
     if(sv != "")
-        if(!toDouble(sv, dv)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(sv, dv)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
     double df = obs_from_dh;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
     double d2 = 0;
     if(h2 != "")
-        if(!toDouble(h2, d2)) return error(T_GKF_bad_instrument_reflector_height + h2);
+        if(!toDouble(h2, d2)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + h2);
 
     try
     {
@@ -1046,24 +1058,24 @@ int GKFparserImpl::process_sdistance(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_slopedist + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_slopedist + nam + " = " + val);
     }
 
-    if(ss == "") return error(T_GKF_missing_standpoint_id);
-    if(sc == "") return error(T_GKF_missing_forepoint_id);
-    if(sm == "") return error(T_GKF_missing_observed_value);
+    if(ss == "") return error(m_lnet.texts().T_GKF_missing_standpoint_id);
+    if(sc == "") return error(m_lnet.texts().T_GKF_missing_forepoint_id);
+    if(sm == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
-    if(!toDouble(sm, dm)) return error(T_GKF_bad_distance + sm);
+    if(!toDouble(sm, dm)) return error(m_lnet.texts().T_GKF_bad_distance + sm);
     double dv = implicit_stdev_distance(dm);
     if(sv != "")
-        if(!toDouble(sv, dv)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(sv, dv)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
     double df = obs_from_dh;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
 
     try
     {
@@ -1114,28 +1126,28 @@ int GKFparserImpl::process_zangle(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_zangle + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_zangle + nam + " = " + val);
     }
 
-    if(ss == "") return error(T_GKF_missing_standpoint_id);
-    if(sc == "") return error(T_GKF_missing_forepoint_id);
-    if(sm == "") return error(T_GKF_missing_observed_value);
+    if(ss == "") return error(m_lnet.texts().T_GKF_missing_standpoint_id);
+    if(sc == "") return error(m_lnet.texts().T_GKF_missing_forepoint_id);
+    if(sm == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
     if(GNU_gama::deg2gon(sm, dm))
         degrees = true;
     else if(!toDouble(sm, dm))
-        return error(T_GKF_bad_zangle + sm);
+        return error(m_lnet.texts().T_GKF_bad_zangle + sm);
 
     double dv = implicit_stdev_zangle();
     if(sv != "")
-        if(!toDouble(sv, dv)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(sv, dv)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
     double df = obs_from_dh;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
 
     try
     {
@@ -1179,7 +1191,7 @@ int GKFparserImpl::process_obs(const char** atts)
         else if(nam == "from_dh")
             sh = val;
         else
-            return error(T_GKF_undefined_attribute_of_obs + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_obs + nam + " = " + val);
     }
 
     m_idim = 0;
@@ -1189,12 +1201,12 @@ int GKFparserImpl::process_obs(const char** atts)
     if(sz != "")
     {
         double dz;
-        if(!toDouble(sz, dz)) return error(T_GKF_bad_orientation_angle + sz);
+        if(!toDouble(sz, dz)) return error(m_lnet.texts().T_GKF_bad_orientation_angle + sz);
         standpoint->set_orientation(dz);
     }
     if(sh != "")
     {
-        if(!toDouble(sh, obs_from_dh)) return error(T_GKF_bad_instrument_reflector_height + sh);
+        if(!toDouble(sh, obs_from_dh)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + sh);
     }
     m_OD.clusters.push_back(standpoint);
 
@@ -1234,14 +1246,15 @@ int GKFparserImpl::finish_obs()
         }
         catch(...)
         {
-            return error(T_GKF_covariance_matrix_is_not_positive_definite);
+            return error(m_lnet.texts().T_GKF_covariance_matrix_is_not_positive_definite);
         }
     }
 
+    GNU_gama::Cluster<Observation>* cluster = standpoint;
     standpoint = 0;
     standpoint_id = "";
     m_sigma.erase(m_sigma.begin(), m_sigma.end());
-    return 0;
+    return cluster_finished(cluster);
 }
 
 
@@ -1270,28 +1283,28 @@ int GKFparserImpl::process_direction(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_direction + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_direction + nam + " = " + val);
     }
 
-    if(standpoint_id == "") return error(T_GKF_missing_standpoint_id);
-    if(sc == "") return error(T_GKF_missing_forepoint_id);
-    if(sm == "") return error(T_GKF_missing_observed_value);
+    if(standpoint_id == "") return error(m_lnet.texts().T_GKF_missing_standpoint_id);
+    if(sc == "") return error(m_lnet.texts().T_GKF_missing_forepoint_id);
+    if(sm == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
     if(GNU_gama::deg2gon(sm, dm))
         degrees = true;
     else if(!toDouble(sm, dm))
-        return error(T_GKF_bad_direction + sm);
+        return error(m_lnet.texts().T_GKF_bad_direction + sm);
 
     double ds = implicit_stdev_direction();
     if(ss != "")
-        if(!toDouble(ss, ds)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(ss, ds)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
     double df = obs_from_dh;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
 
     try
     {
@@ -1338,28 +1351,28 @@ int GKFparserImpl::process_azimuth(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_azimuth + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_azimuth + nam + " = " + val);
     }
 
-    if(ss == "") return error(T_GKF_missing_standpoint_id);
-    if(sc == "") return error(T_GKF_missing_forepoint_id);
-    if(sm == "") return error(T_GKF_missing_observed_value);
+    if(ss == "") return error(m_lnet.texts().T_GKF_missing_standpoint_id);
+    if(sc == "") return error(m_lnet.texts().T_GKF_missing_forepoint_id);
+    if(sm == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
     if(GNU_gama::deg2gon(sm, dm))
         degrees = true;
     else if(!toDouble(sm, dm))
-        return error(T_GKF_bad_azimuth + sm);
+        return error(m_lnet.texts().T_GKF_bad_azimuth + sm);
 
     double ds = implicit_stdev_azimuth();
     if(sv != "")
-        if(!toDouble(sv, ds)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(sv, ds)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
     double df = obs_from_dh;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
 
     try
     {
@@ -1393,18 +1406,18 @@ int GKFparserImpl::process_cov(const char** atts)
         else if(nam == "band")
             sband = val;
         else
-            return error(T_GKF_undefined_attribute_of_cov_mat + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_cov_mat + nam + " = " + val);
     }
 
-    if(sdim == "") return error(T_GKF_cov_mat_missing_dim);
-    if(sband == "") return error(T_GKF_cov_mat_missing_band_width);
+    if(sdim == "") return error(m_lnet.texts().T_GKF_cov_mat_missing_dim);
+    if(sband == "") return error(m_lnet.texts().T_GKF_cov_mat_missing_band_width);
 
-    if(!toIndex(sdim, m_idim)) return error(T_GKF_cov_mat_bad_dim + nam + " = " + val);
-    if(!toIndex(sband, m_iband)) return error(T_GKF_cov_mat_bad_band_width + nam + " = " + val);
+    if(!toIndex(sdim, m_idim)) return error(m_lnet.texts().T_GKF_cov_mat_bad_dim + nam + " = " + val);
+    if(!toIndex(sband, m_iband)) return error(m_lnet.texts().T_GKF_cov_mat_bad_band_width + nam + " = " + val);
 
-    if(m_idim < 1) return error(T_GKF_cov_mat_bad_dim + nam + " = " + val);
+    if(m_idim < 1) return error(m_lnet.texts().T_GKF_cov_mat_bad_dim + nam + " = " + val);
     if(isNegative(m_iband) || m_iband >= m_idim)
-        return error(T_GKF_cov_mat_bad_band_width + nam + " = " + val);
+        return error(m_lnet.texts().T_GKF_cov_mat_bad_band_width + nam + " = " + val);
 
     return 0;
 }
@@ -1429,9 +1442,9 @@ int GKFparserImpl::finish_cov(CovMat& cov_mat)
         }
         if(w.size())
         {
-            if(elements == 0) return error(T_GKF_cov_mat_bad_dim_too_many_elements);
+            if(elements == 0) return error(m_lnet.texts().T_GKF_cov_mat_bad_dim_too_many_elements);
             double d;
-            if(!toDouble(w, d)) return error(T_GKF_cov_mat_bad_element);
+            if(!toDouble(w, d)) return error(m_lnet.texts().T_GKF_cov_mat_bad_element);
             cov_mat(row, col) = d;
             elements--;
             col++;
@@ -1439,7 +1452,7 @@ int GKFparserImpl::finish_cov(CovMat& cov_mat)
         }
     }
 
-    if(elements) return error(T_GKF_cov_mat_bad_dim_not_enough_elements);
+    if(elements) return error(m_lnet.texts().T_GKF_cov_mat_bad_dim_not_enough_elements);
 
     m_idim = 0;
     m_cov_mat_data = "";
@@ -1460,7 +1473,7 @@ int GKFparserImpl::process_coords(const char** atts)
         if(nam == "extern") { ext = val; }
         else
         {
-            return error(T_GKF_undefined_attribute_of_coordinates + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_coordinates + nam + " = " + val);
         }
     }
 
@@ -1475,9 +1488,9 @@ int GKFparserImpl::process_coords(const char** atts)
 
 int GKFparserImpl::finish_coords()
 {
-    if(!m_idim) return error(T_GKF_coordinates_without_covariance_matrix);
+    if(!m_idim) return error(m_lnet.texts().T_GKF_coordinates_without_covariance_matrix);
     if(m_idim != size_to<int>(coordinates->observation_list.size()))
-        return error("T_GKF_cov_dim_differs_from_number_of_coordinates");
+        return error("m_lnet.texts().T_GKF_cov_dim_differs_from_number_of_coordinates");
 
     coordinates->update();
     finish_cov(coordinates->covariance_matrix);
@@ -1487,17 +1500,17 @@ int GKFparserImpl::finish_coords()
         try
         {
             CovMat tmp = coordinates->covariance_matrix;
-            std::cout << tmp ;
             tmp.cholDec();
         }
         catch(...)
         {
-            return error(T_GKF_covariance_matrix_is_not_positive_definite);
+            return error(m_lnet.texts().T_GKF_covariance_matrix_is_not_positive_definite);
         }
     }
 
+    GNU_gama::Cluster<Observation>* cluster = coordinates;
     coordinates = 0;
-    return 0;
+    return cluster_finished(cluster);
 }
 
 
@@ -1507,7 +1520,7 @@ int GKFparserImpl::process_coords_point(const char** atts)
     state = state_coords_point;  // we must reset state here !!!
 
     if(!m_pp_xydef && !m_pp_zdef)
-        return error(T_GKF_point_must_define_xy_andor_z_inside_tag_coordinates);
+        return error(m_lnet.texts().T_GKF_point_must_define_xy_andor_z_inside_tag_coordinates);
 
     if(m_pp_xydef)
     {
@@ -1529,7 +1542,7 @@ int GKFparserImpl::process_hdiffs(const char** atts)
         string nam, val;
         nam = string(*atts++);
         val = string(*atts++);
-        return error(T_GKF_undefined_attribute_of_height_differences + nam + " = " + val);
+        return error(m_lnet.texts().T_GKF_undefined_attribute_of_height_differences + nam + " = " + val);
     }
 
     heightdifferences = new HeightDifferences(&m_OD);
@@ -1562,14 +1575,15 @@ int GKFparserImpl::finish_hdiffs()
         }
         catch(...)
         {
-            return error(T_GKF_covariance_matrix_is_not_positive_definite);
+            return error(m_lnet.texts().T_GKF_covariance_matrix_is_not_positive_definite);
         }
     }
 
+    GNU_gama::Cluster<Observation>* cluster = heightdifferences;
     heightdifferences = 0;
     m_sigma.erase(m_sigma.begin(), m_sigma.end());
 
-    return 0;
+    return cluster_finished(cluster);
 }
 
 int GKFparserImpl::process_dh(const char** atts)
@@ -1595,21 +1609,21 @@ int GKFparserImpl::process_dh(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_height_differences + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_height_differences + nam + " = " + val);
     }
 
-    if(sfrom == "") return error(T_GKF_missing_from_ID);
-    if(sto == "") return error(T_GKF_missing_to_ID);
-    if(sval == "") return error(T_GKF_missing_observed_value);
+    if(sfrom == "") return error(m_lnet.texts().T_GKF_missing_from_ID);
+    if(sto == "") return error(m_lnet.texts().T_GKF_missing_to_ID);
+    if(sval == "") return error(m_lnet.texts().T_GKF_missing_observed_value);
 
     double dm;
-    if(!toDouble(sval, dm)) return error(T_GKF_bad_height_diff + sval);
+    if(!toDouble(sval, dm)) return error(m_lnet.texts().T_GKF_bad_height_diff + sval);
     double dd = 0;
     if(sdist != "")
-        if(!toDouble(sdist, dd) || dd < 0) return error(T_GKF_bad_distance + sdist);
+        if(!toDouble(sdist, dd) || dd < 0) return error(m_lnet.texts().T_GKF_bad_distance + sdist);
     double ds = m_lnet.apriori_m_0() * sqrt(dd);
     if(sstdev != "")
-        if(!toDouble(sstdev, ds)) return error(T_GKF_illegal_standard_deviation);
+        if(!toDouble(sstdev, ds)) return error(m_lnet.texts().T_GKF_illegal_standard_deviation);
 
     try
     {
@@ -1636,7 +1650,7 @@ int GKFparserImpl::process_vectors(const char** atts)
         string nam, val;
         nam = string(*atts++);
         val = string(*atts++);
-        return error(T_GKF_undefined_attribute_of_vectors + nam + " = " + val);
+        return error(m_lnet.texts().T_GKF_undefined_attribute_of_vectors + nam + " = " + val);
     }
 
     vectors = new Vectors(&m_OD);
@@ -1648,9 +1662,9 @@ int GKFparserImpl::process_vectors(const char** atts)
 
 int GKFparserImpl::finish_vectors()
 {
-    if(!m_idim) return error(T_GKF_vectors_without_covariance_matrix);
+    if(!m_idim) return error(m_lnet.texts().T_GKF_vectors_without_covariance_matrix);
     if(m_idim != size_to<int>(vectors->observation_list.size()))
-        return error("T_GKF_cov_dim_differs_from_number_of_vectors");
+        return error("m_lnet.texts().T_GKF_cov_dim_differs_from_number_of_vectors");
 
     vectors->update();  // bind observations to the cluster
     finish_cov(vectors->covariance_matrix);
@@ -1664,11 +1678,36 @@ int GKFparserImpl::finish_vectors()
         }
         catch(...)
         {
-            return error(T_GKF_covariance_matrix_is_not_positive_definite);
+            return error(m_lnet.texts().T_GKF_covariance_matrix_is_not_positive_definite);
         }
     }
 
+    GNU_gama::Cluster<Observation>* cluster = vectors;
     vectors = 0;
+    return cluster_finished(cluster);
+}
+
+
+int GKFparserImpl::cluster_finished(GNU_gama::Cluster<Observation>* cluster)
+{
+    if(!m_cluster_handler) return 0;
+
+    // exceptions must not be thrown through expat callbacks
+    try
+    {
+        m_cluster_handler(cluster);
+    }
+    catch(const std::exception& e)
+    {
+        m_handler_exception = std::current_exception();
+        return error(e.what());
+    }
+    catch(...)
+    {
+        m_handler_exception = std::current_exception();
+        return error("cluster handler failed");
+    }
+
     return 0;
 }
 
@@ -1700,22 +1739,22 @@ int GKFparserImpl::process_vec(const char** atts)
         else if(nam == "extern")
             ex = val;
         else
-            return error(T_GKF_undefined_attribute_of_height_differences + nam + " = " + val);
+            return error(m_lnet.texts().T_GKF_undefined_attribute_of_height_differences + nam + " = " + val);
     }
 
-    if(sfrom == "") return error(T_GKF_missing_from_ID);
-    if(sto == "") return error(T_GKF_missing_to_ID);
-    if(sdx == "" || sdy == "" || sdz == "") return error(T_GKF_bad_vector_data);
+    if(sfrom == "") return error(m_lnet.texts().T_GKF_missing_from_ID);
+    if(sto == "") return error(m_lnet.texts().T_GKF_missing_to_ID);
+    if(sdx == "" || sdy == "" || sdz == "") return error(m_lnet.texts().T_GKF_bad_vector_data);
 
     double dx, dy, dz;
     if(!toDouble(sdx, dx) || !toDouble(sdy, dy) || !toDouble(sdz, dz))
-        return error(T_GKF_bad_vector_data);
+        return error(m_lnet.texts().T_GKF_bad_vector_data);
     double df = 0;
     if(hf != "")
-        if(!toDouble(hf, df)) return error(T_GKF_bad_instrument_reflector_height + hf);
+        if(!toDouble(hf, df)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + hf);
     double dt = 0;
     if(ht != "")
-        if(!toDouble(ht, dt)) return error(T_GKF_bad_instrument_reflector_height + ht);
+        if(!toDouble(ht, dt)) return error(m_lnet.texts().T_GKF_bad_instrument_reflector_height + ht);
 
     try
     {
@@ -1753,20 +1792,33 @@ std::istream& operator>>(std::istream& input, GNU_gama::local::LocalNetwork& net
     // in a tmp network and if it succeds, then we move it to the one passed.
     // Now if parsing fails, we leave the input network in a non valid state
 
+    // empty or unreadable input leaves the network unchanged
+    if(input.peek() == std::istream::traits_type::eof()) return input;
+
     GKFparserImpl gkf(network);
-        
-    std::string line;
-    while(std::getline(input, line, input.widen('\n')))
-    {
-        if(!line.empty())
-        {
-            gkf.xml_parse(line.c_str(), line.size(), !input ? 1 : 0); 
-        }
-    } 
+    gkf.xml_parse_stream(input);
 
     return input;
 }
 
+void read(std::istream& input, GNU_gama::local::LocalNetwork& network,
+          const ClusterHandler& handler)
+{
+    if(input.peek() == std::istream::traits_type::eof()) return;
+
+    GKFparserImpl gkf(network, handler);
+
+    try
+    {
+        gkf.xml_parse_stream(input);
+    }
+    catch(const ParserException&)
+    {
+        if(gkf.handler_exception()) std::rethrow_exception(gkf.handler_exception());
+        throw;
+    }
+}
+
 }  // namespace GKFparser
 }  // namespace local
 }  // namespace GNU_gama
@@ -25,6 +25,7 @@
 
 #include <gnu_gama/local/network.h>
 #include <gnu_gama/exception.h>
+#include <functional>
 #include <iostream>
 
 namespace GNU_gama
@@ -38,6 +39,19 @@ using ParserException = GNU_gama::Exception::parser;
 
 GaMaAPI std::istream& operator>>(std::istream& input, GNU_gama::local::LocalNetwork& network);
 
+/** Called for each cluster of observations as soon as it is parsed
+ *  (the cluster is the last one in network.OD.clusters). The handler
+ *  may remove the cluster from the list and delete it, which allows
+ *  to process large inputs without holding all observations in memory.
+ */
+using ClusterHandler = std::function<void(GNU_gama::Cluster<GNU_gama::local::Observation>*)>;
+
+/** Reads XML input like operator>>, \a handler is called for each cluster.
+ *  Exceptions thrown by the handler stop parsing and are rethrown.
+ */
+GaMaAPI void read(std::istream& input, GNU_gama::local::LocalNetwork& network,
+                  const ClusterHandler& handler);
+
 }  // namespace GKFparser
 }  // namespace local
 }  // namespace GNU_gama
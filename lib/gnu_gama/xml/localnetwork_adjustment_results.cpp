@@ -19,6 +19,7 @@
     Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <cstdlib>
 #include <iostream>
 #include <cstring>
 #include <string>
@@ -87,6 +88,8 @@ void LocalNetworkAdjustmentResults::init()
   fixed_points      .clear();
   approximate_points.clear();
   adjusted_points   .clear();
+
+  profile.clear();
 }
 
 double LocalNetworkAdjustmentResults::Observation::residual() const
@@ -258,6 +261,9 @@ void LocalNetworkAdjustmentResults::Parser::init()
   tagfun[s_obs_f_end                          ][t_std_residual                   ] = &Parser::std_residual;
   tagfun[s_std_residual_end                   ][t_err_obs                        ] = &Parser::err_obs;
   tagfun[s_err_obs_end                        ][t_err_adj                        ] = &Parser::err_adj;
+  tagfun[s_observations_end                   ][t_profile                        ] = &Parser::profile;
+  tagfun[s_profile                            ][t_phase                          ] = &Parser::phase;
+  tagfun[s_phase_end                          ][t_phase                          ] = &Parser::phase;
   tagfun[s_observations                       ][t_distance                       ] = &Parser::observation;
   tagfun[s_observations                       ][t_direction                      ] = &Parser::observation;
   tagfun[s_observations                       ][t_angle                          ] = &Parser::observation;
@@ -408,8 +414,10 @@ int LocalNetworkAdjustmentResults::Parser::tag(const char* c)
       break;
     case 'p':
       if (!strcmp(c, "passed"                    )) return t_passed;
+      if (!strcmp(c, "phase"                     )) return t_phase;
       if (!strcmp(c, "point"                     )) return t_point;
       if (!strcmp(c, "probability"               )) return t_probability;
+      if (!strcmp(c, "profile"                   )) return t_profile;
       if (!strcmp(c, "project-equations"         )) return t_project_equations;
       break;
     case 'q':
@@ -1801,3 +1809,62 @@ void LocalNetworkAdjustmentResults::Parser::err_adj(bool start)
       set_state(s_err_adj_end);
     }
 }
+
+
+void LocalNetworkAdjustmentResults::Parser::profile(bool start)
+{
+  if (start)
+    {
+      adj->profile.clear();
+      stack.push(&Parser::profile);
+      set_state(s_profile);
+    }
+  else
+    {
+      set_state(s_profile_end);
+    }
+}
+
+
+void LocalNetworkAdjustmentResults::Parser::phase(bool start)
+{
+  if (start)
+    {
+      GNU_gama::Profile::Phase p;
+      while (*attributes)
+        {
+          string atr = *attributes++;
+          string val = *attributes++;
+
+          if (atr == "name")
+            p.name = val;
+          else if (atr == "level")
+            p.level = std::atoi(val.c_str());
+          else if (atr == "calls")
+            p.calls = std::atoi(val.c_str());
+          else if (atr == "seconds")
+            p.seconds = std::atof(val.c_str());
+          else if (atr == "peak-kb")
+            p.peak_kb = std::atol(val.c_str());
+          else if (atr == "growth-kb")
+            p.growth_kb = std::atol(val.c_str());
+          else if (atr == "allocations")
+            p.allocations = std::atoll(val.c_str());
+          else if (atr == "allocated-kb")
+            p.allocated_kb = std::atoll(val.c_str());
+          else
+            {
+              error("unknown attribute");
+              return;
+            }
+        }
+      adj->profile.push_back(p);
+
+      stack.push(&Parser::phase);
+      set_state(s_phase);
+    }
+  else
+    {
+      set_state(s_phase_end);
+    }
+}
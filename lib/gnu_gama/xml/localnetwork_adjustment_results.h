@@ -230,6 +230,10 @@ namespace GNU_gama
           s_err_obs_end,
           s_err_adj,
           s_err_adj_end,
+          s_profile,
+          s_profile_end,
+          s_phase,
+          s_phase_end,
 
           s_stop
         };
@@ -298,8 +302,10 @@ namespace GNU_gama
           t_orientation,
           t_original_index,
           t_passed,
+          t_phase,
           t_point,
           t_probability,
+          t_profile,
           t_project_equations,
           t_qrr,
           t_ratio,
@@ -418,6 +424,8 @@ namespace GNU_gama
       void dim(bool);
       void band(bool);
       void flt(bool);
+      void profile(bool);
+      void phase(bool);
       void ind(bool);
       void observations(bool);
       void observation(bool);
@@ -30,6 +30,7 @@
 #include <vector>
 #include <Math/Service/covmat.h>
 #include <gnu_gama/local/xmlerror.h>
+#include <Utilities/Service/profile.h>
 
 
 namespace GNU_gama
@@ -181,6 +182,9 @@ namespace GNU_gama
     typedef std::vector<Observation> ObservationList;
     ObservationList  obslist;
 
+    /** optional profile of computational phases */
+    std::vector<GNU_gama::Profile::Phase> profile;
+
   private:
 
     void init();
@@ -19,6 +19,7 @@
 */
 
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <iomanip>
@@ -132,13 +133,20 @@ void LocalNetworkOctave::write(std::ostream& out) const
 
 
   const double m2 = netinfo->m_0() * netinfo->m_0();
+  std::vector<int> qi(n > 1 ? n-1 : 0), qj(qi.size());
+  std::vector<double> qxx(qi.size());
+  for (int j=1; j<n; j++) qj[j-1] = ind[j];
+
   out << "Cov = [\n";
   for (int k=0, i=1; i<n; i++, k=0)
     {
+      std::fill(qi.begin(), qi.end(), ind[i]);
+      netinfo->qxx(int(qi.size()), qi.data(), qj.data(), qxx.data());
+
       for (int j=1; j<n; j++)
         {
           out << " " << setprecision(7) << scientific << setw(14);
-          out << m2*netinfo->qxx(ind[i], ind[j]);
+          out << m2*qxx[j-1];
           if (++k%5 == 0) out << " ...\n";
         };
       out << ";\n";
@@ -381,6 +381,8 @@ void LocalNetworkXML::write(std::ostream& out) const
   coordinates(out);
   observations(out);
 
+  if (profile) profile->write_xml(out);
+
   out << "\n</gama-local-adjustment>\n";
 }
 
@@ -737,20 +739,36 @@ void LocalNetworkXML::coordinates(std::ostream& out) const
   out.setf(ios_base::scientific, ios_base::floatfield);
   out.precision(7);
   const double m2 = netinfo->m_0() * netinfo->m_0();
+
+  // weight coefficients are computed row by row of the band
+  std::vector<int> qi, qj;
+  std::vector<double> qxx;
   for (int k=0, i=1; i<=dim; i++)
-    for (int j=i; j<=std::min(dim, i+band); j++)
-      {
-        out << "<flt>" << m2*netinfo->qxx(ind[i], ind[j]) << "</flt>";
-        if (++k == 3)
-          {
-            k = 0;
-            out << "\n";
-          }
-        else
-          {
-            out << " ";
-          }
-      }
+    {
+      qi.clear();
+      qj.clear();
+      for (int j=i; j<=std::min(dim, i+band); j++)
+        {
+          qi.push_back(ind[i]);
+          qj.push_back(ind[j]);
+        }
+      qxx.resize(qi.size());
+      netinfo->qxx(int(qi.size()), qi.data(), qj.data(), qxx.data());
+
+      for (std::size_t n=0; n<qxx.size(); n++)
+        {
+          out << "<flt>" << m2*qxx[n] << "</flt>";
+          if (++k == 3)
+            {
+              k = 0;
+              out << "\n";
+            }
+          else
+            {
+              out << " ";
+            }
+        }
+    }
 
   out << "</cov-mat>\n";
 
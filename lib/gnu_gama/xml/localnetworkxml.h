@@ -25,6 +25,7 @@
 #include <gnu_gama/local/gamadata.h>
 #include <gnu_gama/local/network.h>
 #include <gnu_gama/local/cluster.h>
+#include <Utilities/Service/profile.h>
 #include <string>
 
 
@@ -37,9 +38,13 @@ namespace GNU_gama
     LocalNetworkXML(GNU_gama::local::LocalNetwork* ln) : netinfo(ln) {}
     void write(std::ostream&) const;
 
+    /** optional profile of computational phases written after observations */
+    void set_profile(const GNU_gama::Profile* p) { profile = p; }
+
   private:
 
     GNU_gama::local::LocalNetwork* netinfo;
+    const GNU_gama::Profile* profile {nullptr};
 
     void coordinates_summary (std::ostream&) const;
     void observations_summary(std::ostream&) const;
@@ -0,0 +1,430 @@
+/* GNU Gama -- benchmark of adjustment algorithms on synthetic networks
+   Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gnu_gama/local/acord/acord2.h>
+#include <gnu_gama/local/language.h>
+#include <gnu_gama/local/network.h>
+#include <gnu_gama/xml/gkfparser.h>
+#include <Math/Service/memalloc.h>
+#include <Utilities/Service/profile.h>
+#include "network-generator.h"
+
+/* Synthetic networks of given types and sizes are adjusted by all
+ * requested algorithms and orderings. Times of network generation,
+ * input, adjustment and extraction of the covariance band, factor
+ * statistics and phases recorded by GNU_gama::Profile are written in
+ * JSON (one record per run) for regression tracking, a short summary
+ * of each run goes to standard error output.
+ *
+ * Adjusted unknowns of each network are compared with the first
+ * algorithm run on it; the program fails if they differ by more than
+ * the tolerance or if an adjustment fails.
+ */
+
+namespace {
+
+  using GNU_gama::local::LocalNetwork;
+  using Algorithm = LocalNetwork::Algorithm;
+  using GNU_gama::SparseOrdering;
+
+  struct Options
+  {
+    std::vector<NetworkGenerator::Type> types;
+    std::vector<int>          unknowns;
+    std::vector<Algorithm>    algorithms;
+    std::vector<SparseOrdering> orderings;
+    int      defect         {3};
+    int      threads        {1};
+    int      dense_limit    {5000};
+    int      envelope_limit {200000};
+    int      cov_band       {2};
+    double   tolerance      {1e-2};
+    unsigned seed           {1};
+    GNU_gama::MemAlloc::Policy allocator {GNU_gama::MemAlloc::Policy::standard};
+    std::string json;
+    std::string gkf;
+  };
+
+  struct Run
+  {
+    std::string type, algorithm, ordering, status {"ok"}, message;
+    int    requested {0}, points {0}, unknowns {0}, observations {0};
+    int    defect {0};
+    double generate {0}, input {0}, adjustment {0}, covariance {0};
+    double factor_nonzeroes {0}, factor_flops {0}, max_difference {0};
+    long   peak_kb {0};
+    std::vector<GNU_gama::Profile::Phase> phases;
+  };
+
+  const char* name(Algorithm a)
+  {
+    switch (a)
+      {
+      case Algorithm::gso       : return "gso";
+      case Algorithm::svd       : return "svd";
+      case Algorithm::cholesky  : return "cholesky";
+      case Algorithm::envelope  : return "envelope";
+      case Algorithm::supernodal: return "supernodal";
+      }
+    return "";
+  }
+
+  const char* name(SparseOrdering o)
+  {
+    switch (o)
+      {
+      case SparseOrdering::rcm: return "rcm";
+      case SparseOrdering::amd: return "amd";
+      case SparseOrdering::nd : return "nd";
+      }
+    return "";
+  }
+
+  bool sparse(Algorithm a)
+  {
+    return a == Algorithm::envelope || a == Algorithm::supernodal;
+  }
+
+  double seconds(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>
+      (std::chrono::steady_clock::now() - start).count();
+  }
+
+  const char* usage =
+    "\n"
+    "Usage:  gama-benchmark  [ options ]\n\n"
+    " --type       grid | traverse | triangulation | leveling | gnss | free\n"
+    " --unknowns   N       approximate number of unknowns (implicit 1000)\n"
+    " --algorithm  envelope | supernodal | gso | svd | cholesky\n"
+    " --ordering   rcm | amd | nd   (sparse algorithms)\n"
+    "     options above can be repeated, implicitly all values are used\n"
+    " --defect     1 | 3 | 4   datum defect of free networks (implicit 3)\n"
+    " --threads    N       threads of linearization and decomposition\n"
+    " --dense-limit N      gso, svd and cholesky are skipped for networks\n"
+    "                      with more unknowns (implicit 5000)\n"
+    " --envelope-limit N   envelope limit (implicit 200000)\n"
+    " --cov-band   N       bandwidth of extracted covariances (implicit 2)\n"
+    " --tolerance  mm      maximal difference of adjusted unknowns\n"
+    "                      between algorithms (implicit 1e-2)\n"
+    " --seed       N       random seed of generated networks\n"
+    " --allocator  default | aligned | pool   matrix and vector storage\n"
+    " --json       file    results (implicitly standard output)\n"
+    " --gkf        dir     write generated networks to directory\n\n";
+
+  int arguments(int argc, char* argv[], Options& opt)
+  {
+    for (int i=1; i<argc; i++)
+      {
+        const std::string a = (argv[i][0] == '-' && argv[i][1] == '-')
+                              ? argv[i]+1 : argv[i];
+        if (a == "-h" || a == "-help") return 1;
+        if (i+1 == argc) return 1;
+
+        const std::string v = argv[++i];
+        NetworkGenerator::Type t;
+
+        if (a == "-type" && NetworkGenerator::type(v, t))
+          opt.types.push_back(t);
+        else if (a == "-unknowns" && std::atoi(v.c_str()) > 0)
+          opt.unknowns.push_back(std::atoi(v.c_str()));
+        else if (a == "-algorithm")
+          {
+            if      (v == "gso"       ) opt.algorithms.push_back(Algorithm::gso);
+            else if (v == "svd"       ) opt.algorithms.push_back(Algorithm::svd);
+            else if (v == "cholesky"  ) opt.algorithms.push_back(Algorithm::cholesky);
+            else if (v == "envelope"  ) opt.algorithms.push_back(Algorithm::envelope);
+            else if (v == "supernodal") opt.algorithms.push_back(Algorithm::supernodal);
+            else return 1;
+          }
+        else if (a == "-ordering")
+          {
+            if      (v == "rcm") opt.orderings.push_back(SparseOrdering::rcm);
+            else if (v == "amd") opt.orderings.push_back(SparseOrdering::amd);
+            else if (v == "nd" ) opt.orderings.push_back(SparseOrdering::nd);
+            else return 1;
+          }
+        else if (a == "-defect")         opt.defect = std::atoi(v.c_str());
+        else if (a == "-threads")        opt.threads = std::atoi(v.c_str());
+        else if (a == "-dense-limit")    opt.dense_limit = std::atoi(v.c_str());
+        else if (a == "-envelope-limit") opt.envelope_limit = std::atoi(v.c_str());
+        else if (a == "-cov-band")       opt.cov_band = std::atoi(v.c_str());
+        else if (a == "-tolerance")      opt.tolerance = std::atof(v.c_str());
+        else if (a == "-seed")           opt.seed = unsigned(std::atol(v.c_str()));
+        else if (a == "-allocator")
+          {
+            using GNU_gama::MemAlloc::Policy;
+            if      (v == "default") opt.allocator = Policy::standard;
+            else if (v == "aligned") opt.allocator = Policy::aligned;
+            else if (v == "pool"   ) opt.allocator = Policy::pool;
+            else return 1;
+          }
+        else if (a == "-json")           opt.json = v;
+        else if (a == "-gkf")            opt.gkf = v;
+        else return 1;
+      }
+
+    if (opt.types.empty()) opt.types = NetworkGenerator::types();
+    if (opt.unknowns.empty()) opt.unknowns.push_back(1000);
+    if (opt.algorithms.empty())
+      opt.algorithms = { Algorithm::envelope, Algorithm::supernodal,
+                         Algorithm::gso, Algorithm::svd, Algorithm::cholesky };
+    if (opt.orderings.empty())
+      opt.orderings = { SparseOrdering::rcm, SparseOrdering::amd,
+                        SparseOrdering::nd };
+
+    return 0;
+  }
+
+  void adjust(const Options& opt, const std::string& gkf, Algorithm algorithm,
+              SparseOrdering ordering, Run& run, std::vector<double>& x)
+  {
+    GNU_gama::Profile profile;
+    GNU_gama::Profile::Active active(&profile);
+
+    auto lnet = std::make_unique<LocalNetwork>();
+
+    auto start = std::chrono::steady_clock::now();
+    {
+      GNU_gama::Profile::Scope phase("input");
+      std::istringstream inp(gkf);
+      using GNU_gama::local::GKFparser::operator>>;
+      inp >> *lnet;
+    }
+    run.input = seconds(start);
+
+    lnet->set_algorithm(algorithm);
+    if (sparse(algorithm)) lnet->set_ordering(ordering);
+    lnet->set_threads(opt.threads);
+    lnet->remove_inconsistency();
+
+    // approximate orientations of direction sets
+    {
+      GNU_gama::Profile::Scope phase("acord2");
+      GNU_gama::local::Acord2 acord2(lnet->PD, lnet->OD);
+      acord2.execute();
+    }
+
+    start = std::chrono::steady_clock::now();
+    const auto& u = lnet->solve();
+    run.adjustment = seconds(start);
+
+    const int n = lnet->sum_unknowns();
+    run.unknowns     = n;
+    run.observations = lnet->sum_observations();
+    run.defect = lnet->degrees_of_freedom() - run.observations + n;
+    if (sparse(algorithm))
+      {
+        run.factor_nonzeroes = lnet->factor_nonzeroes();
+        run.factor_flops     = lnet->factor_flops();
+      }
+
+    x.resize(n);
+    for (int i=1; i<=n; i++) x[i-1] = u(i);
+
+    // covariance band of adjusted unknowns, as in XML output
+    std::vector<int> I, J;
+    for (int i=1; i<=n; i++)
+      for (int j=i; j<=std::min(n, i+opt.cov_band); j++)
+        {
+          I.push_back(i);
+          J.push_back(j);
+        }
+    std::vector<double> Q(I.size());
+
+    start = std::chrono::steady_clock::now();
+    {
+      GNU_gama::Profile::Scope phase("covariance");
+      lnet->qxx(int(I.size()), I.data(), J.data(), Q.data());
+    }
+    run.covariance = seconds(start);
+
+    run.peak_kb = GNU_gama::Profile::peak_memory_kb();
+    run.phases  = profile.phases();
+  }
+
+  void write_json(std::ostream& out, const Run& r, bool first)
+  {
+    out << (first ? "\n  " : ",\n  ")
+        << "{\"type\": \"" << r.type << "\""
+        << ", \"requested\": " << r.requested
+        << ", \"points\": " << r.points
+        << ", \"unknowns\": " << r.unknowns
+        << ", \"observations\": " << r.observations
+        << ", \"defect\": " << r.defect
+        << ", \"algorithm\": \"" << r.algorithm << "\""
+        << ", \"ordering\": \"" << r.ordering << "\""
+        << ", \"status\": \"" << r.status << "\"";
+    if (!r.message.empty())
+      {
+        out << ", \"message\": \"";
+        for (char c : r.message)
+          if (c == '"' || c == '\\') out << '\\' << c;
+          else if (c == '\n')        out << "\\n";
+          else                       out << c;
+        out << "\"";
+      }
+    out << ", \"generate\": " << r.generate
+        << ", \"input\": " << r.input
+        << ", \"adjustment\": " << r.adjustment
+        << ", \"covariance\": " << r.covariance
+        << ", \"factor_nonzeroes\": " << r.factor_nonzeroes
+        << ", \"factor_flops\": " << r.factor_flops
+        << ", \"max_difference\": " << r.max_difference
+        << ", \"peak_kb\": " << r.peak_kb
+        << ",\n   \"phases\": [";
+    for (std::size_t i=0; i<r.phases.size(); i++)
+      {
+        const GNU_gama::Profile::Phase& p = r.phases[i];
+        out << (i ? ", " : "")
+            << "{\"phase\": \"" << p.name << "\", \"level\": " << p.level
+            << ", \"calls\": " << p.calls << ", \"seconds\": " << p.seconds
+            << ", \"allocations\": " << p.allocations
+            << ", \"allocated_kb\": " << p.allocated_kb << "}";
+      }
+    out << "]}";
+  }
+
+}  // unnamed namespace
+
+
+int main(int argc, char* argv[])
+{
+  Options opt;
+  if (arguments(argc, argv, opt))
+    {
+      std::cerr << usage;
+      return 1;
+    }
+
+  GNU_gama::local::set_gama_language(GNU_gama::local::en);
+  GNU_gama::MemAlloc::set_policy(opt.allocator);
+  GNU_gama::Profile::set_allocation_counter(GNU_gama::MemAlloc::heap_counter);
+
+  std::ofstream json_file;
+  if (!opt.json.empty()) json_file.open(opt.json);
+  std::ostream& json = opt.json.empty() ? std::cout : json_file;
+  json.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  json.precision(6);
+  json << "{\"benchmark\": [";
+
+  bool first  = true;
+  int  failed = 0;
+
+  for (NetworkGenerator::Type type : opt.types)
+    for (int requested : opt.unknowns)
+      {
+        auto start = std::chrono::steady_clock::now();
+        std::ostringstream gkf;
+        NetworkGenerator generator(type, requested, opt.defect, opt.seed);
+        generator.write_gkf(gkf);
+        const double generate = seconds(start);
+
+        const std::string label = NetworkGenerator::name(type) + "-"
+                                  + std::to_string(requested);
+        if (!opt.gkf.empty())
+          {
+            std::ofstream file(opt.gkf + "/" + label + ".gkf");
+            file << gkf.str();
+          }
+
+        std::vector<double> reference;
+        for (Algorithm algorithm : opt.algorithms)
+          for (SparseOrdering ordering : opt.orderings)
+            {
+              // dense algorithms do not depend on ordering
+              if (!sparse(algorithm) && ordering != opt.orderings.front())
+                continue;
+
+              Run run;
+              run.type      = NetworkGenerator::name(type);
+              run.requested = requested;
+              run.points    = generator.points();
+              run.algorithm = name(algorithm);
+              run.ordering  = sparse(algorithm) ? name(ordering) : "-";
+              run.generate  = generate;
+
+              if ((!sparse(algorithm) && requested > opt.dense_limit) ||
+                  (algorithm == Algorithm::envelope &&
+                   requested > opt.envelope_limit))
+                {
+                  run.status = "skipped";
+                }
+              else try
+                {
+                  std::vector<double> x;
+                  adjust(opt, gkf.str(), algorithm, ordering, run, x);
+
+                  if (reference.empty()) reference = x;
+                  for (std::size_t i=0; i<x.size() && i<reference.size(); i++)
+                    run.max_difference = std::max(run.max_difference,
+                                                  std::abs(x[i] - reference[i]));
+                  if (x.size() != reference.size() ||
+                      !(run.max_difference <= opt.tolerance))
+                    {
+                      run.status = "differs";
+                      failed++;
+                    }
+                }
+              catch (const std::exception& e)
+                {
+                  run.status  = "failed";
+                  run.message = e.what();
+                  failed++;
+                }
+              catch (...)
+                {
+                  run.status  = "failed";
+                  run.message = "unknown exception";
+                  failed++;
+                }
+
+              write_json(json, run, first);
+              first = false;
+
+              std::cerr << std::left << std::setw(24) << label
+                        << std::setw(11) << run.algorithm
+                        << std::setw(4)  << run.ordering << std::right
+                        << std::setw(9)  << run.unknowns;
+              if (run.status == "skipped")
+                std::cerr << "   skipped\n";
+              else
+                std::cerr << std::fixed << std::setprecision(3)
+                          << std::setw(11) << run.adjustment << " s"
+                          << std::setw(10) << run.covariance << " s   "
+                          << run.status << " " << run.message << "\n";
+            }
+      }
+
+  json << "\n]}\n";
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,288 @@
+/* GNU Gama -- benchmark of dense matrix kernels
+   Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Math/Service/mat.h>
+#include <Math/Service/symmat.h>
+#include <Math/Service/transmat.h>
+#include <Math/Service/vec.h>
+
+/* Products computed by Kernels (matrix product, trans(A)*B and normal
+ * equations trans(A)*A of a design matrix with 2N rows) are timed
+ * against the simple loops they replaced. Results of kernels must be
+ * identical with the reference loops for any number of threads.
+ *
+ * Generic operators (sum of SymMat and Mat, product of SymMat and
+ * Vec) are timed with operands of their own class (direct element
+ * access) against the same operators called with MatBase operands
+ * (virtual element access).
+ */
+
+namespace {
+
+  using Mat     = GNU_gama::Mat<double, int, GNU_gama::Exception::matvec>;
+  using SymMat  = GNU_gama::SymMat<double, int, GNU_gama::Exception::matvec>;
+  using MatBase = GNU_gama::MatBase<double, int, GNU_gama::Exception::matvec>;
+  using Vec     = GNU_gama::Vec<double, int, GNU_gama::Exception::matvec>;
+
+  struct Options {
+    std::vector<int> dims;
+    int              threads         {1};
+    int              reference_limit {5000};
+    std::string      json;
+  };
+
+  double seconds(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>
+      (std::chrono::steady_clock::now() - start).count();
+  }
+
+  Mat random_mat(int rows, int cols, unsigned seed)
+  {
+    Mat M(rows, cols);
+    for (double& m : M)
+      {
+        seed = seed*1103515245u + 12345u;
+        m = double((seed >> 8) % 2001) / 1000.0 - 1.0;
+      }
+    return M;
+  }
+
+  /* reference loops */
+
+  Mat reference_product(const MatBase& A, const MatBase& B)
+  {
+    Mat C(A.rows(), B.cols());
+    double* c = C.begin();
+    for (int i=1; i<=C.rows(); i++)
+      for (int j=1; j<=C.cols(); j++)
+        {
+          double s = 0;
+          for (int k=1; k<=B.rows(); k++) s += A(i,k) * B(k,j);
+          *c++ = s;
+        }
+    return C;
+  }
+
+  SymMat reference_normals(const Mat& A)
+  {
+    SymMat N(A.cols());
+    for (int i=1; i<=A.cols(); i++)
+      for (int j=i; j<=A.cols(); j++)
+        {
+          double s = 0;
+          for (int k=1; k<=A.rows(); k++) s += A(k,i)*A(k,j);
+          N(i,j) = s;
+        }
+    return N;
+  }
+
+  bool identical(const MatBase& a, const MatBase& b)
+  {
+    return a.rows() == b.rows() && a.cols() == b.cols() &&
+      std::memcmp(a.begin(), b.begin(),
+                  (a.end() - a.begin())*sizeof(double)) == 0;
+  }
+
+  const char* usage =
+    "\n"
+    "Usage:  matvec-benchmark  [ options ]\n\n"
+    " --dim        N       dimension of matrices, can be repeated\n"
+    "                      (implicit 500, 1000, 2000)\n"
+    " --threads    N       threads of kernels (0 for all cores, implicit 1)\n"
+    " --reference-limit N  reference loops are skipped for larger\n"
+    "                      dimensions (implicit 5000)\n"
+    " --json       file    results (implicitly standard output)\n\n";
+
+  int arguments(int argc, char* argv[], Options& opt)
+  {
+    for (int i=1; i<argc; i++)
+      {
+        const std::string a = (argv[i][0] == '-' && argv[i][1] == '-')
+                              ? argv[i]+1 : argv[i];
+        if (a == "-h" || a == "-help") return 1;
+        if (i+1 == argc) return 1;
+
+        const std::string v = argv[++i];
+
+        if (a == "-dim" && std::atoi(v.c_str()) > 0)
+          opt.dims.push_back(std::atoi(v.c_str()));
+        else if (a == "-threads")         opt.threads = std::atoi(v.c_str());
+        else if (a == "-reference-limit") opt.reference_limit = std::atoi(v.c_str());
+        else if (a == "-json")            opt.json = v;
+        else return 1;
+      }
+
+    if (opt.dims.empty()) opt.dims = { 500, 1000, 2000 };
+
+    return 0;
+  }
+
+}
+
+
+int main(int argc, char* argv[])
+{
+  Options opt;
+  if (arguments(argc, argv, opt))
+    {
+      std::cerr << usage;
+      return 1;
+    }
+
+  GNU_gama::Kernels::set_threads(opt.threads);
+
+  std::ofstream json_file;
+  if (!opt.json.empty()) json_file.open(opt.json);
+  std::ostream& json = opt.json.empty() ? std::cout : json_file;
+  json.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  json.precision(6);
+  json << "{\"matvec-benchmark\": [";
+
+  int  failed = 0;
+  bool first  = true;
+
+  for (int n : opt.dims)
+    {
+      const Mat A = random_mat(n, n, 1);
+      const Mat B = random_mat(n, n, 2);
+      const Mat D = random_mat(2*n, n, 3);    // design matrix
+
+      struct Kernel { const char* name; double kernel, reference; bool ok; };
+      std::vector<Kernel> kernels;
+      const bool reference = n <= opt.reference_limit;
+
+      {
+        auto start = std::chrono::steady_clock::now();
+        const Mat C = A*B;
+        Kernel k {"gemm", seconds(start), 0, true};
+        if (reference)
+          {
+            start = std::chrono::steady_clock::now();
+            const Mat R = reference_product(A, B);
+            k.reference = seconds(start);
+            k.ok = identical(C, R);
+          }
+        kernels.push_back(k);
+      }
+      {
+        auto start = std::chrono::steady_clock::now();
+        const Mat C = trans(D)*D;
+        Kernel k {"gemm_tn", seconds(start), 0, true};
+        if (reference)
+          {
+            start = std::chrono::steady_clock::now();
+            const Mat R = reference_product(trans(D), D);
+            k.reference = seconds(start);
+            k.ok = identical(C, R);
+          }
+        kernels.push_back(k);
+      }
+      {
+        auto start = std::chrono::steady_clock::now();
+        SymMat N(n);
+        GNU_gama::Kernels::syrk_tn(n, 2*n, D.begin(), n, N.begin());
+        Kernel k {"syrk_tn", seconds(start), 0, true};
+        if (reference)
+          {
+            start = std::chrono::steady_clock::now();
+            const SymMat R = reference_normals(D);
+            k.reference = seconds(start);
+            k.ok = identical(N, R);
+          }
+        kernels.push_back(k);
+      }
+      {
+        SymMat S(n);
+        for (int i=1; i<=n; i++)
+          for (int j=1; j<=i; j++) S(i,j) = B(i,j);
+        Vec x(n);
+        for (int i=1; i<=n; i++) x(i) = A(1,i);
+
+        // operations are repeated for measurable times of small dims
+        const int repeat = std::max(1, 50000000/(n*n));
+        const MatBase& s = S;
+        const MatBase& a = A;
+
+        Mat C, R;
+        auto start = std::chrono::steady_clock::now();
+        for (int r=0; r<repeat; r++) C = S + A;
+        Kernel k {"add", seconds(start), 0, true};
+        if (reference)
+          {
+            start = std::chrono::steady_clock::now();
+            for (int r=0; r<repeat; r++) R = s + a;
+            k.reference = seconds(start);
+            k.ok = identical(C, R);
+          }
+        kernels.push_back(k);
+
+        Vec y, z;
+        start = std::chrono::steady_clock::now();
+        for (int r=0; r<repeat; r++) y = S*x;
+        Kernel v {"gemv", seconds(start), 0, true};
+        if (reference)
+          {
+            start = std::chrono::steady_clock::now();
+            for (int r=0; r<repeat; r++) z = s*x;
+            v.reference = seconds(start);
+            v.ok = y.dim() == z.dim() &&
+              std::memcmp(y.begin(), z.begin(), n*sizeof(double)) == 0;
+          }
+        kernels.push_back(v);
+      }
+
+      for (const Kernel& k : kernels)
+        {
+          if (!k.ok) failed++;
+
+          json << (first ? "\n" : ",\n")
+               << "{\"kernel\": \"" << k.name << "\", \"dim\": " << n
+               << ", \"threads\": " << opt.threads
+               << ", \"seconds\": " << k.kernel;
+          if (reference)
+            json << ", \"reference_seconds\": " << k.reference
+                 << ", \"identical\": " << (k.ok ? "true" : "false");
+          json << "}";
+          first = false;
+
+          std::cerr << std::left << std::setw(9) << k.name << std::right
+                    << std::setw(6) << n << std::fixed << std::setprecision(3)
+                    << std::setw(10) << k.kernel << " s";
+          if (reference)
+            std::cerr << std::setw(10) << k.reference << " s   "
+                      << (k.ok ? "identical" : "differs");
+          std::cerr << "\n";
+        }
+    }
+
+  json << "\n]}\n";
+
+  return failed ? 1 : 0;
+}
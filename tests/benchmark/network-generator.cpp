@@ -0,0 +1,334 @@
+/* GNU Gama -- synthetic local geodetic networks for benchmarks
+   Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include "network-generator.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+  const double PI = 3.14159265358979323846;
+
+  int side(double n) { return std::max(3, int(std::ceil(std::sqrt(n)))); }
+
+}
+
+const std::vector<NetworkGenerator::Type>& NetworkGenerator::types()
+{
+  static const std::vector<Type> all {
+    Type::grid, Type::traverse, Type::triangulation,
+    Type::leveling, Type::gnss, Type::free };
+
+  return all;
+}
+
+std::string NetworkGenerator::name(Type t)
+{
+  switch (t)
+    {
+    case Type::grid         : return "grid";
+    case Type::traverse     : return "traverse";
+    case Type::triangulation: return "triangulation";
+    case Type::leveling     : return "leveling";
+    case Type::gnss         : return "gnss";
+    case Type::free         : return "free";
+    }
+  return "";
+}
+
+bool NetworkGenerator::type(const std::string& s, Type& t)
+{
+  for (Type n : types())
+    if (s == name(n))
+      {
+        t = n;
+        return true;
+      }
+  return false;
+}
+
+NetworkGenerator::NetworkGenerator(Type t, int unknowns, int defect,
+                                   unsigned seed)
+  : type_(t), defect_(0), rnd_(seed)
+{
+  if (t == Type::free)
+    {
+      if (defect != 1 && defect != 3 && defect != 4)
+        throw std::invalid_argument("datum defect of free network "
+                                    "must be 1, 3 or 4");
+      defect_ = defect;
+    }
+
+  const double n = std::max(unknowns, 10);
+
+  switch (type_)
+    {
+    case Type::grid:
+      // two coordinates and orientation for each point
+      grid_points(side(n/3), 200.0, false);
+      break;
+    case Type::traverse:
+      {
+        const int k = std::max(2, int(n/3));
+        for (int i=0; i<k+4; i++)
+          pts_.push_back({ 200.0*i, 50.0*std::sin(0.3*i), 0.0,
+                           i < 2 || i >= k+2 });
+      }
+      break;
+    case Type::triangulation:
+      mesh_points(side(n/3), 300.0);
+      break;
+    case Type::leveling:
+      grid_points(side(n), 500.0, true);
+      break;
+    case Type::gnss:
+      grid_points(side(n/3), 1000.0, true);
+      break;
+    case Type::free:
+      if (defect_ == 1)
+        grid_points(side(n), 500.0, true);
+      else if (defect_ == 3)
+        grid_points(side(n/3), 200.0, false);
+      else
+        mesh_points(side(n/3), 300.0);
+      for (Point& p : pts_) p.fixed = false;
+      break;
+    }
+}
+
+void NetworkGenerator::grid_points(int m, double step, bool with_z)
+{
+  side_ = m;
+  for (int i=0; i<m; i++)
+    for (int j=0; j<m; j++)
+      {
+        const double z = with_z ? 300.0 + 20*std::sin(0.2*i)*std::cos(0.3*j)
+                                : 0.0;
+        pts_.push_back({ i*step, j*step, z, i == 0 && j < 2 });
+      }
+}
+
+void NetworkGenerator::mesh_points(int m, double step)
+{
+  side_ = m;
+  for (int i=0; i<m; i++)
+    for (int j=0; j<m; j++)
+      pts_.push_back({ i*step*std::sqrt(3.0)/2, j*step + (i%2)*step/2, 0.0,
+                       i == 0 && j < 2 });
+}
+
+double NetworkGenerator::noise(double stdev)
+{
+  if (stdev <= 0) return 0;
+
+  std::normal_distribution<double> normal(0.0, stdev);
+  return normal(rnd_);
+}
+
+double NetworkGenerator::bearing(int from, int to) const
+{
+  double b = std::atan2(pts_[to].y - pts_[from].y, pts_[to].x - pts_[from].x);
+  if (b < 0) b += 2*PI;
+  return b*200/PI;
+}
+
+double NetworkGenerator::distance(int from, int to) const
+{
+  return std::hypot(pts_[to].x - pts_[from].x, pts_[to].y - pts_[from].y);
+}
+
+void NetworkGenerator::write_points(std::ostream& out, const char* fixed,
+                                    const char* adjusted, bool xy, bool z)
+{
+  for (std::size_t i=0; i<pts_.size(); i++)
+    {
+      const Point& p = pts_[i];
+      // approximate coordinates of adjusted points are shifted
+      const double s = p.fixed ? 0 : approx_shift_/1000;
+      out << "<point id=\"" << i+1 << "\"";
+      if (xy) out << " x=\"" << p.x + noise(s) << "\" y=\"" << p.y + noise(s)
+                  << "\"";
+      if (z)  out << " z=\"" << p.z + noise(s) << "\"";
+      out << (p.fixed ? " fix=\"" : " adj=\"")
+          << (p.fixed ? fixed : adjusted) << "\"/>\n";
+    }
+}
+
+void NetworkGenerator::write_station(std::ostream& out, int from,
+                                     const std::vector<int>& to,
+                                     bool directions, bool distances)
+{
+  out << "<obs from=\"" << from+1 << "\">\n";
+  for (int t : to)
+    {
+      if (directions)
+        {
+          double d = bearing(from, t) + noise(direction_stdev_)/10000;
+          if (d >= 400) d -= 400;
+          if (d <  0  ) d += 400;
+          out << "  <direction to=\"" << t+1 << "\" val=\""
+              << std::setprecision(6) << d << "\"/>\n";
+        }
+      if (distances)
+        out << "  <distance to=\"" << t+1 << "\" val=\""
+            << std::setprecision(4)
+            << distance(from, t) + noise(distance_stdev_)/1000 << "\"/>\n";
+    }
+  out << "</obs>\n" << std::setprecision(4);
+}
+
+void NetworkGenerator::write_gkf(std::ostream& out)
+{
+  const auto flags = out.flags();
+  const auto prec  = out.precision();
+  out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  out.precision(4);
+
+  out << "<?xml version=\"1.0\" ?>\n"
+      << "<gama-local xmlns=\"http://www.gnu.org/software/gama/gama-local\">\n"
+      << "<network>\n\n"
+      << "<description>synthetic " << name(type_) << " network, "
+      << pts_.size() << " points";
+  if (type_ == Type::free) out << ", datum defect " << defect_;
+  out << "</description>\n\n"
+      << "<parameters sigma-apr=\"10\" conf-pr=\"0.95\" tol-abs=\"1000\""
+      << " sigma-act=\"aposteriori\"/>\n\n"
+      << "<points-observations distance-stdev=\"" << distance_stdev_
+      << "\" direction-stdev=\"" << direction_stdev_ << "\">\n\n";
+
+  const int N = int(pts_.size());
+  const int m = side_;
+
+  // neighbours in square grid (2D, leveling and gnss)
+  auto grid = [m](int k, bool all) {
+    std::vector<int> to;
+    const int i = k / m, j = k % m;
+    if (all && i > 0  ) to.push_back(k-m);
+    if (all && j > 0  ) to.push_back(k-1);
+    if (j+1 < m) to.push_back(k+1);
+    if (i+1 < m) to.push_back(k+m);
+    return to;
+  };
+
+  // neighbours in triangular mesh, odd rows are shifted
+  auto mesh = [m](int k) {
+    std::vector<int> to;
+    const int i = k / m, j = k % m;
+    const int s = (i % 2) ? 0 : -1;
+    if (j > 0  ) to.push_back(k-1);
+    if (j+1 < m) to.push_back(k+1);
+    for (int r : {i-1, i+1})
+      if (r >= 0 && r < m)
+        for (int c : {j+s, j+s+1})
+          if (c >= 0 && c < m) to.push_back(r*m + c);
+    return to;
+  };
+
+  auto leveling = [&](bool free) {
+    write_points(out, "z", free ? "Z" : "z", false, true);
+    for (int i=0; i<m; i++)
+      {
+        out << "\n<height-differences>\n";
+        for (int k=i*m; k<(i+1)*m; k++)
+          for (int t : grid(k, false))
+            out << "  <dh from=\"" << k+1 << "\" to=\"" << t+1 << "\" val=\""
+                << pts_[t].z - pts_[k].z + noise(2.0)/1000
+                << "\" stdev=\"2.0\"/>\n";
+        out << "</height-differences>\n";
+      }
+  };
+
+  auto grid2d = [&](bool free) {
+    write_points(out, "xy", free ? "XY" : "xy", true, false);
+    out << "\n";
+    for (int k=0; k<N; k++) write_station(out, k, grid(k, true), true, true);
+  };
+
+  auto triangulation = [&](bool free) {
+    write_points(out, "xy", free ? "XY" : "xy", true, false);
+    out << "\n";
+    for (int k=0; k<N; k++) write_station(out, k, mesh(k), true, false);
+  };
+
+  switch (type_)
+    {
+    case Type::grid:
+      grid2d(false);
+      break;
+    case Type::traverse:
+      write_points(out, "xy", "xy", true, false);
+      out << "\n";
+      for (int k=1; k<N-1; k++)
+        {
+          out << "<obs from=\"" << k+1 << "\">\n";
+          for (int t : {k-1, k+1})
+            {
+              double d = bearing(k, t) + noise(direction_stdev_)/10000;
+              if (d >= 400) d -= 400;
+              if (d <  0  ) d += 400;
+              out << "  <direction to=\"" << t+1 << "\" val=\""
+                  << std::setprecision(6) << d << std::setprecision(4)
+                  << "\"/>\n";
+            }
+          if (!(pts_[k].fixed && pts_[k+1].fixed))
+            out << "  <distance to=\"" << k+2 << "\" val=\""
+                << distance(k, k+1) + noise(distance_stdev_)/1000 << "\"/>\n";
+          out << "</obs>\n";
+        }
+      break;
+    case Type::triangulation:
+      triangulation(false);
+      break;
+    case Type::leveling:
+      leveling(false);
+      break;
+    case Type::gnss:
+      write_points(out, "xyz", "xyz", true, true);
+      for (int k=0; k<N; k++)
+        {
+          const std::vector<int> to = grid(k, false);
+          if (to.empty()) continue;
+
+          out << "\n<vectors>\n";
+          for (int t : to)
+            out << "  <vec from=\"" << k+1 << "\" to=\"" << t+1
+                << "\" dx=\"" << pts_[t].x - pts_[k].x + noise(vector_stdev_)/1000
+                << "\" dy=\"" << pts_[t].y - pts_[k].y + noise(vector_stdev_)/1000
+                << "\" dz=\"" << pts_[t].z - pts_[k].z + noise(vector_stdev_)/1000
+                << "\"/>\n";
+          out << "  <cov-mat dim=\"" << 3*to.size() << "\" band=\"0\">\n   ";
+          for (std::size_t i=0; i<3*to.size(); i++)
+            out << " " << vector_stdev_*vector_stdev_;
+          out << "\n  </cov-mat>\n</vectors>\n";
+        }
+      break;
+    case Type::free:
+      if      (defect_ == 1) leveling(true);
+      else if (defect_ == 3) grid2d(true);
+      else                   triangulation(true);
+      break;
+    }
+
+  out << "\n</points-observations>\n</network>\n</gama-local>\n";
+
+  out.flags(flags);
+  out.precision(prec);
+}
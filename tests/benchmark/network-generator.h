@@ -0,0 +1,91 @@
+/* GNU Gama -- synthetic local geodetic networks for benchmarks
+   Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#ifndef NETWORK_GENERATOR_H
+#define NETWORK_GENERATOR_H
+
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Generates gama-local XML input (gkf) of parametrised synthetic
+ * networks with approximately the given number of unknowns.
+ *
+ * Observations are computed from true coordinates with normally
+ * distributed errors, approximate coordinates of adjusted points are
+ * shifted by a few centimeters. The same seed gives the same network.
+ *
+ *   grid           2D square grid, directions and distances to neighbours
+ *   traverse       single traverse between two pairs of fixed points
+ *   triangulation  2D triangular mesh, directions only
+ *   leveling       square grid of leveling lines
+ *   gnss           3D square grid of GNSS vectors
+ *   free           free network, all points constrained; datum defect
+ *                  1 (leveling), 3 (grid) or 4 (triangulation)
+ */
+class NetworkGenerator {
+public:
+
+  enum class Type { grid, traverse, triangulation, leveling, gnss, free };
+
+  static const std::vector<Type>& types();
+  static std::string name(Type);
+  static bool type(const std::string&, Type&);
+
+  NetworkGenerator(Type t, int unknowns, int defect = 3, unsigned seed = 1);
+
+  void write_gkf(std::ostream&);
+
+  Type type()     const { return type_;     }
+  int  defect()   const { return defect_;   }
+  int  points()   const { return int(pts_.size()); }
+
+private:
+
+  struct Point {
+    double x, y, z;
+    bool   fixed;
+  };
+
+  Type type_;
+  int  defect_;
+  int  side_ {0};      // points in a row of grid or mesh
+  std::mt19937 rnd_;
+  std::vector<Point> pts_;
+
+  // standard deviations of observations [mm], [cc]
+  const double distance_stdev_  = 5.0;
+  const double direction_stdev_ = 10.0;
+  const double vector_stdev_    = 5.0;
+  const double approx_shift_    = 30.0;
+
+  double noise(double stdev);
+  double bearing(int from, int to) const;   // [gon]
+  double distance(int from, int to) const;  // [m]
+
+  void grid_points(int m, double step, bool with_z);
+  void mesh_points(int m, double step);
+  void write_points(std::ostream&, const char* fixed, const char* adjusted,
+                    bool xy, bool z);
+  void write_station(std::ostream&, int from, const std::vector<int>& to,
+                     bool directions, bool distances);
+};
+
+#endif
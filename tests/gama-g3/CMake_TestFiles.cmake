@@ -4,6 +4,9 @@ set(INPUT_FILES
     "demo-g3-02"
     "demo-g3-03")
 
+set(ITERATION_FILES
+    "demo-g3-04")
+
 set(SJTSK05_FILES
     "dopnul"
     "vyberova_udrzba")
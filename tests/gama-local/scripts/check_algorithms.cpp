@@ -52,6 +52,8 @@ int main(int argc, char* argv[])
   algname.push_back(" gso ");   algorithm.push_back(getNet(alg_gso,  argv[3]));
   algname.push_back(" chol");   algorithm.push_back(getNet(alg_chol, argv[3]));
   algname.push_back(" env ");   algorithm.push_back(getNet(alg_env,  argv[3]));
+  algname.push_back(" snod");   algorithm.push_back(getNet(alg_snode,argv[3]));
+  algname.push_back(" svdj");   algorithm.push_back(getNet(alg_svdj, argv[3]));
 
   condnum = algorithm[0]->cond();
 
@@ -81,5 +83,22 @@ int main(int argc, char* argv[])
           }
       }
 
+  // Jacobi SVD on 2 threads and on 1 thread must give identical results
+
+  LocalNetwork* svdj1 = getNet(alg_svdj1, argv[3]);
+  maxdiff = xyzMaxDiff(algorithm[5], svdj1);
+  std::cout << "threads  max.diff"
+            << std::scientific << std::setprecision(3) << std::setw(11)
+            << maxdiff << " [m]  svdj svdj1  " << netconfig;
+  if (maxdiff == 0)
+    {
+      std::cout << "\n";
+    }
+  else
+    {
+      failed = true;
+      std::cout << "  !!!\n";
+    }
+
   if (failed) return 1;
 }
@@ -0,0 +1,201 @@
+/* GNU Gama -- testing concurrent adjustments of independent networks
+   Copyright (C) 2020  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gnu_gama/ellipsoids.h>
+#include <gnu_gama/xml/gkfparser.h>
+#include <gnu_gama/local/network.h>
+#include <gnu_gama/local/language.h>
+#include <gnu_gama/local/acord/acord2.h>
+#include <gnu_gama/local/acord/acordstatistics.h>
+#include <gnu_gama/local/test_linearization_visitor.h>
+#include <gnu_gama/local/results/text/adjusted_observations.h>
+#include <gnu_gama/local/results/text/adjusted_unknowns.h>
+#include <gnu_gama/local/results/text/approximate_coordinates.h>
+#include <gnu_gama/local/results/text/error_ellipses.h>
+#include <gnu_gama/local/results/text/fixed_points.h>
+#include <gnu_gama/local/results/text/general_parameters.h>
+#include <gnu_gama/local/results/text/network_description.h>
+#include <gnu_gama/local/results/text/reduced_observations_to_ellipsoid.h>
+#include <gnu_gama/local/results/text/residuals_observations.h>
+
+/* Independent networks are adjusted serially and then concurrently
+ * (several jobs per network, even jobs in gons, odd jobs in degrees,
+ * english and czech texts of networks in alternating pairs of jobs),
+ * text outputs of all jobs must be identical to the serial runs.
+ */
+
+namespace {
+
+  using namespace GNU_gama::local;
+
+  struct Job
+  {
+    std::string   file;
+    bool          gons;
+    gama_language lang;
+  };
+
+  std::string adjust(const Job& job)
+  {
+    std::ostringstream out;
+    std::unique_ptr<LocalNetwork> lnet(new LocalNetwork);
+    lnet->set_language(job.lang);
+
+    std::ifstream inp(job.file);
+    if (!inp) return "cannot open " + job.file;
+    {
+      using GNU_gama::local::GKFparser::operator>>;
+      inp >> *lnet;
+    }
+    if (job.gons) lnet->set_gons();
+    else          lnet->set_degrees();
+
+    lnet->remove_inconsistency();
+
+    AcordStatistics stats(lnet->PD, lnet->OD);
+    Acord2 acord2(lnet->PD, lnet->OD);
+    acord2.execute();
+
+    if (lnet->correction_to_ellipsoid())
+      {
+        GNU_gama::gama_ellipsoid elnum =
+          GNU_gama::ellipsoid(lnet->ellipsoid().c_str());
+        GNU_gama::Ellipsoid el {};
+        GNU_gama::set(&el, elnum);
+        ReduceToEllipsoid reduce_to_el(lnet->PD, lnet->OD, el, lnet->latitude());
+        reduce_to_el.execute();
+        ReducedObservationsToEllipsoidText(lnet.get(), reduce_to_el.getMap(), out);
+      }
+
+    stats.execute();
+    ApproximateCoordinates(&stats, out, lnet->texts());
+
+    if (lnet->huge_abs_terms()) lnet->remove_huge_abs_terms();
+
+    if (GeneralParameters(lnet.get(), out))
+      {
+        lnet->clear_linearization_iterations();
+        while (lnet->next_linearization_iterations() && TestLinearization(lnet.get()))
+          {
+            lnet->increment_linearization_iterations();
+            lnet->refine_approx();
+          }
+
+        NetworkDescription(lnet->description, out, lnet->texts());
+        GeneralParameters (lnet.get(), out);
+        FixedPoints       (lnet.get(), out);
+        AdjustedUnknowns  (lnet.get(), out);
+        ErrorEllipses     (lnet.get(), out);
+        AdjustedObservations (lnet.get(), out);
+        ResidualsObservations(lnet.get(), out);
+      }
+
+    return out.str();
+  }
+
+  std::string adjust_noexcept(const Job& job)
+  {
+    try
+      {
+        return adjust(job);
+      }
+    catch (const std::exception& e)
+      {
+        return std::string("exception : ") + e.what();
+      }
+    catch (...)
+      {
+        return "unknown exception";
+      }
+  }
+
+}  // unnamed namespace
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 4)
+    {
+      std::cout << "\nusage: " << argv[0]
+                << "  threads  repetitions  file.gkf ...\n\n";
+      return 1;
+    }
+
+  set_gama_language(en);
+
+  int threads     = std::atoi(argv[1]);
+  int repetitions = std::atoi(argv[2]);
+  if (threads     <= 0) threads = std::thread::hardware_concurrency();
+  if (threads     <= 0) threads = 2;
+  if (repetitions <= 0) repetitions = 1;
+
+  std::vector<Job> jobs;
+  for (int r=0; r<repetitions; r++)
+    for (int f=3; f<argc; f++)
+      jobs.push_back({argv[f], (jobs.size() % 2) == 0,
+                      (jobs.size() / 2) % 2 ? cz : en});
+
+  std::vector<std::string> serial(jobs.size());
+  for (std::size_t j=0; j<jobs.size(); j++)
+    serial[j] = adjust_noexcept(jobs[j]);
+
+  std::vector<std::string> concurrent(jobs.size());
+  std::atomic<std::size_t> next {0};
+  std::vector<std::thread> pool;
+  for (int t=0; t<threads; t++)
+    pool.emplace_back([&]()
+      {
+        for (std::size_t j; (j = next++) < jobs.size(); )
+          concurrent[j] = adjust_noexcept(jobs[j]);
+      });
+  for (auto& t : pool) t.join();
+
+  int failed = 0;
+  for (std::size_t j=0; j<jobs.size(); j++)
+    {
+      bool ok = concurrent[j] == serial[j] && !serial[j].empty();
+      if (!ok) failed++;
+      if (j < std::size_t(argc-3) || !ok)
+        std::cout << (ok ? "  passed  " : "FAILED    ")
+                  << (jobs[j].gons ? "gon " : "deg ")
+                  << (jobs[j].lang == en ? "en " : "cz ") << jobs[j].file << "\n";
+    }
+
+  // texts are written in the language of each network
+  if (adjust_noexcept({argv[3], true, en}) == adjust_noexcept({argv[3], true, cz}))
+    {
+      failed++;
+      std::cout << "FAILED    en and cz texts are identical " << argv[3] << "\n";
+    }
+
+  std::cout << "threads " << threads << ", jobs " << jobs.size()
+            << ", failed " << failed << "\n";
+
+  return failed ? 1 : 0;
+}
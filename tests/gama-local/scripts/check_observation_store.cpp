@@ -0,0 +1,313 @@
+/*
+  GNU Gama -- testing ObservationStore partitioning of observations
+  Copyright (C) 2026  GNU Gama developers
+
+  This file is part of the GNU Gama C++ library
+
+  GNU Gama is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GNU Gama is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <gnu_gama/local/cluster.h>
+#include <gnu_gama/local/observation_store.h>
+
+using namespace GNU_gama::local;
+
+namespace
+{
+  int error = 0;
+
+  void check(bool test, const std::string& text)
+  {
+    if (!test)
+      {
+        std::cout << "failed : " << text << "\n";
+        error++;
+      }
+  }
+
+  using Cluster = GNU_gama::Cluster<Observation>;
+
+  // clusters of all types in the order of the input, each type of
+  // observations appears in more than one cluster
+
+  void network(ObservationData& od)
+  {
+    StandPoint* sp1 = new StandPoint(&od);
+    sp1->observation_list.push_back(new Direction("A", "B", 0.1));
+    sp1->observation_list.push_back(new Distance ("A", "B", 100.0));
+    sp1->observation_list.push_back(new Direction("A", "C", 0.7));
+    sp1->observation_list.push_back(new Angle    ("A", "B", "C", 0.6));
+    sp1->observation_list.push_back(new Distance ("A", "C", 120.0));
+    od.clusters.push_back(sp1);
+
+    HeightDifferences* hd = new HeightDifferences(&od);
+    hd->observation_list.push_back(new H_Diff("A", "B", 1.5, 0.1));
+    hd->observation_list.push_back(new H_Diff("B", "C", -0.5, 0.2));
+    od.clusters.push_back(hd);
+
+    Coordinates* co = new Coordinates(&od);
+    co->observation_list.push_back(new X("A", 1000.0));
+    co->observation_list.push_back(new Y("A", 2000.0));
+    co->observation_list.push_back(new Z("A", 300.0));
+    od.clusters.push_back(co);
+
+    Vectors* ve = new Vectors(&od);
+    ve->observation_list.push_back(new Xdiff("A", "B", 10.0));
+    ve->observation_list.push_back(new Ydiff("A", "B", 20.0));
+    ve->observation_list.push_back(new Zdiff("A", "B", 1.5));
+    od.clusters.push_back(ve);
+
+    StandPoint* sp2 = new StandPoint(&od);
+    sp2->observation_list.push_back(new S_Distance("B", "C", 80.0));
+    sp2->observation_list.push_back(new Z_Angle   ("B", "C", 1.6));
+    sp2->observation_list.push_back(new Azimuth   ("B", "C", 2.1));
+    sp2->observation_list.push_back(new Distance  ("B", "C", 79.9));
+    sp2->observation_list.push_back(new Direction ("B", "A", 3.0));
+    od.clusters.push_back(sp2);
+
+    for (Cluster* c : od.clusters) c->update();
+  }
+
+  // active observations in the order of clusters, as the list of
+  // revised observations in LocalNetwork
+
+  std::vector<Observation*> revised(const ObservationData& od)
+  {
+    std::vector<Observation*> list;
+    for (const Cluster* c : od.clusters)
+      for (Observation* m : c->observation_list)
+        if (m->active()) list.push_back(m);
+
+    return list;
+  }
+
+  // expected sequence of positions: blocks in the fixed order of types,
+  // rows within a block in the order of the list
+
+  template <typename T>
+  void rows_of(const std::vector<Observation*>& list, std::vector<int>& rows)
+  {
+    for (int r=0; r<int(list.size()); r++)
+      if (dynamic_cast<T*>(list[r])) rows.push_back(r);
+  }
+
+  std::vector<int> expected(const std::vector<Observation*>& list)
+  {
+    std::vector<int> rows;
+    rows_of<Distance>  (list, rows);
+    rows_of<Direction> (list, rows);
+    rows_of<Angle>     (list, rows);
+    rows_of<H_Diff>    (list, rows);
+    rows_of<S_Distance>(list, rows);
+    rows_of<Z_Angle>   (list, rows);
+    rows_of<X>         (list, rows);
+    rows_of<Y>         (list, rows);
+    rows_of<Z>         (list, rows);
+    rows_of<Xdiff>     (list, rows);
+    rows_of<Ydiff>     (list, rows);
+    rows_of<Zdiff>     (list, rows);
+    rows_of<Azimuth>   (list, rows);
+    return rows;
+  }
+
+  class Sequence : public AllObservationsVisitor
+  {
+  public:
+    std::vector<const Observation*> obs;
+
+    void visit(Distance* m)   { obs.push_back(m); }
+    void visit(Direction* m)  { obs.push_back(m); }
+    void visit(Angle* m)      { obs.push_back(m); }
+    void visit(H_Diff* m)     { obs.push_back(m); }
+    void visit(S_Distance* m) { obs.push_back(m); }
+    void visit(Z_Angle* m)    { obs.push_back(m); }
+    void visit(X* m)          { obs.push_back(m); }
+    void visit(Y* m)          { obs.push_back(m); }
+    void visit(Z* m)          { obs.push_back(m); }
+    void visit(Xdiff* m)      { obs.push_back(m); }
+    void visit(Ydiff* m)      { obs.push_back(m); }
+    void visit(Zdiff* m)      { obs.push_back(m); }
+    void visit(Azimuth* m)    { obs.push_back(m); }
+  };
+
+  const LocalPoint* point(const PointData& pd, const PointID& id)
+  {
+    PointData::const_iterator p = pd.find(id);
+    return p != pd.end() ? &p->second : nullptr;
+  }
+
+  void check_store(const ObservationStore& store, const PointData& pd,
+                   const std::vector<Observation*>& list,
+                   const std::string& text)
+  {
+    check(store.size() == int(list.size()), text + " : size");
+
+    // observations are not copied, rows point back to the list
+
+    bool same = true;
+    store.for_each([&](const auto* m, int row)
+      {
+        same = same && row >= 0 && row < int(list.size()) && list[row] == m;
+      });
+    check(same, text + " : rows of observations");
+
+    // iteration order of for_each, for_range and accept
+
+    std::vector<int> rows;
+    store.for_each([&](const auto*, int row) { rows.push_back(row); });
+    check(rows == expected(list), text + " : iteration order");
+
+    bool ranges = true;
+    for (int k=0; k<=store.size(); k++)
+      {
+        std::vector<int> split;
+        store.for_range(0, k, [&](const auto*, int row) { split.push_back(row); });
+        store.for_range(k, store.size(),
+                        [&](const auto*, int row) { split.push_back(row); });
+        ranges = ranges && split == rows;
+      }
+    check(ranges, text + " : for_range");
+
+    // numeric fields of blocks, items in the order of for_range
+
+    std::vector<int> items;
+    bool fields = true;
+    store.for_items(0, store.size(), [&](const auto& b, int i)
+      {
+        using T = std::remove_pointer_t<
+                    typename std::decay_t<decltype(b.obs)>::value_type>;
+        const T* m = b.obs[i];
+        items.push_back(b.row[i]);
+        fields = fields && b.value[i] == m->value()
+                        && b.from[i] == point(pd, m->from());
+        if constexpr (std::is_same<T, X>::value || std::is_same<T, Y>::value
+                      || std::is_same<T, Z>::value)
+          fields = fields && b.to[i] == nullptr;
+        else
+          fields = fields && b.to[i] == point(pd, m->to());
+        if constexpr (std::is_same<T, Angle>::value)
+          fields = fields && b.fs[i] == point(pd, m->fs());
+      });
+    check(items == rows, text + " : for_items");
+    check(fields, text + " : values and points");
+
+    Sequence sequence;
+    store.accept(&sequence);
+    bool visited = sequence.obs.size() == rows.size();
+    for (std::size_t i=0; visited && i<rows.size(); i++)
+      visited = sequence.obs[i] == list[rows[i]];
+    check(visited, text + " : accept");
+
+    // rows of each cluster are contiguous and follow the cluster order
+
+    std::map<const Cluster*, std::vector<int>> clusters;
+    store.for_each([&](const auto* m, int row)
+      {
+        clusters[m->ptr_cluster()].push_back(row);
+      });
+
+    bool contiguous = true;
+    int next = 0;
+    for (const Observation* m : list)
+      {
+        std::vector<int>& c = clusters[m->ptr_cluster()];
+        if (c.empty()) continue;
+        std::sort(c.begin(), c.end());
+        contiguous = contiguous && c.front() == next
+                                && c.back() == next + int(c.size()) - 1;
+        next += int(c.size());
+        c.clear();
+      }
+    check(contiguous && next == store.size(), text + " : clusters");
+  }
+}
+
+int main()
+{
+  ObservationData od;
+  network(od);
+
+  // insertion
+
+  // missing points are inserted
+
+  PointData pd;
+  pd["A"].set_xy(0, 0);
+  pd["B"].set_xy(100, 0);
+
+  std::vector<Observation*> list = revised(od);
+  ObservationStore store;
+  store.build(list, pd);
+
+  check(pd.size() == 3 && pd.count("C") == 1, "points of observations");
+  check_store(store, pd, list, "all observations");
+  check(store.block<Distance>().obs.size()  == 3, "block of distances");
+  check(store.block<Direction>().obs.size() == 3, "block of directions");
+  check(store.block<H_Diff>().obs.size()    == 2, "block of height differences");
+  check(store.block<Azimuth>().row ==
+        std::vector<int>{int(list.size()) - 3}, "row of azimuth");
+
+  // removal of observations, the store is rebuilt from the revised list
+
+  for (Cluster* c : od.clusters)
+    for (Observation* m : c->observation_list)
+      if (dynamic_cast<Distance*>(m) || dynamic_cast<Y*>(m) ||
+          dynamic_cast<H_Diff*>(m)) m->set_passive();
+
+  list = revised(od);
+  store.build(list, pd);
+
+  check_store(store, pd, list, "active observations");
+  check(store.block<Distance>().obs.empty() &&
+        store.block<Y>().obs.empty() &&
+        store.block<H_Diff>().obs.empty(), "removed blocks");
+  check(store.block<X>().row == std::vector<int>{3}, "row of x after removal");
+
+  // removal of a whole cluster
+
+  Cluster* first = od.clusters.front();
+  for (Observation* m : first->observation_list) m->set_passive();
+
+  list = revised(od);
+  store.build(list, pd);
+
+  check_store(store, pd, list, "without first cluster");
+
+  // values are copied again after reductions of observations
+
+  for (Observation* m : list) m->set_value(m->value() + 1);
+  store.gather();
+  check_store(store, pd, list, "gathered values");
+  bool removed = true;
+  store.for_each([&](const auto* m, int)
+    {
+      removed = removed && m->ptr_cluster() != first;
+    });
+  check(removed, "observations of removed cluster");
+
+  store.clear();
+  int visits = 0;
+  store.for_each([&](const auto*, int) { visits++; });
+  check(store.size() == 0 && visits == 0 &&
+        store.block<Direction>().obs.empty(), "cleared store");
+
+  std::cout << (error ? "failed" : "passed") << "\n";
+  return error;
+}
@@ -0,0 +1,158 @@
+/*
+  GNU Gama -- testing point identifiers and lookups in PointData
+  Copyright (C) 2026  GNU Gama developers
+
+  This file is part of the GNU Gama C++ library
+
+  GNU Gama is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GNU Gama is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <gnu_gama/local/gamadata.h>
+
+using GNU_gama::local::PointID;
+using GNU_gama::local::PointData;
+
+namespace
+{
+  int error = 0;
+
+  void check(bool test, const std::string& text)
+  {
+    if (!test)
+      {
+        std::cout << "failed : " << text << "\n";
+        error++;
+      }
+  }
+
+  std::string name(int i)
+  {
+    return (i % 3 == 0) ? "p" + std::to_string(i) : std::to_string(i);
+  }
+}
+
+int main()
+{
+  // normalization of identifiers, equal identifiers share the hash
+
+  PointID a("  A   12 "), b("A 12"), c("A\t12"), d("A 13");
+  check(a.str() == "A 12", "normalized identifier 'A 12'");
+  check(a == b && b == c, "equality of normalized identifiers");
+  check(!(a != b), "inequality of equal identifiers");
+  check(a != d, "inequality of different identifiers");
+  check(a.hash() == b.hash() && a.hash() == c.hash(), "hash of equal identifiers");
+  check(std::hash<PointID>()(a) == a.hash(), "std::hash of PointID");
+  check(PointID() == PointID(""), "empty identifier");
+  check(PointID("").str().empty(), "empty identifier string");
+
+  // ordering: numeric identifiers first and by value, then by string
+
+  check(PointID("2")  < PointID("10"), "numeric ordering 2 < 10");
+  check(!(PointID("10") < PointID("2")), "numeric ordering !(10 < 2)");
+  check(PointID("10") < PointID("A"),  "numeric before string");
+  check(!(PointID("A") < PointID("10")), "string after numeric");
+  check(PointID("10") < PointID("010"), "'010' is not numeric");
+  check((PointID("A2") < PointID("A10")) == (std::string("A2") < "A10"),
+        "string ordering");
+  check(!(a < b) && !(b < a), "ordering of equal identifiers");
+
+  // lookups in PointData
+
+  PointData pd;
+  const int N = 1000;
+  for (int i=0; i<N; i++) pd[name(i)].set_xy(i, -i);
+
+  check(int(pd.size()) == N, "size of PointData");
+  bool found = true;
+  for (int i=0; i<N; i++)
+    {
+      auto p = pd.find(" " + name(i) + " ");
+      found = found && p != pd.end() && p->first == PointID(name(i))
+                    && p->second.x() == i;
+    }
+  check(found, "find all points");
+  check(pd.count("p1") == 0 && pd.find("p1") == pd.end(), "missing point");
+
+  PointID prev;
+  bool ordered = true;
+  for (auto i=pd.begin(); i!=pd.end(); ++i)
+    {
+      if (i != pd.begin()) ordered = ordered && prev < i->first;
+      prev = i->first;
+    }
+  check(ordered, "iteration order of PointData");
+  check(pd.begin()->first == PointID("1"), "first point");
+
+  // erasing, reinserting and copies keep the index consistent
+
+  pd.erase("p3");
+  pd.erase(pd.find("4"));
+  check(pd.count("p3") == 0 && pd.count("4") == 0, "erased points");
+  check(int(pd.size()) == N - 2, "size after erase");
+  pd["p3"].set_xy(-1, -1);
+  check(pd.count("p3") == 1 && pd.find("p3")->second.x() == -1,
+        "reinserted point");
+
+  PointData many;
+  for (int i=0; i<N; i++) many[name(i)].set_xy(i, i);
+  for (int i=0; i<N; i+=2) many.erase(name(i));
+  many.erase(many.find(name(1)), many.find(name(7)));
+  bool consistent = many.size() == std::size_t(N/2 - 2);
+  for (int i=0; i<N; i++)
+    {
+      auto p = many.find(name(i));
+      const bool erased = i % 2 == 0 || i == 1 || i == 5;
+      consistent = consistent && (p == many.end()) == erased
+                              && (erased || p->second.x() == i);
+    }
+  for (int i=0; i<N; i+=2) many[name(i)].set_xy(-i, 0);
+  for (int i=0; i<N; i+=2)
+    consistent = consistent && many.find(name(i))->second.x() == -i;
+  std::size_t counted = 0;
+  for (int i=0; i<N; i++) counted += many.count(name(i));
+  check(consistent && counted == many.size(),
+        "lookups after erasing and reinserting many points");
+
+  PointData copy(pd);
+  pd.clear();
+  check(pd.empty() && pd.count("5") == 0, "cleared PointData");
+  check(int(copy.size()) == N - 1 && copy.find("5") != copy.end()
+        && copy.find("5")->second.x() == 5, "copy of PointData");
+
+  PointData assigned;
+  assigned["X"];
+  assigned = copy;
+  check(assigned.count("X") == 0 && assigned.count("p6") == 1,
+        "assigned PointData");
+
+  // concurrent read-only lookups in independent networks
+
+  std::vector<int> hits(4, 0);
+  std::vector<std::thread> threads;
+  for (int t=0; t<4; t++)
+    threads.emplace_back([&, t]() {
+        const PointData& net = t % 2 ? copy : assigned;
+        for (int i=0; i<N; i++) hits[t] += int(net.count(name(i)));
+      });
+  for (auto& t : threads) t.join();
+  for (int h : hits) check(h == N - 1, "concurrent lookups");
+
+  std::cout << (error ? "failed" : "passed") << "\n";
+  return error;
+}
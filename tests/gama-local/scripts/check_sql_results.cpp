@@ -0,0 +1,139 @@
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <map>
+#include <string>
+#include <gnu_gama/xml/localnetwork_adjustment_results.h>
+
+/* Compares adjustment results written by gama-local into the sqlite
+ * database (--sqlitedb db --configuration name) with XML results of
+ * the same run.
+ */
+
+static sqlite3* database;
+
+static double maxdiff(double diff, double a, double b)
+{
+  double d = a - b;
+  return std::abs(d) > std::abs(diff) ? d : diff;
+}
+
+static sqlite3_stmt* query(const char* sql, const std::string& conf)
+{
+  sqlite3_stmt* stmt = 0;
+  if (sqlite3_prepare_v2(database, sql, -1, &stmt, 0) != SQLITE_OK)
+    {
+      std::cout << "DB prepare error " << sqlite3_errmsg(database) << "\n";
+      return 0;
+    }
+  sqlite3_bind_text(stmt, 1, conf.c_str(), -1, SQLITE_TRANSIENT);
+  return stmt;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace GNU_gama;
+
+  if (argc != 4)
+    {
+      std::cout << "\nusage: " << argv[0] << "  file.db  configuration  file.xml\n\n";
+      return 1;
+    }
+
+  LocalNetworkAdjustmentResults xml;
+  try {
+    std::ifstream inp_xml(argv[3]);
+    if (!inp_xml) {
+      std::cout << "   ####  ERROR ON OPENING FILE " << argv[3] << "\n";
+      return 1;
+    }
+    xml.read_xml(inp_xml);
+  }
+  catch (GNU_gama::Exception::parser& e)
+    {
+      std::cout  << argv[3] << " "
+                 << e.line << " " << e.error_code << " " << e.what() << "\n";
+      return 1;
+    }
+
+  if (sqlite3_open_v2(argv[1], &database, SQLITE_OPEN_READONLY, 0) != SQLITE_OK)
+    {
+      std::cout << "DB open error " << argv[1] << "\n";
+      return 1;
+    }
+  const std::string conf = argv[2];
+  const char* cnfg = " where conf_id = (select conf_id from gnu_gama_local_configurations"
+                     " where conf_name = ?1)";
+
+  double dxyz = 0;
+  std::map<std::string, const LocalNetworkAdjustmentResults::Point*> points;
+  for (const auto& p : xml.adjusted_points) points[p.id] = &p;
+
+  sqlite3_stmt* stmt = query((std::string("select id, x, y, z "
+                              "from gnu_gama_local_adj_coordinates")
+                              + cnfg).c_str(), conf);
+  int npoints = 0;
+  while (stmt && sqlite3_step(stmt) == SQLITE_ROW)
+    {
+      auto p = points.find(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+      if (p == points.end()) continue;
+      npoints++;
+      const LocalNetworkAdjustmentResults::Point& b = *p->second;
+      if (b.hxy && sqlite3_column_type(stmt, 1) != SQLITE_NULL)
+        {
+          dxyz = maxdiff(dxyz, sqlite3_column_double(stmt, 1), b.x);
+          dxyz = maxdiff(dxyz, sqlite3_column_double(stmt, 2), b.y);
+        }
+      if (b.hz && sqlite3_column_type(stmt, 3) != SQLITE_NULL)
+        dxyz = maxdiff(dxyz, sqlite3_column_double(stmt, 3), b.z);
+    }
+  sqlite3_finalize(stmt);
+
+  double dcov = 0;
+  stmt = query((std::string("select rind, cind, val "
+                "from gnu_gama_local_adj_covmat") + cnfg).c_str(), conf);
+  int ncov = 0;
+  while (stmt && sqlite3_step(stmt) == SQLITE_ROW)
+    {
+      int i = sqlite3_column_int(stmt, 0);
+      int j = sqlite3_column_int(stmt, 1);
+      if (j - i > int(xml.cov.bandWidth())) continue;
+      ncov++;
+      double a = sqlite3_column_double(stmt, 2);
+      double b = xml.cov(i,j);
+      double s = std::max(1.0, std::abs(b));  // relative difference
+      dcov = maxdiff(dcov, a/s, b/s);
+    }
+  sqlite3_finalize(stmt);
+
+  double dres = 0;
+  stmt = query((std::string("select indx, std_resid "
+                "from gnu_gama_local_adj_observations") + cnfg).c_str(), conf);
+  std::size_t nres = 0;
+  while (stmt && sqlite3_step(stmt) == SQLITE_ROW)
+    {
+      nres++;
+      std::size_t i = sqlite3_column_int(stmt, 0);
+      if (i < 1 || i > xml.obslist.size()) return 1;
+      if (sqlite3_column_type(stmt, 1) != SQLITE_NULL)
+        dres = maxdiff(dres, std::abs(sqlite3_column_double(stmt, 1)),
+                       std::abs(xml.obslist[i-1].std_residual));
+    }
+  sqlite3_finalize(stmt);
+  sqlite3_close(database);
+
+  std::cout.precision(4);
+  std::cout << "         max.diff xyz" << std::setw(11) << dxyz << " [m] "
+            << " cov" << std::setw(11) << dcov
+            << " std.resid" << std::setw(11) << dres
+            << "  " << conf << "\n";
+
+  if (npoints != int(xml.adjusted_points.size())) return 1;
+  if (ncov == 0 || nres != xml.obslist.size())    return 1;
+  if (std::abs(dxyz) >= 1e-4 || std::abs(dcov) >= 1e-3
+      || std::abs(dres) >= 1e-2) return 1;
+}
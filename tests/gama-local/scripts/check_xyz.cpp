@@ -100,6 +100,20 @@ GNU_gama::local::LocalNetwork* getNet(int alg, const char* file)
     case 3:
       lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::envelope);
       break;
+    case 4:
+      lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::supernodal);
+      break;
+    case 5:
+      lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::svd);
+      lnet->set_svd_method(GNU_gama::SVDMethod::jacobi);
+      lnet->set_threads(2);
+      GNU_gama::set_svd_parallel_work(0);   // small networks on 2 threads
+      break;
+    case 6:
+      lnet->set_algorithm(GNU_gama::local::LocalNetwork::Algorithm::svd);
+      lnet->set_svd_method(GNU_gama::SVDMethod::jacobi);
+      lnet->set_threads(1);
+      break;
     }
 
   using namespace GNU_gama::local;
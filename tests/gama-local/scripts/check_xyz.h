@@ -22,7 +22,7 @@
 
 #include <gnu_gama/local/network.h>
 
-enum {alg_svd, alg_gso, alg_chol, alg_env};
+enum {alg_svd, alg_gso, alg_chol, alg_env, alg_snode, alg_svdj, alg_svdj1};
 
 double                     xyzMaxDiff(GNU_gama::local::LocalNetwork* lnet1, 
 				      GNU_gama::local::LocalNetwork* lnet2);
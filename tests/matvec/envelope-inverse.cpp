@@ -0,0 +1,77 @@
+/* envelope-inverse.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/envelope.h>
+#include <Math/Service/smatrix.h>
+#include <Math/Service/smatrix_graph.h>
+#include <Math/Service/smatrix_ordering.h>
+#include <Math/Service/matvec.h>
+#include "test-networks.h"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* selected inversion of envelope decomposition compared with elements
+   of the dense inverse of normal equations */
+
+int main()
+{
+  cout << "\n   envelope selected inversion  ...  envelope-inverse\n"
+       << "------------------------------------------------------\n\n";
+
+  // chain of 2D points with one fixed point
+
+  const int points = 40;
+  const int N = 2*points;
+  SparseMatrix<>* A = TestNetworks::chain(points, true);
+
+  SparseMatrixGraph<> graph(A);
+  ReverseCuthillMcKee<> ordering;
+  ordering.reset(&graph);
+
+  Envelope<double,int> chol(A, &graph, &ordering);
+  chol.cholDec();
+  Envelope<double,int> q;
+  q.inverse(chol);
+
+  Mat<> Nm(N, N);
+  Nm.set_zero();
+  for (int r=1; r<=A->rows(); r++)
+    for (double *b=A->begin(r), *e=A->end(r); b!=e; b++)
+      for (double *c=A->begin(r); c!=e; c++)
+        Nm(A->ibegin(r)[b-A->begin(r)], A->ibegin(r)[c-A->begin(r)]) += *b * *c;
+  Mat<> Q = inv(Nm);
+
+  double maxdif = 0;
+  int count = 0;
+  for (int i=1; i<=N; i++)
+    for (int j=1; j<=N; j++)
+      if (const double* z = q.element(ordering.invp(i), ordering.invp(j)))
+        {
+          maxdif = std::max(maxdif, std::abs(*z - Q(i,j))/std::abs(Q(i,i)));
+          count++;
+        }
+
+  cout << "elements " << count << "  defect " << chol.defect()
+       << "  maxdif " << maxdif << "\n";
+
+  delete A;
+  return (chol.defect() == 0 && maxdif < 1e-10) ? 0 : 1;
+}
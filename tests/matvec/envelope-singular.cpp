@@ -0,0 +1,120 @@
+/* envelope-singular.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/adj.h>
+#include <Math/Business/Adjustment/adj_envelope.h>
+#include "test-networks.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* weight coefficients of a free network (regularized solution) from
+   the envelope algorithm, single elements q_xx() and rows of the full
+   band q_xx_selected(), compared with the SVD solution */
+
+namespace {
+
+  const int points = 30;
+  const int N = 2*points;
+
+  void input(AdjInputData& data, int minx)
+  {
+    // chain of 2D points, translation is not defined
+
+    SparseMatrix<>* A = TestNetworks::chain(points, false);
+    const int rows = A->rows();
+    Vec<> rhs(rows);
+    for (int r=1; r<=rows; r++)
+      rhs(r) = r % 2 ? std::sin(1.7*r) : std::cos(1.3*r);
+
+    BlockDiagonal<>* cov = new BlockDiagonal<>(1, rows);
+    vector<double> mem(rows, 1.0);
+    cov->add_block(rows, 0, mem.data());
+
+    IntegerList<>* list = new IntegerList<>(minx);
+    IntegerList<>::iterator m = list->begin();
+    for (int i=1; i<=minx; i++) *m++ = N - minx + i;
+
+    data.set_mat(A);
+    data.set_cov(cov);
+    data.set_rhs(rhs);
+    data.set_minx(list);
+  }
+
+}
+
+int main()
+{
+  cout << "\n   envelope weight coefficients of singular system  ...  envelope-singular\n"
+       << "---------------------------------------------------------------------------\n\n";
+
+  int failed = 0;
+  for (int minx : { N, 10 })
+    {
+      AdjInputData data;
+      input(data, minx);
+
+      Adj svd;
+      svd.set(&data);
+      svd.set_algorithm(Adj::svd);
+
+      Adj env;
+      env.set(&data);
+      env.set_algorithm(Adj::envelope);
+
+      svd.x();
+      env.x();
+
+      AdjEnvelope<double, int, Exception::matvec> selected;
+      vector<int> list(data.minx()->begin(), data.minx()->end());
+      selected.min_x(int(list.size()), list.data());
+      selected.reset(&data);
+
+      double maxdif = 0;
+      vector<int> qi(N), qj(N);
+      vector<double> q(N);
+      for (int i=1; i<=N; i++)
+        {
+          for (int j=1; j<=N; j++)
+            {
+              qi[j-1] = i;
+              qj[j-1] = j;
+            }
+          selected.q_xx_selected(N, qi.data(), qj.data(), q.data());
+
+          for (int j=1; j<=N; j++)
+            {
+              const double s = svd.q_xx(i,j);
+              const double e = env.q_xx(i,j);
+              const double scale = std::sqrt(svd.q_xx(i,i)*svd.q_xx(j,j));
+              maxdif = std::max(maxdif, std::abs(e - s)/scale);
+              maxdif = std::max(maxdif, std::abs(q[j-1] - s)/scale);
+            }
+        }
+
+      if (env.defect() != 2 || maxdif > 1e-9) failed++;
+
+      cout << "regularized " << minx << "  defect " << env.defect()
+           << "  maxdif " << maxdif << "\n";
+    }
+
+  return failed;
+}
@@ -0,0 +1,86 @@
+/* envelope-threads.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/envelope.h>
+#include <Math/Service/smatrix.h>
+#include <Math/Service/smatrix_graph.h>
+#include <Math/Service/smatrix_ordering.h>
+#include "test-networks.h"
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace GNU_gama;
+
+bool identical(const Envelope<double,int>& a, const Envelope<double,int>& b)
+{
+  if (a.dim() != b.dim() || a.defect() != b.defect()) return false;
+
+  for (int i=1; i<=a.dim(); i++)
+    {
+      const double da = a.diagonal(i);
+      const double db = b.diagonal(i);
+      if (memcmp(&da, &db, sizeof(double))) return false;
+
+      const int n = a.end(i) - a.begin(i);
+      if (n != b.end(i) - b.begin(i) ||
+          memcmp(a.begin(i), b.begin(i), n*sizeof(double))) return false;
+    }
+
+  return true;
+}
+
+int main()
+{
+  cout << "\n   multi-threaded envelope decomposition  ...  envelope-threads\n"
+       << "----------------------------------------------------------------\n\n";
+
+  int failed = 0;
+
+  // grid network with a linearly dependent unknown after the last node
+  SparseMatrix<>* A = TestNetworks::grid(20, 15, 0.01, 1);
+  SparseMatrixGraph<> graph(A);
+
+  for (int n=0; n<3; n++)
+    {
+      auto ord = make_ordering<int>(SparseOrdering(n));
+      ord->reset(&graph);
+
+      Envelope<double,int> env(A, &graph, ord.get());
+      Envelope<double,int> seq(env);
+      seq.cholDec();
+
+      for (int threads : { 2, 3, 0 })
+        {
+          Envelope<double,int> par(env);
+          par.set_threads(threads);
+          par.cholDec();
+
+          const bool ok = identical(seq, par);
+          if (!ok) failed++;
+
+          cout << "ordering " << n << "  threads " << threads
+               << "  defect " << par.defect()
+               << (ok ? "  identical" : "  !!! differs") << "\n";
+        }
+    }
+
+  delete A;
+  return failed;
+}
@@ -0,0 +1,169 @@
+/* homogenization.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/adj.h>
+#include <Math/Business/Adjustment/homogenization.h>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* Scaled design matrix of blocks with different band widths is
+   compared with dense forward substitution of block columns. Results
+   must be identical for any number of threads, rows of a block with
+   3x3 correlated groups inside its band must stay sparse. */
+
+namespace {
+
+  const int columns = 60;
+  unsigned  seed    = 12345;
+
+  double random()
+  {
+    seed = seed*1103515245u + 12345u;
+    return double((seed >> 8) % 1000) / 1000.0;
+  }
+
+  struct Block { int dim, width; bool groups; };
+
+  const vector<Block> blocks {
+    { 5, 0, false}, {30, 2, true}, {40, 4, false}, {12, 11, false}, {7, 0, false}
+  };
+
+  void input(AdjInputData& data)
+  {
+    int rows = 0, floats = 0;
+    for (const Block& b : blocks)
+      {
+        rows   += b.dim;
+        floats += b.dim*(b.width+1) - b.width*(b.width+1)/2;
+      }
+
+    BlockDiagonal<>* cov = new BlockDiagonal<>(int(blocks.size()), floats);
+    for (const Block& b : blocks)
+      {
+        vector<double> mem;
+        for (int i=1; i<=b.dim; i++)
+          {
+            mem.push_back(4.0 + random());
+            for (int j=i+1; j<=b.dim && j<=i+b.width; j++)
+              {
+                const bool zero = b.groups && (i-1)/3 != (j-1)/3;
+                mem.push_back(zero ? 0.0 : 0.5*random() - 0.25);
+              }
+          }
+        cov->add_block(b.dim, b.width, mem.data());
+      }
+
+    SparseMatrix<>* A = new SparseMatrix<>(4*rows, rows, columns);
+    Vec<> rhs(rows);
+    for (int r=1; r<=rows; r++)
+      {
+        A->new_row();
+        const int c = 1 + (3*r) % (columns - 3);
+        for (int k=0; k<4; k++) A->add_element(random() - 0.5, c + k);
+        rhs(r) = random();
+      }
+
+    data.set_mat(A);
+    data.set_cov(cov);
+    data.set_rhs(rhs);
+  }
+
+  Mat<> dense_reference(const AdjInputData& data, int& nonzeroes)
+  {
+    BlockDiagonal<>* bd = data.cov()->replicate();
+    bd->cholDec();
+    UpperBlockDiagonal<> upper(bd);
+
+    const SparseMatrix<>* A = data.mat();
+    Mat<> T(A->rows(), columns);
+    T.set_zero();
+    for (int r=1; r<=A->rows(); r++)
+      for (int k=0; k<A->size(r); k++)
+        T(r, A->ibegin(r)[k]) = A->begin(r)[k];
+
+    for (int row0=1, b=1; b<=bd->blocks(); row0 += bd->dim(b), b++)
+      for (int c=1; c<=columns; c++)
+        for (int i=row0; i<row0+bd->dim(b); i++)
+          {
+            const double* p = upper.begin(i);
+            const double* e = upper.end  (i);
+            const double  x = T(i,c) / *p++;
+            T(i,c) = x;
+            for (int n=i+1; p!=e; n++) T(n,c) -= *p++ * x;
+          }
+
+    nonzeroes = 0;
+    for (int r=1; r<=T.rows(); r++)
+      for (int c=1; c<=columns; c++)
+        if (T(r,c) != 0) nonzeroes++;
+
+    delete bd;
+    return T;
+  }
+
+}
+
+int main()
+{
+  cout << "\n   sparse homogenization of correlated blocks  ...  homogenization\n"
+       << "-------------------------------------------------------------------\n\n";
+
+  AdjInputData data;
+  input(data);
+
+  int dense_nonzeroes = 0;
+  const Mat<> T = dense_reference(data, dense_nonzeroes);
+
+  int failed = 0;
+  for (int threads : { 1, 2, 3, 0 })
+    {
+      Homogenization<> hom(&data);
+      hom.set_threads(threads);
+      const SparseMatrix<>* S = hom.mat();
+
+      Mat<> D(S->rows(), columns);
+      D.set_zero();
+      for (int r=1; r<=S->rows(); r++)
+        for (int k=0; k<S->size(r); k++)
+          D(r, S->ibegin(r)[k]) = S->begin(r)[k];
+
+      bool identical = S->rows() == T.rows() &&
+                       S->nonzeroes() == dense_nonzeroes;
+      for (int r=1; identical && r<=T.rows(); r++)
+        for (int c=1; c<=columns; c++)
+          if (D(r,c) != T(r,c)) identical = false;
+
+      // rows of the block with 3x3 groups (rows 6 ... 35) depend only
+      // on rows of their group
+      bool sparse = true;
+      for (int r=6; r<=35; r++)
+        if (S->size(r) > 3*4) sparse = false;
+
+      if (!identical || !sparse) failed++;
+
+      cout << "threads " << threads
+           << "  nonzeroes " << S->nonzeroes()
+           << (identical ? "  identical" : "  !!! differs")
+           << (sparse    ? "" : "  !!! dense rows") << "\n";
+    }
+
+  return failed;
+}
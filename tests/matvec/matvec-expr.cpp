@@ -0,0 +1,251 @@
+/* matvec-expr.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Service/matvec.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* Sums, differences and scalar multiples of vectors and matrices and
+   products of transposed matrices are compared with element loops,
+   results must be identical. Temporary operands are reused for the
+   results, results are ordinary objects which can be stored (auto)
+   and bound to references of base classes. Assignment keeps storage
+   of the destination of the same size, also when the destination is
+   an operand of the expression. */
+
+namespace {
+
+  using TMat = TransMat<double, int, Exception::matvec>;
+
+  unsigned seed = 12345;
+
+  double random()
+  {
+    seed = seed*1103515245u + 12345u;
+    return double((seed >> 8) % 2001) / 1000.0 - 1.0;
+  }
+
+  Vec<> random_vec(int n)
+  {
+    Vec<> v(n);
+    for (double& x : v) x = random();
+    return v;
+  }
+
+  Mat<> random_mat(int r, int c)
+  {
+    Mat<> M(r, c);
+    for (double& x : M) x = random();
+    return M;
+  }
+
+  int failed = 0;
+
+  void check(const string& test, bool ok)
+  {
+    if (!ok) failed++;
+    cout << test << (ok ? "  ok\n" : "  !!! failed\n");
+  }
+
+  template <typename A, typename B>
+  bool identical(const A& a, const B& b)
+  {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) return false;
+    for (int i=1; i<=a.rows(); i++)
+      for (int j=1; j<=a.cols(); j++)
+        if (a(i,j) != b(i,j)) return false;
+    return true;
+  }
+
+  bool identical(const Vec<>& a, const Vec<>& b)
+  {
+    return a.dim() == b.dim() && std::equal(a.begin(), a.end(), b.begin());
+  }
+
+  /* template deducing its arguments from the base class */
+  template <typename Float, typename Index, typename Exc>
+  Float max_abs(const MatVecBase<Float, Index, Exc>& M)
+  {
+    Float m = 0;
+    for (const Float x : M) m = std::max(m, std::abs(x));
+    return m;
+  }
+
+}
+
+int main()
+{
+  cout << "\n   vector and matrix expressions  ...  matvec-expr\n"
+       << "----------------------------------------------------\n\n";
+
+  const int n = 50, m = 30;
+
+  const Vec<> a = random_vec(n), b = random_vec(n), c = random_vec(n);
+  {
+    Vec<> r(n);
+    for (int i=1; i<=n; i++) r(i) = (a(i) + b(i)*2.0) - c(i)*0.5;
+
+    const Vec<> x = a + b*2.0 - 0.5*c;
+    check("Vec expression", identical(x, r));
+
+    Vec<> t = b*2.0;
+    const double* buffer = t.begin();
+    Vec<> y = a + std::move(t) - c*0.5;
+    check("Vec temporary reused", identical(y, r) && y.begin() == buffer);
+
+    Vec<> s(n);
+    for (int i=1; i<=n; i++) s(i) = a(i) - (b(i) - c(i));
+    check("Vec temporary right operand", identical(a - (b - c), s));
+
+    double d = 0;
+    for (int i=1; i<=n; i++) d += a(i)*b(i);
+    check("trans(Vec)*Vec", trans(a)*b == d);
+
+    double q = 0;
+    for (int i=1; i<=n; i++) q = std::max(q, std::abs(a(i) - b(i)));
+    check("Vec expression bound to MatVecBase&", max_abs(a - b) == q);
+  }
+
+  const Mat<> A = random_mat(n, m), B = random_mat(n, m), C = random_mat(m, m);
+  {
+    Mat<> R(n, m);
+    for (int i=1; i<=n; i++)
+      for (int j=1; j<=m; j++)
+        R(i,j) = (A(i,j)*3.0 + B(i,j)) - A(i,j);
+
+    const Mat<> X = A*3.0 + B - A;
+    check("Mat expression", identical(X, R));
+
+    Mat<> T = A*3.0;
+    const double* buffer = T.begin();
+    const Mat<> Y = std::move(T) + B - A;
+    check("Mat temporary reused", identical(Y, R) && Y.begin() == buffer);
+
+    double q = 0;
+    for (int i=1; i<=n; i++)
+      for (int j=1; j<=m; j++) q = std::max(q, std::abs(A(i,j) - B(i,j)));
+    check("Mat expression bound to MatVecBase&", max_abs(A - B) == q);
+    check("trans(Mat) bound to MatVecBase&", max_abs(trans(A)) == max_abs(A));
+
+    const TMat S = trans(A)*2.0 + trans(A);
+    Mat<> U(m, n);
+    for (int i=1; i<=m; i++)
+      for (int j=1; j<=n; j++)
+        U(i,j) = A(j,i)*2.0 + A(j,i);
+    check("TransMat expression", identical(S, U));
+  }
+  {
+    Mat<> P(m, m), Q(m, n);
+    Vec<> p(m);
+    P.set_zero();
+    Q.set_zero();
+    p.set_zero();
+    for (int i=1; i<=m; i++)
+      for (int k=1; k<=n; k++)
+        {
+          for (int j=1; j<=m; j++) P(i,j) += A(k,i)*B(k,j);
+          p(i) += A(k,i)*a(k);
+        }
+    for (int i=1; i<=m; i++)
+      for (int j=1; j<=n; j++)
+        for (int k=1; k<=m; k++) Q(i,j) += C(i,k)*A(j,k);
+
+    const Mat<> TB = trans(A)*B;
+    const Mat<> CT = C*trans(A);
+    const Mat<> TT = trans(C)*trans(A);
+
+    Vec<> Ta = trans(A)*a;
+    bool ok = Ta.dim() == m;
+    for (int i=1; ok && i<=m; i++) ok = Ta(i) == p(i);
+    check("trans(Mat)*Mat", identical(TB, P));
+    check("trans(Mat)*Vec", ok);
+    check("Mat*trans(Mat)", identical(CT, Q));
+    check("trans(Mat)*trans(Mat)", identical(TT, Mat<>(trans(C))*Mat<>(trans(A))));
+  }
+  {
+    // results of operations with temporaries can be stored
+    const Vec<> x = random_vec(m);
+    auto r = A*x - a;
+    auto s = 2.0*(A*x) + a;
+    auto M = trans(A)*B - C;
+    Vec<> y = r;
+
+    Vec<> ax = A*x;
+    bool ok = true;
+    for (int i=1; i<=n; i++)
+      ok = ok && y(i) == ax(i) - a(i) && s(i) == ax(i)*2.0 + a(i);
+    check("auto result of temporaries", ok);
+    check("auto Mat result of temporaries", identical(M, trans(A)*B - C));
+  }
+  {
+    // assignment of a temporary reuses storage of the destination
+    Vec<> x = a;
+    const double* buffer = x.begin();
+    x = b*2.0 + c;
+    bool ok = x.begin() == buffer;
+    for (int i=1; i<=n; i++) ok = ok && x(i) == b(i)*2.0 + c(i);
+    check("Vec assignment reuses destination", ok);
+
+    Mat<> X = A;
+    const double* mbuffer = X.begin();
+    X = B - A*0.5;
+    check("Mat assignment reuses destination",
+          X.begin() == mbuffer && identical(X, Mat<>(B - A*0.5)));
+
+    Mat<> Z(m, n);
+    Z = trans(A);
+    check("assignment of different dimensions",
+          Z.rows() == m && Z.cols() == n && identical(Z, Mat<>(trans(A))));
+
+    Vec<> e;
+    e = a + b;
+    check("assignment of different size", identical(e, a + b));
+  }
+  {
+    // operands aliased with the destination or with each other
+    Vec<> r(n), s(n);
+    for (int i=1; i<=n; i++) r(i) = (a(i)*2.0 + a(i)) - a(i);
+
+    Vec<> x = a;
+    x = x*2.0 + x - x;
+    check("Vec destination as operand", identical(x, r));
+
+    x = a;
+    x = std::move(x)*2.0 + a - a;
+    check("Vec destination as temporary operand", identical(x, r));
+
+    for (int i=1; i<=n; i++) s(i) = a(i) + a(i);
+    x = a;
+    x = std::move(x) + x;
+    check("Vec temporary operand aliased", identical(x, s));
+
+    Mat<> X = A, R(n, m);
+    for (int i=1; i<=n; i++)
+      for (int j=1; j<=m; j++) R(i,j) = A(i,j) - A(i,j)*0.5;
+    X = std::move(X) - X*0.5;
+    check("Mat temporary operand aliased", identical(X, R));
+  }
+
+  return failed;
+}
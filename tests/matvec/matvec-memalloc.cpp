@@ -0,0 +1,193 @@
+/* matvec-memalloc.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Service/matvec.h>
+#include <Math/Service/memalloc.h>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* The same computation is run with all allocation policies, results
+   must be identical. Aligned and pool blocks must be aligned to 64
+   bytes, blocks of repeated temporaries must be reused from the pool,
+   also blocks released in another thread, release of a pool in
+   another thread must not touch blocks cached by an active arena, and
+   all storage must be released (no bytes in use left). */
+
+namespace {
+
+  int failed = 0;
+
+  void check(const string& test, bool ok)
+  {
+    if (!ok) failed++;
+    cout << test << (ok ? "  ok\n" : "  !!! failed\n");
+  }
+
+  bool identical(const Vec<>& a, const Vec<>& b)
+  {
+    return a.dim() == b.dim() && std::equal(a.begin(), a.end(), b.begin());
+  }
+
+  bool aligned(const double* p)
+  {
+    return reinterpret_cast<std::uintptr_t>(p) % MemAlloc::alignment == 0;
+  }
+
+  /* temporaries of different sizes in a loop */
+  Vec<> compute(int n)
+  {
+    Mat<> A(n, n);
+    for (int i=1; i<=n; i++)
+      for (int j=1; j<=n; j++)
+        A(i,j) = 1.0/(i + j - 1) + (i == j ? 1 : 0);
+
+    Vec<> s(n);
+    s.set_zero();
+    for (int k=1; k<=20; k++)
+      {
+        Vec<> t(n), u(k);
+        for (int i=1; i<=n; i++) t(i) = k + i;
+        for (int i=1; i<=k; i++) u(i) = i;
+        Mat<> B = A*A;
+        s = s + B*t + u.norm_L2()*t;
+      }
+    return s;
+  }
+
+}
+
+int main()
+{
+  cout << "\n   allocation policies  ...  matvec-memalloc\n"
+       << "----------------------------------------------\n\n";
+
+  const int n = 40;
+
+  MemAlloc::set_policy(MemAlloc::Policy::standard);
+  const Vec<> r = compute(n);
+  const long long in_use = MemAlloc::stats().in_use;
+
+  MemAlloc::set_policy(MemAlloc::Policy::aligned);
+  {
+    const Vec<> a = compute(n);
+    Mat<> M(3, 7);
+    check("aligned policy results", identical(a, r));
+    check("aligned blocks", aligned(a.begin()) && aligned(M.begin()));
+  }
+
+  MemAlloc::set_policy(MemAlloc::Policy::pool);
+  Vec<> outlives;
+  {
+    MemPool pool;
+    {
+      MemArena arena(pool);
+
+      MemAlloc::reset_stats();
+      const Vec<> p = compute(n);
+      const MemAlloc::Stats s = MemAlloc::stats();
+
+      check("pool policy results", identical(p, r));
+      check("pool blocks", aligned(p.begin()));
+      check("pool reuses blocks", s.pool_reuses > 0 &&
+            s.heap_allocations + s.pool_reuses == s.allocations);
+      check("pool caches released blocks", pool.cached_bytes() > 0);
+
+      outlives = p;
+    }
+
+    Vec<> heap(n);   // no arena active
+    check("allocation without arena", aligned(heap.begin()));
+
+    pool.release();
+    check("pool release", pool.cached_bytes() == 0);
+
+    {
+      MemArena arena(pool);
+      outlives = compute(n);     // block of the pool outlives it
+    }
+  }
+  check("block outliving its pool", identical(outlives, r));
+  outlives.reset();
+
+  {
+    MemPool pool;
+    MemArena arena(pool);
+
+    MemAlloc::reset_stats();
+    Vec<> a(100);
+    std::thread thread([&]()
+      {
+        MemArena other(pool);    // the pool is active in the main thread
+        Vec<> b(100);
+        a.reset();
+      });
+    thread.join();
+    Vec<> c(100);
+
+    const MemAlloc::Stats s = MemAlloc::stats();
+    check("block released in another thread reused",
+          s.pool_reuses == 1 && pool.cached_bytes() == 0);
+    check("statistics of all threads",
+          s.allocations == 3 && s.heap_allocations == 2);
+  }
+
+  {
+    MemPool pool;
+    {
+      MemArena arena(pool);
+      { Vec<> a(100); }
+      std::thread thread([&]() { pool.release(); });
+      thread.join();
+      check("release keeps blocks of an arena in another thread",
+            pool.cached_bytes() > 0);
+    }
+    std::thread thread([&]() { pool.release(); });
+    thread.join();
+    check("release in another thread", pool.cached_bytes() == 0);
+
+    // arenas of one thread and releases of another
+    bool same = true;
+    std::thread releases([&]()
+      {
+        for (int i=0; i<200; i++) pool.release();
+      });
+    for (int i=0; i<200; i++)
+      {
+        MemArena arena(pool);
+        same = same && identical(compute(20), compute(20));
+      }
+    releases.join();
+    check("arenas and concurrent release", same);
+  }
+
+  MemAlloc::set_policy(MemAlloc::Policy::standard);
+  {
+    Vec<> a(10), b(20);
+    a = b;                       // copy of different size
+    b = a;
+  }
+  check("all blocks released", MemAlloc::stats().in_use == in_use);
+
+  return failed;
+}
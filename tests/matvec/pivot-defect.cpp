@@ -0,0 +1,157 @@
+/* pivot-defect.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/envelope.h>
+#include <Math/Business/Adjustment/supernodal.h>
+#include <Math/Service/smatrix.h>
+#include <Math/Service/smatrix_graph.h>
+#include <Math/Service/smatrix_ordering.h>
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* Linearly dependent unknowns of LDL' decomposition of normal
+   equations. A free network of distances has datum defect 3 for any
+   weights of observations, a network with a weakly determined
+   rotation is near-singular but regular. Defect must not depend on
+   the scale of weights, on ordering and on the decomposition. */
+
+namespace {
+
+  const int nx = 12, ny = 10;
+
+  int id(int i, int j) { return 2*(i*ny + j) + 1; }
+
+  double px(int i, int j) { return 100.0*i + 7.0*std::sin(1.3*i + 0.7*j); }
+  double py(int i, int j) { return 100.0*j + 7.0*std::cos(0.9*i + 1.1*j); }
+
+  /* distances to the right, upper and diagonal neighbours with weight
+     w; if rotation > 0 the first point is fixed and the rotation is
+     given by an observed coordinate of the second point */
+
+  SparseMatrix<>* network(double w, double rotation)
+  {
+    int rows = 0;
+    for (int i=0; i<nx; i++)
+      for (int j=0; j<ny; j++)
+        rows += (i+1 < nx) + (j+1 < ny) + (i+1 < nx && j+1 < ny);
+    if (rotation > 0) rows += 3;
+
+    SparseMatrix<>* A = new SparseMatrix<>(4*rows, rows, 2*nx*ny);
+
+    auto distance = [A, w](int i, int j, int k, int l)
+      {
+        const double dx = px(k,l) - px(i,j);
+        const double dy = py(k,l) - py(i,j);
+        const double d  = std::sqrt(dx*dx + dy*dy);
+        A->new_row();
+        A->add_element(-w*dx/d, id(i,j));
+        A->add_element(-w*dy/d, id(i,j)+1);
+        A->add_element( w*dx/d, id(k,l));
+        A->add_element( w*dy/d, id(k,l)+1);
+      };
+
+    for (int i=0; i<nx; i++)
+      for (int j=0; j<ny; j++)
+        {
+          if (i+1 < nx)             distance(i, j, i+1, j);
+          if (j+1 < ny)             distance(i, j, i, j+1);
+          if (i+1 < nx && j+1 < ny) distance(i, j, i+1, j+1);
+        }
+
+    if (rotation > 0)
+      {
+        A->new_row();
+        A->add_element(w, id(0,0));
+        A->new_row();
+        A->add_element(w, id(0,0)+1);
+        A->new_row();
+        A->add_element(rotation*w, id(0,1));
+      }
+
+    return A;
+  }
+
+  int envelope(const SparseMatrix<>* A, SparseOrdering ord, int threads)
+  {
+    SparseMatrixGraph<> graph(A);
+    auto ordering = make_ordering<int>(ord);
+    ordering->reset(&graph);
+
+    Envelope<double,int> env(A, &graph, ordering.get());
+    env.set_threads(threads);
+    env.cholDec();
+    return env.defect();
+  }
+
+  int supernodal(const SparseMatrix<>* A, SparseOrdering ord)
+  {
+    SparseMatrixGraph<> graph(A);
+    auto ordering = make_ordering<int>(ord);
+    ordering->reset(&graph);
+
+    Supernodal<double,int> sn;
+    sn.set(A, &graph, ordering.get());
+    sn.cholDec();
+    return sn.defect();
+  }
+
+}
+
+int main()
+{
+  cout << "\n   linearly dependent unknowns  ...  pivot-defect\n"
+       << "--------------------------------------------------\n\n";
+
+  const char* names[] = { "rcm", "amd", "nd " };
+  const SparseOrdering orderings[] = {
+    SparseOrdering::rcm, SparseOrdering::amd, SparseOrdering::nd
+  };
+
+  int failed = 0;
+  for (double rotation : { 0.0, 1e-2 })
+    for (double w : { 1e-2, 1.0, 1e2, 1e4 })
+      {
+        const int defect = rotation > 0 ? 0 : 3;
+        SparseMatrix<>* A = network(w, rotation);
+
+        for (int k=0; k<3; k++)
+          {
+            const int e1 = envelope(A, orderings[k], 1);
+            const int e2 = envelope(A, orderings[k], 2);
+            const int sn = supernodal(A, orderings[k]);
+
+            const bool ok = e1 == defect && e2 == defect && sn == defect;
+            if (!ok) failed++;
+
+            cout << (rotation > 0 ? "regular " : "free    ")
+                 << "weight " << w << "\t" << names[k]
+                 << "  envelope " << e1 << " " << e2
+                 << "  supernodal " << sn
+                 << (ok ? "" : "   !!! defect should be ") ;
+            if (!ok) cout << defect;
+            cout << "\n";
+          }
+
+        delete A;
+      }
+
+  return failed;
+}
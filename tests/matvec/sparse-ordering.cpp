@@ -0,0 +1,80 @@
+/* sparse-ordering.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Service/smatrix.h>
+#include <Math/Service/smatrix_graph.h>
+#include <Math/Service/smatrix_ordering.h>
+#include "test-networks.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace GNU_gama;
+
+bool permutation(const SparseMatrixOrdering<>& ord)
+{
+  const int N = ord.nodes();
+  vector<int> count(N+1, 0);
+  for (int i=1; i<=N; i++)
+    {
+      const int p = ord.perm(i);
+      if (p < 1 || p > N || count[p]++ || ord.invp(p) != i) return false;
+    }
+  return true;
+}
+
+int main()
+{
+  cout << "\n   sparse matrix orderings  ...  sparse-ordering\n"
+       << "------------------------------------------------\n\n";
+
+  int failed = 0;
+  SparseMatrix<>* A = TestNetworks::grid(30, 30);
+  SparseMatrixGraph<> graph(A);
+
+  const char* name[] = { "rcm", "amd", "nd " };
+  double fill[3];
+  for (int n=0; n<3; n++)
+    {
+      auto ord = make_ordering<int>(SparseOrdering(n));
+      ord->reset(&graph);
+
+      FactorStatistics<> stat(&graph, ord.get());
+      fill[n] = stat.nonzeroes();
+
+      const bool ok = permutation(*ord);
+      if (!ok) failed++;
+
+      cout << name[n] << "  nonzeroes " << setw(8) << stat.nonzeroes()
+           << "  flops "  << setw(10) << stat.flops()
+           << "  envelope " << setw(8) << stat.envelope_nonzeroes()
+           << (ok ? "" : "  !!! not a permutation") << "\n";
+    }
+
+  // fill reducing orderings must beat profile reduction on 2D grids
+
+  if (fill[1] >= fill[0] || fill[2] >= fill[0])
+    {
+      cout << "\n!!! fill of amd/nd is not lower than fill of rcm\n";
+      failed++;
+    }
+
+  delete A;
+  return failed;
+}
@@ -0,0 +1,96 @@
+/* supernodal-inverse.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/supernodal.h>
+#include <Math/Service/smatrix.h>
+#include <Math/Service/smatrix_graph.h>
+#include <Math/Service/smatrix_ordering.h>
+#include "test-networks.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* selected inversion of supernodal decomposition compared with columns
+   of inv(N) computed by solve(), for a regular and a free network; all
+   pairs of columns of a design matrix row must be within the selected
+   inverse */
+
+namespace
+{
+  int test(bool fixed)
+  {
+    const int points = 40;
+    const int N = 2*points;
+    // the first point of the chain is fixed in the regular network
+    SparseMatrix<>* A = TestNetworks::chain(points, fixed);
+
+    SparseMatrixGraph<> graph(A);
+    ApproximateMinimumDegree<> ordering;
+    ordering.reset(&graph);
+
+    Supernodal<double,int> sn;
+    sn.set(A, &graph, &ordering);
+    sn.cholDec();
+    sn.inverse();
+
+    double maxdif = 0;
+    int count = 0;
+    std::vector<double> col(N);
+    for (int j=1; j<=N; j++)
+      {
+        std::fill(col.begin(), col.end(), 0.0);
+        col[j-1] = 1;
+        sn.solve(col.data(), N);
+
+        for (int i=1; i<=N; i++)
+          if (const double* z = sn.inverse(i, j))
+            {
+              const double d = std::abs(*z - col[i-1]);
+              const double s = std::abs(*sn.inverse(j, j));
+              maxdif = std::max(maxdif, s > 0 ? d/s : d);
+              count++;
+            }
+      }
+
+    bool clique = true;
+    for (int r=1; r<=A->rows(); r++)
+      for (int *b=A->ibegin(r), *e=A->iend(r); b!=e; b++)
+        for (int *c=A->ibegin(r); c!=e; c++)
+          clique = clique && sn.inverse(sn.invp(*b), sn.invp(*c)) != nullptr;
+
+    const int defect = fixed ? 0 : 2;
+    cout << (fixed ? "regular" : "free   ")
+         << "  supernodes " << sn.supernodes() << "  elements " << count
+         << "  defect " << sn.defect() << "  maxdif " << maxdif
+         << (clique ? "" : "  row pairs outside the structure") << "\n";
+
+    delete A;
+    return (sn.defect() == defect && clique && maxdif < 1e-10) ? 0 : 1;
+  }
+}
+
+int main()
+{
+  cout << "\n   supernodal selected inversion  ...  supernodal-inverse\n"
+       << "----------------------------------------------------------\n\n";
+
+  return test(true) + test(false);
+}
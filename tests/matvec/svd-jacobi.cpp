@@ -0,0 +1,235 @@
+/* svd-jacobi.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Service/svd.h>
+#include <Math/Service/hilbert.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* One-sided Jacobi SVD is compared with the Golub-Reinsch SVD on full
+   rank, rank deficient and ill-conditioned matrices: residuals of
+   A = U*W*trans(V), orthogonality of V, singular values, nullity,
+   weight coefficients q_xx and solutions with and without
+   regularization of a subset of unknowns. Matrices with graded columns
+   test pivoting of the QR preconditioning. Results of the Jacobi
+   method must not depend on the number of threads. */
+
+namespace {
+
+  unsigned seed = 4321;
+
+  double random()
+  {
+    seed = seed*1103515245u + 12345u;
+    return double((seed >> 8) % 2001) / 1000.0 - 1.0;
+  }
+
+  Mat<> random_mat(int m, int n, int defect)
+  {
+    Mat<> A(m, n);
+    for (double& a : A) a = random();
+    for (int d=0; d<defect; d++)        // dependent columns
+      for (int i=1; i<=m; i++)
+        A(i, n-d) = A(i, 1+d) - 0.5*A(i, 2+d);
+    return A;
+  }
+
+  int failed = 0;
+
+  void check(const string& test, bool ok)
+  {
+    if (!ok) failed++;
+    cout << test << (ok ? "  ok\n" : "  !!! failed\n");
+  }
+
+  double residual(SVD<>& svd, const Mat<>& A)
+  {
+    const Mat<>& U = svd.SVD_U();
+    const Vec<>& W = svd.SVD_W();
+    const Mat<>& V = svd.SVD_V();
+    double r = 0;
+    for (int i=1; i<=A.rows(); i++)
+      for (int j=1; j<=A.cols(); j++)
+        {
+          double s = 0;
+          for (int k=1; k<=A.cols(); k++) s += U(i,k)*W(k)*V(j,k);
+          r = std::max(r, std::abs(s - A(i,j)));
+        }
+    return r;
+  }
+
+  double orthogonality(SVD<>& svd)
+  {
+    const Mat<>& V = svd.SVD_V();
+    double r = 0;
+    for (int i=1; i<=V.cols(); i++)
+      for (int j=1; j<=V.cols(); j++)
+        {
+          double s = 0;
+          for (int k=1; k<=V.rows(); k++) s += V(k,i)*V(k,j);
+          r = std::max(r, std::abs(s - (i == j ? 1 : 0)));
+        }
+    return r;
+  }
+
+  vector<double> singular_values(SVD<>& svd)
+  {
+    const Vec<>& W = svd.SVD_W();
+    vector<double> w(W.begin(), W.end());
+    sort(w.begin(), w.end());
+    return w;
+  }
+
+  /* maximal difference of q_xx relative to the maximal |q_xx| */
+  double qxx_difference(SVD<>& a, SVD<>& b, int n)
+  {
+    double d = 0, q = 0;
+    for (int i=1; i<=n; i++)
+      for (int j=1; j<=n; j++)
+        {
+          q = std::max(q, std::abs(a.q_xx(i,j)));
+          d = std::max(d, std::abs(a.q_xx(i,j) - b.q_xx(i,j)));
+        }
+    return d/q;
+  }
+
+  double solution_difference(SVD<>& a, SVD<>& b, const Vec<>& rhs)
+  {
+    Vec<> x, y;
+    a.solve(rhs, x);
+    b.solve(rhs, y);
+    double d = 0, s = 0;
+    for (int i=1; i<=x.dim(); i++)
+      {
+        s = std::max(s, std::abs(x(i)));
+        d = std::max(d, std::abs(x(i) - y(i)));
+      }
+    return d/s;
+  }
+
+  void compare(const string& name, const Mat<>& A, double tol_q)
+  {
+    const int n = A.cols();
+    double norm = 0;
+    for (double a : A) norm = std::max(norm, std::abs(a));
+
+    SVD<> gr, jc;
+    gr.reset(A);
+    jc.set_method(SVDMethod::jacobi);
+    jc.reset(A);
+
+    const double rg = residual(gr, A)/norm, rj = residual(jc, A)/norm;
+    const double og = orthogonality(gr),   oj = orthogonality(jc);
+
+    const vector<double> wg = singular_values(gr), wj = singular_values(jc);
+    double dw = 0;
+    for (int i=0; i<n; i++) dw = std::max(dw, std::abs(wg[i] - wj[i]));
+    dw /= wg.back();
+
+    Vec<> rhs(A.rows());
+    for (double& r : rhs) r = random();
+    const double dq = qxx_difference(gr, jc, n);
+    const double dx = solution_difference(gr, jc, rhs);
+
+    cout << scientific << setprecision(1)
+         << name << "  nullity " << gr.nullity()
+         << "  residual " << rg << " " << rj
+         << "  orthogonality " << og << " " << oj
+         << "  W " << dw << "  q_xx " << dq << "  x " << dx << "\n";
+
+    check(name + " residual", rj < 1e-13*n && rg < 1e-13*n);
+    check(name + " orthogonality", oj < 1e-13*n);
+    check(name + " singular values", dw < 1e-12*n);
+    check(name + " nullity", gr.nullity() == jc.nullity());
+    check(name + " q_xx", dq < tol_q);
+    check(name + " solution", dx < tol_q);
+
+    if (gr.nullity() > 0)
+      {
+        vector<int> subset;
+        for (int i=1; i<=n; i+=2) subset.push_back(i);
+        gr.min_x(int(subset.size()), subset.data());
+        jc.min_x(int(subset.size()), subset.data());
+        check(name + " q_xx min_x(subset)", qxx_difference(gr, jc, n) < tol_q);
+        check(name + " solution min_x(subset)",
+              solution_difference(gr, jc, rhs) < tol_q);
+      }
+  }
+
+  // results must be identical for any number of threads
+
+  void threads(const string& name, const Mat<>& A, int t, int defect)
+  {
+    SVD<> a, b;
+    a.set_method(SVDMethod::jacobi);
+    b.set_method(SVDMethod::jacobi);
+    a.set_threads(1);
+    b.set_threads(t);
+    a.reset(A);
+    b.reset(A);
+
+    const Vec<>& wa = a.SVD_W();
+    const Vec<>& wb = b.SVD_W();
+    const Mat<>& ua = a.SVD_U();
+    const Mat<>& ub = b.SVD_U();
+    const Mat<>& va = a.SVD_V();
+    const Mat<>& vb = b.SVD_V();
+    check(name + " identical",
+          std::equal(wa.begin(), wa.end(), wb.begin()) &&
+          std::equal(ua.begin(), ua.end(), ub.begin()) &&
+          std::equal(va.begin(), va.end(), vb.begin()) &&
+          a.nullity() == defect && b.nullity() == defect);
+  }
+
+}
+
+int main()
+{
+  cout << "\n   one-sided Jacobi SVD  ...  svd-jacobi\n"
+       << "-----------------------------------------\n\n";
+
+  compare("full rank  60 x 20", random_mat(60, 20, 0), 1e-10);
+  compare("defect 3   60 x 20", random_mat(60, 20, 3), 1e-10);
+  compare("square     30 x 30", random_mat(30, 30, 0), 1e-8);
+  compare("hilbert     8 x  8", Hilbert<>(8), 1e-4);
+
+  Mat<> G = random_mat(80, 12, 0);     // graded columns, permuted by QR
+  for (int i=1; i<=G.rows(); i++)
+    for (int j=1; j<=G.cols(); j++) G(i,j) *= std::pow(10.0, -((5*j) % 12));
+  compare("graded     80 x 12", G, 1e-6);
+
+  // above the size limit the decomposition runs on more threads, the
+  // limit is lifted for the small matrices
+
+  threads("threads 1 and 3  240 x 120", random_mat(240, 120, 2), 3, 2);
+
+  set_svd_parallel_work(0);
+  threads("threads 1 and 3   60 x  20", random_mat(60, 20, 3), 3, 3);
+  threads("threads 1 and 4   30 x  30", random_mat(30, 30, 0), 4, 0);
+  threads("threads 1 and 2    8 x   8", Hilbert<>(8), 2, 0);
+  set_svd_parallel_work(1e6);
+
+  return failed;
+}
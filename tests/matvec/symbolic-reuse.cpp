@@ -0,0 +1,161 @@
+/* symbolic-reuse.cpp
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <Math/Business/Adjustment/adj.h>
+#include <Math/Business/Adjustment/adj_envelope.h>
+#include <Math/Business/Adjustment/adj_supernodal.h>
+#include <Utilities/Service/profile.h>
+#include "test-networks.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace GNU_gama;
+
+/* the symbolic factorization of sparse algorithms is reused when the
+   sparsity pattern of the design matrix has not changed (linearization
+   iterations); solutions with the reused structure must be identical
+   with a fresh factorization of the same input, a changed pattern must
+   be detected */
+
+namespace {
+
+  const int points = 40;
+  const int N = 2*points;
+
+  // chain of 2D points with the first point fixed, angles and values
+  // depend on the iteration, with 'tie' every fifth point is connected
+  // also to the point three positions ahead (new pattern)
+
+  void input(AdjInputData& data, int iteration, bool tie)
+  {
+    SparseMatrix<>* A = TestNetworks::chain(points, true, 0.07*iteration, tie);
+    const int rows = A->rows();
+    Vec<> rhs(rows);
+    rhs(1) =  0.01*iteration;
+    rhs(2) = -0.01*iteration;
+    for (int r=3; r<=rows; r++)
+      rhs(r) = r % 2 ? std::sin(1.7*r + iteration) : std::cos(1.3*r + iteration);
+
+    BlockDiagonal<>* cov = new BlockDiagonal<>(1, rows);
+    vector<double> mem(rows);
+    for (int i=0; i<rows; i++) mem[i] = 1.0 + 0.1*((i + iteration) % 7);
+    cov->add_block(rows, 0, mem.data());
+
+    data.set_mat(A);
+    data.set_cov(cov);
+    data.set_rhs(rhs);
+  }
+
+  template <typename Adjustment>
+  bool identical(Adjustment& reused, Adjustment& fresh)
+  {
+    const Vec<>& xr = reused.unknowns();
+    const Vec<>& xf = fresh.unknowns();
+    const Vec<>& vr = reused.residuals();
+    const Vec<>& vf = fresh.residuals();
+
+    bool same = reused.defect() == fresh.defect()
+      && reused.sum_of_squares() == fresh.sum_of_squares();
+    for (int i=1; same && i<=N; i++)
+      same = xr(i) == xf(i) && reused.q_xx(i,i) == fresh.q_xx(i,i)
+        && (i == N || reused.q_xx(i,i+1) == fresh.q_xx(i,i+1));
+    for (int i=1; same && i<=vr.dim(); i++)
+      same = vr(i) == vf(i);
+
+    return same;
+  }
+
+  int calls(const Profile& profile, const string& name)
+  {
+    int n = 0;
+    for (const Profile::Phase& p : profile.phases())
+      if (p.name == name) n += p.calls;
+    return n;
+  }
+
+  template <typename Adjustment>
+  int test(const char* name, SparseOrdering ordering)
+  {
+    // iterations 0 and 1 share the pattern, iteration 2 changes it
+
+    vector<unique_ptr<AdjInputData>> data;
+    for (int k=0; k<3; k++)
+      {
+        data.emplace_back(new AdjInputData);
+        input(*data.back(), k, k == 2);
+      }
+
+    Profile profile;
+    Adjustment reused;
+    reused.set_ordering(ordering);
+
+    int failed = 0;
+    for (int k=0; k<3; k++)
+      {
+        {
+          Profile::Active active(&profile);
+          reused.reset(data[k].get());
+          reused.unknowns();
+        }
+
+        Adjustment fresh;
+        fresh.set_ordering(ordering);
+        fresh.reset(data[k].get());
+
+        const bool ok = identical(reused, fresh);
+        if (!ok) failed++;
+
+        cout << name << "  ordering " << int(ordering) << "  iteration " << k
+             << (ok ? "  identical" : "  !!! differs") << "\n";
+      }
+
+    // the symbolic phase runs for the first and the changed pattern only
+
+    const int symbolic = calls(profile, "ordering");
+    if (symbolic != 2)
+      {
+        cout << name << "  symbolic factorizations " << symbolic
+             << ", expected 2\n";
+        failed++;
+      }
+
+    return failed;
+  }
+}
+
+int main()
+{
+  cout << "\n   reuse of symbolic factorization  ...  symbolic-reuse\n"
+       << "--------------------------------------------------------\n\n";
+
+  using Envelope   = AdjEnvelope  <double, int, Exception::matvec>;
+  using Supernodal = AdjSupernodal<double, int, Exception::matvec>;
+
+  int failed = 0;
+  for (SparseOrdering ordering : { SparseOrdering::rcm, SparseOrdering::amd })
+    {
+      failed += test<Envelope>  ("envelope  ", ordering);
+      failed += test<Supernodal>("supernodal", ordering);
+    }
+
+  return failed;
+}
@@ -0,0 +1,128 @@
+/* test-networks.h
+   Copyright (C) 2026  GNU Gama developers
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef GNU_gama_tests_matvec_test_networks_h
+#define GNU_gama_tests_matvec_test_networks_h
+
+#include <Math/Service/smatrix.h>
+#include <cmath>
+
+/* design matrices of small networks shared by tests of sparse
+   algorithms */
+
+namespace TestNetworks {
+
+  /* grid network, two unknowns in each node and observations between
+     horizontal and vertical neighbours; coefficients of observations
+     in nodes change by 'slope' with the node indexes, 'free' unknowns
+     without observations are added after the last node */
+
+  inline GNU_gama::SparseMatrix<>* grid(int nx, int ny,
+                                        double slope = 0, int free = 0)
+  {
+    auto id = [ny](int i, int j) { return 2*(i*ny + j) + 1; };
+
+    int rows = 0;
+    for (int i=0; i<nx; i++)
+      for (int j=0; j<ny; j++)
+        rows += 1 + (i+1 < nx) + (j+1 < ny);
+
+    auto* A = new GNU_gama::SparseMatrix<>(4*rows, rows, 2*nx*ny + free);
+    for (int i=0; i<nx; i++)
+      for (int j=0; j<ny; j++)
+        {
+          A->new_row();
+          A->add_element(1.0 + slope*j, id(i,j));
+          A->add_element(0.5 - slope*i, id(i,j)+1);
+
+          if (i+1 < nx)
+            {
+              A->new_row();
+              A->add_element( 0.6, id(i,j));
+              A->add_element( 0.8, id(i,j)+1);
+              A->add_element(-0.6, id(i+1,j));
+              A->add_element(-0.8, id(i+1,j)+1);
+            }
+          if (j+1 < ny)
+            {
+              A->new_row();
+              A->add_element( 0.8, id(i,j));
+              A->add_element(-0.6, id(i,j)+1);
+              A->add_element(-0.8, id(i,j+1));
+              A->add_element( 0.6, id(i,j+1)+1);
+            }
+        }
+
+    return A;
+  }
+
+
+  /* chain of 2D points with coordinate differences to the next two
+     points in rotated coordinate systems, angles of rotations are
+     shifted by 'phase'; the first point is 'fixed' by two rows before
+     its differences, with 'ties' every fifth point is connected also
+     to the point three positions ahead */
+
+  inline GNU_gama::SparseMatrix<>* chain(int points, bool fixed,
+                                         double phase = 0, bool ties = false)
+  {
+    auto linked = [=](int p, int d)
+      {
+        return p+d < points && (d < 3 || (ties && p % 5 == 0));
+      };
+
+    int rows = fixed ? 2 : 0;
+    for (int p=0; p<points; p++)
+      for (int d=1; d<=3; d++)
+        if (linked(p, d)) rows += 2;
+
+    auto* A = new GNU_gama::SparseMatrix<>(4*rows, rows, 2*points);
+    for (int p=0; p<points; p++)
+      {
+        const int x = 2*p + 1;
+        if (p == 0 && fixed)
+          {
+            A->new_row();
+            A->add_element(1.0, x);
+            A->new_row();
+            A->add_element(1.0, x+1);
+          }
+        for (int d=1; d<=3; d++)
+          if (linked(p, d))
+            {
+              const double a = 0.3*p + d + phase;
+              const double c = std::cos(a), s = std::sin(a);
+              A->new_row();
+              A->add_element( c, x);
+              A->add_element( s, x+1);
+              A->add_element(-c, x+2*d);
+              A->add_element(-s, x+2*d+1);
+              A->new_row();
+              A->add_element(-s, x);
+              A->add_element( c, x+1);
+              A->add_element( s, x+2*d);
+              A->add_element(-c, x+2*d+1);
+            }
+      }
+
+    return A;
+  }
+
+}
+
+#endif